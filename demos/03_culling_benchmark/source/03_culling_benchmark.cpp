@@ -0,0 +1,181 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+// Compares frustum culling with SceneCullingBVH against Bullet's Dbvt, which is what DefaultSceneCullingManager uses. Both are
+// given the same random boxes and the same camera path, and the average time of a frustum query and of moving a tenth of the
+// boxes is printed for each object count.
+//
+// This is built the same way as the sandbox, by compiling it with the engine's unity build.
+
+#include "../../../source/GTGE.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+using namespace GT;
+
+
+/// The policy for counting the leaves of a Dbvt that are inside the frustum. This is the same traversal that
+/// DefaultSceneCullingManager::DbvtPolicy does, without passing anything on to a visibility callback.
+struct CountingDbvtPolicy : btDbvt::ICollide
+{
+    CountingDbvtPolicy()
+        : count(0)
+    {
+    }
+
+    void Process(const btDbvtNode*)
+    {
+        this->count += 1;
+    }
+
+    size_t count;
+};
+
+
+static float RandomFloat(float low, float high)
+{
+    return low + (high - low) * (static_cast<float>(rand()) / static_cast<float>(RAND_MAX));
+}
+
+static glm::mat4 CalculateCameraMVP(int frame)
+{
+    float angle = static_cast<float>(frame) * 0.05f;
+
+    glm::mat4 projection = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 300.0f);
+    glm::mat4 view       = glm::lookAt(glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(glm::cos(angle) * 100.0f, 0.0f, glm::sin(angle) * 100.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    return projection * view;
+}
+
+static void RunBenchmark(size_t objectCount, int frameCount)
+{
+    srand(1);
+
+    Vector<glm::vec3> aabbMins(objectCount);
+    Vector<glm::vec3> aabbMaxs(objectCount);
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        glm::vec3 centre(RandomFloat(-500.0f, 500.0f), RandomFloat(-50.0f, 50.0f), RandomFloat(-500.0f, 500.0f));
+        glm::vec3 extents(RandomFloat(0.5f, 4.0f));
+
+        aabbMins.PushBack(centre - extents);
+        aabbMaxs.PushBack(centre + extents);
+    }
+
+
+    // Dbvt.
+    btDbvtBroadphase broadphase;
+    Vector<btBroadphaseProxy*> proxies(objectCount);
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        proxies.PushBack(broadphase.createProxy(ToBulletVector3(aabbMins[i]), ToBulletVector3(aabbMaxs[i]), 0, nullptr, 1, 1, nullptr, nullptr));
+    }
+
+    // SceneCullingBVH.
+    SceneCullingBVH bvh;
+    Vector<uint32_t> objectIDs(objectCount);
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        objectIDs.PushBack(bvh.Add(aabbMins[i], aabbMaxs[i]));
+    }
+
+    Benchmarker bvhBuild;
+    bvhBuild.Start();
+    bvh.Commit();
+    bvhBuild.End();
+
+
+    Benchmarker dbvtQuery;
+    Benchmarker dbvtMove;
+    Benchmarker bvhQuery;
+    Benchmarker bvhMove;
+
+    size_t dbvtVisibleCount = 0;
+    size_t bvhVisibleCount  = 0;
+
+    Vector<uint32_t> visibleObjects(objectCount);
+
+    for (int iFrame = 0; iFrame < frameCount; ++iFrame)
+    {
+        // Move a tenth of the objects.
+        glm::vec3 offset(RandomFloat(-0.1f, 0.1f), 0.0f, RandomFloat(-0.1f, 0.1f));
+
+        dbvtMove.Start();
+        for (size_t i = iFrame % 10; i < objectCount; i += 10)
+        {
+            broadphase.setAabb(proxies[i], ToBulletVector3(aabbMins[i] + offset), ToBulletVector3(aabbMaxs[i] + offset), nullptr);
+        }
+        broadphase.m_sets[0].optimizeIncremental(1);
+        broadphase.m_sets[1].optimizeIncremental(1);
+        dbvtMove.End();
+
+        bvhMove.Start();
+        for (size_t i = iFrame % 10; i < objectCount; i += 10)
+        {
+            bvh.Update(objectIDs[i], aabbMins[i] + offset, aabbMaxs[i] + offset);
+        }
+        bvh.Commit();
+        bvhMove.End();
+
+
+        glm::mat4 mvp = CalculateCameraMVP(iFrame);
+
+        // Dbvt, set up the same way as DefaultSceneCullingManager::ProcessVisibleSceneNodes().
+        dbvtQuery.Start();
+        {
+            Math::Plane planes[6];
+            Math::CalculateFrustumPlanes(mvp, planes, false);
+
+            btVector3 planes_n[6];
+            btScalar  planes_o[6];
+            for (int iPlane = 0; iPlane < 6; ++iPlane)
+            {
+                planes_n[iPlane] = btVector3(planes[iPlane].a, planes[iPlane].b, planes[iPlane].c);
+                planes_o[iPlane] = planes[iPlane].d;
+            }
+
+            CountingDbvtPolicy policy;
+            btDbvt::collideKDOP(broadphase.m_sets[1].m_root, planes_n, planes_o, 6, policy);
+            btDbvt::collideKDOP(broadphase.m_sets[0].m_root, planes_n, planes_o, 6, policy);
+
+            dbvtVisibleCount += policy.count;
+        }
+        dbvtQuery.End();
+
+        bvhQuery.Start();
+        {
+            visibleObjects.Clear();
+            bvh.QueryFrustum(mvp, visibleObjects);
+
+            bvhVisibleCount += visibleObjects.count;
+        }
+        bvhQuery.End();
+    }
+
+
+    printf("%7u objects: Dbvt query %8.3fms, move %8.3fms | BVH query %8.3fms, move %8.3fms, build %8.3fms | visible %u / %u\n",
+        static_cast<unsigned int>(objectCount),
+        dbvtQuery.GetAverageTime() * 1000.0, dbvtMove.GetAverageTime() * 1000.0,
+        bvhQuery.GetAverageTime()  * 1000.0, bvhMove.GetAverageTime()  * 1000.0, bvhBuild.GetAverageTime() * 1000.0,
+        static_cast<unsigned int>(dbvtVisibleCount / frameCount), static_cast<unsigned int>(bvhVisibleCount / frameCount));
+
+
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        broadphase.destroyProxy(proxies[i], nullptr);
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    const size_t objectCounts[] = {10000, 25000, 50000, 100000};
+    for (size_t i = 0; i < sizeof(objectCounts) / sizeof(objectCounts[0]); ++i)
+    {
+        RunBenchmark(objectCounts[i], 200);
+    }
+
+    return 0;
+}
@@ -0,0 +1,191 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+// Times generating a full mipmap chain with MipmapGenerator for the image sizes and formats the engine ships with, and for the larger
+// images that are loaded into the editor. Each chain is generated with the generic per-texel filter, which is what MipmapGenerator
+// used for every format before it had SIMD kernels, with the box filter on the calling thread and split across a thread pool, and
+// with the sRGB filter split across the thread pool. The box filter results are checked against the generic filter.
+//
+// This is built the same way as the sandbox, by compiling it with the engine's unity build.
+
+#include "../../../source/GTGE.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+using namespace GT;
+
+
+/// The maximum number of mipmaps in a chain, which is enough for a 32768x32768 image.
+static const unsigned int MaxMipmapCount = 16;
+
+/// An image to time.
+struct BenchmarkImage
+{
+    unsigned int width;
+    unsigned int height;
+    ImageFormat  format;
+    const char*  description;
+};
+
+
+/// Generates every mipmap after the base mipmap with the given filter.
+static void GenerateChain(Mipmap* chain, unsigned int mipmapCount, MipmapFilter filter, ThreadPool* pThreadPool)
+{
+    for (unsigned int iMipmap = 1; iMipmap < mipmapCount; ++iMipmap)
+    {
+        MipmapGenerator::Generate(chain[iMipmap - 1], chain[iMipmap], filter, pThreadPool);
+    }
+}
+
+/// Generates every mipmap after the base mipmap with the generic per-texel filter.
+static void GenerateChainGeneric(Mipmap* chain, unsigned int mipmapCount)
+{
+    bool isFloat = GetImageFormatDataType(chain[0].format) == ImageFormatDataTypes::Float;
+
+    for (unsigned int iMipmap = 1; iMipmap < mipmapCount; ++iMipmap)
+    {
+        auto &source = chain[iMipmap - 1];
+        auto &dest   = chain[iMipmap];
+
+        dest.DeleteLocalData();
+        dest.format = source.format;
+        dest.width  = ImageUtils::CalculateMipmapWidth(1, source.width);
+        dest.height = ImageUtils::CalculateMipmapHeight(1, source.height);
+        dest.data   = malloc(ImageUtils::CalculateDataSize(dest.width, dest.height, dest.format));
+
+        if (isFloat)
+        {
+            MipmapGenerator::Generate<float>(source.width, source.height, GetImageFormatComponentCount(source.format), source.data, dest.data);
+        }
+        else
+        {
+            MipmapGenerator::Generate<uint8_t>(source.width, source.height, GetImageFormatComponentCount(source.format), source.data, dest.data);
+        }
+    }
+}
+
+/// Determines whether or not every mipmap of the two chains is the same.
+static bool AreChainsEqual(const Mipmap* chainA, const Mipmap* chainB, unsigned int mipmapCount)
+{
+    for (unsigned int iMipmap = 0; iMipmap < mipmapCount; ++iMipmap)
+    {
+        if (memcmp(chainA[iMipmap].data, chainB[iMipmap].data, chainA[iMipmap].GetDataSizeInBytes()) != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static void RunBenchmark(const BenchmarkImage &image, ThreadPool &threadPool)
+{
+    srand(1);
+
+    unsigned int mipmapCount = Min(ImageUtils::CalculateMipmapCount(image.width, image.height), MaxMipmapCount);
+    size_t       dataSize    = ImageUtils::CalculateDataSize(image.width, image.height, image.format);
+
+    // Random texels. Floating point images are given values in [0, 1] rather than random bit patterns.
+    void* data = malloc(dataSize);
+    if (GetImageFormatDataType(image.format) == ImageFormatDataTypes::Float)
+    {
+        for (size_t i = 0; i < dataSize / sizeof(float); ++i)
+        {
+            reinterpret_cast<float*>(data)[i] = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < dataSize; ++i)
+        {
+            reinterpret_cast<uint8_t*>(data)[i] = static_cast<uint8_t>(rand());
+        }
+    }
+
+    Mipmap genericChain[MaxMipmapCount];
+    Mipmap chain[MaxMipmapCount];
+    genericChain[0].format = chain[0].format = image.format;
+    genericChain[0].width  = chain[0].width  = image.width;
+    genericChain[0].height = chain[0].height = image.height;
+    genericChain[0].data   = chain[0].data   = data;
+
+
+    // Large images are run fewer times so that each one takes a similar amount of time.
+    int iterationCount = static_cast<int>(Max(static_cast<size_t>(4), (64 * 1024 * 1024) / dataSize));
+
+    Benchmarker generic;
+    Benchmarker box;
+    Benchmarker boxThreaded;
+    Benchmarker srgbThreaded;
+
+    for (int iIteration = 0; iIteration < iterationCount; ++iIteration)
+    {
+        generic.Start();
+        GenerateChainGeneric(genericChain, mipmapCount);
+        generic.End();
+
+        box.Start();
+        GenerateChain(chain, mipmapCount, MipmapFilter_Box, nullptr);
+        box.End();
+
+        boxThreaded.Start();
+        GenerateChain(chain, mipmapCount, MipmapFilter_Box, &threadPool);
+        boxThreaded.End();
+
+        srgbThreaded.Start();
+        GenerateChain(chain, mipmapCount, MipmapFilter_SRGB, &threadPool);
+        srgbThreaded.End();
+    }
+
+    // The sRGB filter ran last, so the box filter is run again for the comparison.
+    GenerateChain(chain, mipmapCount, MipmapFilter_Box, &threadPool);
+    bool isMatching = AreChainsEqual(genericChain, chain, mipmapCount);
+
+
+    printf("%5ux%-5u %-7s %-28s generic %9.3fms | box %9.3fms, threaded %9.3fms | sRGB threaded %9.3fms | %s\n",
+        image.width, image.height, (image.format == ImageFormat_RGB8) ? "RGB8" : (image.format == ImageFormat_RGBA8) ? "RGBA8" : "RGBA32F", image.description,
+        generic.GetAverageTime() * 1000.0, box.GetAverageTime() * 1000.0, boxThreaded.GetAverageTime() * 1000.0, srgbThreaded.GetAverageTime() * 1000.0,
+        isMatching ? "matches" : "MISMATCH");
+
+
+    // The base mipmap is shared, so only one of the chains can free it.
+    genericChain[0].data = nullptr;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    // The calling thread participates in each batch, like the context's thread pool.
+    unsigned int cpuCount = System::GetCPUCount();
+
+    ThreadPool threadPool;
+    threadPool.Startup((cpuCount > 1) ? cpuCount - 1 : 0);
+
+    printf("%u threads\n", threadPool.GetThreadCount());
+
+    const BenchmarkImage images[] =
+    {
+        {128,  128,  ImageFormat_RGBA8,   "editor sprites"},
+        {256,  256,  ImageFormat_RGB8,    "default.png"},
+        {256,  256,  ImageFormat_RGBA8,   "default-normal.png"},
+        {1024, 1024, ImageFormat_RGB8,    "1K texture"},
+        {1024, 1024, ImageFormat_RGBA8,   "1K texture"},
+        {2048, 2048, ImageFormat_RGBA8,   "2K texture"},
+        {4096, 4096, ImageFormat_RGB8,    "4K texture"},
+        {4096, 4096, ImageFormat_RGBA8,   "4K texture"},
+        {1000, 600,  ImageFormat_RGBA8,   "non-power-of-two GUI image"},
+        {2048, 1024, ImageFormat_RGBA32F, "HDR environment"},
+    };
+
+    for (size_t i = 0; i < sizeof(images) / sizeof(images[0]); ++i)
+    {
+        RunBenchmark(images[i], threadPool);
+    }
+
+    threadPool.Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+// Times loading OBJ models with ModelAsset_OBJ. By default the models are generated grid meshes of increasing size, where each vertex
+// is shared by up to six triangles so that the face vertex deduplication does real work. The paths of OBJ files can also be given on
+// the command line, in which case those are timed instead. The time, vertex and index counts and throughput are printed for each model.
+//
+// This is built the same way as the sandbox, by compiling it with the engine's unity build.
+
+#include "../../../source/GTGE.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+using namespace GT;
+
+
+/// Generates the text of an OBJ file containing a flat grid with the given number of vertices along each side. Every vertex has its
+/// own position and texture coordinate and they all share a single normal. The returned buffer must be freed with free().
+static char* GenerateGridOBJ(unsigned int gridSize, size_t &sizeOut)
+{
+    // No line is longer than 64 characters.
+    size_t lineCount = (gridSize * gridSize * 2) + 1 + ((gridSize - 1) * (gridSize - 1) * 2);
+    char*  data      = reinterpret_cast<char*>(malloc(lineCount * 64));
+    size_t size      = 0;
+
+    for (unsigned int y = 0; y < gridSize; ++y)
+    {
+        for (unsigned int x = 0; x < gridSize; ++x)
+        {
+            size += IO::snprintf(data + size, 64, "v %f %f %f\n", x * 0.1f, y * 0.1f, ((x * y) % 7) * 0.01f);
+        }
+    }
+
+    for (unsigned int y = 0; y < gridSize; ++y)
+    {
+        for (unsigned int x = 0; x < gridSize; ++x)
+        {
+            size += IO::snprintf(data + size, 64, "vt %f %f\n", x / static_cast<float>(gridSize), y / static_cast<float>(gridSize));
+        }
+    }
+
+    size += IO::snprintf(data + size, 64, "vn 0 0 1\n");
+
+    for (unsigned int y = 0; y < gridSize - 1; ++y)
+    {
+        for (unsigned int x = 0; x < gridSize - 1; ++x)
+        {
+            unsigned int i0 = (y * gridSize) + x + 1;           // OBJ indices are 1 based.
+            unsigned int i1 = i0 + 1;
+            unsigned int i2 = i0 + gridSize;
+            unsigned int i3 = i2 + 1;
+
+            size += IO::snprintf(data + size, 64, "f %u/%u/1 %u/%u/1 %u/%u/1\n", i0, i0, i1, i1, i2, i2);
+            size += IO::snprintf(data + size, 64, "f %u/%u/1 %u/%u/1 %u/%u/1\n", i1, i1, i3, i3, i2, i2);
+        }
+    }
+
+    sizeOut = size;
+    return data;
+}
+
+/// Reads the whole of the given file. The returned buffer must be freed with free().
+static char* ReadFile(const char* filePath, size_t &sizeOut)
+{
+    FILE* pFile = fopen(filePath, "rb");
+    if (pFile == nullptr)
+    {
+        return nullptr;
+    }
+
+    fseek(pFile, 0, SEEK_END);
+    size_t size = static_cast<size_t>(ftell(pFile));
+    fseek(pFile, 0, SEEK_SET);
+
+    char* data = reinterpret_cast<char*>(malloc(size + 1));
+    if (fread(data, 1, size, pFile) != size)
+    {
+        free(data);
+        fclose(pFile);
+        return nullptr;
+    }
+
+    data[size] = '\0';
+    fclose(pFile);
+
+    sizeOut = size;
+    return data;
+}
+
+
+static void RunBenchmark(const char* description, const char* data, size_t dataSize)
+{
+    // Small files are run more times so that each one takes a similar amount of time.
+    int iterationCount = static_cast<int>(Max(static_cast<size_t>(2), (16 * 1024 * 1024) / dataSize));
+
+    Benchmarker  benchmarker;
+    size_t       vertexCount = 0;
+    unsigned int indexCount  = 0;
+    bool         succeeded   = true;
+
+    for (int iIteration = 0; iIteration < iterationCount; ++iIteration)
+    {
+        ModelAsset_OBJ model(description, AssetType_Model_OBJ);
+
+        benchmarker.Start();
+        succeeded = model.LoadFromMemory(description, data, dataSize);
+        benchmarker.End();
+
+        if (!succeeded)
+        {
+            break;
+        }
+
+        vertexCount = model.GetMeshVertexDataSize(0) / model.GetMeshVertexStride(0);
+        indexCount  = model.GetMeshIndexCount(0);
+    }
+
+    if (succeeded)
+    {
+        double timeInSeconds = benchmarker.GetAverageTime();
+
+        printf("%-32s %8.2f MB | %8u triangles, %8u vertices | %10.3fms | %8.1f MB/s\n",
+            description, dataSize / (1024.0 * 1024.0), indexCount / 3, static_cast<unsigned int>(vertexCount), timeInSeconds * 1000.0, (dataSize / (1024.0 * 1024.0)) / timeInSeconds);
+    }
+    else
+    {
+        printf("%-32s failed to load\n", description);
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    printf("%u CPUs\n", System::GetCPUCount());
+
+    if (argc > 1)
+    {
+        for (int iArg = 1; iArg < argc; ++iArg)
+        {
+            size_t dataSize;
+            char*  data = ReadFile(argv[iArg], dataSize);
+            if (data != nullptr)
+            {
+                RunBenchmark(argv[iArg], data, dataSize);
+                free(data);
+            }
+            else
+            {
+                printf("%-32s could not be read\n", argv[iArg]);
+            }
+        }
+    }
+    else
+    {
+        // The larger sizes are above the size where the file is split up and parsed on multiple threads.
+        const unsigned int gridSizes[] = {60, 120, 250, 700};
+
+        for (size_t i = 0; i < sizeof(gridSizes) / sizeof(gridSizes[0]); ++i)
+        {
+            char description[64];
+            IO::snprintf(description, sizeof(description), "%ux%u grid", gridSizes[i], gridSizes[i]);
+
+            size_t dataSize;
+            char*  data = GenerateGridOBJ(gridSizes[i], dataSize);
+
+            RunBenchmark(description, data, dataSize);
+            free(data);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,245 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+// Compares HashMap against Map for the two kinds of keys the engine uses them with: pointers to objects, which is what the culling
+// manager and the visibility processor key on, and 64-bit integers. Both containers are given the same keys in the same shuffled order,
+// and the average time of inserting every key, finding every key, iterating over every item and removing every key is printed for each
+// item count. After the timings, both containers are put through the same random sequence of adds and removes and their contents are
+// compared.
+//
+// This is built the same way as the sandbox, by compiling it with the engine's unity build.
+
+#include "../../../source/GTGE.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+using namespace GT;
+
+
+/// The object the pointer keys point to. This is about the size of the smaller objects that are used as keys.
+struct BenchmarkObject
+{
+    int data[8];
+};
+
+/// The largest item count that is timed.
+static const size_t MaxItemCount = 100000;
+
+/// The objects the pointer keys point to.
+static BenchmarkObject g_Objects[MaxItemCount];
+
+
+/// Creates the key for the item at the given index.
+template <typename T>
+T CreateKey(size_t index);
+
+template <>
+uint64_t CreateKey<uint64_t>(size_t index)
+{
+    // Spread the keys out rather than having them be sequential, which would flatter both containers.
+    return static_cast<uint64_t>(index) * 0x9E3779B97F4A7C15ULL;
+}
+
+template <>
+const BenchmarkObject* CreateKey<const BenchmarkObject*>(size_t index)
+{
+    return &g_Objects[index];
+}
+
+
+/// Creates the keys for the given number of items, in a shuffled order.
+template <typename T>
+void CreateShuffledKeys(size_t itemCount, Vector<T> &keysOut)
+{
+    keysOut.Clear();
+    for (size_t i = 0; i < itemCount; ++i)
+    {
+        keysOut.PushBack(CreateKey<T>(i));
+    }
+
+    for (size_t i = itemCount - 1; i > 0; --i)
+    {
+        size_t j = static_cast<size_t>(rand()) % (i + 1);
+
+        T temp = keysOut[i];
+        keysOut[i] = keysOut[j];
+        keysOut[j] = temp;
+    }
+}
+
+
+/// The timings of one container.
+struct ContainerTimings
+{
+    Benchmarker insert;
+    Benchmarker find;
+    Benchmarker iterate;
+    Benchmarker remove;
+};
+
+static void PrintTimings(const char* keyDescription, size_t itemCount, const char* containerDescription, const ContainerTimings &timings, size_t sink)
+{
+    // The sink is printed so that the compiler can't throw away the loops that produce it.
+    printf("%-8s %7u items | %-7s | insert %9.3fms | find %9.3fms | iterate %9.3fms | remove %9.3fms | %u\n",
+        keyDescription, static_cast<unsigned int>(itemCount), containerDescription,
+        timings.insert.GetAverageTime() * 1000.0, timings.find.GetAverageTime() * 1000.0, timings.iterate.GetAverageTime() * 1000.0, timings.remove.GetAverageTime() * 1000.0,
+        static_cast<unsigned int>(sink));
+}
+
+
+template <typename T>
+void RunBenchmark(const char* keyDescription, size_t itemCount)
+{
+    srand(1);
+
+    Vector<T> keys;
+    CreateShuffledKeys(itemCount, keys);
+
+    // Small item counts are run more times so that each one takes a similar amount of time.
+    int iterationCount = static_cast<int>(Max(static_cast<size_t>(4), (1000000) / itemCount));
+
+
+    // Map.
+    {
+        ContainerTimings timings;
+        size_t sink = 0;
+
+        for (int iIteration = 0; iIteration < iterationCount; ++iIteration)
+        {
+            Map<T, size_t> map;
+
+            timings.insert.Start();
+            for (size_t i = 0; i < itemCount; ++i)
+            {
+                map.Add(keys[i], i);
+            }
+            timings.insert.End();
+
+            timings.find.Start();
+            for (size_t i = 0; i < itemCount; ++i)
+            {
+                sink += map.Find(keys[i])->value;
+            }
+            timings.find.End();
+
+            timings.iterate.Start();
+            for (size_t i = 0; i < map.count; ++i)
+            {
+                sink += map.buffer[i]->value;
+            }
+            timings.iterate.End();
+
+            timings.remove.Start();
+            for (size_t i = 0; i < itemCount; ++i)
+            {
+                map.RemoveByKey(keys[i]);
+            }
+            timings.remove.End();
+        }
+
+        PrintTimings(keyDescription, itemCount, "Map", timings, sink);
+    }
+
+    // HashMap.
+    {
+        ContainerTimings timings;
+        size_t sink = 0;
+
+        for (int iIteration = 0; iIteration < iterationCount; ++iIteration)
+        {
+            HashMap<T, size_t> map;
+
+            timings.insert.Start();
+            for (size_t i = 0; i < itemCount; ++i)
+            {
+                map.Add(keys[i], i);
+            }
+            timings.insert.End();
+
+            timings.find.Start();
+            for (size_t i = 0; i < itemCount; ++i)
+            {
+                sink += map.Find(keys[i])->value;
+            }
+            timings.find.End();
+
+            timings.iterate.Start();
+            for (size_t i = 0; i < map.count; ++i)
+            {
+                sink += map.buffer[i].value;
+            }
+            timings.iterate.End();
+
+            timings.remove.Start();
+            for (size_t i = 0; i < itemCount; ++i)
+            {
+                map.RemoveByKey(keys[i]);
+            }
+            timings.remove.End();
+        }
+
+        PrintTimings(keyDescription, itemCount, "HashMap", timings, sink);
+    }
+}
+
+
+/// Puts a Map and a HashMap through the same random sequence of adds and removes and checks that they end up with the same items.
+template <typename T>
+bool AreMapsMatching(size_t keyCount, size_t operationCount)
+{
+    srand(2);
+
+    Map<T, size_t>     map;
+    HashMap<T, size_t> hashMap;
+
+    for (size_t iOperation = 0; iOperation < operationCount; ++iOperation)
+    {
+        T key = CreateKey<T>(static_cast<size_t>(rand()) % keyCount);
+
+        if ((rand() % 3) != 0)
+        {
+            map.Add(key, iOperation);
+            hashMap.Add(key, iOperation);
+        }
+        else
+        {
+            map.RemoveByKey(key);
+            hashMap.RemoveByKey(key);
+        }
+    }
+
+    if (map.count != hashMap.count)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < map.count; ++i)
+    {
+        auto item = hashMap.Find(map.buffer[i]->key);
+        if (item == nullptr || item->value != map.buffer[i]->value)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    const size_t itemCounts[] = {100, 1000, 10000, MaxItemCount};
+
+    for (size_t i = 0; i < sizeof(itemCounts) / sizeof(itemCounts[0]); ++i)
+    {
+        RunBenchmark<const BenchmarkObject*>("pointer", itemCounts[i]);
+        RunBenchmark<uint64_t>("uint64", itemCounts[i]);
+    }
+
+    printf("pointer keys %s\n", AreMapsMatching<const BenchmarkObject*>(5000, 1000000) ? "match" : "MISMATCH");
+    printf("uint64 keys  %s\n", AreMapsMatching<uint64_t>(5000, 1000000) ? "match" : "MISMATCH");
+
+    return 0;
+}
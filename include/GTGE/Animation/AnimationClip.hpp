@@ -0,0 +1,111 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#ifndef GT_AnimationClip
+#define GT_AnimationClip
+
+#include "AnimationChannel.hpp"
+#include "../Math.hpp"
+#include <GTGE/Core/Vector.hpp>
+
+namespace GT
+{
+    class Animation;
+
+    /// Class representing an animation that has been baked into flat arrays for fast sampling.
+    ///
+    /// Animation stores it's keys in a map per channel, with each key being a separate heap allocated object. That is fine for
+    /// editing, but looking up two keys per channel every frame is too slow for playback. A clip is baked from an Animation once and
+    /// stores the position, rotation and scale of every channel at every key frame in tightly packed arrays, with each channel's keys
+    /// stored contiguously and indexed directly by key frame index. The key frame times are kept in a separate sorted array.
+    ///
+    /// A clip does not reference the animation it was baked from. It needs to be baked again if the animation changes.
+    class AnimationClip
+    {
+    public:
+
+        /// Constructor.
+        AnimationClip();
+
+        /// Destructor.
+        ~AnimationClip();
+
+
+        /// Bakes the given channels of the given animation into the clip, replacing whatever was there before.
+        ///
+        /// @param animation [in] A reference to the animation whose key frames are being baked.
+        /// @param channels  [in] The channels to bake. Channel 'i' of the clip is baked from channels[i].
+        ///
+        /// @remarks
+        ///     Only TransformAnimationKey keys are supported.
+        void Bake(const Animation &animation, const Vector<const AnimationChannel*> &channels);
+
+        /// Clears the clip.
+        void Clear();
+
+
+        /// Retrieves the number of channels.
+        size_t GetChannelCount() const { return this->channelCount; }
+
+        /// Retrieves the number of key frames.
+        size_t GetKeyFrameCount() const { return this->times.count; }
+
+        /// Retrieves the sorted array of key frame times.
+        const float* GetKeyFrameTimes() const { return this->times.buffer; }
+
+
+        /// Retrieves the positions of the given channel. There is one for each key frame.
+        const glm::vec3* GetChannelPositions(size_t channelIndex) const { return this->positions.buffer + (channelIndex * this->times.count); }
+
+        /// Retrieves the rotations of the given channel. There is one for each key frame.
+        const glm::quat* GetChannelRotations(size_t channelIndex) const { return this->rotations.buffer + (channelIndex * this->times.count); }
+
+        /// Retrieves the scales of the given channel. There is one for each key frame.
+        const glm::vec3* GetChannelScales(size_t channelIndex) const { return this->scales.buffer + (channelIndex * this->times.count); }
+
+        /// Determines whether or not the given channel has a key at the given key frame.
+        bool HasKey(size_t channelIndex, size_t keyFrameIndex) const { return this->hasKey[channelIndex * this->times.count + keyFrameIndex] != 0; }
+
+
+        /// Samples a channel between two key frames.
+        ///
+        /// @param channelIndex        [in]  The index of the channel to sample.
+        /// @param startKeyFrame       [in]  The index of the key frame to interpolate from.
+        /// @param endKeyFrame         [in]  The index of the key frame to interpolate to.
+        /// @param interpolationFactor [in]  The interpolation factor between the two key frames.
+        /// @param positionOut         [out] A reference to the variable that will receive the position.
+        /// @param rotationOut         [out] A reference to the variable that will receive the rotation.
+        /// @param scaleOut            [out] A reference to the variable that will receive the scale.
+        ///
+        /// @return False if the channel is missing a key at either key frame, in which case the outputs are left unchanged.
+        bool Sample(size_t channelIndex, size_t startKeyFrame, size_t endKeyFrame, float interpolationFactor, glm::vec3 &positionOut, glm::quat &rotationOut, glm::vec3 &scaleOut) const;
+
+
+
+    private:
+
+        /// The time of each key frame, sorted.
+        Vector<float> times;
+
+        /// The position of each channel at each key frame. The keys of a channel are contiguous.
+        Vector<glm::vec3> positions;
+
+        /// The rotation of each channel at each key frame.
+        Vector<glm::quat> rotations;
+
+        /// The scale of each channel at each key frame.
+        Vector<glm::vec3> scales;
+
+        /// Whether or not each channel has a key at each key frame.
+        Vector<uint8_t> hasKey;
+
+        /// The number of channels.
+        size_t channelCount;
+
+
+    private:    // No copying.
+        AnimationClip(const AnimationClip &);
+        AnimationClip & operator=(const AnimationClip &);
+    };
+}
+
+#endif
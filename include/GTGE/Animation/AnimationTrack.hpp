@@ -56,7 +56,9 @@ namespace GT
         /// @return The amount of interpolation to apply between startKeyFrame and endKeyFrame.
         ///
         /// @remarks
-        ///     Since the transition times are not constant, this method must do a linear iteration over each key frame.
+        ///     Since the transition times are not constant, this method must do a linear iteration over the key frames. The track keeps
+        ///     a cursor at the last key frame that was found and starts from there when the time has moved forward, so normal playback
+        ///     only looks at a key frame or two per call.
         float GetKeyFramesAtTime(float time, size_t loopStartIndex, size_t &startKeyFrameOut, size_t &endKeyFrameOut);
 
 
@@ -98,6 +100,9 @@ namespace GT
         /// The list of local key frames, sorted by time.
         Vector<LocalKeyFrame> localKeyFrames;
 
+        /// The index of the local key frame that was found by the last call to GetKeyFramesAtTime().
+        size_t cursor;
+
 
 
     private:    // No copying.
@@ -55,6 +55,12 @@ namespace GT
         ///     not required that inherited classes implement this, in which case the default implementation will simply try loading it from a file.
         virtual bool LoadMetadata(const char* absolutePath, drfs_context* pVFS);
 
+        /// Loads the metadata from the given buffer, which contains the content of a metadata file.
+        ///
+        /// @param pData            [in] A pointer to the buffer containing the metadata.
+        /// @param dataSizeInBytes  [in] The size in bytes of the buffer.
+        bool LoadMetadataFromMemory(const void* pData, size_t dataSizeInBytes);
+
 
         /////////////////////////////////////
         // Virtual Methods
@@ -73,6 +79,19 @@ namespace GT
         ///     This will replace the existing content of the asset.
         virtual bool Load(const char* absolutePath, drfs_context* pVFS) = 0;
 
+        /// Loads the asset from the given buffer, which contains the content of the file.
+        ///
+        /// @param absolutePath    [in] The absolute path or identifier of the file the data came from. This is used for resolving relative paths.
+        /// @param pData           [in] A pointer to the buffer containing the file data.
+        /// @param dataSizeInBytes [in] The size in bytes of the buffer.
+        ///
+        /// @remarks
+        ///     This is used for loading assets from game packages. The buffer is only valid for the duration of the call, so anything that
+        ///     needs to be kept must be copied.
+        ///     @par
+        ///     The default implementation returns false, in which case the asset can only be loaded from a file.
+        virtual bool LoadFromMemory(const char* absolutePath, const void* pData, size_t dataSizeInBytes);
+
 
 
     private:
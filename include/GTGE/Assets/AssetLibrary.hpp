@@ -7,17 +7,35 @@ namespace GT
 {
     class Asset;
     class AssetAllocator;
+    class GamePackage;
 
 #if defined(GT_BUILD_DEFAULT_ASSETS)
     class DefaultAssetAllocator;
 #endif
 
 
+    /// The handle of an asynchronous load. This is never 0 for a valid load.
+    typedef uint32_t AssetLoadHandle;
+
+    /// The function signature for the callback that is called when an asynchronous load completes.
+    ///
+    /// @param pAsset    [in] A pointer to the loaded asset, or null if it failed to load. The callback owns a reference, so it must be unloaded with AssetLibrary::Unload().
+    /// @param pUserData [in] The user data pointer that was passed to AssetLibrary::LoadAsync().
+    typedef void (* AssetLoadCallback)(Asset* pAsset, void* pUserData);
+
+
     /// Class for managing every type of asset.
     ///
     /// Asset paths where the asset data is stored in a library/archive type file is supported. In this case, the last extension is used to determine
     /// which extension should be used for loading. An example of such a path is OBJ MTL files such as "data/material.mtl/mymaterial". In this case,
     /// whichever allocator is associated with the ".mtl" extension is used because that is the last extension mentioned in the path.
+    ///
+    /// Assets can be loaded from any thread. The lock is only held while looking up and inserting into the cache, so different assets load
+    /// in parallel. Requests for an asset that is already being loaded, whether synchronous or asynchronous, wait for that load instead
+    /// of starting another one.
+    ///
+    /// Assets can also be loaded from game packages mounted with MountPackage(). Relative paths are looked up in the mounted packages before
+    /// the file system, and the absolute path of an asset loaded from a package is the path of the package followed by the entry's path.
     class AssetLibrary
     {
     public:
@@ -30,9 +48,18 @@ namespace GT
 
 
         /// Starts up the asset library.
-        bool Startup(drfs_context* pVFS);
+        ///
+        /// @param pVFS              [in] The file system to load assets from.
+        /// @param loaderThreadCount [in] The number of threads to create for asynchronous loads.
+        ///
+        /// @remarks
+        ///     If no loader threads can be created, asynchronous loads are run on the thread that calls DispatchCompletedLoads().
+        bool Startup(drfs_context* pVFS, unsigned int loaderThreadCount = DefaultLoaderThreadCount);
 
         /// Shuts down the asset library.
+        ///
+        /// @remarks
+        ///     Asynchronous loads that have not started are cancelled, and the callbacks of loads that have not been dispatched are not called.
         void Shutdown();
 
 
@@ -40,6 +67,52 @@ namespace GT
         drfs_context* GetVFS() const;
 
 
+        /// Mounts a game package so that assets can be loaded from it.
+        ///
+        /// @param absolutePath [in] The absolute path of the package file.
+        ///
+        /// @return True if the package is mounted successfully; false otherwise.
+        ///
+        /// @remarks
+        ///     Packages should be mounted before any assets are loaded. Packages that are mounted later take priority over earlier ones, and
+        ///     all of them take priority over the file system. Packages are unmounted in Shutdown().
+        bool MountPackage(const char* absolutePath);
+
+        /// Retrieves the number of mounted packages.
+        size_t GetPackageCount() const;
+
+        /// Finds the absolute path of a file, looking in the mounted packages before the file system.
+        ///
+        /// @param filePath            [in]  The relative or absolute path of the file.
+        /// @param absolutePathOut     [out] Receives the absolute path of the file.
+        /// @param absolutePathOutSize [in]  The size of the buffer pointed to by absolutePathOut.
+        ///
+        /// @return True if the file is found; false otherwise.
+        ///
+        /// @remarks
+        ///     The absolute path of a file in a package is the path of the package followed by the path of the entry. Use IsPackagePath()
+        ///     to tell these apart from files on the file system and GetPackageFileData() to read them.
+        ///     @par
+        ///     An absolute path inside one of the file system's base directories that doesn't exist is looked up in the packages relative to
+        ///     that base directory. This is how absolute paths of files that were packed by the packager are resolved.
+        bool FindAbsolutePath(const char* filePath, char* absolutePathOut, size_t absolutePathOutSize) const;
+
+        /// Determines whether or not the given absolute path is inside a mounted package.
+        bool IsPackagePath(const char* absolutePath) const;
+
+        /// Retrieves the data of a file in a mounted package.
+        ///
+        /// @param absolutePath [in]  The absolute path of the file, as returned by FindAbsolutePath().
+        /// @param dataSizeOut  [out] Receives the size of the data in bytes.
+        /// @param pBufferOut   [out] Receives the buffer the data was decompressed into, or null if the data is read straight out of the package.
+        ///
+        /// @return A pointer to the data, or null if the file is not in a mounted package or it's entry is corrupt.
+        ///
+        /// @remarks
+        ///     pBufferOut must be freed with free() once the data is no longer needed, even if null is returned.
+        const void* GetPackageFileData(const char* absolutePath, size_t &dataSizeOut, void* &pBufferOut) const;
+
+
         /// Loads an asset using the give file path.
         ///
         /// @param filePathOrIdentifier [in] The absolute or relative file path of the asset to load if it is backed by a file, or a unique identifier if the asset is not backed by a file.
@@ -71,6 +144,39 @@ namespace GT
         void Reload(const char* filePathOrIdentifier);
 
 
+        /// Starts loading an asset on a loader thread.
+        ///
+        /// @param filePathOrIdentifier [in] The absolute or relative file path of the asset to load if it is backed by a file, or a unique identifier if the asset is not backed by a file.
+        /// @param explicitAssetType    [in] The asset type to load, or AssetType_Unknown to determine it from the extension.
+        /// @param callback             [in] The function to call when the load completes. This can not be null.
+        /// @param pUserData            [in] A pointer to application-defined data that is passed to the callback.
+        ///
+        /// @return The handle of the load, or 0 if the callback is null.
+        ///
+        /// @remarks
+        ///     The callback is always called from DispatchCompletedLoads(), even if the asset is already loaded, which means it is delivered on the
+        ///     main thread. It receives a reference to the asset in the same way as Load().
+        AssetLoadHandle LoadAsync(const char* filePathOrIdentifier, AssetType explicitAssetType, AssetLoadCallback callback, void* pUserData);
+
+        /// Determines whether or not the given asynchronous load has finished loading.
+        ///
+        /// @remarks
+        ///     This returns true before the callback has been called. Handles that have already been dispatched are also complete.
+        bool IsAsyncLoadComplete(AssetLoadHandle handle) const;
+
+        /// Blocks until the given asynchronous load has finished loading.
+        ///
+        /// @remarks
+        ///     This does not call the callback. Call DispatchCompletedLoads() after this to have it called straight away.
+        void WaitForAsyncLoad(AssetLoadHandle handle);
+
+        /// Calls the callbacks of every asynchronous load that has completed since the last call.
+        ///
+        /// @remarks
+        ///     This is called by the context at the start of each frame on the main thread.
+        void DispatchCompletedLoads();
+
+
         /// Registers an asset allocator which is used to create and delete asset objects.
         ///
         /// @param allocator [in] A reference to the allocator to register.
@@ -87,12 +193,130 @@ namespace GT
         ///     the engine's default asset loaders.
         void RegisterAllocator(AssetAllocator &allocator);
 
+        /// Retrieves the type of the asset at the given path based on the registered allocators.
+        ///
+        /// @return The asset type, or AssetType_Unknown if none of the allocators can load it.
+        AssetType GetAssetTypeByPath(const char* filePath);
+
+
+        /// Retrieves the total size in bytes of the files of every asset that has been loaded, including reloads.
+        uint64_t GetBytesLoaded() const;
+
+
+        /// The number of loader threads created by default.
+        static const unsigned int DefaultLoaderThreadCount = 2;
+
 
     private:
 
+        struct AsyncLoad;
+
+        /// An asset that is currently being loaded. Every request for the asset while it is loading shares this.
+        struct InFlightLoad
+        {
+            /// The absolute path or identifier of the asset.
+            char absolutePathOrIdentifier[DRFS_MAX_PATH];
+
+            /// The allocator that created the asset.
+            AssetAllocator* pAllocator;
+
+            /// The asset being loaded. This is set to null if the load fails.
+            Asset* pAsset;
+
+            /// Whether or not the load has finished.
+            bool isComplete;
+
+            /// The number of requests for the asset, including the one that started the load. Each of these receives a reference.
+            size_t requestCount;
+
+            /// The number of threads holding a pointer to this object, including the one doing the load. It is deleted when this reaches 0.
+            size_t holdCount;
+
+            /// The number of threads blocked on the semaphore.
+            size_t waiterCount;
+
+            /// The semaphore that is released once for each waiter when the load finishes.
+            dr_semaphore waitSemaphore;
+
+            /// The asynchronous loads waiting for this load to finish.
+            Vector<AsyncLoad*> asyncLoads;
+        };
+
+        /// An asynchronous load request.
+        struct AsyncLoad
+        {
+            /// The handle of the load.
+            AssetLoadHandle handle;
+
+            /// The callback and it's user data.
+            AssetLoadCallback callback;
+            void* pUserData;
+
+            /// The load this request is waiting on, or null once it is complete.
+            InFlightLoad* pLoad;
+
+            /// The loaded asset, or null if it failed to load. This is only valid once pLoad is null.
+            Asset* pAsset;
+        };
+
+
+        /// Resolves the absolute path of an asset, looking in the mounted packages first, then the file system, then falling back to it's
+        /// metadata file and then to the identifier itself.
+        void FindAbsolutePathOrIdentifier(const char* filePathOrIdentifier, char* absolutePathOrIdentifierOut, size_t absolutePathOrIdentifierOutSize) const;
+
+        /// Retrieves the loaded asset, or creates a new in-flight load for it.
+        ///
+        /// @remarks
+        ///     This must be called with the lock held. If the asset is already loaded, a reference is added and the asset is returned. If it is
+        ///     already being loaded, the request is added to the existing in-flight load. If neither, a new in-flight load is created and
+        ///     isNewLoadOut is set to true, in which case the caller is responsible for calling ExecuteLoad(). If the asset can't be created at
+        ///     all, both the return value and pLoadOut are null.
+        Asset* AcquireOrBeginLoad(const char* absolutePathOrIdentifier, AssetType explicitAssetType, InFlightLoad* &pLoadOut, bool &isNewLoadOut);
+
+        /// Finds the mounted package that contains the asset with the given absolute path.
+        ///
+        /// @param absolutePathOrIdentifier [in]  The absolute path of the asset.
+        /// @param entryPathOut             [out] Receives a pointer to the part of absolutePathOrIdentifier that is the path of the entry.
+        ///
+        /// @return A pointer to the package, or null if the asset is not in a mounted package.
+        GamePackage* FindPackageByAbsolutePath(const char* absolutePathOrIdentifier, const char* &entryPathOut) const;
+
+        /// Loads the metadata and data of the given asset, either from a mounted package or the file system.
+        ///
+        /// @param pAsset                   [in]  A pointer to the asset to load.
+        /// @param absolutePathOrIdentifier [in]  The absolute path or identifier of the asset.
+        /// @param fileSizeInBytesOut       [out] Receives the size of the file the asset was loaded from, or 0 if it's unknown.
+        ///
+        /// @return True if the asset is loaded successfully; false otherwise.
+        bool LoadAssetData(Asset* pAsset, const char* absolutePathOrIdentifier, uint64_t &fileSizeInBytesOut);
+
+        /// Loads the asset of an in-flight load and completes it. This must be called without the lock held.
+        ///
+        /// @return The loaded asset, or null if it failed to load.
+        Asset* ExecuteLoad(InFlightLoad* pLoad);
+
+        /// Completes an in-flight load, adding the asset to the cache on success and deleting it on failure, and wakes up everything
+        /// that was waiting on it. This must be called with the lock held.
+        ///
+        /// @return The loaded asset, or null if it failed to load.
+        Asset* CompleteLoad(InFlightLoad* pLoad, bool succeeded, uint64_t fileSizeInBytes);
+
+        /// Blocks until the given in-flight load completes and returns the asset. This must be called with the lock held, which is released
+        /// while waiting.
+        Asset* WaitForInFlightLoad(InFlightLoad* pLoad);
+
+        /// Releases a hold on an in-flight load, deleting it if it was the last one. This must be called with the lock held.
+        void ReleaseInFlightLoad(InFlightLoad* pLoad);
+
+        /// Finds the asynchronous load with the given handle in the pending or completed lists. This must be called with the lock held.
+        AsyncLoad* FindAsyncLoad(AssetLoadHandle handle) const;
+
         AssetAllocator* FindAllocatorAndTypeByPath(const char* filePath, AssetType &assetTypeOut);
         AssetAllocator* FindAllocatorByType(AssetType type);
 
+        /// The entry point for each loader thread.
+        static int LoaderThreadProc(void* pData);
+
 
     private:
 
@@ -102,12 +326,42 @@ namespace GT
         /// The list of allocators.
         Vector<AssetAllocator*> m_allocators;
 
+        /// The mounted packages, with the highest priority first.
+        Vector<GamePackage*> m_packages;
+
         /// The list of loaded assets, by absolute file path.
         Dictionary<Asset*> m_loadedAssets;
 
-        /// The mutex for loading and unloading assets.
+        /// The mutex for the cache, the in-flight loads and the asynchronous load queues.
         dr_mutex m_mutex;
 
+        /// The assets that are currently being loaded, by absolute file path.
+        Dictionary<InFlightLoad*> m_inFlightLoads;
+
+        /// The in-flight loads waiting for a loader thread, in the order they were requested.
+        Vector<InFlightLoad*> m_loadQueue;
+
+        /// The semaphore that is released once for each load added to the queue.
+        dr_semaphore m_loadQueueSemaphore;
+
+        /// The loader threads.
+        Vector<dr_thread> m_loaderThreads;
+
+        /// Whether or not the loader threads should terminate.
+        bool m_isTerminating;
+
+        /// The asynchronous loads that have not completed.
+        Vector<AsyncLoad*> m_pendingAsyncLoads;
+
+        /// The asynchronous loads that have completed but have not been dispatched.
+        Vector<AsyncLoad*> m_completedAsyncLoads;
+
+        /// The handle to give to the next asynchronous load.
+        AssetLoadHandle m_nextAsyncLoadHandle;
+
+        /// The total size of the files of every asset that has been loaded.
+        uint64_t m_bytesLoaded;
+
         
 #if defined(GT_BUILD_DEFAULT_ASSETS)
         /// A pointer to the default asset allocator. This is always present if at least one default asset is included in the build.
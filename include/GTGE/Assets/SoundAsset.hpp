@@ -34,6 +34,9 @@ namespace GT
         /// @copydoc Asset::Load()
         bool Load(const char* absolutePath, drfs_context* pVFS);
 
+        /// @copydoc Asset::LoadFromMemory()
+        bool LoadFromMemory(const char* absolutePath, const void* pData, size_t dataSizeInBytes);
+
         /// Retrieves information about the audio data of the sound.
         ///
         /// @remarks
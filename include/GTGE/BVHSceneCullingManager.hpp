@@ -0,0 +1,231 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#ifndef GT_BVHSceneCullingManager
+#define GT_BVHSceneCullingManager
+
+#include "SceneCullingManager.hpp"
+#include "SceneCullingBVH.hpp"
+#include "SceneNode.hpp"
+#include <GTGE/Core/HashMap.hpp>
+
+namespace GT
+{
+    /// A culling manager that keeps the bounds of everything in a SceneCullingBVH instead of a Bullet collision world.
+    ///
+    /// Models, particle systems, point lights and spot lights are each given a world space AABB in the tree. Frustum culling tests
+    /// four boxes at a time with SIMD and collects the visible objects into a buffer before passing them to the callback, and light
+    /// contacts are found with a box query followed by an exact sphere or cone test.
+    ///
+    /// This does not do occlusion culling, so occluders are ignored. A rotated model's AABB is the box around it's rotated bounds,
+    /// which is a little looser than the oriented box used by DefaultSceneCullingManager.
+    class BVHSceneCullingManager : public SceneCullingManager
+    {
+    public:
+
+        /// Constructor.
+        BVHSceneCullingManager();
+
+        /// Destructor.
+        virtual ~BVHSceneCullingManager();
+
+
+        /// SceneCullingManager::AddModel().
+        virtual void AddModel(SceneNode &sceneNode);
+
+        /// SceneCullingManager::RemoveModel().
+        virtual void RemoveModel(SceneNode &sceneNode);
+
+
+        /// SceneCullingManager::AddPointLight().
+        virtual void AddPointLight(SceneNode &sceneNode);
+
+        /// SceneCullingManager::RemovePointLight().
+        virtual void RemovePointLight(SceneNode &sceneNode);
+
+
+        /// SceneCullingManager::AddSpotLight().
+        virtual void AddSpotLight(SceneNode &sceneNode);
+
+        /// SceneCullingManager::RemoveSpotLight().
+        virtual void RemoveSpotLight(SceneNode &sceneNode);
+
+
+        /// SceneCullingManager::AddDirectionalLight().
+        virtual void AddDirectionalLight(SceneNode &sceneNode);
+
+        /// SceneCullingManager::RemoveDirectionalLight().
+        virtual void RemoveDirectionalLight(SceneNode &sceneNode);
+
+
+        /// SceneCullingManager::AddAmbientLight().
+        virtual void AddAmbientLight(SceneNode &sceneNode);
+
+        /// SceneCullingManager::RemoveAmbientLight().
+        virtual void RemoveAmbientLight(SceneNode &sceneNode);
+
+
+        /// SceneCullingManager::AddParticleSystem().
+        virtual void AddParticleSystem(SceneNode &sceneNode);
+
+        /// SceneCullingManager::RemoveParticleSystem().
+        virtual void RemoveParticleSystem(SceneNode &sceneNode);
+
+
+        /// SceneCullingManager::AddOccluder().
+        virtual void AddOccluder(SceneNode &sceneNode);
+
+        /// SceneCullingManager::RemoveOccluder().
+        virtual void RemoveOccluder(SceneNode &sceneNode);
+
+
+
+        /// SceneCullingManager::UpdateModelTransform().
+        virtual void UpdateModelTransform(SceneNode &sceneNode);
+
+        /// SceneCullingManager::UpdatePointLightTransform().
+        virtual void UpdatePointLightTransform(SceneNode &sceneNode);
+
+        /// SceneCullingManager::UpdateSpotLightTransform().
+        virtual void UpdateSpotLightTransform(SceneNode &sceneNode);
+
+        /// SceneCullingManager::UpdateDirectionalLightTransform().
+        virtual void UpdateDirectionalLightTransform(SceneNode &sceneNode);
+
+        /// SceneCullingManager::UpdateAmbientLightTransform().
+        virtual void UpdateAmbientLightTransform(SceneNode &sceneNode);
+
+        /// SceneCullingManager::UpdateParticleSystemTransform().
+        virtual void UpdateParticleSystemTransform(SceneNode &sceneNode);
+
+        /// SceneCullingManager::UpdateOccluderLightTransform().
+        virtual void UpdateOccluderTransform(SceneNode &sceneNode);
+
+
+        /// SceneCullingManager::UpdateModelScale().
+        virtual void UpdateModelScale(SceneNode &sceneNode);
+
+        /// SceneCullingManager::UpdateOccluderScale().
+        virtual void UpdateOccluderScale(SceneNode &sceneNode);
+
+
+        /// SceneCullingManager::UpdateModelAABB().
+        virtual void UpdateModelAABB(SceneNode &sceneNode);
+
+        /// SceneCullingManager::UpdateParticleSystemAABB().
+        virtual void UpdateParticleSystemAABB(SceneNode &sceneNode);
+
+
+        /// SceneCullingManager::GetGlobalAABB().
+        virtual void GetGlobalAABB(glm::vec3 &aabbMin, glm::vec3 &aabbMax) const;
+
+
+        /// SceneCullingManager::ProcessVisibleObjects().
+        ///
+        /// @remarks
+        ///     This commits any pending changes to the tree, so it must not be called at the same time as anything else.
+        virtual void ProcessVisibleSceneNodes(const glm::mat4 &mvp, VisibilityCallback &callback) const;
+
+
+        /// SceneCullingManager::QueryPointLightContacts().
+        virtual void QueryPointLightContacts(const SceneNode &light, VisibilityCallback &callback) const;
+
+        /// SceneCullingManager::QuerySpotLightContacts().
+        virtual void QuerySpotLightContacts(const SceneNode &light, VisibilityCallback &callback) const;
+
+        /// SceneCullingManager::IsLightContactQueryThreadSafe().
+        virtual bool IsLightContactQueryThreadSafe() const;
+
+
+
+    protected:
+
+        /// The different types of objects in the tree.
+        enum ObjectType
+        {
+            ObjectType_Model,
+            ObjectType_PointLight,
+            ObjectType_SpotLight,
+            ObjectType_ParticleSystem
+        };
+
+        /// The information about an object in the tree, indexed by it's ID in the tree.
+        struct CullingObject
+        {
+            /// The scene node that owns the object.
+            SceneNode* sceneNode;
+
+            /// The type of the object.
+            ObjectType type;
+
+            /// The world position of a light.
+            glm::vec3 position;
+
+            /// The world direction of a spot light.
+            glm::vec3 direction;
+
+            /// The radius of a point light or the length of a spot light.
+            float radius;
+
+            /// The sine and cosine of the half angle of a spot light's cone.
+            float sinAngle;
+            float cosAngle;
+        };
+
+
+        /// Adds an object of the given type to the tree and returns it's ID.
+        uint32_t AddObject(SceneNode &sceneNode, ObjectType type);
+
+        /// Removes the object with the given ID from the tree.
+        void RemoveObject(uint32_t objectID);
+
+        /// Recalculates the bounds of the given object from it's scene node.
+        void UpdateObject(uint32_t objectID);
+
+        /// Calculates the world space bounds of the given object from it's scene node. This also refreshes the shape of a light.
+        void CalculateObjectAABB(CullingObject &object, glm::vec3 &aabbMinOut, glm::vec3 &aabbMaxOut) const;
+
+        /// Passes the given object to the callback if it's scene node is visible.
+        void ProcessVisibleObject(const CullingObject &object, VisibilityCallback &callback) const;
+
+        /// Passes every model and particle system touching the light with the given ID to the callback.
+        ///
+        /// @remarks
+        ///     This only reads from the tree, so it can be called from multiple threads at the same time.
+        void QueryLightContacts(uint32_t lightID, VisibilityCallback &callback) const;
+
+
+        /// The tree. This is mutable because it's committed at the start of ProcessVisibleSceneNodes().
+        mutable SceneCullingBVH m_bvh;
+
+        /// The information about each object in the tree, indexed by it's ID.
+        Vector<CullingObject> m_objects;
+
+        /// The IDs of the models in the tree.
+        HashMap<const SceneNode*, uint32_t> m_models;
+
+        /// The IDs of the point lights in the tree.
+        HashMap<const SceneNode*, uint32_t> m_pointLights;
+
+        /// The IDs of the spot lights in the tree.
+        HashMap<const SceneNode*, uint32_t> m_spotLights;
+
+        /// The IDs of the particle systems in the tree.
+        HashMap<const SceneNode*, uint32_t> m_particleSystems;
+
+        /// The ambient lights. These are always visible.
+        Vector<const SceneNode*> m_ambientLights;
+
+        /// The directional lights. These are always visible.
+        Vector<const SceneNode*> m_directionalLights;
+
+        /// The IDs of the visible objects from the last call to ProcessVisibleSceneNodes().
+        mutable Vector<uint32_t> m_visibleObjects;
+
+
+    private:    // No copying.
+        BVHSceneCullingManager(const BVHSceneCullingManager &);
+        BVHSceneCullingManager & operator=(const BVHSceneCullingManager &);
+    };
+}
+
+#endif
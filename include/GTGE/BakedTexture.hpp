@@ -0,0 +1,143 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#ifndef GT_BakedTexture
+#define GT_BakedTexture
+
+#include <GTGE/Core/ImageFormats.hpp>
+#include <dr_libs/dr_fs.h>
+#include <cstdint>
+#include <cstddef>
+
+namespace GT
+{
+    class ThreadPool;
+
+    /// The flags of a baked texture.
+    enum BakedTextureFlags
+    {
+        /// The texel rows are stored bottom to top, for renderers where Renderer::HasFlippedTextures() is true.
+        BakedTextureFlag_Flipped = (1 << 0)
+    };
+
+
+    /// The header at the start of a baked texture file.
+    ///
+    /// A baked texture is laid out as this header, followed by the data of each mipmap from largest to smallest with no padding in between.
+    /// The size of each mipmap is derived from its dimensions and the format. Everything is little-endian.
+    struct BakedTextureHeader
+    {
+        /// BakedTexture::Magic.
+        uint32_t magic;
+
+        /// BakedTexture::Version.
+        uint32_t version;
+
+        /// The ImageFormat of every mipmap. This is one of RGB8, RGBA8, DXT1 or DXT5.
+        uint32_t format;
+
+        /// The dimensions of the base mipmap.
+        uint32_t width;
+        uint32_t height;
+
+        /// The number of mipmaps, including the base mipmap.
+        uint32_t mipmapCount;
+
+        /// A combination of BakedTextureFlags.
+        uint32_t flags;
+
+        /// Unused. Set to zero.
+        uint32_t reserved;
+    };
+
+
+    /// A texture that has been baked into a native .gttexture file.
+    ///
+    /// A baked texture holds the whole mipmap chain of an image, already in the orientation the renderer expects and optionally block-compressed,
+    /// which means it can be handed to the renderer without any decoding or mipmap generation. They are made by GamePackager when packaging
+    /// with texture baking enabled, and are stored next to the image they were made from with ".gttexture" appended to the file name, in the
+    /// same way as .gtmodel files.
+    class BakedTexture
+    {
+    public:
+
+        /// The magic number at the start of the header, "GTTX".
+        static const uint32_t Magic = 0x58545447;
+
+        /// The current version of the file format.
+        static const uint32_t Version = 1;
+
+        /// The maximum number of mipmaps a baked texture can have.
+        static const uint32_t MaxMipmapCount = 32;
+
+
+        /// Constructor.
+        BakedTexture();
+
+
+        /// Reads a baked texture from the data of a .gttexture file.
+        ///
+        /// @param pData    [in] A pointer to the file data.
+        /// @param dataSize [in] The size in bytes of the file data.
+        ///
+        /// @return True if the data is a valid baked texture; false otherwise.
+        ///
+        /// @remarks
+        ///     The data is not copied, so it must stay valid for as long as the mipmap data is needed.
+        bool Parse(const void* pData, size_t dataSize);
+
+
+        /// Retrieves the width of the base mipmap.
+        unsigned int GetWidth() const { return m_header.width; }
+
+        /// Retrieves the height of the base mipmap.
+        unsigned int GetHeight() const { return m_header.height; }
+
+        /// Retrieves the format of the mipmap data.
+        ImageFormat GetFormat() const { return static_cast<ImageFormat>(m_header.format); }
+
+        /// Determines whether or not the texel rows are stored bottom to top.
+        bool IsFlipped() const { return (m_header.flags & BakedTextureFlag_Flipped) != 0; }
+
+
+        /// Retrieves the number of mipmaps, including the base mipmap.
+        uint32_t GetMipmapCount() const { return m_header.mipmapCount; }
+
+        /// Retrieves the width of the given mipmap.
+        unsigned int GetMipmapWidth(uint32_t mipmapIndex) const;
+
+        /// Retrieves the height of the given mipmap.
+        unsigned int GetMipmapHeight(uint32_t mipmapIndex) const;
+
+        /// Retrieves a pointer to the data of the given mipmap.
+        const void* GetMipmapData(uint32_t mipmapIndex) const;
+
+
+        /// Bakes the image at the given path into a .gttexture file.
+        ///
+        /// @param pVFS               [in] The file system to write the baked texture to.
+        /// @param sourceAbsolutePath [in] The absolute path of the image file.
+        /// @param outputAbsolutePath [in] The absolute path of the .gttexture file.
+        /// @param flip               [in] Whether or not to store the texel rows bottom to top. This should be Renderer::HasFlippedTextures().
+        /// @param compress           [in] Whether or not to block-compress the texture where possible.
+        /// @param pThreadPool        [in] The thread pool to generate the mipmaps with, or null to use the calling thread only.
+        ///
+        /// @return True if the texture is baked successfully; false otherwise.
+        ///
+        /// @remarks
+        ///     Only 8-bit RGB and RGBA images are baked. Images with dimensions that are multiples of 4 are compressed as DXT1 if they are opaque
+        ///     and DXT5 if they are not. Other images keep their format, but still have their mipmaps precomputed.
+        static bool Bake(drfs_context* pVFS, const char* sourceAbsolutePath, const char* outputAbsolutePath, bool flip, bool compress, ThreadPool* pThreadPool = nullptr);
+
+
+
+    private:
+
+        /// A copy of the header.
+        BakedTextureHeader m_header;
+
+        /// Pointers to the data of each mipmap.
+        const uint8_t* m_pMipmapData[MaxMipmapCount];
+    };
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include "Rendering/VertexFormat.hpp"
 #include "Math.hpp"
 #include <GTGE/Core/Vector.hpp>
+#include <GTGE/Core/ThreadPool.hpp>
 
 namespace GT
 {
@@ -33,9 +34,30 @@ namespace GT
 
         /// Executes the vertex shader.
         ///
+        /// @param input       [in] The input vertex buffer.
+        /// @param vertexCount [in] The number of vertices to process.
+        /// @param format      [in] The format of the input and output buffers.
+        /// @param output      [in] The output vertex buffer. This can be the same as the input buffer.
+        /// @param threadCount [in] The number of threads to split the vertices across.
+        ///
         /// @return True if the shader is executed successfully; false otherwise.
+        ///
+        /// @remarks
+        ///     When threadCount is larger than 1 the vertices are split into contiguous chunks, one per thread. The calling thread processes
+        ///     the first chunk and temporary threads are created for the rest. Use the ThreadPool overload for per-frame work to avoid the
+        ///     cost of creating threads.
         bool Execute(const float* input, size_t vertexCount, const VertexFormat &format, float* output, size_t threadCount = 1);
 
+        /// Executes the vertex shader, splitting the vertices across the given thread pool.
+        ///
+        /// @remarks
+        ///     The vertices are split into one chunk per thread in the pool.
+        bool Execute(const float* input, size_t vertexCount, const VertexFormat &format, float* output, ThreadPool &threadPool);
+
+
+        /// The minimum number of vertices a chunk should contain when executing across multiple threads. Smaller meshes are done on fewer threads.
+        static const size_t MinVerticesPerThread = 512;
+
 
     // Processing.
     protected:
@@ -46,7 +68,7 @@ namespace GT
         {
         public:
 
-            Vertex(unsigned int id, float* data, const VertexFormat &format);
+            Vertex(unsigned int id, unsigned int threadIndex, float* data, const VertexFormat &format);
            ~Vertex();
 
             /// Retrieves the ID of the vertex.
@@ -55,6 +77,12 @@ namespace GT
             ///     Use this for accessing things like vertex attributes.
             unsigned int GetID() const;
 
+            /// Retrieves the index of the thread that is processing the vertex.
+            ///
+            /// @remarks
+            ///     This is in the range of [0, GetExecutionThreadCount()). Use this for accumulating per-thread results without locking.
+            unsigned int GetThreadIndex() const;
+
             /// Retrieves a vertex attribute as a vec4/float4.
             ///
             /// @param attribute [in] The index of the vertex attribute to retrieve. E.g. VertexAttribs::Position, VertexAttribute::Normal.
@@ -80,6 +108,9 @@ namespace GT
             /// The ID of the vertex.
             unsigned int id;
 
+            /// The index of the thread that is processing the vertex.
+            unsigned int threadIndex;
+
             /// A pointer to the vertex's data.
             float* data;
 
@@ -104,18 +135,66 @@ namespace GT
 
 
         /// A virtual method that will be called at the start of execution.
+        ///
+        /// @remarks
+        ///     This is called on the calling thread. GetExecutionThreadCount() is valid at this point.
         virtual void OnStartExecute();
 
         /// A virtual method that will be called at the end of execution.
+        ///
+        /// @remarks
+        ///     This is called on the calling thread after every thread has finished. Use this to merge any per-thread results.
         virtual void OnEndExecute();
 
         /// A virtual method that will be called when a vertex needs to be processed.
+        ///
+        /// @remarks
+        ///     This can be called from multiple threads at the same time. Any state that is written to must be indexed by vertex.GetThreadIndex().
         virtual void ProcessVertex(Vertex &vertex) = 0;
 
 
+        /// A virtual method that is given the chance to process a whole range of vertices at once.
+        ///
+        /// @param input         [in] The input vertex buffer. This is the start of the buffer, not the start of the range.
+        /// @param output        [in] The output vertex buffer. This is the start of the buffer, not the start of the range.
+        /// @param firstVertexID [in] The ID of the first vertex in the range.
+        /// @param endVertexID   [in] The ID of the vertex one past the end of the range.
+        /// @param threadIndex   [in] The index of the thread processing the range.
+        ///
+        /// @return True if the range was processed; false if ProcessVertex() should be called for each vertex instead.
+        ///
+        /// @remarks
+        ///     Override this to implement specialised kernels that read and write the interleaved buffers directly. Unlike ProcessVertex(),
+        ///     attributes that are not touched by the kernel are not copied to the output buffer automatically.
+        virtual bool ProcessVertexRange(const float* input, float* output, size_t firstVertexID, size_t endVertexID, size_t threadIndex);
+
+
+        /// Retrieves the number of threads the current execution is split across.
+        size_t GetExecutionThreadCount() const { return m_threadCount; }
+
+        /// Retrieves the vertex format of the current execution.
+        const VertexFormat & GetExecutionFormat() const { return m_format; }
+
+        /// Retrieves the size of a vertex in floats for the current execution.
+        size_t GetExecutionVertexSizeInFloats() const { return m_vertexSizeInFloats; }
+
+
 
     private:
 
+        /// Sets up the execution state and determines how many threads to use, clamped so that each thread gets a reasonable number of vertices.
+        bool BeginExecute(const float* input, size_t vertexCount, const VertexFormat &format, float* output, size_t threadCount);
+
+        /// Retrieves the range of vertices to process for the given thread.
+        void GetThreadVertexRange(size_t threadIndex, size_t &firstVertexIDOut, size_t &endVertexIDOut) const;
+
+        /// The job function for executing a chunk of vertices on a thread pool.
+        static void ExecuteJob(size_t jobIndex, size_t threadIndex, void* pUserData);
+
+        /// The entry point for temporary threads created by the thread count overload of Execute().
+        static int ExecuteThreadProc(void* pData);
+
+
         /// The input buffer.
         const float* m_input;
 
@@ -132,6 +211,9 @@ namespace GT
         /// The output buffer.
         float* m_output;
 
+        /// The number of threads the current execution is split across.
+        size_t m_threadCount;
+
 
         /// The variables below control whether or not the various common vertex attributes are used by the vertex shader.
         bool m_usingPosition;
@@ -160,7 +242,7 @@ namespace GT
         CPUVertexShader(const CPUVertexShader &);
         CPUVertexShader & operator=(const CPUVertexShader &);
 
-    friend void ProcessVertexShader(CPUVertexShader &shader, size_t firstVertexID, size_t lastVertexID);
+    friend void ProcessVertexShader(CPUVertexShader &shader, size_t firstVertexID, size_t endVertexID, size_t threadIndex);
     };
 }
 
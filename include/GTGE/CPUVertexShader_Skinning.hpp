@@ -23,10 +23,10 @@ namespace GT
         ~CPUVertexShader_Skinning();
 
 
-        /// Sets the buffer containing the bones to index into.
+        /// Sets the palette of skinning transforms to index into.
         ///
-        /// @param bones [in] A buffer containing pointers to bones that the vertex will index into for blending.
-        void SetBoneBuffer(const Bone* const* bones);
+        /// @param palette [in] A buffer containing the skinning transform of each bone that the vertex will index into for blending.
+        void SetSkinningPalette(const glm::mat4* palette);
 
         /// Sets the pointer to the buffer containing the skinning vertex attributes for each vertex.
         ///
@@ -48,14 +48,24 @@ namespace GT
         /// CPUVertexShader::OnStartExecute()
         void OnStartExecute();
 
+        /// CPUVertexShader::OnEndExecute()
+        void OnEndExecute();
+
         /// CPUVertexShader::ProcessVertex()
         void ProcessVertex(Vertex &vertex);
 
+        /// CPUVertexShader::ProcessVertexRange()
+        ///
+        /// @remarks
+        ///     When built with SSE2 this uses a specialised kernel for formats with a 3-component position and normal, and optionally
+        ///     a 3-component tangent and bitangent (P3T2N3, P3T2N3T3B3, etc.). Other formats fall back to ProcessVertex().
+        bool ProcessVertexRange(const float* input, float* output, size_t firstVertexID, size_t endVertexID, size_t threadIndex);
+
 
     private:
 
-        /// A pointer to the buffer containing the bones to index into.
-        const Bone* const* bones;
+        /// A pointer to the palette of skinning transforms to index into.
+        const glm::mat4* skinningPalette;
 
         /// A pointer to the buffer containing the skinning vertex attributes.
         const SkinningVertexAttribute* skinningVertexAttributes;
@@ -63,6 +73,26 @@ namespace GT
         /// The AABB containing each vertex.
         glm::vec4 aabbMin;
         glm::vec4 aabbMax;
+
+        /// The AABB of the vertices processed by each thread. These are merged into aabbMin and aabbMax in OnEndExecute(). Each one is
+        /// padded out to a cache line so that threads aren't fighting over the same line while they update their bounds.
+        struct ThreadAABB
+        {
+            glm::vec4 min;
+            glm::vec4 max;
+            uint8_t padding[64 - (sizeof(glm::vec4) * 2)];
+        };
+        Vector<ThreadAABB> threadAABBs;
+
+
+        /// Whether or not the current execution can use the specialised kernel. This is determined in OnStartExecute().
+        bool useFastPath;
+
+        /// The offsets of the attributes used by the specialised kernel, in floats. The tangent and bitangent offsets are -1 if the format does not have them.
+        int positionOffset;
+        int normalOffset;
+        int tangentOffset;
+        int bitangentOffset;
         
     
     private:    // No copying.
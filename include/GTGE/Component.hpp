@@ -5,6 +5,8 @@
 
 #undef GetClassName
 
+#include "Core/StringID.hpp"
+
 #define GTENGINE_IMPL_COMPONENT_ATTRIBS(className, name) \
     const char* const className::Name      = name; \
     const char* const className::ClassName = #className; \
@@ -21,6 +23,11 @@
         { \
             return className::ClassName; \
         } \
+        static StringID GetNameID() \
+        { \
+            static const StringID nameID = InternString(className::Name); \
+            return nameID; \
+        } \
     private: \
         className(const className &);   \
         className & operator=(const className &);
@@ -9,6 +9,8 @@
 
 namespace GT
 {
+    class Script;
+
     class ScriptComponent : public Component
     {
     public:
@@ -231,6 +233,40 @@ namespace GT
         bool HasOnStartupBeenCalled() const;
 
 
+        /// Sets the registry references of the scene node's Lua table and it's bound OnUpdate function.
+        ///
+        /// @param script          [in] The script the references belong to.
+        /// @param sceneNodeTable  [in] The reference to the scene node's Lua table, or Script::NoReference.
+        /// @param onUpdate        [in] The reference to the scene node's OnUpdate function, or Script::NoReference.
+        ///
+        /// @remarks
+        ///     The component takes ownership of the references and releases any existing ones first. These are used to avoid looking
+        ///     up the scene node by name every frame when posting OnUpdate.
+        void SetScriptReferences(Script &script, int sceneNodeTable, int onUpdate);
+
+        /// Releases every registry reference held by the component.
+        ///
+        /// @remarks
+        ///     This needs to be called whenever the scene node's Lua table is destroyed, such as when the scene node is uninstantiated.
+        void ReleaseScriptReferences();
+
+        /// Releases the references to the bound event handler functions, but keeps the reference to the scene node's table.
+        ///
+        /// @remarks
+        ///     This needs to be called whenever the components are registered or unregistered on the Lua side, since that rebinds the
+        ///     event handlers.
+        void ReleaseScriptEventHandlerReferences();
+
+        /// Retrieves the script the references belong to, or null if the component is not holding any.
+        Script* GetReferencedScript() const { return this->referencedScript; }
+
+        /// Retrieves the reference to the scene node's Lua table.
+        int GetSceneNodeTableReference() const { return this->sceneNodeTableReference; }
+
+        /// Retrieves the reference to the scene node's OnUpdate function.
+        int GetOnUpdateReference() const { return this->onUpdateReference; }
+
+
 
         /// Retrieves the number of public variables.
         size_t GetPublicVariableCount() const;
@@ -323,6 +359,16 @@ namespace GT
         bool hasOnStartupBeenCalled;
 
 
+        /// The script that owns the registry references below. This is null when the component is not holding any references.
+        Script* referencedScript;
+
+        /// The registry reference to the scene node's Lua table.
+        int sceneNodeTableReference;
+
+        /// The registry reference to the scene node's bound OnUpdate function.
+        int onUpdateReference;
+
+
 
         GTENGINE_DECL_COMPONENT_ATTRIBS(ScriptComponent)
     };
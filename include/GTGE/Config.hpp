@@ -21,6 +21,26 @@
 
 
 
+// SIMD
+//
+// SIMD code paths can be enabled and disabled from here. These are only used when the compiler is targeting an instruction set that supports
+// them (-msse2/-mavx/-mavx2 on GCC and Clang, /arch on MSVC). Every SIMD path has a scalar fallback, so disabling these only affects performance.
+
+#define GT_ENABLE_SSE2              1
+#define GT_ENABLE_AVX               1
+#define GT_ENABLE_AVX2              1
+
+
+
+// Profiling
+//
+// Profiler zones (GT_PROFILE_ZONE) can be compiled out from here. When they are compiled in, a zone that is hit while nothing is being captured
+// costs a single flag check. See ProfilerCapture.
+
+#define GT_ENABLE_PROFILER          1
+
+
+
 // Rendering APIs
 //
 // Rendering APIs can be enabled and disabled from here. By default, everything is enabled. To disable these, either comment out the line or
@@ -69,6 +89,28 @@
 
 
 
+// SIMD.
+#if (defined(GT_ENABLE_SSE2) && GT_ENABLE_SSE2 == 1) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GT_BUILD_SSE2
+#endif
+
+#if (defined(GT_ENABLE_AVX) && GT_ENABLE_AVX == 1) && defined(GT_BUILD_SSE2) && defined(__AVX__)
+#define GT_BUILD_AVX
+#endif
+
+#if (defined(GT_ENABLE_AVX2) && GT_ENABLE_AVX2 == 1) && defined(GT_BUILD_AVX) && defined(__AVX2__)
+#define GT_BUILD_AVX2
+#endif
+
+
+
+// Profiling.
+#if defined(GT_ENABLE_PROFILER) && GT_ENABLE_PROFILER == 1
+#define GT_BUILD_PROFILER
+#endif
+
+
+
 // Vulkan Support.
 #if (defined(GT_ENABLE_VULKAN) && GT_ENABLE_VULKAN == 1)
 #define GT_BUILD_VULKAN
@@ -16,6 +16,7 @@
 #include "Editor.hpp"
 #include "GUIEventHandler.hpp"
 #include "Profiler.hpp"
+#include "StatsRegistry.hpp"
 #include "GameStateManager.hpp"
 
 #ifdef _WIN32
@@ -159,6 +160,29 @@ namespace GT
 
 
 
+        ////////////////////////////////////////////////////
+        // Threading
+
+        /// Retrieves a reference to the shared worker thread pool.
+        ///
+        /// @remarks
+        ///     This is used by sub-systems that split work across threads such as scene updating and CPU skinning.
+        ThreadPool & GetThreadPool() { return m_threadPool; }
+
+
+
+        ////////////////////////////////////////////////////
+        // Stats
+
+        /// Retrieves a reference to the per-frame stats.
+        ///
+        /// @remarks
+        ///     The engine's own stats are identified by the EngineStat enum. The stats are ended at the start of each frame, when the time
+        ///     the previous frame took is known.
+        StatsRegistry & GetStats() { return m_stats; }
+
+
+
         //// FROM GAME ////
 
         /// Runs the game.
@@ -376,7 +400,9 @@ namespace GT
         ///
         /// @param outputDirectory [in] The output directory, relative to the running directory.
         /// @param executableName  [in] The name of the executable.
-        bool PackageForDistribution(const char* outputDirectory, const char* executableName);
+        /// @param packAssets      [in] Whether or not to pack the asset files into a memory-mapped game package. See GamePackager::EnablePackage().
+        /// @param bakeTextures    [in] Whether or not to bake compressed textures with precomputed mipmaps. See GamePackager::EnableTextureBaking().
+        bool PackageForDistribution(const char* outputDirectory, const char* executableName, bool packAssets = false, bool bakeTextures = false);
 
 
 
@@ -483,6 +509,9 @@ namespace GT
         /// Updates a renders a single frame.
         void DoFrame();
 
+        /// Samples the cumulative counters and ends the current frame of the stats.
+        void EndStatsFrame(double frameTimeInSeconds);
+
         /// Updates the game. This is run on the update thread.
         void Update();
 
@@ -599,6 +628,22 @@ namespace GT
         Texture2DLibrary m_textureLibrary;
 
 
+        /// The shared worker thread pool.
+        ThreadPool m_threadPool;
+
+        /// The per-frame stats.
+        StatsRegistry m_stats;
+
+        /// Whether or not a frame has been run since the stats were last ended. This is false until the first frame.
+        bool m_hasUnendedStatsFrame;
+
+        /// The draw call count, script call count and asset bytes loaded when the stats were last ended. These are cumulative, so
+        /// the stats for each frame are the difference.
+        uint64_t m_lastDrawCallCount;
+        uint64_t m_lastScriptCallCount;
+        uint64_t m_lastAssetBytesLoaded;
+
+
 
         /// The game state manager.
         GameStateManager &m_gameStateManager;
@@ -57,6 +57,25 @@ namespace GT
         }
 
 
+        /// Retrieves a pointer to the given number of bytes and moves past them, without copying anything.
+        ///
+        /// @param bytesToRead [in] The number of bytes to read.
+        ///
+        /// @return A pointer to the data inside the buffer, or null if there are not enough bytes remaining.
+        const void* ReadDirect(size_t bytesToRead)
+        {
+            if (bytesToRead > this->GetAvailableBufferSpaceInBytes())
+            {
+                return nullptr;
+            }
+
+            const void* data = m_buffer + m_currentPos;
+            m_currentPos += bytesToRead;
+
+            return data;
+        }
+
+
         /// Retrieves the position of the read pointer.
         ///
         /// @remarks
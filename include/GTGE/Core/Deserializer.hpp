@@ -67,6 +67,17 @@ namespace GT
             return this->TellImpl();
         }
 
+        /// @copydoc Deserializer::ReadDirectImpl
+        const void* ReadDirect(size_t bytesToRead)
+        {
+            if (this->HasRoomInChunk(bytesToRead))
+            {
+                return this->ReadDirectImpl(bytesToRead);
+            }
+
+            return nullptr;
+        }
+
 
 
         /// Reads a value from the buffer.
@@ -110,6 +121,53 @@ namespace GT
             return bytesRead;
         }
 
+        /// Reads a block of data, retrieving a pointer straight to it if the deserializer supports it.
+        ///
+        /// @param bytesToRead [in]  The number of bytes to read.
+        /// @param pBufferOut  [out] Receives a pointer to a buffer allocated with malloc() if the data needed to be copied, or null if it didn't.
+        /// @param alignment   [in]  The alignment the returned pointer must have. This must be a power of two.
+        ///
+        /// @return A pointer to the data, or null if there are not enough bytes remaining.
+        ///
+        /// @remarks
+        ///     This is intended for bulk data such as arrays. Deserializers that read from memory return a pointer from ReadDirect(), while
+        ///     others read the data into a new buffer. The data is also copied if the direct pointer is not aligned. If pBufferOut is not null
+        ///     it must be freed with free() once the data is no longer needed.
+        const void* ReadBlock(size_t bytesToRead, void* &pBufferOut, size_t alignment = 1)
+        {
+            pBufferOut = nullptr;
+
+            const void* pData = this->ReadDirect(bytesToRead);
+            if (pData != nullptr)
+            {
+                if ((reinterpret_cast<uintptr_t>(pData) & (alignment - 1)) != 0)
+                {
+                    pBufferOut = malloc((bytesToRead > 0) ? bytesToRead : 1);
+                    if (pBufferOut != nullptr)
+                    {
+                        memcpy(pBufferOut, pData, bytesToRead);
+                    }
+
+                    pData = pBufferOut;
+                }
+            }
+            else
+            {
+                pBufferOut = malloc((bytesToRead > 0) ? bytesToRead : 1);
+                if (pBufferOut != nullptr && this->Read(pBufferOut, bytesToRead) == bytesToRead)
+                {
+                    pData = pBufferOut;
+                }
+                else
+                {
+                    free(pBufferOut);
+                    pBufferOut = nullptr;
+                }
+            }
+
+            return pData;
+        }
+
 
         /// Marks the beginning of the reading of a protected chunk of data.
         ///
@@ -210,6 +268,23 @@ namespace GT
         ///     This can be used in determining how many bytes have been read at a certain point.
         virtual size_t TellImpl() const = 0;
 
+        /// Retrieves a pointer to the data at the read pointer and moves the read pointer past it, without copying anything.
+        ///
+        /// @param bytesToRead [in] The number of bytes to read.
+        ///
+        /// @return A pointer to the data, or null if the data can not be read directly.
+        ///
+        /// @remarks
+        ///     The default implementation returns null, which is what deserializers that don't read from memory should do. If there are not
+        ///     enough bytes remaining this should return null without moving the read pointer.
+        ///     @par
+        ///     The returned pointer is not necessarily aligned, and is only valid for as long as the source buffer is.
+        virtual const void* ReadDirectImpl(size_t bytesToRead)
+        {
+            (void)bytesToRead;
+            return nullptr;
+        }
+
 
     private:
 
@@ -323,6 +398,20 @@ namespace GT
             return this->readPointer;
         }
 
+        /// Deserializer::ReadDirect().
+        const void* ReadDirectImpl(size_t bytesToRead)
+        {
+            if (bytesToRead > this->GetAvailableBufferSpaceInBytes())
+            {
+                return nullptr;
+            }
+
+            const void* data = reinterpret_cast<const uint8_t*>(this->buffer) + this->readPointer;
+            this->readPointer += bytesToRead;
+
+            return data;
+        }
+
 
         /// Retrieves the amount of space reamining in the buffer.
         size_t GetAvailableBufferSpaceInBytes() const
@@ -344,6 +433,17 @@ namespace GT
         size_t readPointer;
 
 
+    protected:
+
+        /// Changes the buffer to read from and moves the read pointer back to the start.
+        void SetBuffer(const void* bufferIn, size_t bufferSizeInBytesIn)
+        {
+            this->buffer            = bufferIn;
+            this->bufferSizeInBytes = bufferSizeInBytesIn;
+            this->readPointer       = 0;
+        }
+
+
     private:    // No copying.
         BasicDeserializer(const BasicDeserializer &);
         BasicDeserializer & operator=(const BasicDeserializer &);
@@ -466,6 +566,56 @@ namespace GT
         assert(false);
         return 0;
     }
+
+
+
+
+    /// Class for deserialization from a memory-mapped file.
+    ///
+    /// Reading is a copy out of the mapping rather than a call into the file system, and ReadDirect() and ReadBlock() return pointers straight
+    /// into the mapping, which means bulk data can be used without being copied at all.
+    ///
+    /// This only works for files on the native file system. Use IsOpen() to check whether or not the file was mapped, and fall back to a
+    /// FileDeserializer if it wasn't.
+    class MappedFileDeserializer : public BasicDeserializer
+    {
+    public:
+
+        /// Constructor.
+        ///
+        /// @param absolutePath [in] The absolute path of the file to map.
+        MappedFileDeserializer(const char* absolutePath)
+            : BasicDeserializer(nullptr, 0), m_file()
+        {
+            if (m_file.Open(absolutePath))
+            {
+                this->SetBuffer(m_file.GetData(), m_file.GetSize());
+            }
+        }
+
+        /// Destructor.
+        virtual ~MappedFileDeserializer()
+        {
+        }
+
+
+        /// Determines whether or not the file was mapped successfully.
+        bool IsOpen() const
+        {
+            return m_file.IsOpen();
+        }
+
+
+    private:
+
+        /// The mapped file.
+        MappedFile m_file;
+
+
+    private:    // No copying.
+        MappedFileDeserializer(const MappedFileDeserializer &);
+        MappedFileDeserializer & operator=(const MappedFileDeserializer &);
+    };
 }
 
 #if defined(_MSC_VER)
@@ -5,6 +5,30 @@
 
 namespace GT
 {
+    /// The number of items a dictionary needs to have before it builds a hash table for lookups. Below this a binary search is just
+    /// as fast and we don't want to spend memory on a table for every small dictionary.
+    static const size_t DictionaryUTF_HashTableThreshold = 8;
+
+    /// Hashes a dictionary key with FNV-1a. For char keys this gives the same result as GT::Hash().
+    template <typename T>
+    inline uint32_t DictionaryUTF_Hash(const T* key, ptrdiff_t keySizeInTs)
+    {
+        uint32_t hash = 2166136261UL;
+
+        for (ptrdiff_t i = 0; keySizeInTs == -1 || i < keySizeInTs; ++i)
+        {
+            if (key[i] == T(0))
+            {
+                break;
+            }
+
+            hash = (hash ^ static_cast<uint32_t>(key[i])) * 0x01000193;
+        }
+
+        return hash;
+    }
+
+
     /// An item in a dictionary.
     template <typename T, typename U>
     class DictionaryItemUTF
@@ -12,7 +36,7 @@ namespace GT
     public:
 
         DictionaryItemUTF(const T* key, ptrdiff_t keySizeInBytes, const U &value)
-            : key(key), keySizeInBytes(keySizeInBytes), value(value), index(0)
+            : key(key), keySizeInBytes(keySizeInBytes), value(value), index(0), hash(DictionaryUTF_Hash(key, keySizeInBytes))
         {
         }
 
@@ -42,10 +66,13 @@ namespace GT
         /// The value;
         U value;
 
-        /// The index of the item in the internal buffer. This will change when the content of the buffer changes. This is NOT used internally by Dictionary, but rather is
-        /// only used to allow an application to have fast access to the item by directly accessing the buffer.  This is only set in Find().
+        /// The index of the item in the internal buffer. This will change when the content of the buffer changes, but the dictionary keeps
+        /// it up to date so it's always valid.
         size_t index;
 
+        /// The hash of the key. This is used by the dictionary's hash table.
+        uint32_t hash;
+
 
     private:    // No copying.
         DictionaryItemUTF(const DictionaryItemUTF &);
@@ -95,20 +122,23 @@ namespace GT
 
         /// Constructs an empty dictionary.
         DictionaryUTF()
-            : buffer(nullptr), bufferSize(0), count(0)
+            : buffer(nullptr), bufferSize(0), count(0), slots(nullptr), slotMask(0)
         {
         }
 
         /// Copy constructor.
         DictionaryUTF(const DictionaryUTF &other)
-            : buffer(nullptr), bufferSize(other.bufferSize), count(other.count)
+            : buffer(nullptr), bufferSize(other.bufferSize), count(other.count), slots(nullptr), slotMask(0)
         {
             this->buffer = static_cast<DictionaryItemUTF<T, U>**>(malloc(sizeof(DictionaryItemUTF<T, U>*) * this->bufferSize));
 
             for (size_t i = 0; i < this->count; ++i)
             {
                 this->buffer[i] = DictionaryItemUTF<T, U>::Allocate(Strings::Create(other.buffer[i]->key, other.buffer[i]->keySizeInBytes), other.buffer[i]->keySizeInBytes, other.buffer[i]->value);
+                this->buffer[i]->index = i;
             }
+
+            this->RebuildHashTable();
         }
 
 
@@ -129,6 +159,19 @@ namespace GT
         ///     Existing items are replaced.
         DictionaryItemUTF<T, U>* Add(const T* key, ptrdiff_t keySizeInBytes, const U &value)
         {
+            // If the item already exists we just replace the value. The hash table is the quickest way to find out, if we have one.
+            if (this->slots != nullptr)
+            {
+                auto existingItem = this->Find(key, keySizeInBytes);
+                if (existingItem != nullptr)
+                {
+                    existingItem->value.~U();
+                    new (&existingItem->value) U(value);
+
+                    return existingItem;
+                }
+            }
+
             // We first need to try and find the item. If it's exact, we replace; otherwise we insert after the result.
             FindResult result = this->BinarySearch(key, keySizeInBytes);
             if (result.exact)
@@ -190,6 +233,22 @@ namespace GT
                     this->buffer[result.index] = newitem;
                 }
 
+
+                // Every item from the insertion point onwards has moved, so their indices need updating.
+                for (size_t i = result.index; i < this->count; ++i)
+                {
+                    this->buffer[i]->index = i;
+                }
+
+                if (this->slots != nullptr && this->count <= (this->slotMask + 1) / 2)
+                {
+                    this->InsertIntoHashTable(newitem);
+                }
+                else if (this->count > DictionaryUTF_HashTableThreshold)
+                {
+                    this->RebuildHashTable();
+                }
+
                 return newitem;
             }
         }
@@ -221,10 +280,10 @@ namespace GT
         void RemoveByKey(const T* key, ptrdiff_t keySizeInBytes = -1)
         {
             // We first need to find the item. If we don't find an exact match, we just ignore it.
-            FindResult result = this->BinarySearch(key, keySizeInBytes);
-            if (result.exact)
+            auto item = this->Find(key, keySizeInBytes);
+            if (item != nullptr)
             {
-                this->Remove(result.index);
+                this->RemoveByIndex(item->index);
             }
         }
 
@@ -235,12 +294,18 @@ namespace GT
             if (index < this->count)
             {
                 // First delete the item...
+                if (this->slots != nullptr)
+                {
+                    this->RemoveFromHashTable(this->buffer[index]);
+                }
+
                 DictionaryItemUTF<T, U>::Deallocate(this->buffer[index]);
 
                 // Now move everything down to remove it from the array.
                 for (size_t i = index; i < this->count - 1; ++i)
                 {
                     this->buffer[i] = this->buffer[i + 1];
+                    this->buffer[i]->index = i;
                 }
 
                 --this->count;
@@ -255,13 +320,15 @@ namespace GT
         /// @return The dictionary item for the given key, or null if the item is not found.
         DictionaryItemUTF<T, U>* Find(const T *key, ptrdiff_t keySizeInBytes = -1)
         {
+            if (this->slots != nullptr)
+            {
+                return this->Find(key, keySizeInBytes, DictionaryUTF_Hash(key, keySizeInBytes));
+            }
+
             FindResult result = this->BinarySearch(key, keySizeInBytes);
             if (result.exact)
             {
-                auto item = this->buffer[result.index];
-                item->index = result.index;
-
-                return item;
+                return this->buffer[result.index];
             }
 
             return nullptr;
@@ -272,6 +339,53 @@ namespace GT
             return const_cast<DictionaryUTF<T, U>*>(this)->Find(key, keySizeInBytes);
         }
 
+        /// Finds the dictionary item of the given key, using a hash that has already been calculated.
+        ///
+        /// @param  key            [in] The key of the item being retrieved.
+        /// @param  keySizeInBytes [in] The size in bytes of the key string. Can be -1 if the key is null terminated.
+        /// @param  hash           [in] The hash of the key, as returned by DictionaryUTF_Hash(). This is what the string table gives out with each ID.
+        ///
+        /// @return The dictionary item for the given key, or null if the item is not found.
+        DictionaryItemUTF<T, U>* Find(const T *key, ptrdiff_t keySizeInBytes, uint32_t hash)
+        {
+            if (this->slots == nullptr)
+            {
+                // Small dictionaries don't have a table, but with the hash already known a linear scan is cheaper than a binary search
+                // since most items are rejected without looking at their key.
+                if (this->count > DictionaryUTF_HashTableThreshold)
+                {
+                    return this->Find(key, keySizeInBytes);
+                }
+
+                for (size_t i = 0; i < this->count; ++i)
+                {
+                    auto item = this->buffer[i];
+                    if (item->hash == hash && Strings::FastCompare(key, keySizeInBytes, item->key, item->keySizeInBytes) == 0)
+                    {
+                        return item;
+                    }
+                }
+
+                return nullptr;
+            }
+
+            for (size_t iSlot = hash & this->slotMask; this->slots[iSlot] != nullptr; iSlot = (iSlot + 1) & this->slotMask)
+            {
+                auto item = this->slots[iSlot];
+                if (item->hash == hash && Strings::FastCompare(key, keySizeInBytes, item->key, item->keySizeInBytes) == 0)
+                {
+                    return item;
+                }
+            }
+
+            return nullptr;
+        }
+
+        const DictionaryItemUTF<T, U>* Find(const T *key, ptrdiff_t keySizeInBytes, uint32_t hash) const
+        {
+            return const_cast<DictionaryUTF<T, U>*>(this)->Find(key, keySizeInBytes, hash);
+        }
+
 
         /// Determines if an item with the given key exists.
         bool DoesItemExist(const T* key, ptrdiff_t keySizeInBytes = -1) const
@@ -294,6 +408,11 @@ namespace GT
 
             this->count = 0;
 
+            // The hash table is only worth having for larger dictionaries, so we always drop it here.
+            free(this->slots);
+            this->slots    = nullptr;
+            this->slotMask = 0;
+
             if (clearBuffer)
             {
                 free(this->buffer);
@@ -324,7 +443,10 @@ namespace GT
                 for (size_t i = 0; i < other.count; ++i)
                 {
                     this->buffer[i] = DictionaryItemUTF<T, U>::Allocate(Strings::Create(other.buffer[i]->key, other.buffer[i]->keySizeInBytes), other.buffer[i]->keySizeInBytes, other.buffer[i]->value);
+                    this->buffer[i]->index = i;
                 }
+
+                this->RebuildHashTable();
             }
 
             return *this;
@@ -333,6 +455,72 @@ namespace GT
 
     private:
 
+        /// Rebuilds the hash table from scratch, sized for the current item count. The table is removed if the dictionary is small.
+        void RebuildHashTable()
+        {
+            free(this->slots);
+            this->slots    = nullptr;
+            this->slotMask = 0;
+
+            if (this->count <= DictionaryUTF_HashTableThreshold)
+            {
+                return;
+            }
+
+            // The table is kept at most half full. If we can't allocate it we just fall back to the binary search.
+            size_t slotCount = 16;
+            while (slotCount < this->count * 4)
+            {
+                slotCount *= 2;
+            }
+
+            this->slots = static_cast<DictionaryItemUTF<T, U>**>(calloc(slotCount, sizeof(DictionaryItemUTF<T, U>*)));
+            if (this->slots != nullptr)
+            {
+                this->slotMask = slotCount - 1;
+
+                for (size_t i = 0; i < this->count; ++i)
+                {
+                    this->InsertIntoHashTable(this->buffer[i]);
+                }
+            }
+        }
+
+        /// Inserts an item into the hash table. The table must have room for it.
+        void InsertIntoHashTable(DictionaryItemUTF<T, U>* item)
+        {
+            size_t iSlot = item->hash & this->slotMask;
+            while (this->slots[iSlot] != nullptr)
+            {
+                iSlot = (iSlot + 1) & this->slotMask;
+            }
+
+            this->slots[iSlot] = item;
+        }
+
+        /// Removes an item from the hash table using a backward shift so no tombstones are needed.
+        void RemoveFromHashTable(DictionaryItemUTF<T, U>* item)
+        {
+            size_t iHole = item->hash & this->slotMask;
+            while (this->slots[iHole] != item)
+            {
+                assert(this->slots[iHole] != nullptr);
+                iHole = (iHole + 1) & this->slotMask;
+            }
+
+            for (size_t iNext = (iHole + 1) & this->slotMask; this->slots[iNext] != nullptr; iNext = (iNext + 1) & this->slotMask)
+            {
+                size_t iIdeal = this->slots[iNext]->hash & this->slotMask;
+                if (((iNext - iIdeal) & this->slotMask) >= ((iNext - iHole) & this->slotMask))
+                {
+                    this->slots[iHole] = this->slots[iNext];
+                    iHole = iNext;
+                }
+            }
+
+            this->slots[iHole] = nullptr;
+        }
+
         /// Searches for the item of the given key.
         FindResult BinarySearch(const T* key, ptrdiff_t keySizeInBytes) const
         {
@@ -390,6 +578,15 @@ namespace GT
 
         /// The number of items in the map.
         size_t count;
+
+
+    private:
+
+        /// The hash table of items, or null if the dictionary is too small to need one. The number of slots is a power of two.
+        DictionaryItemUTF<T, U>** slots;
+
+        /// The number of slots minus one.
+        size_t slotMask;
     };
 
 
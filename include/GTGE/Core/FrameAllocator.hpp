@@ -0,0 +1,205 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#ifndef GT_FrameAllocator
+#define GT_FrameAllocator
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace GT
+{
+    /// A linear allocator for memory that only needs to live until the end of the frame.
+    ///
+    /// Allocations are made by bumping an offset through a list of blocks and everything is released in one go with Reset(). If a
+    /// frame needed more than one block, Reset() replaces them with a single block that is big enough for the whole frame, so once
+    /// the allocator has warmed up a frame is served without touching the heap at all.
+    ///
+    /// Objects created with New() have their destructors called by Reset(), in the reverse order of their creation. Memory returned
+    /// by Allocate() is raw and nothing is called on it.
+    ///
+    /// This is not thread-safe.
+    class FrameAllocator
+    {
+    public:
+
+        /// Constructor.
+        ///
+        /// @param initialBlockSizeInBytes [in] The size of the first block. No memory is allocated until the first allocation.
+        FrameAllocator(size_t initialBlockSizeInBytes = 64 * 1024);
+
+        /// Destructor.
+        ~FrameAllocator();
+
+
+        /// Allocates a chunk of memory that is valid until the next call to Reset().
+        ///
+        /// @param sizeInBytes [in] The size of the allocation, in bytes.
+        /// @param alignment   [in] The alignment of the allocation. This must be a power of two.
+        ///
+        /// @return A pointer to the new memory, or null if the memory could not be allocated.
+        void* Allocate(size_t sizeInBytes, size_t alignment = 16);
+
+        /// Creates a new object that will be destructed by the next call to Reset().
+        ///
+        /// @return A pointer to the new object, or null if the memory could not be allocated.
+        template <typename T, typename... Args>
+        T* New(Args&&... args)
+        {
+            // The destructor record is allocated first so we don't need to undo the object if it fails.
+            DestructorRecord* record = nullptr;
+            if (!std::is_trivially_destructible<T>::value)
+            {
+                record = reinterpret_cast<DestructorRecord*>(this->AllocateFromBlocks(sizeof(DestructorRecord), alignof(DestructorRecord)));
+                if (record == nullptr)
+                {
+                    return nullptr;
+                }
+            }
+
+            void* memory = this->Allocate(sizeof(T), alignof(T));
+            if (memory == nullptr)
+            {
+                return nullptr;
+            }
+
+            T* object = new (memory) T(std::forward<Args>(args)...);
+
+            if (record != nullptr)
+            {
+                record->destruct = &FrameAllocator::Destruct<T>;
+                record->object   = object;
+                record->prev     = m_lastDestructor;
+                m_lastDestructor = record;
+            }
+
+            return object;
+        }
+
+
+        /// Releases every allocation made since the last reset, calling the destructors of every object created with New().
+        ///
+        /// @remarks
+        ///     This should be called once at the end of every frame. The per-frame counters are moved into the last frame counters.
+        void Reset();
+
+
+        /// Retrieves the number of allocations made since the last reset.
+        size_t GetAllocationCount() const { return m_allocationCount; }
+
+        /// Retrieves the number of bytes allocated since the last reset, not including alignment padding.
+        size_t GetAllocatedBytes() const { return m_allocatedBytes; }
+
+        /// Retrieves the number of allocations made in the frame before the last reset.
+        size_t GetLastFrameAllocationCount() const { return m_lastFrameAllocationCount; }
+
+        /// Retrieves the number of bytes allocated in the frame before the last reset.
+        size_t GetLastFrameAllocatedBytes() const { return m_lastFrameAllocatedBytes; }
+
+        /// Retrieves the largest number of bytes allocated in any single frame.
+        size_t GetPeakAllocatedBytes() const { return m_peakAllocatedBytes; }
+
+        /// Retrieves the total size of every block currently owned by the allocator.
+        size_t GetCapacity() const { return m_capacity; }
+
+        /// Retrieves the number of times a block has been allocated from the heap over the lifetime of the allocator.
+        ///
+        /// @remarks
+        ///     This should stop increasing once the allocator has warmed up. If it keeps climbing, the frames are alternating between
+        ///     very different amounts of memory.
+        size_t GetBlockAllocationCount() const { return m_blockAllocationCount; }
+
+
+
+    private:
+
+        /// The header at the start of every block. The memory for allocations comes immediately after it.
+        struct Block
+        {
+            /// The next block in the list.
+            Block* next;
+
+            /// The size of the block's data, not including this header.
+            size_t sizeInBytes;
+
+            /// The offset of the next allocation within the block's data.
+            size_t offset;
+        };
+
+        /// Structure representing an object whose destructor needs to be called when the allocator is reset.
+        struct DestructorRecord
+        {
+            /// The function that calls the destructor.
+            void (* destruct)(void* object);
+
+            /// The object to destruct.
+            void* object;
+
+            /// The previously recorded destructor.
+            DestructorRecord* prev;
+        };
+
+
+        /// Allocates memory from the blocks, creating a new block if required. This does not touch the counters.
+        void* AllocateFromBlocks(size_t sizeInBytes, size_t alignment);
+
+        /// Attempts to allocate memory from the given block.
+        static void* AllocateFromBlock(Block* block, size_t sizeInBytes, size_t alignment);
+
+        /// Creates a new block and appends it to the end of the list.
+        Block* AppendNewBlock(size_t minSizeInBytes);
+
+        /// Frees every block.
+        void FreeBlocks();
+
+        /// Calls the destructor of an object created with New().
+        template <typename T>
+        static void Destruct(void* object)
+        {
+            reinterpret_cast<T*>(object)->~T();
+        }
+
+
+        /// The first block in the list.
+        Block* m_firstBlock;
+
+        /// The block allocations are currently being made from.
+        Block* m_currentBlock;
+
+        /// The size of the block to allocate when the list is empty.
+        size_t m_initialBlockSizeInBytes;
+
+        /// The most recently recorded destructor. Reset() walks this list backwards.
+        DestructorRecord* m_lastDestructor;
+
+
+        /// The number of allocations made since the last reset.
+        size_t m_allocationCount;
+
+        /// The number of bytes allocated since the last reset.
+        size_t m_allocatedBytes;
+
+        /// The number of allocations made in the previous frame.
+        size_t m_lastFrameAllocationCount;
+
+        /// The number of bytes allocated in the previous frame.
+        size_t m_lastFrameAllocatedBytes;
+
+        /// The largest number of bytes allocated in a single frame.
+        size_t m_peakAllocatedBytes;
+
+        /// The total size of every block.
+        size_t m_capacity;
+
+        /// The number of blocks that have been allocated from the heap.
+        size_t m_blockAllocationCount;
+
+
+    private:    // No copying.
+        FrameAllocator(const FrameAllocator &);
+        FrameAllocator & operator=(const FrameAllocator &);
+    };
+}
+
+#endif
@@ -0,0 +1,453 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#ifndef GT_HashMap
+#define GT_HashMap
+
+namespace GT
+{
+    /// Mixes the bits of a 64-bit value down to a 32-bit hash. This is the finalizer from MurmurHash3.
+    inline uint32_t HashMap_MixBits(uint64_t value)
+    {
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCDULL;
+        value ^= value >> 33;
+        value *= 0xC4CEB9FE1A85EC53ULL;
+        value ^= value >> 33;
+
+        return static_cast<uint32_t>(value);
+    }
+
+    /// The default hasher for HashMap. This works for integers, enums and pointers.
+    ///
+    /// Specialize this, or pass a different hasher to HashMap, for other key types. A hasher needs a static Hash() function that
+    /// returns a 32-bit hash of the key.
+    template <typename T>
+    struct HashMapHasher
+    {
+        static uint32_t Hash(const T &key)
+        {
+            return HashMap_MixBits(static_cast<uint64_t>(key));
+        }
+    };
+
+    template <typename T>
+    struct HashMapHasher<T*>
+    {
+        static uint32_t Hash(const T* key)
+        {
+            return HashMap_MixBits(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key)));
+        }
+    };
+
+
+    /// An item in a HashMap.
+    template <typename T, typename U>
+    class HashMapItem
+    {
+    public:
+
+        HashMapItem(const T &key, const U &value, size_t index)
+            : key(key), value(value), index(index)
+        {
+        }
+
+
+        /// The key.
+        const T key;
+
+        /// The value.
+        U value;
+
+        /// The index of the item in the map's buffer. Unlike MapItem, this is always up to date.
+        size_t index;
+
+
+    private:    // Items are moved around by the map itself.
+        HashMapItem(const HashMapItem<T, U> &);
+        HashMapItem<T, U> & operator=(const HashMapItem<T, U> &);
+    };
+
+
+    /// Class representing a map that uses a hash table to find items.
+    ///
+    /// The interface mirrors Map so call sites can switch between them. The items are stored inline in a single tightly packed buffer,
+    /// which is iterated by index in exactly the same way as Map, except that 'buffer' contains the items themselves rather than
+    /// pointers to them. Lookups use a separate open-addressed table of slots with linear probing. Each slot stores the full hash of
+    /// it's key, so a probe only touches the item buffer when the hashes match.
+    ///
+    /// The items are NOT sorted. Removing an item moves the last item into it's place, so the order of items changes on removal and
+    /// pointers to items are invalidated by Add() and Remove().
+    template <typename T, typename U, typename Hasher = HashMapHasher<T>>
+    class HashMap
+    {
+    public:
+
+        /// Constructor.
+        HashMap()
+            : buffer(nullptr), bufferSize(0), count(0), slots(nullptr), slotMask(0)
+        {
+        }
+
+        /// Destructor.
+        ~HashMap()
+        {
+            this->Reset();
+        }
+
+
+        /// Adds an item to the map, replacing the value if an item with the same key already exists.
+        ///
+        /// @param  key   [in] The key of the new item.
+        /// @param  value [in] The value of the new item.
+        ///
+        /// @return A pointer to the item, or null if memory could not be allocated.
+        HashMapItem<T, U>* Add(const T &key, const U &value)
+        {
+            uint32_t hash = Hasher::Hash(key);
+
+            size_t iSlot = this->FindSlot(key, hash);
+            if (iSlot != static_cast<size_t>(-1))
+            {
+                auto item = this->buffer + (this->slots[iSlot].item - 1);
+
+                item->value.~U();
+                new (&item->value) U(value);
+
+                return item;
+            }
+
+
+            if (this->count + 1 > this->bufferSize)
+            {
+                if (!this->Reserve(this->bufferSize * 2 + 1))
+                {
+                    return nullptr;
+                }
+            }
+
+            auto newItem = new (this->buffer + this->count) HashMapItem<T, U>(key, value, this->count);
+            this->count += 1;
+
+            this->InsertSlot(hash, static_cast<uint32_t>(this->count));
+
+            return newItem;
+        }
+
+        /// Removes the item with the given key.
+        void RemoveByKey(const T &key)
+        {
+            size_t iSlot = this->FindSlot(key, Hasher::Hash(key));
+            if (iSlot != static_cast<size_t>(-1))
+            {
+                this->RemoveBySlot(iSlot);
+            }
+        }
+
+        /// Removes the item at the given index.
+        ///
+        /// @remarks
+        ///     The last item is moved into the removed item's position.
+        void RemoveByIndex(size_t index)
+        {
+            if (index < this->count)
+            {
+                size_t iSlot = this->FindSlotOfItem(index);
+                assert(iSlot != static_cast<size_t>(-1));
+
+                this->RemoveBySlot(iSlot);
+            }
+        }
+
+        /// Removes the item with the given key.
+        void Remove(const T &key)
+        {
+            this->RemoveByKey(key);
+        }
+
+
+        /// Finds the item of the given key.
+        ///
+        /// @param key [in] The key of the item being retrieved.
+        ///
+        /// @return A pointer to the item for the given key. Returns null if the item can not be found.
+        HashMapItem<T, U>* Find(const T &key)
+        {
+            size_t iSlot = this->FindSlot(key, Hasher::Hash(key));
+            if (iSlot != static_cast<size_t>(-1))
+            {
+                return this->buffer + (this->slots[iSlot].item - 1);
+            }
+
+            return nullptr;
+        }
+        const HashMapItem<T, U>* Find(const T &key) const
+        {
+            return const_cast<HashMap<T, U, Hasher>*>(this)->Find(key);
+        }
+
+
+        /// Determines whether or not an item of the given key exists.
+        bool Exists(const T &key) const
+        {
+            return this->FindSlot(key, Hasher::Hash(key)) != static_cast<size_t>(-1);
+        }
+
+
+        /// Makes sure there is enough room for the given number of items without reallocating.
+        ///
+        /// @return False if memory could not be allocated; true otherwise.
+        bool Reserve(size_t newBufferSize)
+        {
+            if (newBufferSize <= this->bufferSize)
+            {
+                return true;
+            }
+
+            // The slot table is always at least twice the size of the item buffer, which keeps the load factor at or below one half.
+            size_t newSlotCount = 4;
+            while (newSlotCount < newBufferSize * 2)
+            {
+                newSlotCount *= 2;
+            }
+
+            auto newBuffer = static_cast<HashMapItem<T, U>*>(malloc(sizeof(HashMapItem<T, U>) * newBufferSize));
+            if (newBuffer == nullptr)
+            {
+                return false;
+            }
+
+            auto newSlots = static_cast<Slot*>(malloc(sizeof(Slot) * newSlotCount));
+            if (newSlots == nullptr)
+            {
+                free(newBuffer);
+                return false;
+            }
+
+
+            for (size_t i = 0; i < this->count; ++i)
+            {
+                new (newBuffer + i) HashMapItem<T, U>(this->buffer[i].key, this->buffer[i].value, i);
+                this->buffer[i].~HashMapItem<T, U>();
+            }
+
+            free(this->buffer);
+            this->buffer     = newBuffer;
+            this->bufferSize = newBufferSize;
+
+
+            // The slots need to be rebuilt from scratch since their positions depend on the size of the table.
+            free(this->slots);
+            this->slots    = newSlots;
+            this->slotMask = newSlotCount - 1;
+
+            for (size_t i = 0; i < newSlotCount; ++i)
+            {
+                this->slots[i].hash = 0;
+                this->slots[i].item = 0;
+            }
+
+            for (size_t i = 0; i < this->count; ++i)
+            {
+                this->InsertSlot(Hasher::Hash(this->buffer[i].key), static_cast<uint32_t>(i + 1));
+            }
+
+            return true;
+        }
+
+
+        /// Removes every item.
+        ///
+        /// @param  clearBuffer [in] Whether or not to also free the internal buffers.
+        void Clear(bool clearBuffer = false)
+        {
+            for (size_t i = 0; i < this->count; ++i)
+            {
+                this->buffer[i].~HashMapItem<T, U>();
+            }
+
+            this->count = 0;
+
+            if (clearBuffer)
+            {
+                free(this->buffer);
+                this->buffer     = nullptr;
+                this->bufferSize = 0;
+
+                free(this->slots);
+                this->slots    = nullptr;
+                this->slotMask = 0;
+            }
+            else
+            {
+                for (size_t i = 0; i <= this->slotMask && this->slots != nullptr; ++i)
+                {
+                    this->slots[i].hash = 0;
+                    this->slots[i].item = 0;
+                }
+            }
+        }
+
+        /// Resets the map to it's default state.
+        void Reset()
+        {
+            this->Clear(true);  // 'true' says to clear the internal buffers.
+        }
+
+        /// Retrieves the number of items in the map.
+        size_t GetCount() const
+        {
+            return this->count;
+        }
+
+        /// Retrieves an item by it's index.
+        ///
+        /// @param index [in] The index of the item to retrieve.
+        HashMapItem<T, U>* GetItemByIndex(size_t index)
+        {
+            if (index < this->count)
+            {
+                return this->buffer + index;
+            }
+
+            return nullptr;
+        }
+
+
+
+    private:
+
+        /// Structure representing a slot in the hash table.
+        struct Slot
+        {
+            /// The full hash of the key of the item in this slot.
+            uint32_t hash;
+
+            /// The index of the item plus one. This is 0 when the slot is empty.
+            uint32_t item;
+        };
+
+
+        /// Finds the slot of the item with the given key, or -1 if it does not exist.
+        size_t FindSlot(const T &key, uint32_t hash) const
+        {
+            if (this->count == 0)
+            {
+                return static_cast<size_t>(-1);
+            }
+
+            for (size_t iSlot = hash & this->slotMask; ; iSlot = (iSlot + 1) & this->slotMask)
+            {
+                auto &slot = this->slots[iSlot];
+                if (slot.item == 0)
+                {
+                    return static_cast<size_t>(-1);
+                }
+
+                if (slot.hash == hash && this->buffer[slot.item - 1].key == key)
+                {
+                    return iSlot;
+                }
+            }
+        }
+
+        /// Finds the slot that refers to the item at the given index.
+        size_t FindSlotOfItem(size_t index) const
+        {
+            uint32_t hash = Hasher::Hash(this->buffer[index].key);
+
+            for (size_t iSlot = hash & this->slotMask; ; iSlot = (iSlot + 1) & this->slotMask)
+            {
+                auto &slot = this->slots[iSlot];
+                if (slot.item == 0)
+                {
+                    return static_cast<size_t>(-1);
+                }
+
+                if (slot.item == index + 1)
+                {
+                    return iSlot;
+                }
+            }
+        }
+
+        /// Inserts a slot for the given item. The table must have room.
+        void InsertSlot(uint32_t hash, uint32_t itemPlusOne)
+        {
+            size_t iSlot = hash & this->slotMask;
+            while (this->slots[iSlot].item != 0)
+            {
+                iSlot = (iSlot + 1) & this->slotMask;
+            }
+
+            this->slots[iSlot].hash = hash;
+            this->slots[iSlot].item = itemPlusOne;
+        }
+
+        /// Removes the item referred to by the given slot.
+        void RemoveBySlot(size_t iSlot)
+        {
+            size_t index = this->slots[iSlot].item - 1;
+
+            // Removing the slot is done with a backward shift rather than a tombstone. Every slot in the same run that could live
+            // in the hole is moved back into it, so lookups never need to skip over deleted entries.
+            size_t iHole = iSlot;
+            for (size_t iNext = (iHole + 1) & this->slotMask; this->slots[iNext].item != 0; iNext = (iNext + 1) & this->slotMask)
+            {
+                size_t iIdeal = this->slots[iNext].hash & this->slotMask;
+                if (((iNext - iIdeal) & this->slotMask) >= ((iNext - iHole) & this->slotMask))
+                {
+                    this->slots[iHole] = this->slots[iNext];
+                    iHole = iNext;
+                }
+            }
+
+            this->slots[iHole].hash = 0;
+            this->slots[iHole].item = 0;
+
+
+            // The last item is moved into the hole in the buffer, which means it's slot needs to be updated to point to it's new index.
+            size_t iLast = this->count - 1;
+            if (index != iLast)
+            {
+                size_t iLastSlot = this->FindSlotOfItem(iLast);
+                assert(iLastSlot != static_cast<size_t>(-1));
+
+                this->slots[iLastSlot].item = static_cast<uint32_t>(index + 1);
+
+                this->buffer[index].~HashMapItem<T, U>();
+                new (this->buffer + index) HashMapItem<T, U>(this->buffer[iLast].key, this->buffer[iLast].value, index);
+            }
+
+            this->buffer[iLast].~HashMapItem<T, U>();
+            this->count -= 1;
+        }
+
+
+    public:
+
+        /// The buffer containing the items. Only items in the range [0, count) are valid.
+        HashMapItem<T, U>* buffer;
+
+        /// The number of items the buffer can hold.
+        size_t bufferSize;
+
+        /// The number of items in the map.
+        size_t count;
+
+
+    private:
+
+        /// The hash table. The number of slots is always a power of two.
+        Slot* slots;
+
+        /// The number of slots minus one.
+        size_t slotMask;
+
+
+    private:    // No copying for now.
+        HashMap(const HashMap<T, U, Hasher> &);
+        HashMap<T, U, Hasher> & operator=(const HashMap<T, U, Hasher> &);
+    };
+}
+
+#endif
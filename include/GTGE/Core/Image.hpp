@@ -7,6 +7,8 @@
 
 namespace GT
 {
+    class ThreadPool;
+
     /**
     *   \brief  The main image class for GTLib.
     *
@@ -131,12 +133,14 @@ namespace GT
 
         /**
         *   \brief  A helper function for automatically generating the mipmaps of the image.
+        *   \param  filter      [in] The filter to use. See MipmapFilter.
+        *   \param  pThreadPool [in] The thread pool to split the generation of each mipmap across, or null to use the calling thread only.
         *   \return True if the mipmaps were generated successfully; false otherwise.
         *
         *   \remarks
         *       This method requires at least a base mipmap. If it does not have one, it will return false.
         */
-        bool GenerateMipmaps();
+        bool GenerateMipmaps(MipmapFilter filter = MipmapFilter_Box, ThreadPool* pThreadPool = nullptr);
 
 
         /**
@@ -14,6 +14,7 @@ namespace GT
         static const int Float        = 2;
         static const int Depth        = 3;
         static const int DepthStencil = 4;
+        static const int Compressed   = 5;
     }
 
     /// Enumerator for the different image formats. We encode information about the formats in the IDs, which are generated with
@@ -43,6 +44,10 @@ namespace GT
         ImageFormat_Depth32          = GTIMAGE_GENIMAGEFORMATID(1, 4, ImageFormatDataTypes::Depth),         ///< 32-bit depth, no stencil.
         ImageFormat_Depth24_Stencil8 = GTIMAGE_GENIMAGEFORMATID(2, 4, ImageFormatDataTypes::DepthStencil),  ///< 24-bit depth, 8-bit stencil (32-bit).
 
+        // Block-compressed formats. The data is made up of 4x4 blocks of texels rather than individual texels, so the component size is zero.
+        ImageFormat_DXT1             = GTIMAGE_GENIMAGEFORMATID(3, 0, ImageFormatDataTypes::Compressed),    ///< S3TC DXT1 (BC1), no alpha. 8 bytes per block.
+        ImageFormat_DXT5             = GTIMAGE_GENIMAGEFORMATID(4, 0, ImageFormatDataTypes::Compressed),    ///< S3TC DXT5 (BC3). 16 bytes per block.
+
         
         // Special formats.
         ImageFormat_R10G10B10A2      = 1,
@@ -88,10 +93,33 @@ namespace GT
     }
     
     /// Retrieves the size of a texel, in bytes.
+    ///
+    /// @remarks
+    ///     This is zero for compressed formats. Use GetImageFormatBlockSizeInBytes() for those.
     inline size_t GetTexelSizeInBytes(ImageFormat format)
     {
         return GetImageFormatComponentCount(format) * GetImageFormatComponentSize(format);
     }
+
+    /// Determines whether or not the format is block-compressed.
+    inline bool IsImageFormatCompressed(ImageFormat format)
+    {
+        return GetImageFormatDataType(format) == ImageFormatDataTypes::Compressed;
+    }
+
+    /// Retrieves the size of a 4x4 block of a compressed format, in bytes. This is zero for formats that are not compressed.
+    inline size_t GetImageFormatBlockSizeInBytes(ImageFormat format)
+    {
+        switch (format)
+        {
+        case ImageFormat_DXT1: return 8;
+        case ImageFormat_DXT5: return 16;
+
+        default: break;
+        }
+
+        return 0;
+    }
 }
 
 #endif
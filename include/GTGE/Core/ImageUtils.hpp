@@ -26,6 +26,9 @@ namespace GT
 
         /**
         *   \brief  Calculates the size of a row based on the width and the format.
+        *
+        *   \remarks
+        *       For compressed formats this is the size of a row of 4x4 blocks.
         */
         size_t CalculatePitch(unsigned int width, ImageFormat format);
 
@@ -54,6 +57,9 @@ namespace GT
         /// @param width     [in] The width of the image.
         /// @param height    [in] The height of the image.
         /// @param flip      [in] Whether or not to flip the data.
+        ///
+        /// @remarks
+        ///     Compressed data is flipped a row of blocks at a time. The texels inside each block are not flipped.
         void CopyImageData(void* dstBuffer, const void* srcBuffer, unsigned int width, unsigned int height, ImageFormat format, bool flip = false);
         
         /// Flips the given image data.
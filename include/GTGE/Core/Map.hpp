@@ -97,6 +97,13 @@ namespace GT
         {
         }
 
+        /// Copy constructor. This makes a copy of every item.
+        Map(const Map<T, U> &other)
+            : buffer(nullptr), bufferSize(0), count(0)
+        {
+            this->CopyFrom(other);
+        }
+
         /// Destructor. This will deallocate every item in the dictionary.
         ~Map()
         {
@@ -104,6 +111,19 @@ namespace GT
         }
 
 
+        /// Assignment operator. This replaces every item with a copy of the items in the other map.
+        Map<T, U> & operator=(const Map<T, U> &other)
+        {
+            if (this != &other)
+            {
+                this->Clear();
+                this->CopyFrom(other);
+            }
+
+            return *this;
+        }
+
+
         /// Adds an item to the dictionary.
         ///
         /// @param  key   [in] The key of the new item.
@@ -321,6 +341,32 @@ namespace GT
 
     private:
 
+        /// Appends a copy of every item in the other map. This map must be empty.
+        void CopyFrom(const Map<T, U> &other)
+        {
+            assert(this->count == 0);
+
+            if (other.count > this->bufferSize)
+            {
+                free(this->buffer);
+                this->buffer     = static_cast<MapItem<T, U>**>(malloc(sizeof(MapItem<T, U>*) * other.count));
+                this->bufferSize = (this->buffer != nullptr) ? other.count : 0;
+            }
+
+            // The other map is already sorted, so the items can be copied straight across.
+            for (size_t i = 0; i < other.count && i < this->bufferSize; ++i)
+            {
+                auto newitem = MapItem<T, U>::Allocate(other.buffer[i]->key, other.buffer[i]->value);
+                if (newitem == nullptr)
+                {
+                    break;
+                }
+
+                this->buffer[i] = newitem;
+                this->count += 1;
+            }
+        }
+
         /// Searches for the item of the given key.
         FindResult BinarySearch(const T &key) const
         {
@@ -377,10 +423,6 @@ namespace GT
         /// The number of items in the map.
         size_t count;
 
-
-    private:    // No copying for now, but really should be added soon.
-        Map(const Map<T, U> &);
-        Map<T, U> & operator=(const Map<T, U> &);
     };
 }
 
@@ -0,0 +1,77 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#ifndef GT_MappedFile
+#define GT_MappedFile
+
+#include <cstdint>
+#include <cstddef>
+
+namespace GT
+{
+    /// A file on the native file system that is mapped into memory for reading.
+    ///
+    /// The pages of the file are only read from disk as they are touched, and the data can be read directly without any copying.
+    class MappedFile
+    {
+    public:
+
+        /// Constructor.
+        MappedFile();
+
+        /// Destructor.
+        ///
+        /// @remarks
+        ///     This unmaps the file.
+        ~MappedFile();
+
+
+        /// Maps the file at the given path.
+        ///
+        /// @param absolutePath [in] The absolute path of the file on the native file system.
+        ///
+        /// @return True if the file is mapped successfully; false otherwise.
+        ///
+        /// @remarks
+        ///     This fails for empty files and for files that are not on the native file system, such as those inside archives.
+        bool Open(const char* absolutePath);
+
+        /// Unmaps the file.
+        ///
+        /// @remarks
+        ///     Pointers returned by GetData() are invalid after this.
+        void Close();
+
+        /// Determines whether or not the file is mapped.
+        bool IsOpen() const { return m_pData != nullptr; }
+
+
+        /// Retrieves a pointer to the start of the mapping.
+        const void* GetData() const { return m_pData; }
+
+        /// Retrieves the size of the mapping, which is the size of the file.
+        size_t GetSize() const { return m_size; }
+
+
+
+    private:
+
+        /// A pointer to the start of the mapping.
+        const uint8_t* m_pData;
+
+        /// The size of the mapping.
+        size_t m_size;
+
+#if defined(_WIN32)
+        /// The file and file mapping handles.
+        void* m_hFile;
+        void* m_hFileMapping;
+#endif
+
+
+    private:    // No copying.
+        MappedFile(const MappedFile &);
+        MappedFile & operator=(const MappedFile &);
+    };
+}
+
+#endif
@@ -5,6 +5,19 @@
 
 namespace GT
 {
+    /// The filters that can be used when generating mipmaps.
+    enum MipmapFilter
+    {
+        /// Each texel is the average of the 2x2 block of texels above it, as they are stored.
+        MipmapFilter_Box,
+
+        /// The same as MipmapFilter_Box, except that the colour components of RGB8 and RGBA8 images are converted from sRGB to linear before
+        /// they are averaged, and back to sRGB afterwards. Alpha is averaged as it is stored. This keeps the smaller mipmaps of sRGB images
+        /// from getting darker than they should. Other formats are filtered the same as MipmapFilter_Box.
+        MipmapFilter_SRGB
+    };
+
+
     class Mipmap
     {
     public:
@@ -5,21 +5,27 @@
 
 namespace GT
 {
+    class ThreadPool;
+
     /// Static class for generating mipmaps.
     class MipmapGenerator
     {
     public:
 
         /// Generates mipmap data from a source mipmap.
-        /// @param source [in] The mipmap that the destination will source it's image data from.
-        /// @param dest   [in] The destination mipmap.
+        /// @param source      [in] The mipmap that the destination will source it's image data from.
+        /// @param dest        [in] The destination mipmap.
+        /// @param filter      [in] The filter to use. See MipmapFilter.
+        /// @param pThreadPool [in] The thread pool to split the rows across, or null to generate the whole mipmap on the calling thread.
         /// @return True if the mipmap could be generated; false otherwise.
         ///
         /// @remarks
         ///     Not all image formats can be mipmapped. In particular, depth and stencil formats can not be mipmapped.
         ///     @par
         ///     16-bit floats can not currently be mipmapped. Support is planned, but contributions are more than welcome.
-        static bool Generate(const Mipmap &source, Mipmap &dest);
+        ///     @par
+        ///     Small mipmaps are always generated on the calling thread, since splitting them up costs more than it saves.
+        static bool Generate(const Mipmap &source, Mipmap &dest, MipmapFilter filter = MipmapFilter_Box, ThreadPool* pThreadPool = nullptr);
 
         /// Mipmap generation function optimized for RGB8 image formats.
         /// @param sourceWidth  [in] The width of the source mipmap.
@@ -41,6 +47,17 @@ namespace GT
         ///     The destination buffer must be pre-allocated.
         static void GenerateRGBA8(unsigned int sourceWidth, unsigned int sourceHeight, const void* sourceData, void* destData);
 
+        /// Mipmap generation function for RGB8 and RGBA8 image formats that store their colours in sRGB. See MipmapFilter_SRGB.
+        /// @param sourceWidth    [in] The width of the source mipmap.
+        /// @param sourceHeight   [in] The height of the source mipmap.
+        /// @param componentCount [in] The number of components in each texel. This must be 3 or 4.
+        /// @param sourceData     [in] A pointer to the source mipmaps image data.
+        /// @param destData       [in] A pointer to the destination buffer. This must be preallocated.
+        ///
+        /// @remarks
+        ///     The destination buffer must be pre-allocated.
+        static void GenerateSRGB8(unsigned int sourceWidth, unsigned int sourceHeight, unsigned int componentCount, const void* sourceData, void* destData);
+
 
         /// Generic function for generating mipmap data.
         /// @param sourceWidth    [in] The width of the source mipmap.
@@ -54,24 +71,44 @@ namespace GT
         ///     the RGB8 format will be an unsigned char or uint8_t.
         template <typename T>
         static void Generate(unsigned int sourceWidth, unsigned int sourceHeight, unsigned int componentCount, const void* sourceData, void* destData)
+        {
+            MipmapGenerator::GenerateRows<T>(sourceWidth, sourceHeight, componentCount, sourceData, destData, 0, ImageUtils::CalculateMipmapHeight(1, sourceHeight));
+        }
+
+        /// Generic function for generating a range of rows of mipmap data.
+        /// @param sourceWidth    [in] The width of the source mipmap.
+        /// @param sourceHeight   [in] The height of the source mipmap.
+        /// @param componentCount [in] The number of components in each texel.
+        /// @param sourceData     [in] A pointer to the source mipmaps image data.
+        /// @param destData       [in] A pointer to the destination buffer. This must be preallocated.
+        /// @param firstRow       [in] The index of the first destination row to generate.
+        /// @param endRow         [in] The index of the destination row after the last one to generate.
+        ///
+        /// @remarks
+        ///     This is the same as Generate<T>(), except that only the given rows are written. Different ranges of rows can be generated
+        ///     on different threads at the same time.
+        template <typename T>
+        static void GenerateRows(unsigned int sourceWidth, unsigned int sourceHeight, unsigned int componentCount, const void* sourceData, void* destData, unsigned int firstRow, unsigned int endRow)
         {
             unsigned int destWidth  = ImageUtils::CalculateMipmapWidth(1, sourceWidth);
-            unsigned int destHeight = ImageUtils::CalculateMipmapHeight(1, sourceHeight);
 
-            for (unsigned int iRow = 0; iRow < destHeight; ++iRow)
+            for (unsigned int iRow = firstRow; iRow < endRow; ++iRow)
             {
-                unsigned int y = iRow << 1;
+                // Sources that are a single texel high or wide reuse the last row or column rather than reading past the end.
+                unsigned int y0 = iRow << 1;
+                unsigned int y1 = Min(y0 + 1, sourceHeight - 1);
 
                 for (unsigned int iCol = 0; iCol < destWidth; ++iCol)
                 {
-                    unsigned int x = iCol << 1;
+                    unsigned int x0 = iCol << 1;
+                    unsigned int x1 = Min(x0 + 1, sourceWidth - 1);
 				    
                     for (unsigned int iComp = 0; iComp < componentCount; ++iComp)
                     {
-                        unsigned int texel00 = (((y + 0) * sourceWidth) + (x + 0)) * componentCount + iComp;
-				        unsigned int texel01 = (((y + 1) * sourceWidth) + (x + 0)) * componentCount + iComp;
-				        unsigned int texel11 = (((y + 1) * sourceWidth) + (x + 1)) * componentCount + iComp;
-				        unsigned int texel10 = (((y + 0) * sourceWidth) + (x + 1)) * componentCount + iComp;
+                        unsigned int texel00 = ((y0 * sourceWidth) + x0) * componentCount + iComp;
+				        unsigned int texel01 = ((y1 * sourceWidth) + x0) * componentCount + iComp;
+				        unsigned int texel11 = ((y1 * sourceWidth) + x1) * componentCount + iComp;
+				        unsigned int texel10 = ((y0 * sourceWidth) + x1) * componentCount + iComp;
 
                         T data00 = reinterpret_cast<const T*>(sourceData)[texel00];
                         T data01 = reinterpret_cast<const T*>(sourceData)[texel01];
@@ -0,0 +1,59 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#ifndef GT_StringID
+#define GT_StringID
+
+#include <cstdint>
+#include <cstddef>
+
+namespace GT
+{
+    /// A stable 32-bit ID for a string that has been interned into the global string table.
+    ///
+    /// Interning the same string always returns the same ID for the lifetime of the program, so IDs can be compared directly instead
+    /// of comparing strings. Hot paths should intern their names once up front and then use the ID from then on.
+    typedef uint32_t StringID;
+
+    /// The ID that is never given to a string.
+    static const StringID InvalidStringID = 0;
+
+
+    /// Interns the given string, returning it's ID.
+    ///
+    /// @param str       [in] The string to intern.
+    /// @param strLength [in] The length of the string in chars, or -1 if it is null terminated.
+    ///
+    /// @return The ID of the string, or InvalidStringID if memory could not be allocated.
+    ///
+    /// @remarks
+    ///     This is thread-safe.
+    StringID InternString(const char* str, ptrdiff_t strLength = -1);
+
+    /// Retrieves the ID of a string that has already been interned, without interning it.
+    ///
+    /// @return The ID of the string, or InvalidStringID if the string has not been interned.
+    StringID FindStringID(const char* str, ptrdiff_t strLength = -1);
+
+    /// Retrieves the null terminated string of the given ID.
+    ///
+    /// @return The string, or null if the ID is invalid. The pointer remains valid for the lifetime of the program.
+    ///
+    /// @remarks
+    ///     This does not take a lock, and is safe to call while other threads are interning strings.
+    const char* GetInternedString(StringID id);
+
+    /// Retrieves the length of the string of the given ID, in chars.
+    ///
+    /// @remarks
+    ///     This does not take a lock, and is safe to call while other threads are interning strings.
+    size_t GetInternedStringLength(StringID id);
+
+    /// Retrieves the hash of the string of the given ID. This is the same value as GT::Hash() for the string, which is also what
+    /// Dictionary uses for it's keys.
+    ///
+    /// @remarks
+    ///     This does not take a lock, and is safe to call while other threads are interning strings.
+    uint32_t GetInternedStringHash(StringID id);
+}
+
+#endif
@@ -0,0 +1,134 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#ifndef GT_ThreadPool
+#define GT_ThreadPool
+
+namespace GT
+{
+    /// The function signature for jobs that are executed by a thread pool.
+    ///
+    /// @param jobIndex    [in] The index of the job being executed. This will be in the range of [0, jobCount).
+    /// @param threadIndex [in] The index of the thread executing the job. This will be in the range of [0, ThreadPool::GetThreadCount()).
+    /// @param pUserData   [in] The user data pointer that was passed to ThreadPool::Run().
+    typedef void (* ThreadPoolJobProc)(size_t jobIndex, size_t threadIndex, void* pUserData);
+
+
+    /// Class representing a pool of worker threads for executing jobs in parallel.
+    ///
+    /// Work is submitted as a batch of jobs with Run(). The calling thread participates in the batch as thread 0 and does not return
+    /// until every job in the batch has finished. The worker threads are numbered from 1. Jobs are handed out dynamically, so a job
+    /// should represent a reasonably sized chunk of work (a range of scene nodes, a range of vertices, etc.) rather than a single item.
+    ///
+    /// The thread index passed to each job can be used to index into per-thread buffers without any locking. Use GetThreadCount() to
+    /// size those buffers.
+    ///
+    /// Run() is thread-safe. Only one batch is distributed across the worker threads at a time. If Run() is called while another batch
+    /// is in progress, including from inside a job, the new batch is run entirely on the calling thread.
+    class ThreadPool
+    {
+    public:
+
+        /// Constructor.
+        ThreadPool();
+
+        /// Destructor.
+        ~ThreadPool();
+
+
+        /// Starts up the thread pool.
+        ///
+        /// @param workerThreadCount [in] The number of worker threads to create, not including the calling thread.
+        ///
+        /// @return True if the thread pool is started up successfully; false otherwise.
+        ///
+        /// @remarks
+        ///     A worker thread count of 0 is valid, in which case every job will be run on the calling thread.
+        bool Startup(unsigned int workerThreadCount);
+
+        /// Shuts down the thread pool, waiting for every worker thread to terminate.
+        void Shutdown();
+
+
+        /// Retrieves the number of worker threads, not including the calling thread.
+        unsigned int GetWorkerThreadCount() const { return m_workerThreadCount; }
+
+        /// Retrieves the number of threads that will participate in a batch, including the calling thread.
+        unsigned int GetThreadCount() const { return m_workerThreadCount + 1; }
+
+
+        /// Runs a batch of jobs and waits for them to complete.
+        ///
+        /// @param jobCount  [in] The number of jobs to run.
+        /// @param jobProc   [in] The function to call for each job.
+        /// @param pUserData [in] A pointer to application-defined data that is passed to each job.
+        void Run(size_t jobCount, ThreadPoolJobProc jobProc, void* pUserData);
+
+
+
+    private:
+
+        /// Runs jobs from the current batch until there are none remaining.
+        void ProcessJobs(size_t threadIndex);
+
+        /// The entry point for each worker thread.
+        static int WorkerThreadProc(void* pData);
+
+
+        /// Structure containing the data passed to each worker thread.
+        struct WorkerThread
+        {
+            /// A pointer to the thread pool that owns the worker.
+            ThreadPool* pThreadPool;
+
+            /// The index of the thread. This is never 0 for worker threads.
+            size_t threadIndex;
+
+            /// The thread handle.
+            dr_thread thread;
+        };
+
+
+        /// The worker threads.
+        WorkerThread* m_pWorkerThreads;
+
+        /// The number of worker threads.
+        unsigned int m_workerThreadCount;
+
+
+        /// The semaphore that worker threads wait on for new batches.
+        dr_semaphore m_wakeSemaphore;
+
+        /// The semaphore that worker threads release when they have finished with a batch.
+        dr_semaphore m_doneSemaphore;
+
+        /// The mutex for handing out job indices and claiming the worker threads for a batch.
+        dr_mutex m_jobLock;
+
+        /// Whether or not a batch is currently being distributed across the worker threads.
+        bool m_isBatchActive;
+
+
+        /// The function to call for each job in the current batch.
+        ThreadPoolJobProc m_jobProc;
+
+        /// The user data for the current batch.
+        void* m_pJobUserData;
+
+        /// The number of jobs in the current batch.
+        size_t m_jobCount;
+
+        /// The index of the next job to hand out.
+        size_t m_nextJobIndex;
+
+
+        /// Whether or not the worker threads should terminate.
+        bool m_isTerminating;
+
+
+    private:    // No copying.
+        ThreadPool(const ThreadPool &);
+        ThreadPool & operator=(const ThreadPool &);
+    };
+}
+
+#endif
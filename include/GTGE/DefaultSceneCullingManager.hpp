@@ -9,6 +9,7 @@
 #include "CollisionGroups.hpp"
 #include "SceneNode.hpp"
 #include "AlignedType.hpp"
+#include <GTGE/Core/HashMap.hpp>
 
 #if defined(_MSC_VER)
     #pragma warning(push)
@@ -136,6 +137,15 @@ namespace GT
         /// SceneCullingManager::QuerySpotLightContacts().
         virtual void QuerySpotLightContacts(const SceneNode &light, VisibilityCallback &callback) const;
 
+        /// SceneCullingManager::IsLightContactQueryThreadSafe().
+        virtual bool IsLightContactQueryThreadSafe() const;
+
+        /// SceneCullingManager::QueryPointLightContactsConcurrent().
+        virtual void QueryPointLightContactsConcurrent(const SceneNode &light, VisibilityCallback &callback) const;
+
+        /// SceneCullingManager::QuerySpotLightContactsConcurrent().
+        virtual void QuerySpotLightContactsConcurrent(const SceneNode &light, VisibilityCallback &callback) const;
+
 
 
         /// Processes the model of the given object.
@@ -183,17 +193,25 @@ namespace GT
         struct CullingObject;
 
 
+        /// Passes every model and particle system touching the given light to the callback without going through Bullet's dispatcher.
+        ///
+        /// @remarks
+        ///     This only reads from the world, so it can be called from multiple threads at the same time. It is used by the concurrent
+        ///     queries. The serial queries use a contact test.
+        void QueryLightContactsConcurrent(const CullingObject &light, VisibilityCallback &callback) const;
+
+
         /// The collision world containing collision objects for everything needing culling.
         CollisionWorld m_world;
 
         /// A container for mapping metadata for models to scene nodes.
-        Map<const SceneNode*, CullingObject*> models;
+        HashMap<const SceneNode*, CullingObject*> models;
 
         /// A container for mapping metadata for point lights to scene nodes.
-        Map<const SceneNode*, CullingObject*> pointLights;
+        HashMap<const SceneNode*, CullingObject*> pointLights;
 
         /// A container for mapping metadata for spot lights to scene nodes.
-        Map<const SceneNode*, CullingObject*> spotLights;
+        HashMap<const SceneNode*, CullingObject*> spotLights;
 
         /// The ambient light objects.
         Vector<const SceneNode*> ambientLights;
@@ -202,7 +220,7 @@ namespace GT
         Vector<const SceneNode*> directionalLights;
 
         /// The particle system objects.
-        Map<const SceneNode*, CullingObject*> particleSystems;
+        HashMap<const SceneNode*, CullingObject*> particleSystems;
 
 
 
@@ -862,6 +880,40 @@ namespace GT
             LightContactTestCallback(const LightContactTestCallback &);
             LightContactTestCallback & operator=(const LightContactTestCallback &);
         };
+
+
+        /// Broadphase callback for finding the models and particle systems touching a light from multiple threads at the same time.
+        ///
+        /// Each candidate from the broadphase is tested against the light's shape directly with GJK rather than going through Bullet's
+        /// dispatcher, which allocates collision algorithms from a shared pool. The same contact breaking threshold as a contact test is
+        /// used, so this finds the same contacts as LightContactTestCallback.
+        class LightContactAabbCallback : public btBroadphaseAabbCallback
+        {
+        public:
+
+            /// Constructor.
+            LightContactAabbCallback(const CullingObject &lightIn, VisibilityCallback &callbackIn)
+                : light(lightIn), callback(callbackIn)
+            {
+            }
+
+
+            /// btBroadphaseAabbCallback::process().
+            bool process(const btBroadphaseProxy* proxy);
+
+
+            /// The culling object of the light.
+            const CullingObject &light;
+
+            /// The callback to pass each contact to.
+            VisibilityCallback &callback;
+
+
+
+        private:    // No copying.
+            LightContactAabbCallback(const LightContactAabbCallback &);
+            LightContactAabbCallback & operator=(const LightContactAabbCallback &);
+        };
     };
 }
 
@@ -484,6 +484,42 @@ namespace GT
         bool IsBloomEnabled() const;
 
 
+        /// Enables reusing the index buffers of particle emitters when the particle count hasn't grown.
+        ///
+        /// @remarks
+        ///     The indices of particle quads never change, so they only need to be regenerated when the index buffer grows. This is
+        ///     enabled by default.
+        void EnableParticleIndexReuse();
+
+        /// Disables reusing the index buffers of particle emitters. The indices will be regenerated every frame.
+        void DisableParticleIndexReuse();
+
+        /// Determines whether or not the index buffers of particle emitters are reused.
+        bool IsParticleIndexReuseEnabled() const;
+
+
+        /// Enables querying the models touched by point and spot lights across the context's thread pool.
+        ///
+        /// @remarks
+        ///     This only has an effect when the scene's culling manager supports it (SceneCullingManager::IsLightContactQueryThreadSafe())
+        ///     and there are enough lights to make it worthwhile. The results are the same as the serial path. This is enabled by default.
+        void EnableParallelLightContactQueries();
+
+        /// Disables querying light contacts in parallel. The lights will be queried one after another.
+        void DisableParallelLightContactQueries();
+
+        /// Determines whether or not light contacts are queried in parallel.
+        bool IsParallelLightContactQueriesEnabled() const;
+
+
+        /// Retrieves the allocator for the per-frame visibility data.
+        ///
+        /// @remarks
+        ///     The allocator is reset in End(), so use GetLastFrameAllocationCount() and GetLastFrameAllocatedBytes() to see how much
+        ///     memory the most recent frame needed.
+        const FrameAllocator & GetFrameAllocator() const { return m_frameAllocator; }
+
+
         /// Sets the HDR exposure.
         void SetHDRExposure(float newExposure);
 
@@ -632,6 +668,14 @@ namespace GT
         Map<const MaterialDefinition*, DefaultSceneRenderer_MaterialShaders*> m_materialShaders;
 
 
+        /// The allocator for the meshes and light groups created by the visibility processors. This is reset in End().
+        FrameAllocator m_frameAllocator;
+
+        /// The mesh lists that are used for the material buckets of the visibility processors. These are recycled between frames
+        /// so their buffers don't need to be reallocated.
+        Vector<Vector<DefaultSceneRendererMesh>*> m_meshListPool;
+
+
         /// The shader to use with the depth pre-pass.
         Shader* depthPassShader;
 
@@ -699,6 +743,12 @@ namespace GT
         /// Keeps track of whether or not bloom is enabled.
         bool isBloomEnabled;
 
+        /// Keeps track of whether or not particle index buffers are reused.
+        bool isParticleIndexReuseEnabled;
+
+        /// Keeps track of whether or not light contacts are queried in parallel.
+        bool isParallelLightContactQueriesEnabled;
+
         /// Keeps track of the HDR exposure.
         float hdrExposure;
 
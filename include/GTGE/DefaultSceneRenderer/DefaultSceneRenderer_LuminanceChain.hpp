@@ -4,6 +4,7 @@
 #define GT_DefaultSceneRenderer_LuminanceChain
 
 #include <GTGE/Core/Vector.hpp>
+#include <GTGE/Core/StringID.hpp>
 
 namespace GT
 {
@@ -87,6 +88,10 @@ namespace GT
         /// The base height that was used when the chain was last initialized.
         unsigned int m_baseHeight;
 
+        /// The interned names of the uniforms that are set on each link in the chain.
+        StringID m_inputTextureNameID;
+        StringID m_exposureNameID;
+
 
     private:    // No copying.
         DefaultSceneRenderer_LuminanceChain(const DefaultSceneRenderer_LuminanceChain &);
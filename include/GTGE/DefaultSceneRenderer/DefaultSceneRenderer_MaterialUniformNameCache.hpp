@@ -5,6 +5,7 @@
 
 #include <GTGE/Core/Vector.hpp>
 #include <GTGE/Core/String.hpp>
+#include <GTGE/Core/StringID.hpp>
 
 namespace GT
 {
@@ -63,11 +64,31 @@ namespace GT
         MaterialUniform_LightNamesStart = MaterialUniform_AmbientLightFS_Colour,
     };
 
+    /// Enumerator representing the names of the uniforms the renderer sets for every mesh or pass, other than the light uniforms.
+    enum RendererUniformNameID
+    {
+        RendererUniform_PVMMatrix = 0,
+        RendererUniform_ModelMatrix,
+        RendererUniform_ViewModelMatrix,
+        RendererUniform_NormalMatrix,
+        RendererUniform_DiffuseLighting,
+        RendererUniform_SpecularLighting,
+        RendererUniform_BackgroundTexture,
+        RendererUniform_ColourBuffer,
+        RendererUniform_LuminanceBuffer,
+        RendererUniform_BloomBuffer,
+        RendererUniform_BloomFactor,
+        RendererUniform_Texture,
+        RendererUniform_TextureSizeReciprocal,
+
+        RendererUniform_NamesCount
+    };
+
 
-    /// Class for caching string representing the names of uniform variables used by materials.
+    /// Class for caching the interned names of uniform variables used by materials.
     ///
     /// We need this class because it is too slow to keep constructing the strings with printf() or similar. What this allows instead
-    /// is to construct the strings once, and then quickly retrieve them later on.
+    /// is to construct and intern the strings once, and then quickly retrieve their IDs later on.
     class DefaultSceneRenderer_MaterialUniformNameCache
     {
     public:
@@ -81,55 +102,62 @@ namespace GT
                 names.Resize(MaterialUniform_LightNamesCount);
 
                 // Ambient.
-                names[MaterialUniform_AmbientLightFS_Colour]                   = String::CreateFormatted("AmbientLightFS%d.ColorF",                   index);
+                names[MaterialUniform_AmbientLightFS_Colour]                   = InternName("AmbientLightFS%d.ColorF",                   index);
 
                 // Directional.
-                names[MaterialUniform_DirectionalLightFS_Colour]               = String::CreateFormatted("DirectionalLightFS%d.ColorF",               index);
-                names[MaterialUniform_DirectionalLightFS_Direction]            = String::CreateFormatted("DirectionalLightFS%d.Direction",            index);
+                names[MaterialUniform_DirectionalLightFS_Colour]               = InternName("DirectionalLightFS%d.ColorF",               index);
+                names[MaterialUniform_DirectionalLightFS_Direction]            = InternName("DirectionalLightFS%d.Direction",            index);
 
                 // Point.
-                names[MaterialUniform_PointLightVS_PositionVS]                 = String::CreateFormatted("PointLightVS%d.PositionVS",                 index);
-                names[MaterialUniform_PointLightFS_Colour]                     = String::CreateFormatted("PointLightFS%d.ColorF",                     index);
-                names[MaterialUniform_PointLightFS_Radius]                     = String::CreateFormatted("PointLightFS%d.Radius",                     index);
-                names[MaterialUniform_PointLightFS_Falloff]                    = String::CreateFormatted("PointLightFS%d.Falloff",                    index);
+                names[MaterialUniform_PointLightVS_PositionVS]                 = InternName("PointLightVS%d.PositionVS",                 index);
+                names[MaterialUniform_PointLightFS_Colour]                     = InternName("PointLightFS%d.ColorF",                     index);
+                names[MaterialUniform_PointLightFS_Radius]                     = InternName("PointLightFS%d.Radius",                     index);
+                names[MaterialUniform_PointLightFS_Falloff]                    = InternName("PointLightFS%d.Falloff",                    index);
 
                 // Spot.
-                names[MaterialUniform_SpotLightFS_Position]                    = String::CreateFormatted("SpotLightFS%d.Position",                    index);
-                names[MaterialUniform_SpotLightFS_Colour]                      = String::CreateFormatted("SpotLightFS%d.ColorF",                      index);
-                names[MaterialUniform_SpotLightFS_Direction]                   = String::CreateFormatted("SpotLightFS%d.Direction",                   index);
-                names[MaterialUniform_SpotLightFS_Length]                      = String::CreateFormatted("SpotLightFS%d.Length",                      index);
-                names[MaterialUniform_SpotLightFS_Falloff]                     = String::CreateFormatted("SpotLightFS%d.Falloff",                     index);
-                names[MaterialUniform_SpotLightFS_CosAngleInner]               = String::CreateFormatted("SpotLightFS%d.CosAngleInner",               index);
-                names[MaterialUniform_SpotLightFS_CosAngleOuter]               = String::CreateFormatted("SpotLightFS%d.CosAngleOuter",               index);
+                names[MaterialUniform_SpotLightFS_Position]                    = InternName("SpotLightFS%d.Position",                    index);
+                names[MaterialUniform_SpotLightFS_Colour]                      = InternName("SpotLightFS%d.ColorF",                      index);
+                names[MaterialUniform_SpotLightFS_Direction]                   = InternName("SpotLightFS%d.Direction",                   index);
+                names[MaterialUniform_SpotLightFS_Length]                      = InternName("SpotLightFS%d.Length",                      index);
+                names[MaterialUniform_SpotLightFS_Falloff]                     = InternName("SpotLightFS%d.Falloff",                     index);
+                names[MaterialUniform_SpotLightFS_CosAngleInner]               = InternName("SpotLightFS%d.CosAngleInner",               index);
+                names[MaterialUniform_SpotLightFS_CosAngleOuter]               = InternName("SpotLightFS%d.CosAngleOuter",               index);
 
                 // Shadow Directional.
-                names[MaterialUniform_ShadowDirectionalLightVS_ProjectionView] = String::CreateFormatted("ShadowDirectionalLightVS%d.ProjectionView", index);
-                names[MaterialUniform_ShaderDirectionalLightFS_Colour]         = String::CreateFormatted("ShadowDirectionalLightFS%d.ColorF",         index);
-                names[MaterialUniform_ShaderDirectionalLightFS_Direction]      = String::CreateFormatted("ShadowDirectionalLightFS%d.Direction",      index);
-                names[MaterialUniform_ShaderDirectionalLightFS_ShadowMap]      = String::CreateFormatted("ShadowDirectionalLightFS%d_ShadowMap",      index);
+                names[MaterialUniform_ShadowDirectionalLightVS_ProjectionView] = InternName("ShadowDirectionalLightVS%d.ProjectionView", index);
+                names[MaterialUniform_ShaderDirectionalLightFS_Colour]         = InternName("ShadowDirectionalLightFS%d.ColorF",         index);
+                names[MaterialUniform_ShaderDirectionalLightFS_Direction]      = InternName("ShadowDirectionalLightFS%d.Direction",      index);
+                names[MaterialUniform_ShaderDirectionalLightFS_ShadowMap]      = InternName("ShadowDirectionalLightFS%d_ShadowMap",      index);
 
                 // Shadow Point.
-                names[MaterialUniform_ShadowPointLightFS_PositionVS]           = String::CreateFormatted("ShadowPointLightVS%d.PositionVS",           index);
-                names[MaterialUniform_ShadowPointLightFS_PositionWS]           = String::CreateFormatted("ShadowPointLightVS%d.PositionWS",           index);
-                names[MaterialUniform_ShadowPointLightFS_Colour]               = String::CreateFormatted("ShadowPointLightFS%d.ColorF",               index);
-                names[MaterialUniform_ShadowPointLightFS_Radius]               = String::CreateFormatted("ShadowPointLightFS%d.Radius",               index);
-                names[MaterialUniform_ShadowPointLightFS_Falloff]              = String::CreateFormatted("ShadowPointLightFS%d.Falloff",              index);
-                names[MaterialUniform_ShadowPointLightFS_ShadowMap]            = String::CreateFormatted("ShadowPointLightFS%d_ShadowMap",            index);
+                names[MaterialUniform_ShadowPointLightFS_PositionVS]           = InternName("ShadowPointLightVS%d.PositionVS",           index);
+                names[MaterialUniform_ShadowPointLightFS_PositionWS]           = InternName("ShadowPointLightVS%d.PositionWS",           index);
+                names[MaterialUniform_ShadowPointLightFS_Colour]               = InternName("ShadowPointLightFS%d.ColorF",               index);
+                names[MaterialUniform_ShadowPointLightFS_Radius]               = InternName("ShadowPointLightFS%d.Radius",               index);
+                names[MaterialUniform_ShadowPointLightFS_Falloff]              = InternName("ShadowPointLightFS%d.Falloff",              index);
+                names[MaterialUniform_ShadowPointLightFS_ShadowMap]            = InternName("ShadowPointLightFS%d_ShadowMap",            index);
 
                 // Shadow Spot.
-                names[MaterialUniforms_ShadowSpotLightVS_ProjectionView]       = String::CreateFormatted("ShadowSpotLightVS%d.ProjectionView",        index);
-                names[MaterialUniforms_ShadowSpotLightFS_Position]             = String::CreateFormatted("ShadowSpotLightFS%d.Position",              index);
-                names[MaterialUniforms_ShadowSpotLightFS_Colour]               = String::CreateFormatted("ShadowSpotLightFS%d.ColorF",                index);
-                names[MaterialUniforms_ShadowSpotLightFS_Direction]            = String::CreateFormatted("ShadowSpotLightFS%d.Direction",             index);
-                names[MaterialUniforms_ShadowSpotLightFS_Length]               = String::CreateFormatted("ShadowSpotLightFS%d.Length",                index);
-                names[MaterialUniforms_ShadowSpotLightFS_Falloff]              = String::CreateFormatted("ShadowSpotLightFS%d.Falloff",               index);
-                names[MaterialUniforms_ShadowSpotLightFS_CosAngleInner]        = String::CreateFormatted("ShadowSpotLightFS%d.CosAngleInner",         index);
-                names[MaterialUniforms_ShadowSpotLightFS_CosAngleOuter]        = String::CreateFormatted("ShadowSpotLightFS%d.CosAngleOuter",         index);
-                names[MaterialUniforms_ShadowSpotLightFS_ShadowMap]            = String::CreateFormatted("ShadowSpotLightFS%d_ShadowMap",             index);
+                names[MaterialUniforms_ShadowSpotLightVS_ProjectionView]       = InternName("ShadowSpotLightVS%d.ProjectionView",        index);
+                names[MaterialUniforms_ShadowSpotLightFS_Position]             = InternName("ShadowSpotLightFS%d.Position",              index);
+                names[MaterialUniforms_ShadowSpotLightFS_Colour]               = InternName("ShadowSpotLightFS%d.ColorF",                index);
+                names[MaterialUniforms_ShadowSpotLightFS_Direction]            = InternName("ShadowSpotLightFS%d.Direction",             index);
+                names[MaterialUniforms_ShadowSpotLightFS_Length]               = InternName("ShadowSpotLightFS%d.Length",                index);
+                names[MaterialUniforms_ShadowSpotLightFS_Falloff]              = InternName("ShadowSpotLightFS%d.Falloff",               index);
+                names[MaterialUniforms_ShadowSpotLightFS_CosAngleInner]        = InternName("ShadowSpotLightFS%d.CosAngleInner",         index);
+                names[MaterialUniforms_ShadowSpotLightFS_CosAngleOuter]        = InternName("ShadowSpotLightFS%d.CosAngleOuter",         index);
+                names[MaterialUniforms_ShadowSpotLightFS_ShadowMap]            = InternName("ShadowSpotLightFS%d_ShadowMap",             index);
+            }
+
+            /// Formats the name of a uniform for the given light index and interns it.
+            static StringID InternName(const char* format, int index)
+            {
+                return InternString(String::CreateFormatted(format, index).c_str());
             }
 
-            /// The list of names for the light index.
-            Vector<String> names;
+
+            /// The list of interned names for the light index.
+            Vector<StringID> names;
         };
 
 
@@ -140,17 +168,25 @@ namespace GT
         DefaultSceneRenderer_MaterialUniformNameCache();
 
 
-        /// Retrieves the name of a light uniform.
+        /// Retrieves the interned name of a light uniform.
         ///
         /// @param nameClass [in] The identifier of the name to retrieve.
         /// @param index     [in] The index of the light whose uniform is being retrieved.
-        const char* GetLightUniformName(MaterialUniformNameID nameID, int index);
+        StringID GetLightUniformName(MaterialUniformNameID nameID, int index);
+
+        /// Retrieves the interned name of one of the uniforms the renderer sets for every mesh or pass.
+        ///
+        /// @param nameID [in] The identifier of the name to retrieve.
+        StringID GetUniformName(RendererUniformNameID nameID) const { return this->uniformNames[nameID]; }
 
 
     private:
 
         /// The caches for light uniforms.
         Vector<LightIndexUniformNames> lightUniforms;
+
+        /// The interned names of the uniforms that are not specific to a light, indexed by RendererUniformNameID.
+        StringID uniformNames[RendererUniform_NamesCount];
     };
 }
 
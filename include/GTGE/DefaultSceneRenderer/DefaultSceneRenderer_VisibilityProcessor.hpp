@@ -5,6 +5,8 @@
 
 #include "DefaultSceneRenderer_Mesh.hpp"
 #include "DefaultSceneRenderer_LightManager.hpp"
+#include <GTGE/Core/FrameAllocator.hpp>
+#include <GTGE/Core/HashMap.hpp>
 
 namespace GT
 {
@@ -14,7 +16,17 @@ namespace GT
     public:
 
         /// Constructor.
-        DefaultSceneRenderer_VisibilityProcessor(Scene &scene, SceneViewport &viewport);
+        ///
+        /// @param scene          [in] The scene whose visible objects are being processed.
+        /// @param viewport       [in] The viewport the objects are visible from.
+        /// @param frameAllocator [in] The allocator the per-mesh and per-model data is allocated from.
+        /// @param meshListPool   [in] The pool the material buckets of opaqueObjects and opaqueObjectsLast are taken from.
+        ///
+        /// @remarks
+        ///     The frame allocator needs to stay alive until it is reset at the end of the frame, which must be after this object has
+        ///     been destructed. The mesh lists are cleared and returned to the pool by the destructor so their buffers can be reused
+        ///     by the next frame.
+        DefaultSceneRenderer_VisibilityProcessor(Scene &scene, SceneViewport &viewport, FrameAllocator &frameAllocator, Vector<Vector<DefaultSceneRendererMesh>*> &meshListPool);
 
         /// Destructor.
         virtual ~DefaultSceneRenderer_VisibilityProcessor();
@@ -50,6 +62,9 @@ namespace GT
         /// Performs an optimization step that arranges everything in a way where the renderer can be a bit more efficient.
         void PostProcess();
 
+        /// Retrieves the number of meshes that have been added to the opaque and transparent lists.
+        size_t GetMeshCount() const;
+
 
 
         //////////////////////////////////////
@@ -79,19 +94,19 @@ namespace GT
 
 
         /// A map structure for mapping a model's Mesh to a scene renderer mesh.
-        Map<const Mesh*, DefaultSceneRendererMesh*> visibleMeshes;
+        HashMap<const Mesh*, DefaultSceneRendererMesh*> visibleMeshes;
 
 
         /// The flat list of visible models, mapped to the indices of the lights that touch them. We want to store pointers to the component and
         /// not the actual model object because we will later want access to the scene node for it's transformation.
-        Map<const ModelComponent*, DefaultSceneRenderer_LightGroup*> visibleModels;
+        HashMap<const ModelComponent*, DefaultSceneRenderer_LightGroup*> visibleModels;
 
         /// The list of meshes whose skinning needs to be applied. The skinning will be applied in PostProcess().
         Vector<const ModelComponent*> modelsToAnimate;
 
 
         /// The flat list of visible particle systems, mapped to the indices of the lights that touch them.
-        Map<const ParticleSystemComponent*, DefaultSceneRenderer_LightGroup*> visibleParticleSystems;
+        HashMap<const ParticleSystemComponent*, DefaultSceneRenderer_LightGroup*> visibleParticleSystems;
 
 
 
@@ -109,6 +124,40 @@ namespace GT
         glm::mat4 projectionViewMatrix;
 
 
+        /// Whether or not the index buffers of particle emitters are left alone when they already contain enough quads. Defaults to true.
+        bool reuseParticleIndices;
+
+        /// Whether or not the light contact queries in PostProcess() are spread across the context's thread pool. Defaults to true.
+        bool parallelLightContacts;
+
+
+
+    private:
+
+        /// Retrieves an empty mesh list from the pool, or creates a new one if the pool is empty.
+        Vector<DefaultSceneRendererMesh>* AcquireMeshList();
+
+
+        /// Finds the models and particle systems touched by each point and spot light, one light after another.
+        void QueryLightContactsSerial();
+
+        /// Finds the models and particle systems touched by each point and spot light across the context's thread pool.
+        ///
+        /// @remarks
+        ///     Each thread records it's contacts into it's own buffer. The buffers are then merged in light order, so the light groups
+        ///     end up in the same order as with QueryLightContactsSerial(). The lights are queried with the culling manager's concurrent
+        ///     queries.
+        void QueryLightContactsParallel();
+
+
+        /// The allocator for the light groups and meshes. Everything allocated from this is released when the renderer resets it at
+        /// the end of the frame.
+        FrameAllocator &frameAllocator;
+
+        /// The pool of mesh lists for the material buckets.
+        Vector<Vector<DefaultSceneRendererMesh>*> &meshListPool;
+
+
 
     private:
 
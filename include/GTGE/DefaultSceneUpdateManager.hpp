@@ -7,6 +7,7 @@
 #include "SceneNode.hpp"
 #include "Physics/DynamicsWorld.hpp"
 #include <GTGE/Core/Vector.hpp>
+#include <GTGE/Core/ThreadPool.hpp>
 
 namespace GT
 {
@@ -37,6 +38,68 @@ namespace GT
         virtual void Step(double deltaTimeInSeconds, SceneCullingManager &cullingManager);
 
 
+        /// Enables parallel updating.
+        ///
+        /// @param threadPool [in] A reference to the thread pool to distribute the work across.
+        ///
+        /// @remarks
+        ///     When parallel updating is enabled, Step() is split into two phases. The first phase runs StepSceneNodeConcurrent() for each
+        ///     scene node across the thread pool. The second phase runs StepSceneNodeSynchronous() for each scene node on the calling thread,
+        ///     in the same order as the serial path. Work that is not thread-safe, such as culling updates and script events, belongs in the
+        ///     second phase.
+        ///     @par
+        ///     StepSceneNode() is not called when parallel updating is enabled. Sub-classes that override StepSceneNode() should also
+        ///     override the two phases before enabling this.
+        void EnableParallelUpdate(ThreadPool &threadPool);
+
+        /// Disables parallel updating.
+        void DisableParallelUpdate();
+
+        /// Determines whether or not parallel updating is enabled.
+        bool IsParallelUpdateEnabled() const { return m_pThreadPool != nullptr; }
+
+        /// Sets the number of scene nodes to group into a single job when updating in parallel.
+        ///
+        /// @remarks
+        ///     Steps with fewer scene nodes than this are always done serially. The default is 64.
+        void SetParallelUpdateBatchSize(size_t batchSize);
+
+        /// Retrieves the number of scene nodes that are grouped into a single job when updating in parallel.
+        size_t GetParallelUpdateBatchSize() const { return m_parallelUpdateBatchSize; }
+
+
+        /// Enables animation LOD.
+        ///
+        /// @remarks
+        ///     When animation LOD is enabled, the animation of a model is stepped based on how the renderer saw it in the previous frame.
+        ///     Models that were seen within the LOD distance are stepped every frame. Models that were seen further away are stepped
+        ///     at a reduced rate, with the skipped time added to the next step. Models that were not seen at all only have their
+        ///     playback time advanced, and the renderer catches up their skeleton and skinning the next time it sees them. The AABB of
+        ///     a model that is not seen is still refreshed at a low rate so the culling manager can tell when it comes into view.
+        ///     @par
+        ///     The models that are not evaluated each frame are spread across frames by their scene node's ID so the work stays even.
+        void EnableAnimationLOD();
+
+        /// Disables animation LOD.
+        void DisableAnimationLOD();
+
+        /// Determines whether or not animation LOD is enabled.
+        bool IsAnimationLODEnabled() const { return m_isAnimationLODEnabled; }
+
+        /// Sets the distance from the camera beyond which a model is stepped at a reduced rate. The default is 50.
+        void SetAnimationLODDistance(float distance);
+
+        /// Retrieves the distance from the camera beyond which a model is stepped at a reduced rate.
+        float GetAnimationLODDistance() const { return m_animationLODDistance; }
+
+        /// Sets how often the animations of distant and unseen models are evaluated.
+        ///
+        /// @param distantInterval [in] The number of frames between steps of a model beyond the LOD distance. The default is 4.
+        /// @param hiddenInterval  [in] The number of frames between AABB refreshes of a model that was not seen. The default is 10. Set
+        ///                             this to 0 to never refresh it.
+        void SetAnimationLODIntervals(uint32_t distantInterval, uint32_t hiddenInterval);
+
+
     protected:
 
         /// Steps a scene node.
@@ -48,12 +111,118 @@ namespace GT
         ///     This is called from Step().
         virtual void StepSceneNode(SceneNode &node, double deltaTimeInSeconds, SceneCullingManager &cullingManager);
 
+        /// Performs the thread-safe part of stepping a scene node when parallel updating is enabled.
+        ///
+        /// @param node               [in] The scene node being updated.
+        /// @param deltaTimeInSeconds [in] The delta time (time since the last step).
+        ///
+        /// @return A combination of the StepResult flags describing what was stepped.
+        ///
+        /// @remarks
+        ///     This is called from a worker thread. It must only touch state that is owned by the scene node itself, such as animation
+        ///     and particles. It must not touch the culling manager or the scripting environment.
+        virtual uint32_t StepSceneNodeConcurrent(SceneNode &node, double deltaTimeInSeconds);
+
+        /// Performs the non-thread-safe part of stepping a scene node when parallel updating is enabled.
+        ///
+        /// @param node               [in] The scene node being updated.
+        /// @param deltaTimeInSeconds [in] The delta time (time since the last step).
+        /// @param stepResult         [in] The flags that were returned by StepSceneNodeConcurrent() for this scene node.
+        ///
+        /// @remarks
+        ///     This is called from the thread that called Step(), after every scene node has been through StepSceneNodeConcurrent().
+        virtual void StepSceneNodeSynchronous(SceneNode &node, double deltaTimeInSeconds, SceneCullingManager &cullingManager, uint32_t stepResult);
+
+        /// Steps the animation of a model, taking animation LOD into account.
+        ///
+        /// @param node               [in] The scene node that owns the model.
+        /// @param model              [in] The model being stepped.
+        /// @param deltaTimeInSeconds [in] The delta time (time since the last step).
+        ///
+        /// @return True if the skeleton was evaluated, in which case the culling manager needs to be given the new AABB.
+        ///
+        /// @remarks
+        ///     This only touches the model, so it is safe to call from StepSceneNodeConcurrent().
+        bool StepModelAnimation(const SceneNode &node, Model &model, double deltaTimeInSeconds);
+
+        /// Adds the live particles of a particle system that has just been stepped to the context's stats.
+        ///
+        /// @remarks
+        ///     This is only called from the thread that called Step().
+        void AddLiveParticleStat(SceneNode &node, const ParticleSystem &particleSystem);
+
+
+        /// Flags returned by StepSceneNodeConcurrent().
+        enum StepResult
+        {
+            StepResult_None             = 0,
+            StepResult_ModelAnimated    = (1 << 0),
+            StepResult_ParticlesUpdated = (1 << 1),
+        };
+
+
+    private:
+
+        /// Performs the update step by distributing the concurrent phase across the thread pool.
+        void StepParallel(double deltaTimeInSeconds, SceneCullingManager &cullingManager);
+
+        /// The job function for the concurrent phase of StepParallel().
+        static void StepParallelJob(size_t jobIndex, size_t threadIndex, void* pUserData);
+
+
+        /// A scene node that has been through the concurrent phase of StepParallel(), and the flags that were returned for it.
+        struct SteppedSceneNode
+        {
+            /// The scene node. This is set to null if the scene node is removed before the synchronous phase gets to it.
+            SceneNode* sceneNode;
+
+            /// The flags returned by StepSceneNodeConcurrent().
+            uint32_t stepResult;
+        };
+
 
 
     protected:
 
         /// The list of every scene node that should be updated.
         Vector<SceneNode*> sceneNodes;
+
+
+
+    private:
+
+        /// A pointer to the thread pool to use for parallel updating. This is null when parallel updating is disabled.
+        ThreadPool* m_pThreadPool;
+
+        /// The number of scene nodes to group into a single job when updating in parallel.
+        size_t m_parallelUpdateBatchSize;
+
+        /// A snapshot of the scene nodes taken at the start of StepParallel(), with the results of the concurrent phase. Scripts can add
+        /// and remove scene nodes during the synchronous phase, so that phase goes through this rather than sceneNodes.
+        Vector<SteppedSceneNode> m_stepResults;
+
+        /// Whether or not the synchronous phase of StepParallel() is in progress, in which case RemoveSceneNode() needs to clear the
+        /// scene node from m_stepResults.
+        bool m_isSteppingSynchronous;
+
+        /// The delta time of the step currently in progress. Read by the job function.
+        double m_currentDeltaTimeInSeconds;
+
+
+        /// Whether or not animation LOD is enabled.
+        bool m_isAnimationLODEnabled;
+
+        /// The distance from the camera beyond which a model is stepped at a reduced rate.
+        float m_animationLODDistance;
+
+        /// The number of frames between steps of a model beyond the LOD distance.
+        uint32_t m_animationLODDistantInterval;
+
+        /// The number of frames between AABB refreshes of a model that was not seen, or 0 to never refresh it.
+        uint32_t m_animationLODHiddenInterval;
+
+        /// The number of times Step() has been called. This is used to spread the reduced rate models across frames.
+        uint32_t m_animationLODFrameIndex;
     };
 }
 
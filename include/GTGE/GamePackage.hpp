@@ -0,0 +1,289 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#ifndef GT_GamePackage
+#define GT_GamePackage
+
+#include <GTGE/Core/String.hpp>
+#include <GTGE/Core/Vector.hpp>
+#include <GTGE/Core/MappedFile.hpp>
+#include <dr_libs/dr_fs.h>
+#include <cstdint>
+
+namespace GT
+{
+    /// The flags of an entry in a game package.
+    enum GamePackageEntryFlags
+    {
+        /// The entry is stored as a single LZ4 block.
+        GamePackageEntryFlag_Compressed = (1 << 0)
+    };
+
+
+    /// An entry in the table of contents of a game package.
+    ///
+    /// The table of contents is sorted by path hash. Entries with the same hash are in no particular order.
+    struct GamePackageEntry
+    {
+        /// The hash of the normalized path of the entry. See GamePackage::HashPath().
+        uint64_t pathHash;
+
+        /// The offset of the entry's data from the start of the file. This is a multiple of the package's alignment.
+        uint64_t dataOffset;
+
+        /// The size in bytes of the data as it's stored in the file.
+        uint64_t storedSize;
+
+        /// The size in bytes of the data once it's decompressed. This is the same as storedSize for uncompressed entries.
+        uint64_t size;
+
+        /// The offset of the null-terminated path in the string table.
+        uint32_t pathOffset;
+
+        /// A combination of GamePackageEntryFlags.
+        uint32_t flags;
+    };
+
+    /// The footer at the end of a game package.
+    ///
+    /// The footer is at the end so the package can be written in a single pass. A package is laid out as the entry data, followed by the
+    /// table of contents, followed by the string table, followed by this footer. Everything is little-endian.
+    struct GamePackageFooter
+    {
+        /// GamePackage::Magic.
+        uint32_t magic;
+
+        /// GamePackage::Version.
+        uint32_t version;
+
+        /// The number of entries in the table of contents.
+        uint32_t entryCount;
+
+        /// The alignment of the entry data.
+        uint32_t alignment;
+
+        /// The offset of the table of contents from the start of the file.
+        uint64_t tocOffset;
+
+        /// The offset and size of the string table.
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+    };
+
+
+    /// A read-only game package that is memory-mapped.
+    ///
+    /// A game package is a single file containing the data files of a game, which avoids the cost of resolving and opening each file
+    /// individually. Entries are found with a binary search on a hash of their path, and uncompressed entries can be read directly from
+    /// the mapping without any copying.
+    ///
+    /// Paths are relative to the root of the data directory the file came from, and are compared case-insensitively with either kind of
+    /// slash.
+    ///
+    /// Once opened, a package can be read from multiple threads at the same time.
+    class GamePackage
+    {
+    public:
+
+        /// The magic number at the start of the footer, "GTPK".
+        static const uint32_t Magic = 0x4B505447;
+
+        /// The current version of the file format.
+        static const uint32_t Version = 1;
+
+        /// The index returned when an entry is not found.
+        static const uint32_t InvalidEntry = UINT32_MAX;
+
+
+        /// Constructor.
+        GamePackage();
+
+        /// Destructor.
+        ~GamePackage();
+
+
+        /// Opens and maps the package at the given path.
+        ///
+        /// @param absolutePath [in] The absolute path of the package file on the native file system.
+        ///
+        /// @return True if the package is opened successfully; false otherwise.
+        ///
+        /// @remarks
+        ///     This fails if the file is not a valid package, including when any entry lies outside of the file or is not aligned.
+        bool Open(const char* absolutePath);
+
+        /// Closes the package, unmapping the file.
+        ///
+        /// @remarks
+        ///     Pointers returned by GetEntryData() are invalid after this.
+        void Close();
+
+        /// Determines whether or not the package is open.
+        bool IsOpen() const { return m_pMappedData != nullptr; }
+
+        /// Retrieves the absolute path of the package file.
+        const char* GetAbsolutePath() const { return m_absolutePath.c_str(); }
+
+
+        /// Finds the entry with the given path.
+        ///
+        /// @return The index of the entry, or InvalidEntry if it does not exist.
+        uint32_t FindEntry(const char* relativePath) const;
+
+        /// Retrieves the number of entries.
+        uint32_t GetEntryCount() const { return m_entryCount; }
+
+        /// Retrieves the path of the given entry.
+        const char* GetEntryPath(uint32_t entryIndex) const;
+
+        /// Retrieves the size in bytes of the given entry once it's decompressed.
+        uint64_t GetEntrySize(uint32_t entryIndex) const;
+
+        /// Determines whether or not the given entry is compressed.
+        bool IsEntryCompressed(uint32_t entryIndex) const;
+
+        /// Retrieves a pointer to the data of the given entry inside the mapping.
+        ///
+        /// @return A pointer to the data, or null if the entry is compressed.
+        ///
+        /// @remarks
+        ///     The pointer is valid until the package is closed.
+        const void* GetEntryData(uint32_t entryIndex) const;
+
+        /// Reads the data of the given entry, decompressing it if necessary.
+        ///
+        /// @param entryIndex [in]  The index of the entry to read.
+        /// @param pDataOut   [out] A pointer to the buffer that will receive the data. This must be at least GetEntrySize() bytes.
+        ///
+        /// @return True if the data is read successfully; false if the compressed data is corrupt.
+        bool ReadEntry(uint32_t entryIndex, void* pDataOut) const;
+
+
+        /// Calculates the hash of the given path, as it's stored in the table of contents.
+        ///
+        /// @remarks
+        ///     The path is normalized by ignoring leading slashes, treating back slashes as forward slashes and lower-casing ASCII letters.
+        static uint64_t HashPath(const char* relativePath);
+
+
+
+    private:
+
+        /// Retrieves the entry at the given index.
+        const GamePackageEntry & GetEntry(uint32_t entryIndex) const;
+
+
+        /// The absolute path of the package file.
+        String m_absolutePath;
+
+        /// The mapped package file.
+        MappedFile m_file;
+
+        /// A pointer to the start of the mapping.
+        const uint8_t* m_pMappedData;
+
+        /// The size of the mapping, which is the size of the file.
+        size_t m_mappedSize;
+
+        /// A pointer to the table of contents inside the mapping.
+        const GamePackageEntry* m_pEntries;
+
+        /// The number of entries.
+        uint32_t m_entryCount;
+
+        /// A pointer to the string table inside the mapping.
+        const char* m_pStrings;
+
+
+    private:    // No copying.
+        GamePackage(const GamePackage &);
+        GamePackage & operator=(const GamePackage &);
+    };
+
+
+    /// Class for writing a game package.
+    ///
+    /// Files are added with AddFile() and are not read until Write() is called, which streams them into the package one at a time.
+    class GamePackageWriter
+    {
+    public:
+
+        /// The default alignment of entry data.
+        static const uint32_t DefaultAlignment = 64;
+
+
+        /// Constructor.
+        ///
+        /// @param alignment [in] The alignment of each entry's data. This must be a power of two.
+        GamePackageWriter(uint32_t alignment = DefaultAlignment);
+
+        /// Destructor.
+        ~GamePackageWriter();
+
+
+        /// Adds a file to the package.
+        ///
+        /// @param sourceAbsolutePath [in] The absolute path of the file to add.
+        /// @param relativePath       [in] The path of the entry in the package.
+        /// @param compress           [in] Whether or not to try compressing the file. It is only stored compressed if that makes it smaller.
+        ///
+        /// @remarks
+        ///     If more than one file is added with the same path, the first one is used.
+        void AddFile(const char* sourceAbsolutePath, const char* relativePath, bool compress);
+
+        /// Retrieves the number of files that have been added.
+        size_t GetFileCount() const { return m_files.count; }
+
+
+        /// Writes the package.
+        ///
+        /// @param pVFS               [in] The file system to read the source files from and write the package to.
+        /// @param outputAbsolutePath [in] The absolute path of the package file.
+        ///
+        /// @return True if the package is written successfully with every file; false otherwise.
+        ///
+        /// @remarks
+        ///     Source files that can't be read are left out of the package and false is returned, but the rest of the package is still
+        ///     written. Use GetUnreadableFiles() to find out which files were left out.
+        bool Write(drfs_context* pVFS, const char* outputAbsolutePath);
+
+        /// Retrieves the absolute paths of the source files that could not be read by the last call to Write().
+        const Vector<String> & GetUnreadableFiles() const { return m_unreadableFiles; }
+
+
+
+    private:
+
+        /// A file that has been added to the package.
+        struct File
+        {
+            /// The absolute path of the source file.
+            String sourceAbsolutePath;
+
+            /// The path of the entry in the package.
+            String relativePath;
+
+            /// The hash of the relative path.
+            uint64_t pathHash;
+
+            /// Whether or not to try compressing the file.
+            bool compress;
+        };
+
+
+        /// The alignment of the entry data.
+        uint32_t m_alignment;
+
+        /// The files that have been added, in the order they were added.
+        Vector<File*> m_files;
+
+        /// The source files that could not be read by the last call to Write().
+        Vector<String> m_unreadableFiles;
+
+
+    private:    // No copying.
+        GamePackageWriter(const GamePackageWriter &);
+        GamePackageWriter & operator=(const GamePackageWriter &);
+    };
+}
+
+#endif
@@ -8,13 +8,17 @@
 
 namespace GT
 {
+    class GamePackageWriter;
+
     /// Class used for packaging a game for distribution.
     ///
     /// The packager depends on certain operations being performed in certain orders:
-    ///     1) Copy over data directories.
-    ///     2) Copy over any other individual files.
-    ///     3) Copy over the main executable.
-    ///     4) Write the config file.
+    ///     1) Enable the game package and texture baking, if they are being used.
+    ///     2) Copy over data directories.
+    ///     3) Copy over any other individual files.
+    ///     4) Copy over the main executable.
+    ///     5) Write the game package, if one is being used.
+    ///     6) Write the config file.
     class GamePackager
     {
     public:
@@ -28,6 +32,27 @@ namespace GT
         ~GamePackager();
 
 
+        /// Enables packing asset files into a game package.
+        ///
+        /// @param packageRelativePath [in] The path of the package file, relative to the output directory.
+        /// @param compress            [in] Whether or not to compress the package's entries.
+        ///
+        /// @remarks
+        ///     Files in the data directories that can be loaded out of the package are added to it instead of being copied over. These are the
+        ///     files the asset library can load along with their metadata, and the images and models loaded by the texture and model libraries.
+        ///     Everything else is still copied over.
+        void EnablePackage(const char* packageRelativePath, bool compress = true);
+
+        /// Enables baking of textures.
+        ///
+        /// @param compress [in] Whether or not to block-compress the baked textures where possible.
+        ///
+        /// @remarks
+        ///     Each image in the data directories gets a baked texture next to it, which the texture library loads instead of decoding the image.
+        ///     Images that are packed into the game package have their baked textures packed with them. Existing .gttexture files in the data
+        ///     directories are not copied over. See BakedTexture.
+        void EnableTextureBaking(bool compress = true);
+
         /// Copies the given data directory over.
         ///
         /// @param sourceAbsolutePath [in] The absolute path of the source directory.
@@ -58,6 +83,16 @@ namespace GT
         bool CopyFile(const char* sourceAbsolutePath, const char* destinationRelativePath = nullptr);
 
 
+        /// Writes the game package.
+        ///
+        /// @return True if the package is written successfully with every file; false otherwise.
+        ///
+        /// @remarks
+        ///     This must be done after copying over the data directories. This does nothing if the package has not been enabled.
+        ///     @par
+        ///     Files that can't be read are logged and left out of the package, in which case false is returned.
+        bool WritePackage();
+
         /// Writes the config file.
         ///
         /// @remarks
@@ -76,6 +111,29 @@ namespace GT
 
         /// The relative path of the executable.
         String executableRelativePath;
+
+        /// The writer for the game package, or null if the package is not enabled.
+        GamePackageWriter* packageWriter;
+
+        /// The path of the game package relative to 'outputDirectoryAbsolutePath'.
+        String packageRelativePath;
+
+        /// The temporary files holding the baked textures of packed images. These are deleted once the package is written.
+        Vector<String> packedBakedTextureAbsolutePaths;
+
+        /// Whether or not to compress the entries of the game package.
+        bool compressPackage;
+
+        /// Whether or not to bake textures.
+        bool bakeTextures;
+
+        /// Whether or not to block-compress baked textures.
+        bool compressTextures;
+
+
+    private:    // No copying.
+        GamePackager(const GamePackager &);
+        GamePackager & operator=(const GamePackager &);
     };
 }
 
@@ -22,8 +22,8 @@ namespace GT
     struct MeshSkinningData
     {
         /// Constructor.
-        MeshSkinningData(const Bone* const* bonesIn, const SkinningVertexAttribute* skinningVertexAttributesIn, const VertexArray &source)
-            : bones(bonesIn),
+        MeshSkinningData(const glm::mat4* skinningPaletteIn, const SkinningVertexAttribute* skinningVertexAttributesIn, const VertexArray &source)
+            : skinningPalette(skinningPaletteIn),
               skinningVertexAttributes(skinningVertexAttributesIn),
               skinnedGeometry()
         {
@@ -47,8 +47,8 @@ namespace GT
         }
 
 
-        /// A pointer to the buffer containing pointers to the bones each vertex will index into.
-        const Bone* const* bones;
+        /// A pointer to the palette of skinning transforms each vertex will index into.
+        const glm::mat4* skinningPalette;
 
         /// A pointer to the buffer containing the skinning vertex attributes for the CPU skinning shader.
         const SkinningVertexAttribute* skinningVertexAttributes;
@@ -142,9 +142,12 @@ namespace GT
 
         /// Sets the animation data for the mesh.
         ///
-        /// @param bones                    [in] A pointer to the buffer containing pointers to the bones the skinning vertex attributes will index in to.
+        /// @param skinningPalette          [in] A pointer to the palette of skinning transforms the skinning vertex attributes will index in to.
         /// @param skinningVertexAttributes [in] A pointer to the buffer containing the skinning vertex attributes for each vertex.
-        void SetSkinningData(const Bone* const* bones, const SkinningVertexAttribute* skinningVertexAttributes);
+        ///
+        /// @remarks
+        ///     The palette is not copied. It is read each time ApplySkinning() is called, so it needs to stay alive for as long as the mesh.
+        void SetSkinningData(const glm::mat4* skinningPalette, const SkinningVertexAttribute* skinningVertexAttributes);
 
 
 
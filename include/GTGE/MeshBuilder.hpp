@@ -33,7 +33,8 @@ namespace GT
         /// @param vertexData [in] A pointer to the vertex data. The size of this buffer is determined by the format specified in the constructor.
         ///
         /// @remarks
-        ///     If an identical vertex has already been emitted, that one will be used instead of adding a duplicate vertex.
+        ///     If an identical vertex has already been emitted, that one will be used instead of adding a duplicate vertex. Duplicates are
+        ///     found with a hash table, so this is constant time regardless of how many vertices have already been emitted.
         void EmitVertex(const float* vertexData);
 
         /// Merges another mesh builder into this one.
@@ -52,6 +53,9 @@ namespace GT
         ///
         /// @return
         ///     True if the vertex was found; false otherwise.
+        ///
+        /// @remarks
+        ///     If a weld epsilon has been set, this will find a vertex whose attributes all quantize to the same values as the input vertex.
         bool Find(const float* vertexData, unsigned int &indexOut);
 
 
@@ -61,7 +65,23 @@ namespace GT
         /// @param vertexData1 [in] The second buffer to compare against.
         ///
         /// @return True if the vertices are equal; false otherwise.
-        bool Equal(const float* vertexData0, const float* vertexData1);
+        bool Equal(const float* vertexData0, const float* vertexData1) const;
+
+
+        /// Sets the epsilon to use when welding duplicate vertices.
+        ///
+        /// @param epsilon [in] The size of the grid each vertex attribute is snapped to for the purpose of detecting duplicates.
+        ///
+        /// @remarks
+        ///     When this is 0 (the default), vertices are only welded if they are bit-for-bit identical, with the exception of -0 and +0
+        ///     which are considered equal. Otherwise, two vertices are welded when every attribute rounds to the same multiple of the
+        ///     epsilon. Note that values which are very close but straddle a rounding boundary will not be welded.
+        ///     @par
+        ///     The vertex data itself is never modified - the first emitted vertex is the one that is kept.
+        void SetWeldEpsilon(float epsilon);
+
+        /// Retrieves the epsilon used when welding duplicate vertices.
+        float GetWeldEpsilon() const { return this->weldEpsilon; }
 
 
         /// Retrieves a pointer to the buffer containing the vertex data.
@@ -93,6 +113,19 @@ namespace GT
 
     protected:
 
+        /// Calculates the hash of the given vertex, taking the weld epsilon into account.
+        uint32_t HashVertex(const float* vertexData) const;
+
+        /// Determines whether or not the given vertices should be welded, taking the weld epsilon into account.
+        bool WeldEqual(const float* vertexData0, const float* vertexData1) const;
+
+        /// Rebuilds the vertex hash table with the given number of slots. This must be a power of 2.
+        void RebuildVertexHashTable(size_t newSlotCount);
+
+        /// Inserts the vertex at the given index into the vertex hash table, without checking for duplicates.
+        void InsertIntoVertexHashTable(unsigned int index, uint32_t hash);
+
+
         /// The number of floats making up each vertex.
         size_t vertexSizeInFloats;
 
@@ -104,6 +137,17 @@ namespace GT
 
         /// Whether or not the mesh builder should check for duplicate vertices. Defaults to true.
         bool checkDuplicatesOnEmit;
+
+        /// The open addressed hash table for finding duplicate vertices. Each slot contains the index of the vertex plus 1, with 0 marking
+        /// an empty slot. The size of this is always 0 or a power of 2, and it is kept at most half full.
+        Vector<unsigned int> vertexHashTable;
+
+        /// The number of vertices that have been inserted into the hash table. Vertices emitted while checkDuplicatesOnEmit is false are not
+        /// inserted, in which case this will not match the vertex count and the table is rebuilt on the next call to Find().
+        size_t hashedVertexCount;
+
+        /// The epsilon used for welding vertices. Defaults to 0, which means vertices must be exactly equal.
+        float weldEpsilon;
     };
 }
 
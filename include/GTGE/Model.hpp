@@ -6,6 +6,7 @@
 #include "ModelDefinition.hpp"
 #include "Mesh.hpp"
 #include "Animation/Animation.hpp"
+#include "SkeletonPose.hpp"
 #include "Serialization.hpp"
 #include <GTGE/Core/Vector.hpp>
 
@@ -58,7 +59,7 @@ namespace GT
         void CopyAndAttachBones(const Vector<Bone*> &bones);
 
 
-        /// Copies the given animation.
+        /// Copies the key frames and named segments of the given animation, and maps each channel of the definition's baked clip to a bone.
         void CopyAnimation(const Animation &sourceAnimation, const Map<Bone*, AnimationChannel*> &sourceAnimationChannelBones);
 
 
@@ -136,8 +137,52 @@ namespace GT
         void ResumeAnimation();
 
         /// Steps the current animation.
+        ///
+        /// @remarks
+        ///     This is the same as AdvanceAnimation() followed by UpdateAnimationPose().
         void StepAnimation(double time);
 
+        /// Advances the playback time of the current animation without evaluating the skeleton.
+        ///
+        /// @remarks
+        ///     The pose is marked as out of date. It is brought up to date by the next call to UpdateAnimationPose(), StepAnimation() or
+        ///     ApplySkinning(). This is used for models that nobody can see.
+        void AdvanceAnimation(double time);
+
+        /// Holds back the given amount of time from the current animation. It is added to the step of the next call to StepAnimation()
+        /// or AdvanceAnimation().
+        ///
+        /// @remarks
+        ///     Unlike AdvanceAnimation(), this leaves the pose alone. This is used for stepping distant models at a reduced rate.
+        void DeferAnimationStep(double time);
+
+        /// Samples the current animation and evaluates the skeleton if the pose is out of date with the playback time.
+        void UpdateAnimationPose();
+
+        /// Determines whether or not the pose is out of date with the playback time of the animation.
+        bool IsAnimationPoseOutOfDate() const { return this->isAnimationPoseOutOfDate; }
+
+        /// Brings the pose up to date and applies skinning to the meshes, but only if the pose has changed since the last time.
+        void ApplySkinning();
+
+
+        /// Records that the model has been seen by a camera. This is called by the renderer for each model it draws.
+        ///
+        /// @param cameraDistance [in] The distance from the camera to the model.
+        ///
+        /// @remarks
+        ///     The nearest distance is kept until ResetSeenDistance() is called. The update manager uses this to decide how often the
+        ///     model's animation needs to be evaluated.
+        void MarkAsSeen(float cameraDistance) const;
+
+        /// Retrieves the distance to the nearest camera the model has been seen by since the last call to ResetSeenDistance(), or -1 if
+        /// it has not been seen.
+        float GetSeenDistance() const { return this->animationSeenDistance; }
+
+        /// Resets the seen distance so that the model is considered unseen until MarkAsSeen() is called again.
+        void ResetSeenDistance() { this->animationSeenDistance = -1.0f; }
+
+
         /// Determines whether or not the model is animating. Basically, this is used in determining whether or not the model should have vertex blending applied.
         bool IsAnimating() const;
 
@@ -180,6 +225,9 @@ namespace GT
         /// The list of bones in the model.
         Vector<Bone*> bones;
 
+        /// The flattened skeleton. This calculates the skinning transforms of the bones, which the meshes read from it's palette.
+        SkeletonPose skeletonPose;
+
 
 
 
@@ -195,15 +243,24 @@ namespace GT
         /// The model's animation object.
         Animation animation;
 
-        /// The bones associated with each channel in the animation.
-        Map<Bone*, AnimationChannel*> animationChannelBones;
-
-        /// The cache of animation keys.
-        Vector<TransformAnimationKey*> animationKeyCache;
+        /// The index of the bone associated with each channel of the definition's baked clip, which is what StepAnimation() samples from.
+        Vector<size_t> animationClipBoneIndices;
 
         /// The playback speed of animations.
         double animationPlaybackSpeed;
 
+        /// The time that has been held back by DeferAnimationStep().
+        double deferredAnimationStep;
+
+        /// Whether or not the pose needs to be evaluated because the playback time has moved since it was last evaluated.
+        bool isAnimationPoseOutOfDate;
+
+        /// Whether or not the meshes need skinning because the pose has changed since skinning was last applied.
+        bool isSkinningOutOfDate;
+
+        /// The distance to the nearest camera the model was seen by, or -1 if it has not been seen. See MarkAsSeen().
+        mutable float animationSeenDistance;
+
 
     private:    // No copying.
         Model(const Model &);
@@ -9,6 +9,7 @@
 #include "Mesh.hpp"
 #include "ConvexHull.hpp"
 #include "Animation/Animation.hpp"
+#include "Animation/AnimationClip.hpp"
 #include <GTGE/Core/Vector.hpp>
 
 
@@ -136,6 +137,13 @@ namespace GT
         /// Maps an animation channel to a bone.
         void MapAnimationChannelToBone(Bone &bone, AnimationChannel &channel);
 
+        /// Bakes the animation into the clip that every model of this definition samples from.
+        ///
+        /// @remarks
+        ///     Channel 'i' of the clip is baked from the channel of item 'i' of animationChannelBones. This needs to be called again
+        ///     whenever the keys or channels of the animation change.
+        void BakeAnimationClip();
+
 
         /// Builds the convex decomposition of the model.
         ///
@@ -265,23 +273,29 @@ namespace GT
         /// Loads the model definition from a native .gtmodel file.
         ///
         /// @param absolutePathIn [in] The absolute path of the file to load.
+        /// @param pData          [in] The contents of the file if it's already in memory, such as when it's in a game package, or null to read the file.
+        /// @param dataSize       [in] The size of the data pointed to by pData.
         ///
         /// @return True if successful; false otherwise.
-        bool LoadFromNativeFile(const String &absolutePathIn);
+        bool LoadFromNativeFile(const String &absolutePathIn, const void* pData = nullptr, size_t dataSize = 0);
 
         /// Loads a model definition from a non-native file (a non-gtmodel file).
         ///
         /// @param absolutePathIn [in] The absolute path of the file to load.
+        /// @param pData          [in] The contents of the file if it's already in memory, or null to read the file.
+        /// @param dataSize       [in] The size of the data pointed to by pData.
         ///
         /// @return True if successful; false otherwise.
-        bool LoadFromForeignFile(const String &absolutePathIn);
+        bool LoadFromForeignFile(const String &absolutePathIn, const void* pData = nullptr, size_t dataSize = 0);
 
         /// Loads a model definition from an Assimp-supported file.
         ///
-        /// @param absolutePathIn [in] the absolute path of the file to load.
+        /// @param absolutePathIn [in] the absolute path of the file to load. When the data is in memory, only it's extension is used.
+        /// @param pData          [in] The contents of the file if it's already in memory, or null to read the file.
+        /// @param dataSize       [in] The size of the data pointed to by pData.
         ///
         /// @return True if successful; false otherwise.
-        bool LoadFromAssimpFile(const String &absolutePathIn);
+        bool LoadFromAssimpFile(const String &absolutePathIn, const void* pData = nullptr, size_t dataSize = 0);
 
 
     public:
@@ -314,6 +328,9 @@ namespace GT
         /// The cache of animation keys.
         Vector<TransformAnimationKey*> animationKeyCache;
 
+        /// The baked animation keys of every channel. This is shared by every model of this definition.
+        AnimationClip animationClip;
+
 
         /// The padding to apply to the animated AABB.
         glm::vec3 animationAABBPadding;
@@ -8,6 +8,9 @@
 namespace GT
 {
     /// Class representing an individual particle emitted by an emitter.
+    ///
+    /// Emitters don't store particles like this - they're stored as a structure of arrays in a ParticleList. This is used for
+    /// gathering and scattering a single particle, such as during serialization.
     class Particle
     {
     public:
@@ -262,9 +262,12 @@ namespace GT
         /// Retrieves the number of alive particles.
         size_t GetParticleCount() const { return this->particles.GetCount(); }
 
-        /// Retrieves a reference to the particle at the given index.
-              Particle & GetParticle(size_t index)       { return this->particles.GetParticle(index); }
-        const Particle & GetParticle(size_t index) const { return this->particles.GetParticle(index); }
+        /// Retrieves a reference to the list of alive particles.
+        ///
+        /// @remarks
+        ///     The particles are stored as a structure of arrays. See ParticleList.
+              ParticleList & GetParticles()       { return this->particles; }
+        const ParticleList & GetParticles() const { return this->particles; }
 
 
 
@@ -465,6 +468,10 @@ namespace GT
         /// The list of alive particles.
         ParticleList particles;
 
+        /// The lifetime ratio of each particle for the current update. This is kept around between updates so we don't need to
+        /// allocate it every frame.
+        Vector<float> m_lifetimeRatios;
+
 
         glm::vec3 m_aabbMin;
         glm::vec3 m_aabbMax;
@@ -4,7 +4,7 @@
 #define GT_ParticleFunction
 
 #include "ParticleFunctionTypes.hpp"
-#include "Particle.hpp"
+#include "ParticleList.hpp"
 
 
 namespace GT
@@ -39,15 +39,19 @@ namespace GT
         }
 
 
-        /// Executes the function.
+        /// Executes the function on a range of particles.
         ///
-        /// @param particle      [in] A reference to the particle that this function is being applied to.
-        /// @param lifetimeRatio [in] A value between 0 and 1 that specifies where in it's life the particle is currently at.
+        /// @param particles      [in] A reference to the list containing the particles that this function is being applied to.
+        /// @param firstParticle  [in] The index of the first particle to apply the function to.
+        /// @param endParticle    [in] The index of the particle one past the last particle to apply the function to.
+        /// @param lifetimeRatios [in] A buffer containing the lifetime ratio of each particle, indexed by the particle index.
         ///
         /// @remarks
-        ///     When 'lifetimeRatio' is at 0 it means the particle is at the beginning of it's life. When it's at 1 it means the particle
-        ///     is at the end of it's life.
-        virtual void Execute(Particle &particle, float lifetimeRatio) = 0;
+        ///     A lifetime ratio is a value between 0 and 1 that specifies where in it's life the particle is currently at. When it's at
+        ///     0 it means the particle is at the beginning of it's life. When it's at 1 it means the particle is at the end of it's life.
+        ///     @par
+        ///     Functions only touch the stream they are responsible for, so they can be applied to disjoint ranges at the same time.
+        virtual void Execute(ParticleList &particles, size_t firstParticle, size_t endParticle, const float* lifetimeRatios) = 0;
 
 
     private:
@@ -177,7 +181,7 @@ namespace GT
 
 
         /// ParticleFunction::Execute().
-        void Execute(Particle &particle, float lifetimeRatio);
+        void Execute(ParticleList &particles, size_t firstParticle, size_t endParticle, const float* lifetimeRatios);
     };
 
 
@@ -201,7 +205,7 @@ namespace GT
 
 
         /// ParticleFunction::Execute()
-        void Execute(Particle &particle, float lifetimeRatio);
+        void Execute(ParticleList &particles, size_t firstParticle, size_t endParticle, const float* lifetimeRatios);
     };
 
 
@@ -228,7 +232,7 @@ namespace GT
 
 
         /// ParticleFunction::Execute()
-        void Execute(Particle &particle, float lifetimeRatio);
+        void Execute(ParticleList &particles, size_t firstParticle, size_t endParticle, const float* lifetimeRatios);
 
         /// ParticleFunction_Vector3::SetRange().
         void SetRange(const glm::vec3 &rangeMin, const glm::vec3 &rangeMax);
@@ -264,7 +268,7 @@ namespace GT
 
 
         /// ParticleFunction::Execute()
-        void Execute(Particle &particle, float lifetimeRatio);
+        void Execute(ParticleList &particles, size_t firstParticle, size_t endParticle, const float* lifetimeRatios);
     };
 
 
@@ -288,7 +292,7 @@ namespace GT
 
 
         /// ParticleFunction::Execute().
-        void Execute(Particle &particle, float lifetimeRatio);
+        void Execute(ParticleList &particles, size_t firstParticle, size_t endParticle, const float* lifetimeRatios);
     };
 }
 
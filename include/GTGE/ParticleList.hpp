@@ -9,11 +9,17 @@ namespace GT
 {
     /// Container class specially designed for efficient storing of particles.
     ///
-    /// This container can probably be used for other objects as well, in which case this may be turned into a template container.
-    ///
     /// In a particle effect, there will potential for many short-lived particles, each of which will be added and removed from this
-    /// list. So therefore, adding and removing particles from a list needs to be efficient. We can use this list for doing the
-    /// construction of particles.
+    /// list. So therefore, adding and removing particles from a list needs to be efficient.
+    ///
+    /// Particles are stored as a structure of arrays - each property of a particle lives in it's own tightly packed stream which is
+    /// indexed by the particle index. This lets the emitter update a single property of every particle in one linear pass without
+    /// dragging the rest of the particle through the cache. Every stream is 16 byte aligned so they can be processed with SSE.
+    ///
+    /// The streams are public so they can be accessed directly in tight loops. Only indices in the range [0, GetCount()) are valid,
+    /// and the pointers themselves are invalidated by Resize(), PushNewParticle() and the copy constructor.
+    ///
+    /// Removing a particle moves the last particle into it's slot, so the order of particles is not preserved.
     class ParticleList
     {
     public:
@@ -28,59 +34,127 @@ namespace GT
         ~ParticleList();
 
 
-        /// Pushes a new particle to the end of the buffer, returning a reference to the new particle.
-        Particle & PushNewParticle();
+        /// Pushes a new particle to the end of the list, returning it's index.
+        ///
+        /// @remarks
+        ///     Each property of the new particle is set to the same default as the Particle constructor.
+        size_t PushNewParticle();
 
-        /// Removes the particle at the given index.
+        /// Removes the particle at the given index by moving the last particle into it's place.
         void Remove(size_t index);
 
+        /// Removes every particle whose time left to death is less than or equal to zero.
+        ///
+        /// @return The number of particles that were removed.
+        ///
+        /// @remarks
+        ///     This is done by swap-compaction, so the order of the remaining particles is not preserved.
+        size_t RemoveDeadParticles();
+
 
 
         /// Retrieves the particle count.
         size_t GetCount() const;
-        
-        /// Retrieves the particle at the given index.
+
+        /// Gathers the properties of the particle at the given index into a Particle object.
         ///
-        /// @param index [in] The index of the particle to retrieve.
+        /// @param index       [in]  The index of the particle to retrieve.
+        /// @param particleOut [out] A reference to the object that will receive the properties of the particle.
+        void GetParticle(size_t index, Particle &particleOut) const;
+
+        /// Scatters the properties of the given Particle object into the particle at the given index.
         ///
-        /// @remarks
-        ///     The returned value can not be considered valid when a new item is added or removed.
-              Particle & GetParticle(size_t index);
-        const Particle & GetParticle(size_t index) const;
+        /// @param index    [in] The index of the particle to modify.
+        /// @param particle [in] A reference to the object containing the new properties of the particle.
+        void SetParticle(size_t index, const Particle &particle);
 
 
         /// Clears the list.
         void Clear();
 
 
-        /// Retrieves the size of the internal buffer, in Particles.
+        /// Retrieves the size of the internal buffer, in particles.
         size_t GetBufferSize() const;
 
         /// Resizes the internal buffer, making sure everything is copied over appropriately.
         ///
-        /// @param [in] The new size of the internal buffer, in Particles.
+        /// @param [in] The new size of the internal buffer, in particles.
         ///
         /// @remarks
         ///     This does not modify the particle count, only the size of the internal buffer.
         void Resize(size_t newBufferSize);
 
-        
-        
+
+
+        /////////////////////////////////////
+        // Streams.
+
+        /// The position of each particle.
+        glm::vec4* positions;
+
+        /// The orientation of each particle.
+        glm::quat* orientations;
+
+        /// The scale of each particle.
+        glm::vec4* scales;
+
+        /// The current linear velocity of each particle.
+        glm::vec4* linearVelocities;
+
+        /// The current angular velocity of each particle.
+        glm::quat* angularVelocities;
+
+        /// The linear velocity of each particle when it was spawned.
+        glm::vec4* spawnLinearVelocities;
+
+        /// The current linear velocity applied to each particle due to gravity.
+        glm::vec4* gravityLinearVelocities;
+
+        /// The linear velocity of each particle as defined by the linear-velocity functions.
+        glm::vec4* functionLinearVelocities;
+
+        /// The current colour of each particle.
+        glm::vec4* colours;
+
+        /// The texture coordinates of the first texture tile of each particle, as (uMin, vMin, uMax, vMax).
+        glm::vec4* texCoordBounds0;
+
+        /// The texture coordinates of the second texture tile of each particle, as (uMin, vMin, uMax, vMax).
+        glm::vec4* texCoordBounds1;
+
+        /// The lifetime of each particle.
+        float* lifetimes;
+
+        /// The amount of time left before each particle dies.
+        float* timesLeftToDeath;
+
+        /// The interpolation factor to use when interpolating between the two texture tiles of each particle.
+        float* uvTileInterpolationFactors;
+
+
+
     private:
 
-        /// A pointer to the buffer containing the particles.
-        Particle* buffer;
+        /// Sets the stream pointers to point into the given buffer.
+        void SetStreamPointers(void* newBuffer, size_t newBufferSize);
+
+        /// Copies the particle at index 'srcIndex' to index 'dstIndex'.
+        void MoveParticle(size_t dstIndex, size_t srcIndex);
 
-        /// The size of the buffer, in "Particle"s.
+        /// Calculates the size in bytes of a buffer that can hold the given number of particles.
+        static size_t CalculateBufferSizeInBytes(size_t particleCount);
+
+
+        /// A pointer to the buffer containing every stream. This is a single allocation.
+        void* buffer;
+
+        /// The size of the buffer, in particles.
         size_t bufferSize;
 
         /// The number of particles currently in the list.
         size_t count;
 
-        /// The index of the first particle.
-        size_t startIndex;
-        
-        
+
     private:    // No assignment, yet.
         ParticleList & operator=(const ParticleList &);
     };
@@ -55,6 +55,9 @@ namespace GT
         ///     This asserts that the index is valid.
         const ParticleEmitter* GetEmitter(size_t index) const;
 
+        /// Retrieves the number of live particles across every emitter.
+        size_t GetParticleCount() const;
+
 
         /// Sets the world positition of the particle system.
         void SetPosition(const glm::vec3 &newPosition);
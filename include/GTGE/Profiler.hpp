@@ -3,7 +3,11 @@
 #ifndef GT_Profiler
 #define GT_Profiler
 
+#include <GTGE/Config.hpp>
 #include <GTGE/Core/Timing.hpp>
+#include <dr_libs/dr_fs.h>
+#include <cstddef>
+#include <cstdint>
 
 namespace GT
 {
@@ -138,6 +142,144 @@ namespace GT
         bool isEnabled;
 
     };
+
+
+
+    /// A zone recorded by ProfilerCapture.
+    struct ProfilerZoneEvent
+    {
+        /// The name of the zone. This is not copied, so it must be a string literal or otherwise outlive the capture.
+        const char* name;
+
+        /// The time the zone began, in seconds.
+        double beginTime;
+
+        /// The time the zone ended, in seconds.
+        double endTime;
+
+        /// The number of zones the zone is nested inside on it's thread.
+        uint32_t depth;
+    };
+
+
+    /// Captures profiler zones from every thread.
+    ///
+    /// Each thread that enters a zone while capturing is given a fixed size ring buffer the first time it does so. Zones are written
+    /// to the calling thread's buffer without any locking when they end, and once a buffer is full it's oldest zones are overwritten.
+    /// The buffers are kept for the lifetime of the process and reused by later captures.
+    ///
+    /// Zones are normally entered with the GT_PROFILE_ZONE macro rather than by calling BeginZone() and EndZone() directly.
+    class ProfilerCapture
+    {
+    public:
+
+        /// The default number of zones each thread keeps.
+        static const size_t DefaultEventsPerThread = 65536;
+
+
+        /// Starts capturing zones on every thread, discarding the previous capture.
+        ///
+        /// @param eventsPerThread [in] The number of zones kept by each thread.
+        ///
+        /// @remarks
+        ///     This should be called from the main thread while no other threads are running jobs.
+        static void Begin(size_t eventsPerThread = DefaultEventsPerThread);
+
+        /// Stops capturing.
+        static void End();
+
+        /// Determines whether or not zones are being captured.
+        static bool IsCapturing() { return s_isCapturing; }
+
+
+        /// Sets the name of the calling thread as it will appear in saved captures.
+        ///
+        /// @remarks
+        ///     The name is copied. It is only used if the thread enters a zone while capturing.
+        static void SetThreadName(const char* name);
+
+
+        /// Saves the last capture as a Chrome trace JSON file, which can be opened with chrome://tracing.
+        ///
+        /// @param pVFS     [in] The file system to write the file with.
+        /// @param filePath [in] The path of the file to write.
+        ///
+        /// @return True if the file is written successfully; false otherwise.
+        ///
+        /// @remarks
+        ///     This must be called after End() and after any work that was running when End() was called has finished.
+        static bool SaveAsChromeTrace(drfs_context* pVFS, const char* filePath);
+
+
+        /// Called when a zone is entered while capturing.
+        ///
+        /// @return The time the zone began, which should be passed to EndZone().
+        static double BeginZone();
+
+        /// Called when a zone that was entered while capturing is left.
+        static void EndZone(const char* name, double beginTime);
+
+
+    private:
+
+        /// Whether or not zones are being captured. This is read by every zone without a lock, and only written by Begin() and End().
+        static volatile bool s_isCapturing;
+    };
+
+
+    /// A scoped profiler zone. The zone begins when the object is constructed and ends when it is destructed.
+    class ProfilerZone
+    {
+    public:
+
+        /// Constructor.
+        ///
+        /// @param name [in] The name of the zone. This must be a string literal.
+        explicit ProfilerZone(const char* name)
+            : m_name(nullptr), m_beginTime(0)
+        {
+            if (ProfilerCapture::IsCapturing())
+            {
+                m_name      = name;
+                m_beginTime = ProfilerCapture::BeginZone();
+            }
+        }
+
+        /// Destructor.
+        ~ProfilerZone()
+        {
+            if (m_name != nullptr)
+            {
+                ProfilerCapture::EndZone(m_name, m_beginTime);
+            }
+        }
+
+
+    private:
+
+        /// The name of the zone, or null if nothing was being captured when the zone began.
+        const char* m_name;
+
+        /// The time the zone began.
+        double m_beginTime;
+
+
+    private:    // No copying.
+        ProfilerZone(const ProfilerZone &);
+        ProfilerZone & operator=(const ProfilerZone &);
+    };
 }
 
+
+/// Profiles the rest of the enclosing scope as a zone with the given name, which must be a string literal.
+///
+/// Zones can be nested and can be used from any thread. They compile to nothing when GT_ENABLE_PROFILER is disabled in Config.hpp.
+#if defined(GT_BUILD_PROFILER)
+#define GT_PROFILE_ZONE_CONCAT2(a, b) a##b
+#define GT_PROFILE_ZONE_CONCAT(a, b)  GT_PROFILE_ZONE_CONCAT2(a, b)
+#define GT_PROFILE_ZONE(name)         GT::ProfilerZone GT_PROFILE_ZONE_CONCAT(_profilerZone, __LINE__)(name)
+#else
+#define GT_PROFILE_ZONE(name)
+#endif
+
 #endif
\ No newline at end of file
@@ -307,6 +307,9 @@ namespace GT
         ///     takes the vertex count.
         static void Draw(const float* vertices, const unsigned int* indices, size_t indexCount, const VertexFormat &format, DrawMode mode = DrawMode_Triangles);
 
+        /// Retrieves the number of draw calls that have been made since the renderer was started up.
+        static uint64_t GetDrawCallCount();
+
 
 
         ///////////////////////////
@@ -402,6 +405,9 @@ namespace GT
         ///     the renderer.
         ///     @par
         ///     Unlike PushTexture2DData(), 'mipmap' can not be -1. It must be a valid mipmap index.
+        ///     @par
+        ///     Compressed formats are uploaded as-is and can not be flipped, so 'flip' must be false for them. Check SupportsCompressedTextures()
+        ///     before using them.
         static void SetTexture2DData(const Texture2D &texture, int mipmap, unsigned int width, unsigned int height, ImageFormat format, const void* data, bool flip = false);
         static void SetTexture2DData(const Texture2D* texture, int mipmap, unsigned int width, unsigned int height, ImageFormat format, const void* data, bool flip = false) { assert(texture != nullptr); SetTexture2DData(*texture, mipmap, width, height, format, data, flip); }
         
@@ -577,6 +583,11 @@ namespace GT
         /// @return True if the renderer has support for attaching buffers of different sizes to a framebuffer.
         static bool SupportsMixedSizedBufferAttachments();
 
+        /// Determines whether or not the block-compressed image formats (ImageFormat_DXT1 and ImageFormat_DXT5) can be used with textures.
+        ///
+        /// @return True if the renderer supports S3TC compressed textures.
+        static bool SupportsCompressedTextures();
+
 
 
 
@@ -38,19 +38,37 @@ namespace GT
         //////////////////////////////////////////////
         // Uniforms.
 
-        virtual void SetUniform(const char* name, float x);
-        virtual void SetUniform(const char* name, float x, float y);
-        virtual void SetUniform(const char* name, float x, float y, float z);
-        virtual void SetUniform(const char* name, float x, float y, float z, float w);
-        virtual void SetUniform(const char* name, const glm::mat2 &value);
-        virtual void SetUniform(const char* name, const glm::mat3 &value);
-        virtual void SetUniform(const char* name, const glm::mat4 &value);
-        virtual void SetUniform(const char* name, const Texture2D* value);
-        virtual void SetUniform(const char* name, const TextureCube* value);
-
-        void SetUniform(const char* name, const glm::vec2 &value) { this->SetUniform(name, value.x, value.y); }
-        void SetUniform(const char* name, const glm::vec3 &value) { this->SetUniform(name, value.x, value.y, value.z); }
-        void SetUniform(const char* name, const glm::vec4 &value) { this->SetUniform(name, value.x, value.y, value.z, value.w); }
+        /// Sets a uniform by the ID of it's interned name. See InternString().
+        ///
+        /// @remarks
+        ///     Uniforms that are set every draw call should have their names interned once up front and use these.
+        virtual void SetUniform(StringID name, float x);
+        virtual void SetUniform(StringID name, float x, float y);
+        virtual void SetUniform(StringID name, float x, float y, float z);
+        virtual void SetUniform(StringID name, float x, float y, float z, float w);
+        virtual void SetUniform(StringID name, const glm::mat2 &value);
+        virtual void SetUniform(StringID name, const glm::mat3 &value);
+        virtual void SetUniform(StringID name, const glm::mat4 &value);
+        virtual void SetUniform(StringID name, const Texture2D* value);
+        virtual void SetUniform(StringID name, const TextureCube* value);
+
+        void SetUniform(StringID name, const glm::vec2 &value) { this->SetUniform(name, value.x, value.y); }
+        void SetUniform(StringID name, const glm::vec3 &value) { this->SetUniform(name, value.x, value.y, value.z); }
+        void SetUniform(StringID name, const glm::vec4 &value) { this->SetUniform(name, value.x, value.y, value.z, value.w); }
+
+        /// Sets a uniform by name. This interns the name, so it is slower than setting it by ID.
+        void SetUniform(const char* name, float x)                              { this->SetUniform(InternString(name), x); }
+        void SetUniform(const char* name, float x, float y)                     { this->SetUniform(InternString(name), x, y); }
+        void SetUniform(const char* name, float x, float y, float z)            { this->SetUniform(InternString(name), x, y, z); }
+        void SetUniform(const char* name, float x, float y, float z, float w)   { this->SetUniform(InternString(name), x, y, z, w); }
+        void SetUniform(const char* name, const glm::mat2 &value)               { this->SetUniform(InternString(name), value); }
+        void SetUniform(const char* name, const glm::mat3 &value)               { this->SetUniform(InternString(name), value); }
+        void SetUniform(const char* name, const glm::mat4 &value)               { this->SetUniform(InternString(name), value); }
+        void SetUniform(const char* name, const Texture2D* value)               { this->SetUniform(InternString(name), value); }
+        void SetUniform(const char* name, const TextureCube* value)             { this->SetUniform(InternString(name), value); }
+        void SetUniform(const char* name, const glm::vec2 &value)               { this->SetUniform(InternString(name), value); }
+        void SetUniform(const char* name, const glm::vec3 &value)               { this->SetUniform(InternString(name), value); }
+        void SetUniform(const char* name, const glm::vec4 &value)               { this->SetUniform(InternString(name), value); }
 
 
         /// Helper for setting the uniforms defined by the given material.
@@ -80,6 +80,9 @@ namespace GT
         /// Retrieves the number of indices in the vertex array.
         inline unsigned int GetIndexCount() const { return m_indexCount; }
 
+        /// Retrieves the number of indices the internal index buffer can hold without reallocating.
+        inline unsigned int GetIndexBufferSize() const { return m_indexBufferSize; }
+
 
         /// Returns a writable pointer to the vertex data. Returns nullptr if the data is already mapped.
         ///
@@ -528,6 +528,30 @@ namespace GT
         void DisableStateStack();
 
 
+        /// Enables deferred transform propagation.
+        ///
+        /// @remarks
+        ///     While enabled, moving, rotating or scaling a scene node only marks it as pending. The culling manager, physics manager,
+        ///     state stack and event handlers are not notified until FlushDeferredTransforms() is called, at which point each node is
+        ///     notified once, parents before children, no matter how many times it was modified. Update() flushes before and after
+        ///     stepping the physics.
+        ///     @par
+        ///     Getters such as GetWorldPosition() are always up to date regardless of this mode.
+        void EnableDeferredTransformPropagation();
+
+        /// Disables deferred transform propagation. Any pending transformations are flushed.
+        void DisableDeferredTransformPropagation();
+
+        /// Determines whether or not deferred transform propagation is enabled. This is disabled by default.
+        bool IsDeferredTransformPropagationEnabled() const;
+
+        /// Posts the transformation events of every scene node that has been modified since the last flush.
+        ///
+        /// @remarks
+        ///     This does nothing if deferred transform propagation is disabled.
+        void FlushDeferredTransforms();
+
+
         /// Performs a commit on the state stack.
         void CommitStateStackFrame();
 
@@ -867,6 +891,11 @@ namespace GT
         /// @param node [in] A reference to the node that has just been scaled.
         void OnSceneNodeScale(SceneNode &node);
 
+        /// Called when a scene node is transformed or scaled while deferred transform propagation is enabled. The node is posted in the next flush.
+        ///
+        /// @param node [in] A reference to the node that has been transformed or scaled.
+        void QueueDeferredSceneNodeTransform(SceneNode &node);
+
         /// Called after the staticness of a scene node has changed.
         ///
         /// @param node [in] A reference to the node whose staticness has changed.
@@ -1093,6 +1122,17 @@ namespace GT
         bool isStateStackEnabled;
 
 
+        /// Whether or not deferred transform propagation is enabled. False by default.
+        bool isDeferredTransformPropagationEnabled;
+
+        /// The scene nodes whose transformation events are waiting to be posted. Nodes that are removed from the scene are set to null rather than
+        /// being removed from the list.
+        Vector<SceneNode*> deferredTransformQueue;
+
+        /// The list of nodes currently being flushed. This is a member so that removing a node during a flush can null it out.
+        Vector<SceneNode*> deferredTransformFlushList;
+
+
         /// A pointer to the script the scene is current registered to.
         GT::Script* registeredScript;
 
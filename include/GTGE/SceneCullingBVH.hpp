@@ -0,0 +1,180 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#ifndef GT_SceneCullingBVH
+#define GT_SceneCullingBVH
+
+#include <GTGE/Core/Vector.hpp>
+#include <glm/glm.hpp>
+
+namespace GT
+{
+    /// A node in a SceneCullingBVH.
+    ///
+    /// Each node holds the bounds of it's four children in a structure of arrays so that all four can be tested against a plane with
+    /// a single set of SIMD instructions.
+    struct SceneCullingBVHNode
+    {
+        float minX[4];
+        float minY[4];
+        float minZ[4];
+        float maxX[4];
+        float maxY[4];
+        float maxZ[4];
+
+        /// The children. A positive value is the index of a child node, a negative value is the bitwise complement of an object slot
+        /// and SceneCullingBVH::EmptyChild is an unused child.
+        int32_t children[4];
+    };
+
+
+    /// A flat bounding volume hierarchy of axis aligned boxes, used for frustum culling.
+    ///
+    /// Objects are stored as a structure of arrays and the tree is a four-wide BVH built over them. A frustum query tests four boxes
+    /// against each plane at a time and writes the IDs of the visible objects to a contiguous buffer rather than calling back for
+    /// each one. A node that is entirely inside the frustum has it's whole sub-tree written out without any further tests.
+    ///
+    /// Adding and removing objects marks the tree for a rebuild, and moving an object marks it for a refit. Neither is done until
+    /// Commit() is called, which should be done once before querying. The const queries are safe to call from multiple threads at
+    /// the same time. If they are called while the tree is out of date, they fall back to testing every object.
+    class SceneCullingBVH
+    {
+    public:
+
+        /// The value of an unused child in a node.
+        static const int32_t EmptyChild = INT32_MIN;
+
+
+        /// Constructor.
+        SceneCullingBVH();
+
+        /// Destructor.
+        ~SceneCullingBVH();
+
+
+        /// Adds an object with the given bounds.
+        ///
+        /// @return The ID of the new object. IDs of removed objects are reused.
+        uint32_t Add(const glm::vec3 &aabbMin, const glm::vec3 &aabbMax);
+
+        /// Removes the given object.
+        void Remove(uint32_t objectID);
+
+        /// Sets the bounds of the given object.
+        void Update(uint32_t objectID, const glm::vec3 &aabbMin, const glm::vec3 &aabbMax);
+
+        /// Removes every object.
+        void Clear();
+
+
+        /// Rebuilds or refits the tree if any objects have been added, removed or moved since the last commit.
+        void Commit();
+
+        /// Determines whether or not the tree needs to be committed before it can be used by queries.
+        bool IsOutOfDate() const { return m_needsRebuild || m_needsRefit; }
+
+
+        /// Retrieves the number of objects.
+        size_t GetObjectCount() const { return m_slotIDs.count; }
+
+        /// Retrieves the number of IDs that have been handed out, including those that are free. Every ID is less than this.
+        size_t GetIDCapacity() const { return m_idSlots.count; }
+
+        /// Retrieves the bounds of the given object.
+        void GetAABB(uint32_t objectID, glm::vec3 &aabbMinOut, glm::vec3 &aabbMaxOut) const;
+
+        /// Retrieves the bounds of every object combined.
+        void GetGlobalAABB(glm::vec3 &aabbMinOut, glm::vec3 &aabbMaxOut) const;
+
+
+        /// Appends the ID of every object whose bounds are inside or intersect the frustum of the given matrix.
+        ///
+        /// @param mvp               [in]  The model-view-projection matrix defining the frustum.
+        /// @param visibleObjectsOut [out] The buffer to append the visible object IDs to.
+        void QueryFrustum(const glm::mat4 &mvp, Vector<uint32_t> &visibleObjectsOut) const;
+
+        /// Appends the ID of every object whose bounds overlap the given box.
+        void QueryAABB(const glm::vec3 &aabbMin, const glm::vec3 &aabbMax, Vector<uint32_t> &objectsOut) const;
+
+        /// Appends the ID of every object.
+        void QueryAll(Vector<uint32_t> &objectsOut) const;
+
+
+
+    private:
+
+        /// An object slot being placed in the tree while building.
+        struct BuildItem
+        {
+            /// The Morton code of the centre of the object's bounds.
+            uint32_t mortonCode;
+
+            /// The object slot.
+            uint32_t slot;
+        };
+
+
+        /// Rebuilds the tree from scratch.
+        void Rebuild();
+
+        /// Recalculates the bounds of every node without changing the structure of the tree.
+        void Refit();
+
+        /// Recursively builds the node for the given range of m_buildItems.
+        int32_t BuildNode(size_t first, size_t count);
+
+        /// Finds where to split the given range of m_buildItems in two.
+        ///
+        /// @return The number of items that go in the first half.
+        size_t FindBuildSplit(size_t first, size_t count) const;
+
+        /// Sets the given child of a node to the given object slot or node, including it's bounds.
+        void SetNodeChild(int32_t nodeIndex, unsigned int childIndex, int32_t child);
+
+        /// Retrieves the bounds of a child, which is either an object slot or a node.
+        void GetChildAABB(int32_t child, glm::vec3 &aabbMinOut, glm::vec3 &aabbMaxOut) const;
+
+
+    private:
+
+        /// The bounds of each object, by slot. Slots are kept packed, with removed objects replaced by the last one.
+        Vector<float> m_minX;
+        Vector<float> m_minY;
+        Vector<float> m_minZ;
+        Vector<float> m_maxX;
+        Vector<float> m_maxY;
+        Vector<float> m_maxZ;
+
+        /// The ID of the object in each slot.
+        Vector<uint32_t> m_slotIDs;
+
+        /// The slot of each ID, or -1 if the ID is free.
+        Vector<int32_t> m_idSlots;
+
+        /// The IDs that are free to be reused.
+        Vector<uint32_t> m_freeIDs;
+
+
+        /// The nodes of the tree. The root is the first node and every node comes before it's children.
+        Vector<SceneCullingBVHNode> m_nodes;
+
+        /// The object slots sorted along a Morton curve. Only used while building.
+        Vector<BuildItem> m_buildItems;
+
+        /// Whether or not objects have been added or removed since the last commit.
+        bool m_needsRebuild;
+
+        /// Whether or not objects have moved since the last commit.
+        bool m_needsRefit;
+
+        /// The number of times the tree has been refitted since it was last rebuilt. The quality of the tree gets worse with each refit
+        /// as objects move away from where they were when it was built, so it's rebuilt every now and then.
+        uint32_t m_refitCount;
+
+
+    private:    // No copying.
+        SceneCullingBVH(const SceneCullingBVH &);
+        SceneCullingBVH & operator=(const SceneCullingBVH &);
+    };
+}
+
+#endif
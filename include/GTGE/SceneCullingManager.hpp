@@ -264,6 +264,27 @@ namespace GT
         ///     It is asserted that the light has a spot light component and is part of the scene.
         virtual void QuerySpotLightContacts(const SceneNode &light, VisibilityCallback &callback) const = 0;
 
+        /// Determines whether or not QueryPointLightContactsConcurrent() and QuerySpotLightContactsConcurrent() can be called from
+        /// multiple threads at the same time.
+        ///
+        /// @remarks
+        ///     The scene must not be modified while the queries are running. The callbacks will be called on the querying threads. This
+        ///     returns false by default.
+        virtual bool IsLightContactQueryThreadSafe() const { return false; }
+
+        /// A version of QueryPointLightContacts() that can be called from multiple threads at the same time.
+        ///
+        /// @remarks
+        ///     This is only called when IsLightContactQueryThreadSafe() returns true. By default this calls QueryPointLightContacts(),
+        ///     which is what a manager whose queries are already thread-safe will want.
+        virtual void QueryPointLightContactsConcurrent(const SceneNode &light, VisibilityCallback &callback) const { this->QueryPointLightContacts(light, callback); }
+
+        /// A version of QuerySpotLightContacts() that can be called from multiple threads at the same time.
+        ///
+        /// @remarks
+        ///     This is only called when IsLightContactQueryThreadSafe() returns true. By default this calls QuerySpotLightContacts().
+        virtual void QuerySpotLightContactsConcurrent(const SceneNode &light, VisibilityCallback &callback) const { this->QuerySpotLightContacts(light, callback); }
+
 
         /////////////////////////////////////////
         // Flags
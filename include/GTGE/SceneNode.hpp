@@ -232,6 +232,11 @@ namespace GT
         
 
         /// Retrieves the world/absolute position of node.
+        ///
+        /// @remarks
+        ///     World transformations are cached and only recalculated after the node or one of it's ancestors has changed. Recalculating
+        ///     writes to the cache, so a node should not have it's world transformation retrieved from multiple threads at the same time
+        ///     unless it's known to be up to date.
         glm::vec3 GetWorldPosition() const;
 
         /// Sets the world/absolute position of the node.
@@ -493,13 +498,13 @@ namespace GT
         template <typename T>
         T * GetComponent()
         {
-            return static_cast<T*>(this->GetComponentByName(T::Name));
+            return static_cast<T*>(this->GetComponentByID(T::GetNameID()));
         }
 
         template <typename T>
         const T* GetComponent() const
         {
-            return static_cast<const T*>(this->GetComponentByName(T::Name));
+            return static_cast<const T*>(this->GetComponentByID(T::GetNameID()));
         }
 
 
@@ -511,6 +516,16 @@ namespace GT
               Component* GetComponentByName(const char* name);
         const Component* GetComponentByName(const char* name) const { return const_cast<SceneNode*>(this)->GetComponentByName(name); }
 
+        /// Retrieves a component based on the interned ID of it's name.
+        ///
+        /// @param  nameID [in] The ID of the name of the component to retrieve, as returned by InternString().
+        ///
+        /// @remarks
+        ///     This is faster than GetComponentByName() since the common components are found by comparing IDs, and the rest are found
+        ///     without hashing the name.
+              Component* GetComponentByID(StringID nameID);
+        const Component* GetComponentByID(StringID nameID) const { return const_cast<SceneNode*>(this)->GetComponentByID(nameID); }
+
 
         /// Adds a component of the type given by 'T'.
         ///
@@ -620,6 +635,21 @@ namespace GT
         ///     This should only be used internally by Scene.
         void _SetScene(Scene* newScene);
 
+        /// Posts any transformation and scaling events that were deferred while the scene was in deferred transform propagation mode.
+        ///
+        /// @remarks
+        ///     This should only be used internally by Scene.
+        void _PostDeferredTransformEvents();
+
+        /// Discards any deferred transformation and scaling events without posting them.
+        ///
+        /// @remarks
+        ///     This should only be used internally by Scene when the node is removed.
+        void _CancelDeferredTransformEvents();
+
+        /// Determines whether or not the node is sitting in it's scene's deferred transform queue.
+        bool _IsInDeferredTransformQueue() const { return (m_deferredTransformFlags & DeferredTransform_Queued) != 0; }
+
 
         /// A helper for removing the scene node from it's current scene.
         void RemoveFromScene();
@@ -690,7 +720,7 @@ namespace GT
         ///     In order for flags to take effect, the scene node should be removed and then re-added to the scene.
         ///     @par
         ///     The accepted flags are those defined in SceneNode::Flags.
-        void SetFlags(unsigned int newFlags) { m_flags = newFlags; }
+        void SetFlags(unsigned int newFlags) { m_flags = newFlags; this->InvalidateWorldTransform(); }
 
         /// Retrieves the scene node's flags.
         ///
@@ -812,6 +842,23 @@ namespace GT
         bool EventsLocked() const;
 
 
+        /// Posts a transformation event, or defers it if the scene is in deferred transform propagation mode.
+        void PostTransformEvent(bool updateDynamicsObject);
+
+        /// Posts a scale event, or defers it if the scene is in deferred transform propagation mode.
+        void PostScaleEvent();
+
+
+        /// Marks the cached world transformation of this node and every descendant as out of date.
+        ///
+        /// @remarks
+        ///     A dirty node always has dirty descendants, so this stops early if the node is already dirty.
+        void InvalidateWorldTransform();
+
+        /// Recalculates the cached world transformation if it is out of date.
+        void UpdateWorldTransform() const;
+
+
 
     private:
 
@@ -848,6 +895,23 @@ namespace GT
         glm::vec3 m_scale;
 
 
+        /// The cached world position. Only valid when m_isWorldTransformDirty is false.
+        mutable glm::vec3 m_worldPosition;
+
+        /// The cached world orientation. Only valid when m_isWorldTransformDirty is false.
+        mutable glm::quat m_worldOrientation;
+
+        /// The cached world scale. Only valid when m_isWorldTransformDirty is false.
+        mutable glm::vec3 m_worldScale;
+
+        /// The cached world transformation matrix, including scale. Only valid when m_isWorldTransformDirty is false.
+        mutable glm::mat4 m_worldTransform;
+
+        /// Whether or not the cached world transformation needs to be recalculated. This is set when the node or any of it's ancestors is
+        /// moved, rotated, scaled or re-parented, and cleared lazily the next time a world transformation is retrieved.
+        mutable bool m_isWorldTransformDirty;
+
+
 
         /// The list of pointers of the event handlers that are attached to this node. This should usually always have at
         /// least a single entry, but doesn't have to.
@@ -876,6 +940,18 @@ namespace GT
         /// will increment, whereas UnlockEvents() will decrement.
         int eventLockCounter;
 
+        /// The transformation events that are waiting to be posted when the scene flushes it's deferred transforms. This is a combination
+        /// of the DeferredTransformFlags bits below. Defaults to 0.
+        unsigned int m_deferredTransformFlags;
+
+        enum DeferredTransformFlags
+        {
+            DeferredTransform_Transform            = (1 << 0),
+            DeferredTransform_UpdateDynamicsObject = (1 << 1),
+            DeferredTransform_Scale                = (1 << 2),
+            DeferredTransform_Queued               = (1 << 3),      // <-- The node is in the scene's queue.
+        };
+
 
         // The component pointers below are used for doing fast retrievals of common components.
 
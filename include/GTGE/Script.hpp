@@ -314,6 +314,9 @@ namespace GT
         */
         bool Call(int numArgs, int numResults = -1);
 
+        /// Retrieves the number of times Call() has been called since the script was created.
+        uint64_t GetCallCount() const { return this->callCount; }
+
 
         /**
         *   \brief                Registers a C function so that it can be called from within this script.
@@ -377,6 +380,38 @@ namespace GT
         void SetGlobal(const char *name);
 
 
+        /**
+        *   \brief             Creates a reference to the value at the given index of the stack and stores it in the registry.
+        *   \param  index [in] The index of the item on the stack to create the reference to.
+        *   \return            The reference, or Script::NoReference if the value is nil.
+        *
+        *   \remarks
+        *       The value is not popped from the stack. The reference keeps the value alive until it is released with ReleaseReference().
+        *       \par
+        *       Pushing a reference with PushReference() is a single array index into the registry, which is much cheaper than walking
+        *       a chain of tables by name. Use this for values that are looked up very frequently, such as per-frame event handlers.
+        */
+        int CreateReference(int index);
+
+        /**
+        *   \brief                 Pushes the value of a reference created with CreateReference() onto the stack.
+        *   \param  reference [in] The reference whose value should be pushed.
+        */
+        void PushReference(int reference);
+
+        /**
+        *   \brief                 Releases a reference that was created with CreateReference().
+        *   \param  reference [in] The reference to release.
+        *
+        *   \remarks
+        *       Releasing Script::NoReference does nothing.
+        */
+        void ReleaseReference(int reference);
+
+        /// The value used to represent a reference that has not been created. This matches LUA_NOREF.
+        static const int NoReference = -2;
+
+
         /**
         *   \brief                 Helper method for pushing the result of the given script onto the stack.
         *   \param  statement [in] The string containing the value that should be pushed onto the stack.
@@ -751,6 +786,9 @@ namespace GT
         /// The list of error handlers that are currently attached to the script.
         Vector<ScriptErrorHandler*> errorHandlers;
 
+        /// The number of times Call() has been called.
+        uint64_t callCount;
+
 
     private:    // No copying.
         Script(const Script &);
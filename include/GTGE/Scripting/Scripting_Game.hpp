@@ -133,8 +133,39 @@ namespace GT
         ///     @par
         ///     Argument 1: The path of the destination directory, relative to the running executable.
         ///     Argument 2: The new name of the executable, not including the path.
+        ///     Argument 3: Whether or not to pack the asset files into a game package. Optional, defaults to false.
+        ///     Argument 4: Whether or not to bake textures. Optional, defaults to false.
         ///     Return:     True if successful.
         int PackageForDistribution(GT::Script &script);
+
+
+        /// Retrieves the names of every stat.
+        ///
+        /// @remarks
+        ///     Return: An array of stat names.
+        int GetStatNames(GT::Script &script);
+
+        /// Retrieves a summary of the recent history of a stat.
+        ///
+        /// @remarks
+        ///     Argument 1: The name of the stat.
+        ///     Return:     A table with 'last', 'min', 'max', 'mean', 'p50', 'p90', 'p99', 'total' and 'frameCount', or nil if the stat does not exist.
+        int GetStatSummary(GT::Script &script);
+
+        /// Retrieves a percentile of the recent history of a stat.
+        ///
+        /// @remarks
+        ///     Argument 1: The name of the stat.
+        ///     Argument 2: The percentile, between 0 and 100.
+        ///     Return:     The value at the given percentile, or nil if the stat does not exist.
+        int GetStatPercentile(GT::Script &script);
+
+        /// Retrieves the recorded hitches.
+        ///
+        /// @remarks
+        ///     Return: An array of tables, oldest first. Each table has 'frameIndex', 'spike' (the name of the time stat that was furthest
+        ///             above it's median, or nil), 'values' and 'medians', where the last two map stat names to values.
+        int GetStatHitches(GT::Script &script);
     }
 }
 
@@ -3,6 +3,8 @@
 #ifndef GT_ShaderParameterCache
 #define GT_ShaderParameterCache
 
+#include "Core/StringID.hpp"
+
 namespace GT
 {
     class Texture2D;
@@ -24,7 +26,7 @@ namespace GT
         ~ShaderParameterCache();
 
 
-        /// Setters.
+        /// Setters. These intern the name. See InternString().
         void Set(const char* name, float x);
         void Set(const char* name, float x, float y)                   { this->Set(name, glm::vec2(x, y)); }
         void Set(const char* name, float x, float y, float z)          { this->Set(name, glm::vec3(x, y, z)); }
@@ -40,6 +42,19 @@ namespace GT
         void Set(const char* name, Texture2D*   texture);
         void Set(const char* name, TextureCube* texture);
 
+        /// Setters taking an interned name.
+        void Set(StringID name, float x);
+        void Set(StringID name, const glm::vec2 &v);
+        void Set(StringID name, const glm::vec3 &v);
+        void Set(StringID name, const glm::vec4 &v);
+
+        void Set(StringID name, const glm::mat2 &v);
+        void Set(StringID name, const glm::mat3 &v);
+        void Set(StringID name, const glm::mat4 &v);
+
+        void Set(StringID name, Texture2D*   texture);
+        void Set(StringID name, TextureCube* texture);
+
 
         /// Unsets a parameter by name.
         void UnsetFloat(const char* name);
@@ -52,6 +67,17 @@ namespace GT
         void UnsetTexture2D(const char* name);
         void UnsetTextureCube(const char* name);
 
+        /// Unsets a parameter by it's interned name.
+        void UnsetFloat(StringID name);
+        void UnsetFloat2(StringID name);
+        void UnsetFloat3(StringID name);
+        void UnsetFloat4(StringID name);
+        void UnsetFloat2x2(StringID name);
+        void UnsetFloat3x3(StringID name);
+        void UnsetFloat4x4(StringID name);
+        void UnsetTexture2D(StringID name);
+        void UnsetTextureCube(StringID name);
+
 
         /// Retrieves a pointer to the given parameter.
         ///
@@ -69,6 +95,21 @@ namespace GT
         const ShaderParameter_Texture2D*   GetTexture2DParameter(const char* name) const;
         const ShaderParameter_TextureCube* GetTextureCubeParameter(const char* name) const;
 
+        /// Retrieves a pointer to the given parameter using an interned name.
+        ///
+        /// @remarks
+        ///     The parameters are keyed by the ID of their name, so this is a binary search over integers. This is the preferred way of
+        ///     looking up parameters every frame.
+        const ShaderParameter_Float*       GetFloatParameter(StringID name) const;
+        const ShaderParameter_Float2*      GetFloat2Parameter(StringID name) const;
+        const ShaderParameter_Float3*      GetFloat3Parameter(StringID name) const;
+        const ShaderParameter_Float4*      GetFloat4Parameter(StringID name) const;
+        const ShaderParameter_Float2x2*    GetFloat2x2Parameter(StringID name) const;
+        const ShaderParameter_Float3x3*    GetFloat3x3Parameter(StringID name) const;
+        const ShaderParameter_Float4x4*    GetFloat4x4Parameter(StringID name) const;
+        const ShaderParameter_Texture2D*   GetTexture2DParameter(StringID name) const;
+        const ShaderParameter_TextureCube* GetTextureCubeParameter(StringID name) const;
+
         
         /// Sets the parameters from another parameter list.
         void SetParameters(const ShaderParameterCache &other);
@@ -85,16 +126,16 @@ namespace GT
         void Clear();
 
 
-        /// Retrieves the internal list of parameters.
-        const Dictionary<ShaderParameter_Float>       & GetFloatParameters()       const { return this->floatParameters;       }
-        const Dictionary<ShaderParameter_Float2>      & GetFloat2Parameters()      const { return this->float2Parameters;      }
-        const Dictionary<ShaderParameter_Float3>      & GetFloat3Parameters()      const { return this->float3Parameters;      }
-        const Dictionary<ShaderParameter_Float4>      & GetFloat4Parameters()      const { return this->float4Parameters;      }
-        const Dictionary<ShaderParameter_Float2x2>    & GetFloat2x2Parameters()    const { return this->float2x2Parameters;    }
-        const Dictionary<ShaderParameter_Float3x3>    & GetFloat3x3Parameters()    const { return this->float3x3Parameters;    }
-        const Dictionary<ShaderParameter_Float4x4>    & GetFloat4x4Parameters()    const { return this->float4x4Parameters;    }
-        const Dictionary<ShaderParameter_Texture2D>   & GetTexture2DParameters()   const { return this->texture2DParameters;   }
-        const Dictionary<ShaderParameter_TextureCube> & GetTextureCubeParameters() const { return this->textureCubeParameters; }
+        /// Retrieves the internal list of parameters. These are keyed by the interned name. Use GetInternedString() to get the name itself.
+        const Map<StringID, ShaderParameter_Float>       & GetFloatParameters()       const { return this->floatParameters;       }
+        const Map<StringID, ShaderParameter_Float2>      & GetFloat2Parameters()      const { return this->float2Parameters;      }
+        const Map<StringID, ShaderParameter_Float3>      & GetFloat3Parameters()      const { return this->float3Parameters;      }
+        const Map<StringID, ShaderParameter_Float4>      & GetFloat4Parameters()      const { return this->float4Parameters;      }
+        const Map<StringID, ShaderParameter_Float2x2>    & GetFloat2x2Parameters()    const { return this->float2x2Parameters;    }
+        const Map<StringID, ShaderParameter_Float3x3>    & GetFloat3x3Parameters()    const { return this->float3x3Parameters;    }
+        const Map<StringID, ShaderParameter_Float4x4>    & GetFloat4x4Parameters()    const { return this->float4x4Parameters;    }
+        const Map<StringID, ShaderParameter_Texture2D>   & GetTexture2DParameters()   const { return this->texture2DParameters;   }
+        const Map<StringID, ShaderParameter_TextureCube> & GetTextureCubeParameters() const { return this->textureCubeParameters; }
 
 
 
@@ -117,15 +158,16 @@ namespace GT
         /// A reference to the main context.
         Context* m_pContext;
 
-        Dictionary<ShaderParameter_Float>       floatParameters;
-        Dictionary<ShaderParameter_Float2>      float2Parameters;
-        Dictionary<ShaderParameter_Float3>      float3Parameters;
-        Dictionary<ShaderParameter_Float4>      float4Parameters;
-        Dictionary<ShaderParameter_Float2x2>    float2x2Parameters;
-        Dictionary<ShaderParameter_Float3x3>    float3x3Parameters;
-        Dictionary<ShaderParameter_Float4x4>    float4x4Parameters;
-        Dictionary<ShaderParameter_Texture2D>   texture2DParameters;
-        Dictionary<ShaderParameter_TextureCube> textureCubeParameters;
+        /// The parameters, keyed by the ID of their interned name so that finding one compares integers rather than strings.
+        Map<StringID, ShaderParameter_Float>       floatParameters;
+        Map<StringID, ShaderParameter_Float2>      float2Parameters;
+        Map<StringID, ShaderParameter_Float3>      float3Parameters;
+        Map<StringID, ShaderParameter_Float4>      float4Parameters;
+        Map<StringID, ShaderParameter_Float2x2>    float2x2Parameters;
+        Map<StringID, ShaderParameter_Float3x3>    float3x3Parameters;
+        Map<StringID, ShaderParameter_Float4x4>    float4x4Parameters;
+        Map<StringID, ShaderParameter_Texture2D>   texture2DParameters;
+        Map<StringID, ShaderParameter_TextureCube> textureCubeParameters;
 
 
 
@@ -0,0 +1,118 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#ifndef GT_SkeletonPose
+#define GT_SkeletonPose
+
+#include "Bone.hpp"
+#include <GTGE/Core/Vector.hpp>
+
+namespace GT
+{
+    /// Class for evaluating the pose of a skeleton in a single linear pass.
+    ///
+    /// Evaluating a skeleton through Bone objects means chasing parent pointers and recomputing the absolute transform of every
+    /// ancestor for every bone. A pose instead stores the skeleton as a set of flat arrays, sorted so that every bone comes after
+    /// it's parent. The model space transform of each bone is then just it's parent's transform multiplied by it's local transform,
+    /// which is done for the whole skeleton in one pass from the start of the arrays to the end.
+    ///
+    /// The skinning transforms are written to a contiguous palette which is indexed by the bone's original index, which is the same
+    /// index used by SkinningVertexAttribute. CPUVertexShader_Skinning reads the palette directly.
+    ///
+    /// The model space transforms are built with matrices, so a bone under a parent with a non-uniform scale will be sheared the
+    /// same way as it would be on the GPU. Bone::GetAbsoluteTransformComponents() composes the scale component-wise instead.
+    class SkeletonPose
+    {
+    public:
+
+        /// Constructor.
+        SkeletonPose();
+
+        /// Destructor.
+        ~SkeletonPose();
+
+
+        /// Builds the pose from the given list of bones, taking the current local transforms and offset matrices of each bone.
+        ///
+        /// @param bones [in] The bones making up the skeleton. Every parent must also be in the list.
+        ///
+        /// @remarks
+        ///     The palette is reallocated by this, so any pointer previously returned by GetSkinningPalette() is invalidated. This
+        ///     calls Evaluate() so the palette is valid straight away.
+        void Build(const Vector<Bone*> &bones);
+
+        /// Clears the pose.
+        void Clear();
+
+
+        /// Sets the local transform of the given bone.
+        ///
+        /// @param boneIndex [in] The index of the bone in the list that was passed to Build().
+        void SetLocalTransform(size_t boneIndex, const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale)
+        {
+            assert(boneIndex < this->sortedIndices.count);
+
+            size_t iSorted = this->sortedIndices.buffer[boneIndex];
+            this->localPositions.buffer[iSorted] = position;
+            this->localRotations.buffer[iSorted] = rotation;
+            this->localScales.buffer[iSorted]    = scale;
+        }
+
+
+        /// Calculates the model space and skinning transforms of every bone from the local transforms.
+        void Evaluate();
+
+
+        /// Retrieves the number of bones.
+        size_t GetBoneCount() const { return this->sortedIndices.count; }
+
+        /// Retrieves the model space transform of the given bone, as of the last call to Evaluate().
+        ///
+        /// @param boneIndex [in] The index of the bone in the list that was passed to Build().
+        const glm::mat4 & GetModelTransform(size_t boneIndex) const { return this->modelTransforms.buffer[this->sortedIndices.buffer[boneIndex]]; }
+
+        /// Retrieves the skinning palette. This is one skinning transform for each bone, in the order of the list passed to Build().
+        const glm::mat4* GetSkinningPalette() const { return this->palette.buffer; }
+
+        /// Retrieves the bounds of the model space positions of every bone, as of the last call to Evaluate().
+        void GetBoneAABB(glm::vec3 &aabbMinOut, glm::vec3 &aabbMaxOut) const;
+
+
+
+    private:
+
+        /// The index of each bone's parent in the sorted arrays, or -1 if it is a root.
+        Vector<int32_t> parentIndices;
+
+        /// The index of each bone in the list passed to Build(), in sorted order.
+        Vector<uint32_t> boneIndices;
+
+        /// The index of each bone in the sorted arrays, in the order of the list passed to Build().
+        Vector<uint32_t> sortedIndices;
+
+
+        /// The local position of each bone, in sorted order.
+        Vector<glm::vec3> localPositions;
+
+        /// The local rotation of each bone, in sorted order.
+        Vector<glm::quat> localRotations;
+
+        /// The local scale of each bone, in sorted order.
+        Vector<glm::vec3> localScales;
+
+        /// The offset matrix of each bone, in sorted order.
+        Vector<glm::mat4> offsetMatrices;
+
+        /// The model space transform of each bone, in sorted order.
+        Vector<glm::mat4> modelTransforms;
+
+        /// The skinning transform of each bone, in the order of the list passed to Build().
+        Vector<glm::mat4> palette;
+
+
+    private:    // No copying.
+        SkeletonPose(const SkeletonPose &);
+        SkeletonPose & operator=(const SkeletonPose &);
+    };
+}
+
+#endif
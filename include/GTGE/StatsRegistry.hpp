@@ -0,0 +1,251 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#ifndef GT_StatsRegistry
+#define GT_StatsRegistry
+
+#include <GTGE/Core/Vector.hpp>
+#include <GTGE/Core/String.hpp>
+#include <cstdint>
+
+namespace GT
+{
+    /// The different types of stats.
+    enum StatType
+    {
+        /// A count of something that happened during the frame. Counters are reset to zero at the end of each frame.
+        StatType_Counter,
+
+        /// A time in milliseconds spent on something during the frame. Like counters, these are reset at the end of each frame.
+        StatType_Time,
+
+        /// A value that is set rather than accumulated, such as the size of something. Gauges keep their value between frames.
+        StatType_Gauge
+    };
+
+
+    /// The stats that are registered by the engine. The ID of each of these stats is the value of the enum.
+    enum EngineStat
+    {
+        EngineStat_FrameTime = 0,           ///< "frame.time"
+        EngineStat_DrawCalls,               ///< "render.draw_calls"
+        EngineStat_VisibleMeshes,           ///< "render.visible_meshes"
+        EngineStat_SkinnedVertices,         ///< "render.skinned_vertices"
+        EngineStat_LiveParticles,           ///< "scene.live_particles"
+        EngineStat_SceneNodes,              ///< "scene.nodes"
+        EngineStat_ScriptCallbacks,         ///< "script.callbacks"
+        EngineStat_AssetBytesLoaded,        ///< "assets.bytes_loaded"
+        EngineStat_UpdateTime,              ///< "time.update"
+        EngineStat_PhysicsTime,             ///< "time.physics"
+        EngineStat_CullingTime,             ///< "time.culling"
+        EngineStat_RenderTime,              ///< "time.render"
+        EngineStat_GUITime,                 ///< "time.gui"
+
+        EngineStat_Count
+    };
+
+
+    /// A summary of the recent history of a stat.
+    struct StatSummary
+    {
+        /// The value of the stat in the last completed frame.
+        double last;
+
+        /// The smallest, largest and mean value over the history.
+        double min;
+        double max;
+        double mean;
+
+        /// The 50th, 90th and 99th percentiles over the history.
+        double p50;
+        double p90;
+        double p99;
+
+        /// The sum of every value the stat has had since it was registered. This is only meaningful for counters and times.
+        double total;
+
+        /// The number of frames in the history.
+        size_t frameCount;
+    };
+
+
+    /// A frame that took longer than the hitch threshold.
+    struct StatsHitch
+    {
+        /// The index of the frame.
+        uint64_t frameIndex;
+
+        /// The value of every stat during the frame, indexed by stat ID.
+        Vector<double> values;
+
+        /// The median value of every stat over the history at the time of the hitch, indexed by stat ID.
+        Vector<double> medians;
+
+        /// The time stat (other than the frame time) that was furthest above it's median, or StatsRegistry::InvalidStat if none were.
+        uint32_t spikeStat;
+    };
+
+
+    /// A registry of named per-frame stats.
+    ///
+    /// Every stat keeps a history of it's value at the end of each of the last frames, which is used for min/max/percentile queries.
+    /// When a frame takes longer than the hitch threshold, the value of every stat during that frame is recorded so that the cause of
+    /// the hitch can be found later.
+    ///
+    /// Stats can be updated from any thread. Registering stats and ending frames should be done on the main thread.
+    class StatsRegistry
+    {
+    public:
+
+        /// The ID returned when a stat is not found.
+        static const uint32_t InvalidStat = UINT32_MAX;
+
+        /// The default number of frames of history kept by each stat.
+        static const size_t DefaultHistorySize = 600;
+
+        /// The number of hitches that are kept. Older hitches are discarded.
+        static const size_t MaxHitches = 16;
+
+
+        /// Constructor.
+        ///
+        /// @remarks
+        ///     The engine's own stats are registered here, in the order of the EngineStat enum.
+        StatsRegistry(size_t historySize = DefaultHistorySize);
+
+        /// Destructor.
+        ~StatsRegistry();
+
+
+        /// Registers a new stat, or returns the ID of the existing one with the same name.
+        ///
+        /// @param name [in] The name of the stat.
+        /// @param type [in] The type of the stat.
+        ///
+        /// @return The ID of the stat.
+        uint32_t Register(const char* name, StatType type);
+
+        /// Finds the ID of the stat with the given name.
+        ///
+        /// @return The ID of the stat, or InvalidStat if it does not exist.
+        uint32_t Find(const char* name) const;
+
+        /// Retrieves the number of stats. Stat IDs are in the range of [0, GetCount()).
+        size_t GetCount() const { return m_stats.count; }
+
+        /// Retrieves the name of the given stat.
+        const char* GetName(uint32_t statID) const;
+
+        /// Retrieves the type of the given stat.
+        StatType GetType(uint32_t statID) const;
+
+
+        /// Adds to the value of a counter or time during the current frame.
+        void Add(uint32_t statID, double amount = 1);
+
+        /// Sets the value of a gauge.
+        void Set(uint32_t statID, double value);
+
+        /// Retrieves the value of the stat during the current frame so far.
+        double GetValue(uint32_t statID) const;
+
+
+        /// Retrieves a summary of the recent history of the given stat.
+        void GetSummary(uint32_t statID, StatSummary &summaryOut) const;
+
+        /// Retrieves the given percentile of the recent history of the given stat.
+        ///
+        /// @param percentile [in] The percentile, in the range of [0, 100].
+        double GetPercentile(uint32_t statID, double percentile) const;
+
+
+        /// Sets the frame time, in seconds, above which a frame is recorded as a hitch. This defaults to 1/30 of a second.
+        void SetHitchThreshold(double thresholdInSeconds);
+
+        /// Retrieves the hitch threshold, in seconds.
+        double GetHitchThreshold() const { return m_hitchThreshold; }
+
+        /// Retrieves the number of recorded hitches.
+        size_t GetHitchCount() const { return m_hitches.count; }
+
+        /// Retrieves the given hitch. Hitches are ordered oldest first.
+        const StatsHitch & GetHitch(size_t index) const { return *m_hitches[index]; }
+
+
+        /// Ends the current frame.
+        ///
+        /// @param frameTimeInSeconds [in] The time the frame took, in seconds. This is the value of EngineStat_FrameTime.
+        ///
+        /// @remarks
+        ///     This pushes the value of every stat onto it's history, records a hitch if the frame took too long, and resets counters
+        ///     and times to zero.
+        void EndFrame(double frameTimeInSeconds);
+
+        /// Retrieves the number of frames that have ended.
+        uint64_t GetFrameCount() const { return m_frameCount; }
+
+
+
+    private:
+
+        /// A single stat.
+        struct Stat
+        {
+            /// The name of the stat.
+            String name;
+
+            /// The type of the stat.
+            StatType type;
+
+            /// The value of the stat during the current frame.
+            double value;
+
+            /// The sum of every value the stat has had at the end of a frame.
+            double total;
+
+            /// The ring buffer of values at the end of each frame. This always has m_historySize items.
+            Vector<double> history;
+
+            /// The number of frames written to the history, including those that have been overwritten.
+            size_t historyWritten;
+        };
+
+
+        /// Copies the history of the given stat into m_sortBuffer, oldest first.
+        ///
+        /// @remarks
+        ///     This must be called with the lock held.
+        void CopyHistory(const Stat &stat) const;
+
+        /// Retrieves the given percentile of the values in m_sortBuffer, reordering it in the process.
+        double GetSortBufferPercentile(double percentile) const;
+
+
+        /// The lock for the stats.
+        mutable dr_mutex m_lock;
+
+        /// The stats, indexed by ID.
+        Vector<Stat*> m_stats;
+
+        /// The number of frames of history kept by each stat.
+        size_t m_historySize;
+
+        /// The number of frames that have ended.
+        uint64_t m_frameCount;
+
+        /// The frame time above which a frame is a hitch.
+        double m_hitchThreshold;
+
+        /// The recorded hitches, oldest first.
+        Vector<StatsHitch*> m_hitches;
+
+        /// The buffer used for sorting history when calculating percentiles.
+        mutable Vector<double> m_sortBuffer;
+
+
+    private:    // No copying.
+        StatsRegistry(const StatsRegistry &);
+        StatsRegistry & operator=(const StatsRegistry &);
+    };
+}
+
+#endif
@@ -109,6 +109,38 @@ namespace GT
 
     private:
 
+        /// Loads the data of the given texture from the given image file, using its baked texture if there is an up-to-date one.
+        ///
+        /// @param texture     [in] The texture to load the data into.
+        /// @param absFileName [in] The absolute path of the image file.
+        ///
+        /// @return True if the data is loaded successfully; false otherwise.
+        bool LoadTextureData(Texture2D &texture, const char* absFileName);
+
+        /// Loads the data of the given texture from the baked texture of the given image file.
+        ///
+        /// @param texture    [in] The texture to load the data into.
+        /// @param sourceInfo [in] The file info of the image file.
+        ///
+        /// @return True if the baked texture exists, is newer than the image and can be used by the renderer; false otherwise.
+        ///
+        /// @remarks
+        ///     See BakedTexture.
+        bool LoadBakedTextureData(Texture2D &texture, const drfs_file_info &sourceInfo);
+
+        /// Sets the data of the given texture from the contents of a baked texture file.
+        ///
+        /// @return True if the baked texture is valid and can be used by the renderer; false otherwise.
+        bool SetBakedTextureData(Texture2D &texture, const void* pData, size_t dataSize, const char* bakedAbsolutePath);
+
+        /// Loads the data of the given texture from an image file in a game package.
+        ///
+        /// @remarks
+        ///     The baked texture in the same package is used if there is one, which is always up-to-date. Otherwise the image is decoded by
+        ///     the asset library, since the image loaders only read from the file system.
+        bool LoadPackagedTextureData(Texture2D &texture, const char* absFileName);
+
+
         /// A reference to the context that owns this library.
         Context &m_context;
 
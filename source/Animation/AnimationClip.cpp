@@ -0,0 +1,105 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#include <GTGE/Animation/AnimationClip.hpp>
+#include <GTGE/Animation/Animation.hpp>
+
+namespace GT
+{
+    AnimationClip::AnimationClip()
+        : times(), positions(), rotations(), scales(), hasKey(), channelCount(0)
+    {
+    }
+
+    AnimationClip::~AnimationClip()
+    {
+    }
+
+
+    void AnimationClip::Bake(const Animation &animation, const Vector<const AnimationChannel*> &channels)
+    {
+        this->Clear();
+
+        size_t keyFrameCount = animation.GetKeyFrameCount();
+        size_t keyCount      = channels.count * keyFrameCount;
+
+        this->times.Resize(keyFrameCount);
+        for (size_t iKeyFrame = 0; iKeyFrame < keyFrameCount; ++iKeyFrame)
+        {
+            this->times[iKeyFrame] = static_cast<float>(animation.GetKeyFrameTimeByIndex(iKeyFrame));
+        }
+
+        this->positions.Resize(keyCount);
+        this->rotations.Resize(keyCount);
+        this->scales.Resize(keyCount);
+        this->hasKey.Resize(keyCount);
+        this->channelCount = channels.count;
+
+        for (size_t iKey = 0; iKey < keyCount; ++iKey)
+        {
+            this->positions[iKey] = glm::vec3(0.0f, 0.0f, 0.0f);
+            this->rotations[iKey] = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+            this->scales[iKey]    = glm::vec3(1.0f, 1.0f, 1.0f);
+            this->hasKey[iKey]    = 0;
+        }
+
+
+        for (size_t iChannel = 0; iChannel < channels.count; ++iChannel)
+        {
+            auto channel = channels[iChannel];
+            assert(channel != nullptr);
+
+            auto &keys = channel->GetKeys();
+            for (size_t iKey = 0; iKey < keys.count; ++iKey)
+            {
+                size_t keyFrameIndex = keys.buffer[iKey]->key;
+                auto   key           = static_cast<const TransformAnimationKey*>(keys.buffer[iKey]->value);
+
+                if (keyFrameIndex < keyFrameCount && key != nullptr)
+                {
+                    size_t index = iChannel * keyFrameCount + keyFrameIndex;
+
+                    this->positions[index] = key->position;
+                    this->rotations[index] = key->rotation;
+                    this->scales[index]    = key->scale;
+                    this->hasKey[index]    = 1;
+                }
+            }
+        }
+    }
+
+    void AnimationClip::Clear()
+    {
+        this->times.Clear();
+        this->positions.Clear();
+        this->rotations.Clear();
+        this->scales.Clear();
+        this->hasKey.Clear();
+        this->channelCount = 0;
+    }
+
+
+    bool AnimationClip::Sample(size_t channelIndex, size_t startKeyFrame, size_t endKeyFrame, float interpolationFactor, glm::vec3 &positionOut, glm::quat &rotationOut, glm::vec3 &scaleOut) const
+    {
+        assert(channelIndex < this->channelCount);
+
+        size_t keyFrameCount = this->times.count;
+        if (startKeyFrame >= keyFrameCount || endKeyFrame >= keyFrameCount)
+        {
+            return false;
+        }
+
+        size_t iStart = channelIndex * keyFrameCount + startKeyFrame;
+        size_t iEnd   = channelIndex * keyFrameCount + endKeyFrame;
+
+        if (this->hasKey[iStart] == 0 || this->hasKey[iEnd] == 0)
+        {
+            return false;
+        }
+
+        positionOut = glm::mix(  this->positions[iStart], this->positions[iEnd], interpolationFactor);
+        rotationOut = glm::slerp(this->rotations[iStart], this->rotations[iEnd], interpolationFactor);
+        scaleOut    = glm::mix(  this->scales[iStart],    this->scales[iEnd],    interpolationFactor);
+
+        return true;
+    }
+}
@@ -6,7 +6,7 @@
 namespace GT
 {
     AnimationTrack::AnimationTrack()
-        : localKeyFrames()
+        : localKeyFrames(), cursor(0)
     {
     }
 
@@ -35,6 +35,7 @@ namespace GT
     void AnimationTrack::Clear()
     {
         this->localKeyFrames.Clear();
+        this->cursor = 0;
     }
 
     float AnimationTrack::GetTotalDuration() const
@@ -60,8 +61,13 @@ namespace GT
         size_t iEndKeyFrame   = 0;
 
 
-        // Start key.
+        // Start key. Every key frame before the cursor is earlier than the cursor, so if the time hasn't gone backwards we can start there.
         size_t iKeyFrame = 0;
+        if (this->cursor < this->localKeyFrames.count && this->localKeyFrames[this->cursor].time < time)
+        {
+            iKeyFrame = this->cursor;
+        }
+
         while (iKeyFrame < this->localKeyFrames.count)
         {
             if (this->localKeyFrames[iKeyFrame].time >= time)
@@ -76,6 +82,8 @@ namespace GT
             ++iKeyFrame;
         }
 
+        this->cursor = iStartKeyFrame;
+
         // End key.
         if (iStartKeyFrame == this->localKeyFrames.count - 1)       // <-- Are we at the end of the track?
         {
@@ -140,7 +148,7 @@ namespace GT
 
     void AnimationTrack::Deserialize(Deserializer &deserializer)
     {
-        this->localKeyFrames.Clear();
+        this->Clear();
 
 
         Serialization::ChunkHeader header;
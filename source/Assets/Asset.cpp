@@ -60,4 +60,27 @@ namespace GT
             return false;
         }
     }
+
+    bool Asset::LoadMetadataFromMemory(const void* pData, size_t dataSizeInBytes)
+    {
+        if (pData == nullptr)
+        {
+            return false;
+        }
+
+        BasicDeserializer deserializer(pData, dataSizeInBytes);
+        m_metadata.Deserialize(deserializer);
+
+        return true;
+    }
+
+
+    bool Asset::LoadFromMemory(const char* absolutePath, const void* pData, size_t dataSizeInBytes)
+    {
+        (void)absolutePath;
+        (void)pData;
+        (void)dataSizeInBytes;
+
+        return false;
+    }
 }
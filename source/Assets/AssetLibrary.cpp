@@ -3,6 +3,8 @@
 #include <GTGE/Assets/AssetLibrary.hpp>
 #include <GTGE/Assets/Asset.hpp>
 #include <GTGE/Assets/AssetAllocator.hpp>
+#include <GTGE/GamePackage.hpp>
+#include <GTGE/Profiler.hpp>
 
 #if defined(GT_BUILD_DEFAULT_ASSETS)
 #include "DefaultAssetAllocator.hpp"
@@ -10,11 +12,74 @@
 
 namespace GT
 {
+    /// Retrieves a pointer to the data of a package entry, decompressing it into a new buffer if it's compressed.
+    ///
+    /// @remarks
+    ///     If pBufferOut is set to something other than null it must be freed with free() once the data is no longer needed. Null is returned
+    ///     if the entry is corrupt.
+    static const void* AssetLibrary_GetPackageEntryData(const GamePackage* pPackage, uint32_t entryIndex, void* &pBufferOut)
+    {
+        pBufferOut = nullptr;
+
+        // Uncompressed entries are read straight out of the mapping.
+        const void* pData = pPackage->GetEntryData(entryIndex);
+        if (pData == nullptr)
+        {
+            size_t dataSize = static_cast<size_t>(pPackage->GetEntrySize(entryIndex));
+
+            pBufferOut = malloc((dataSize > 0) ? dataSize : 1);
+            if (pBufferOut != nullptr && pPackage->ReadEntry(entryIndex, pBufferOut))
+            {
+                pData = pBufferOut;
+            }
+            else
+            {
+                free(pBufferOut);
+                pBufferOut = nullptr;
+            }
+        }
+
+        return pData;
+    }
+
+    /// Finds the entry of a file in the given package.
+    ///
+    /// @remarks
+    ///     An absolute path can only refer to an entry if it's inside the package. GamePackage::InvalidEntry is returned if the file is not
+    ///     in the package.
+    static uint32_t AssetLibrary_FindPackageEntry(const GamePackage* pPackage, const char* filePath)
+    {
+        const char* entryPath = filePath;
+        if (drpath_is_absolute(filePath))
+        {
+            if (!drpath_is_descendant(filePath, pPackage->GetAbsolutePath()))
+            {
+                return GamePackage::InvalidEntry;
+            }
+
+            entryPath = filePath + strlen(pPackage->GetAbsolutePath());
+        }
+
+        return pPackage->FindEntry(entryPath);
+    }
+
+
+
     AssetLibrary::AssetLibrary()
         : m_pVFS(nullptr),
           m_allocators(),
+          m_packages(),
           m_loadedAssets(),
-          m_mutex()
+          m_mutex(),
+          m_inFlightLoads(),
+          m_loadQueue(),
+          m_loadQueueSemaphore(NULL),
+          m_loaderThreads(),
+          m_isTerminating(false),
+          m_pendingAsyncLoads(),
+          m_completedAsyncLoads(),
+          m_nextAsyncLoadHandle(1),
+          m_bytesLoaded(0)
 #if defined(GT_BUILD_DEFAULT_ASSETS)
         , m_pDefaultAssetAllocator(nullptr)
 #endif
@@ -26,7 +91,7 @@ namespace GT
     }
     
 
-    bool AssetLibrary::Startup(drfs_context* pVFS)
+    bool AssetLibrary::Startup(drfs_context* pVFS, unsigned int loaderThreadCount)
     {
         // Don't do anything if it's already been initialized.
         if (m_pVFS == nullptr)
@@ -39,6 +104,23 @@ namespace GT
             m_pDefaultAssetAllocator = new DefaultAssetAllocator();
             this->RegisterAllocator(*m_pDefaultAssetAllocator);
 #endif
+
+            // If the loader threads fail to start, asynchronous loads will fall back to running in DispatchCompletedLoads().
+            m_isTerminating      = false;
+            m_loadQueueSemaphore = dr_create_semaphore(0);
+            if (m_loadQueueSemaphore != NULL)
+            {
+                for (unsigned int iThread = 0; iThread < loaderThreadCount; ++iThread)
+                {
+                    dr_thread thread = dr_create_thread(LoaderThreadProc, this);
+                    if (thread == NULL)
+                    {
+                        break;
+                    }
+
+                    m_loaderThreads.PushBack(thread);
+                }
+            }
         }
 
         return m_pVFS != nullptr;
@@ -46,6 +128,56 @@ namespace GT
 
     void AssetLibrary::Shutdown()
     {
+        if (m_pVFS == nullptr)
+        {
+            return;
+        }
+
+
+        // The loader threads need to be stopped first so that nothing is being loaded while the assets are deleted. Each thread needs
+        // to be woken up so it can see that it needs to terminate.
+        m_isTerminating = true;
+        for (size_t iThread = 0; iThread < m_loaderThreads.count; ++iThread)
+        {
+            dr_release_semaphore(m_loadQueueSemaphore);
+        }
+
+        for (size_t iThread = 0; iThread < m_loaderThreads.count; ++iThread)
+        {
+            dr_wait_thread(m_loaderThreads[iThread]);
+            dr_delete_thread(m_loaderThreads[iThread]);
+        }
+        m_loaderThreads.Clear();
+
+        if (m_loadQueueSemaphore != NULL)
+        {
+            dr_delete_semaphore(m_loadQueueSemaphore);
+            m_loadQueueSemaphore = NULL;
+        }
+
+
+        // Loads that never started are cancelled. Once they're done there can't be any pending asynchronous loads left.
+        dr_lock_mutex(m_mutex);
+        {
+            for (size_t iLoad = 0; iLoad < m_loadQueue.count; ++iLoad)
+            {
+                this->CompleteLoad(m_loadQueue[iLoad], false, 0);
+            }
+            m_loadQueue.Clear();
+
+            assert(m_pendingAsyncLoads.count == 0);
+            assert(m_inFlightLoads.count     == 0);
+
+            // The assets of the completed loads are deleted with everything else below.
+            for (size_t iAsyncLoad = 0; iAsyncLoad < m_completedAsyncLoads.count; ++iAsyncLoad)
+            {
+                delete m_completedAsyncLoads[iAsyncLoad];
+            }
+            m_completedAsyncLoads.Clear();
+        }
+        dr_unlock_mutex(m_mutex);
+
+
         for (size_t iAsset = 0; iAsset < m_loadedAssets.count; ++iAsset)
         {
             auto pAsset = m_loadedAssets.buffer[iAsset]->value;
@@ -62,6 +194,13 @@ namespace GT
         m_loadedAssets.Clear();
         m_allocators.Clear();
 
+        // Packages are unmapped last since assets may still have been referencing them up until they were deleted.
+        for (size_t iPackage = 0; iPackage < m_packages.count; ++iPackage)
+        {
+            delete m_packages[iPackage];
+        }
+        m_packages.Clear();
+
 
 
 #if defined(GT_BUILD_DEFAULT_ASSETS)
@@ -82,99 +221,150 @@ namespace GT
     }
 
 
-    Asset* AssetLibrary::Load(const char* filePathOrIdentifier, AssetType explicitAssetType)
+    bool AssetLibrary::MountPackage(const char* absolutePath)
     {
-        // When an asset is cached, the absolute path is used to retrieve the cached object. It is possible, however, for an asset to not actually
-        // be loaded from a file, in which case filePathOrIdentifier is used as the unique identifier without any modification.
+        auto pPackage = new GamePackage;
+        if (!pPackage->Open(absolutePath))
+        {
+            delete pPackage;
+            return false;
+        }
 
-        char absolutePathOrIdentifier[DRFS_MAX_PATH];
-        if (!drfs_find_absolute_path(m_pVFS, filePathOrIdentifier, absolutePathOrIdentifier, sizeof(absolutePathOrIdentifier)))
+        // The most recently mounted package has the highest priority.
+        m_packages.InsertAt(pPackage, 0);
+
+        return true;
+    }
+
+    size_t AssetLibrary::GetPackageCount() const
+    {
+        return m_packages.count;
+    }
+
+    bool AssetLibrary::FindAbsolutePath(const char* filePath, char* absolutePathOut, size_t absolutePathOutSize) const
+    {
+        for (size_t iPackage = 0; iPackage < m_packages.count; ++iPackage)
         {
-            // The file could not be found, but there may be a metadata file. It is possible that the data for an asset is
-            // entirely defined in the metadata file, we'll look for that file too.
-            char metadataPath[DRFS_MAX_PATH];
-            drpath_copy_and_append_extension(metadataPath, DRFS_MAX_PATH, filePathOrIdentifier, "gtdata");
+            auto pPackage = m_packages[iPackage];
+            assert(pPackage != nullptr);
 
-            if (drfs_find_absolute_path(m_pVFS, metadataPath, absolutePathOrIdentifier, sizeof(absolutePathOrIdentifier)))
+            uint32_t entryIndex = AssetLibrary_FindPackageEntry(pPackage, filePath);
+            if (entryIndex != GamePackage::InvalidEntry)
             {
-                // The metadata file was found. Later on we'll load the metadata for real, so we'll need to remove the ".gtdata" extension beforehand.
-                drpath_remove_extension(absolutePathOrIdentifier);
-            }
-            else
-            {
-                // The file nor it's metadata file could not be found, but the asset loader might be using it as a unique identifier, so we just use it as-is in this case.
-                strcpy_s(absolutePathOrIdentifier, filePathOrIdentifier);
+                drpath_copy_and_append(absolutePathOut, absolutePathOutSize, pPackage->GetAbsolutePath(), pPackage->GetEntryPath(entryIndex));
+                return true;
             }
         }
 
+        if (drfs_find_absolute_path(m_pVFS, filePath, absolutePathOut, absolutePathOutSize))
+        {
+            return true;
+        }
 
-        Asset* pAsset = nullptr;
-        dr_lock_mutex(m_mutex);
+        // Files that were packed are not next to the package, so an absolute path that was made from a base directory is looked up in the
+        // packages relative to that base directory.
+        if (m_packages.count > 0 && drpath_is_absolute(filePath))
         {
-            auto iExistingAsset = m_loadedAssets.Find(absolutePathOrIdentifier);
-            if (iExistingAsset == nullptr)
+            unsigned int baseDirectoryCount = drfs_get_base_directory_count(m_pVFS);
+            for (unsigned int iBaseDirectory = 0; iBaseDirectory < baseDirectoryCount; ++iBaseDirectory)
             {
-                AssetAllocator* pAllocator = nullptr;
-
-                AssetType assetType = explicitAssetType;
-                if (assetType == AssetType_Unknown)
-                {
-                    pAllocator = this->FindAllocatorAndTypeByPath(absolutePathOrIdentifier, assetType);
-                }
-                else
+                const char* baseDirectory = drfs_get_base_directory_by_index(m_pVFS, iBaseDirectory);
+                if (drpath_is_descendant(filePath, baseDirectory))
                 {
-                    pAllocator = this->FindAllocatorByType(assetType);
-                }
+                    char relativePath[DRFS_MAX_PATH];
+                    drpath_to_relative(filePath, baseDirectory, relativePath, sizeof(relativePath));
 
-
-                if (pAllocator != nullptr)
-                {
-                    pAsset = pAllocator->CreateAsset(absolutePathOrIdentifier, assetType);
-                    if (pAsset != nullptr)
+                    for (size_t iPackage = 0; iPackage < m_packages.count; ++iPackage)
                     {
-                        // Load the metadata first. It does not matter if this fails so the return value doesn't need to be checked.
-                        char metadataAbsolutePath[DRFS_MAX_PATH];
-                        drpath_copy_and_append_extension(metadataAbsolutePath, DRFS_MAX_PATH, absolutePathOrIdentifier, "gtdata");
-                        pAsset->LoadMetadata(metadataAbsolutePath, m_pVFS);
+                        auto pPackage = m_packages[iPackage];
+                        assert(pPackage != nullptr);
 
-
-                        // Load the asset after the metadata.
-                        if (pAsset->Load(absolutePathOrIdentifier, m_pVFS))
-                        {
-                            m_loadedAssets.Add(absolutePathOrIdentifier, pAsset);
-                        }
-                        else
+                        uint32_t entryIndex = pPackage->FindEntry(relativePath);
+                        if (entryIndex != GamePackage::InvalidEntry)
                         {
-                            // Failed to load the asset.
-                            pAllocator->DeleteAsset(pAsset);
-                            pAsset = nullptr;
+                            drpath_copy_and_append(absolutePathOut, absolutePathOutSize, pPackage->GetAbsolutePath(), pPackage->GetEntryPath(entryIndex));
+                            return true;
                         }
                     }
-                    else
-                    {
-                        // Failed to create an asset of the given type.
-                        pAsset = nullptr;
-                    }
-                }
-                else
-                {
-                    // Could not find a supported allocator.
-                    pAsset = nullptr;
                 }
             }
-            else
+        }
+
+        return false;
+    }
+
+    bool AssetLibrary::IsPackagePath(const char* absolutePath) const
+    {
+        const char* entryPath;
+        return this->FindPackageByAbsolutePath(absolutePath, entryPath) != nullptr;
+    }
+
+    const void* AssetLibrary::GetPackageFileData(const char* absolutePath, size_t &dataSizeOut, void* &pBufferOut) const
+    {
+        dataSizeOut = 0;
+        pBufferOut  = nullptr;
+
+        const char* entryPath;
+        GamePackage* pPackage = this->FindPackageByAbsolutePath(absolutePath, entryPath);
+        if (pPackage == nullptr)
+        {
+            return nullptr;
+        }
+
+        uint32_t entryIndex = pPackage->FindEntry(entryPath);
+        if (entryIndex == GamePackage::InvalidEntry)
+        {
+            return nullptr;
+        }
+
+        const void* pData = AssetLibrary_GetPackageEntryData(pPackage, entryIndex, pBufferOut);
+        if (pData != nullptr)
+        {
+            dataSizeOut = static_cast<size_t>(pPackage->GetEntrySize(entryIndex));
+        }
+
+        return pData;
+    }
+
+
+    Asset* AssetLibrary::Load(const char* filePathOrIdentifier, AssetType explicitAssetType)
+    {
+        GT_PROFILE_ZONE("AssetLibrary::Load");
+
+        char absolutePathOrIdentifier[DRFS_MAX_PATH];
+        this->FindAbsolutePathOrIdentifier(filePathOrIdentifier, absolutePathOrIdentifier, sizeof(absolutePathOrIdentifier));
+
+
+        // The lock is only held while looking at the cache. The asset itself is loaded without it so that other assets can load at the same time.
+        Asset* pAsset = nullptr;
+        InFlightLoad* pLoad = nullptr;
+        bool executeLoad = false;
+        dr_lock_mutex(m_mutex);
+        {
+            pAsset = this->AcquireOrBeginLoad(absolutePathOrIdentifier, explicitAssetType, pLoad, executeLoad);
+            if (pLoad != nullptr && !executeLoad)
             {
-                auto pExistingAsset = iExistingAsset->value;
-                assert(pExistingAsset != nullptr);
+                // The asset is already being loaded. If a loader thread hasn't got to it yet we just take it and load it ourselves rather
+                // than waiting for everything in front of it in the queue.
+                size_t iQueuedLoad;
+                if (m_loadQueue.FindFirstIndexOf(pLoad, iQueuedLoad))
                 {
-                    pExistingAsset->IncrementReferenceCount();
+                    m_loadQueue.Remove(iQueuedLoad);
+                    executeLoad = true;
+                }
+                else
+                {
+                    pAsset = this->WaitForInFlightLoad(pLoad);
                 }
-
-                pAsset = iExistingAsset->value;
             }
         }
         dr_unlock_mutex(m_mutex);
 
+        if (executeLoad)
+        {
+            pAsset = this->ExecuteLoad(pLoad);
+        }
+
         return pAsset;
     }
 
@@ -228,17 +418,7 @@ namespace GT
     void AssetLibrary::Reload(const char* filePathOrIdentifier)
     {
         char absolutePathOrIdentifier[DRFS_MAX_PATH];
-        if (!drfs_find_absolute_path(m_pVFS, filePathOrIdentifier, absolutePathOrIdentifier, sizeof(absolutePathOrIdentifier)))
-        {
-            char metadataPath[DRFS_MAX_PATH];
-            drpath_copy_and_append_extension(metadataPath, DRFS_MAX_PATH, filePathOrIdentifier, "gtdata");
-
-            if (!drfs_find_absolute_path(m_pVFS, metadataPath, absolutePathOrIdentifier, sizeof(absolutePathOrIdentifier)))
-            {
-                // The file nor it's metadata file could not be found, but the asset loader might be using it as a unique token, so we just assume use it as-is for the absolute path in this case.
-                strcpy_s(absolutePathOrIdentifier, filePathOrIdentifier);
-            }
-        }
+        this->FindAbsolutePathOrIdentifier(filePathOrIdentifier, absolutePathOrIdentifier, sizeof(absolutePathOrIdentifier));
 
         dr_lock_mutex(m_mutex);
         {
@@ -248,14 +428,10 @@ namespace GT
                 auto pAsset = iAsset->value;
                 assert(pAsset != nullptr);
                 {
-                    // Load the metadata first. It does not matter if this fails so the return value doesn't need to be checked.
-                    char metadataAbsolutePath[DRFS_MAX_PATH];
-                    drpath_copy_and_append_extension(metadataAbsolutePath, DRFS_MAX_PATH, filePathOrIdentifier, "gtdata");
-                    pAsset->LoadMetadata(metadataAbsolutePath, m_pVFS);
-
-                    // Load the asset after the metadata.
-                    if (pAsset->Load(absolutePathOrIdentifier, m_pVFS))
+                    uint64_t fileSizeInBytes;
+                    if (this->LoadAssetData(pAsset, absolutePathOrIdentifier, fileSizeInBytes))
                     {
+                        m_bytesLoaded += fileSizeInBytes;
                     }
                     else
                     {
@@ -268,6 +444,160 @@ namespace GT
     }
 
 
+    AssetLoadHandle AssetLibrary::LoadAsync(const char* filePathOrIdentifier, AssetType explicitAssetType, AssetLoadCallback callback, void* pUserData)
+    {
+        if (callback == nullptr)
+        {
+            return 0;
+        }
+
+        char absolutePathOrIdentifier[DRFS_MAX_PATH];
+        this->FindAbsolutePathOrIdentifier(filePathOrIdentifier, absolutePathOrIdentifier, sizeof(absolutePathOrIdentifier));
+
+        auto pAsyncLoad = new AsyncLoad;
+        pAsyncLoad->callback  = callback;
+        pAsyncLoad->pUserData = pUserData;
+        pAsyncLoad->pLoad     = nullptr;
+        pAsyncLoad->pAsset    = nullptr;
+
+        AssetLoadHandle handle;
+        bool isNewLoad = false;
+        dr_lock_mutex(m_mutex);
+        {
+            // 0 is never a valid handle, so it's skipped when the counter wraps around.
+            handle = m_nextAsyncLoadHandle;
+            m_nextAsyncLoadHandle = (m_nextAsyncLoadHandle == UINT32_MAX) ? 1 : m_nextAsyncLoadHandle + 1;
+
+            pAsyncLoad->handle = handle;
+
+            InFlightLoad* pLoad = nullptr;
+            Asset* pAsset = this->AcquireOrBeginLoad(absolutePathOrIdentifier, explicitAssetType, pLoad, isNewLoad);
+            if (pLoad != nullptr)
+            {
+                pAsyncLoad->pLoad = pLoad;
+                pLoad->asyncLoads.PushBack(pAsyncLoad);
+                m_pendingAsyncLoads.PushBack(pAsyncLoad);
+
+                if (isNewLoad)
+                {
+                    m_loadQueue.PushBack(pLoad);
+                }
+            }
+            else
+            {
+                // Either the asset is already loaded or it can't be loaded at all. The callback is still delivered from DispatchCompletedLoads().
+                pAsyncLoad->pAsset = pAsset;
+                m_completedAsyncLoads.PushBack(pAsyncLoad);
+            }
+        }
+        dr_unlock_mutex(m_mutex);
+
+        if (isNewLoad && m_loaderThreads.count > 0)
+        {
+            dr_release_semaphore(m_loadQueueSemaphore);
+        }
+
+        return handle;
+    }
+
+    bool AssetLibrary::IsAsyncLoadComplete(AssetLoadHandle handle) const
+    {
+        bool isComplete;
+        dr_lock_mutex(m_mutex);
+        {
+            auto pAsyncLoad = this->FindAsyncLoad(handle);
+            isComplete = pAsyncLoad == nullptr || pAsyncLoad->pLoad == nullptr;
+        }
+        dr_unlock_mutex(m_mutex);
+
+        return isComplete;
+    }
+
+    void AssetLibrary::WaitForAsyncLoad(AssetLoadHandle handle)
+    {
+        InFlightLoad* pLoadToExecute = nullptr;
+        dr_lock_mutex(m_mutex);
+        {
+            auto pAsyncLoad = this->FindAsyncLoad(handle);
+            if (pAsyncLoad != nullptr && pAsyncLoad->pLoad != nullptr)
+            {
+                // As with Load(), if the load hasn't started we take it off the queue and run it here.
+                size_t iQueuedLoad;
+                if (m_loadQueue.FindFirstIndexOf(pAsyncLoad->pLoad, iQueuedLoad))
+                {
+                    m_loadQueue.Remove(iQueuedLoad);
+                    pLoadToExecute = pAsyncLoad->pLoad;
+                }
+                else
+                {
+                    this->WaitForInFlightLoad(pAsyncLoad->pLoad);
+                }
+            }
+        }
+        dr_unlock_mutex(m_mutex);
+
+        if (pLoadToExecute != nullptr)
+        {
+            this->ExecuteLoad(pLoadToExecute);
+        }
+    }
+
+    void AssetLibrary::DispatchCompletedLoads()
+    {
+        GT_PROFILE_ZONE("AssetLibrary::DispatchCompletedLoads");
+
+        // Without any loader threads the queued loads are run here.
+        if (m_loaderThreads.count == 0)
+        {
+            for (;;)
+            {
+                InFlightLoad* pLoad = nullptr;
+                dr_lock_mutex(m_mutex);
+                {
+                    if (m_loadQueue.count > 0)
+                    {
+                        pLoad = m_loadQueue[0];
+                        m_loadQueue.Remove(0);
+                    }
+                }
+                dr_unlock_mutex(m_mutex);
+
+                if (pLoad == nullptr)
+                {
+                    break;
+                }
+
+                this->ExecuteLoad(pLoad);
+            }
+        }
+
+
+        // The callbacks are called without the lock held since they will most likely want to load or unload assets. Anything that
+        // completes during a callback is dispatched on the next call.
+        Vector<AsyncLoad*> completedAsyncLoads;
+        dr_lock_mutex(m_mutex);
+        {
+            if (m_completedAsyncLoads.count > 0)
+            {
+                completedAsyncLoads = m_completedAsyncLoads;
+                m_completedAsyncLoads.Clear();
+            }
+        }
+        dr_unlock_mutex(m_mutex);
+
+        for (size_t iAsyncLoad = 0; iAsyncLoad < completedAsyncLoads.count; ++iAsyncLoad)
+        {
+            auto pAsyncLoad = completedAsyncLoads[iAsyncLoad];
+            assert(pAsyncLoad != nullptr);
+            {
+                pAsyncLoad->callback(pAsyncLoad->pAsset, pAsyncLoad->pUserData);
+            }
+
+            delete pAsyncLoad;
+        }
+    }
+
+
     void AssetLibrary::RegisterAllocator(AssetAllocator &allocator)
     {
         // It is considered an error if the allocator already exists.
@@ -278,10 +608,378 @@ namespace GT
     }
 
 
+    uint64_t AssetLibrary::GetBytesLoaded() const
+    {
+        uint64_t bytesLoaded;
+        dr_lock_mutex(m_mutex);
+        {
+            bytesLoaded = m_bytesLoaded;
+        }
+        dr_unlock_mutex(m_mutex);
+
+        return bytesLoaded;
+    }
+
+
+    AssetType AssetLibrary::GetAssetTypeByPath(const char* filePath)
+    {
+        AssetType assetType = AssetType_Unknown;
+        this->FindAllocatorAndTypeByPath(filePath, assetType);
+
+        return assetType;
+    }
+
+
 
     ////////////////////////////////////
     // Private
 
+    void AssetLibrary::FindAbsolutePathOrIdentifier(const char* filePathOrIdentifier, char* absolutePathOrIdentifierOut, size_t absolutePathOrIdentifierOutSize) const
+    {
+        // Mounted packages take priority over the file system. The absolute path of an entry is the path of the package followed by the
+        // entry path as it's stored in the package, which makes it the same no matter how the path was written when it was requested.
+        for (size_t iPackage = 0; iPackage < m_packages.count; ++iPackage)
+        {
+            auto pPackage = m_packages[iPackage];
+            assert(pPackage != nullptr);
+
+            uint32_t entryIndex = AssetLibrary_FindPackageEntry(pPackage, filePathOrIdentifier);
+            if (entryIndex != GamePackage::InvalidEntry)
+            {
+                drpath_copy_and_append(absolutePathOrIdentifierOut, absolutePathOrIdentifierOutSize, pPackage->GetAbsolutePath(), pPackage->GetEntryPath(entryIndex));
+                return;
+            }
+
+            // As with files, the asset may be defined entirely by it's metadata.
+            char metadataPath[DRFS_MAX_PATH];
+            drpath_copy_and_append_extension(metadataPath, DRFS_MAX_PATH, filePathOrIdentifier, "gtdata");
+
+            entryIndex = AssetLibrary_FindPackageEntry(pPackage, metadataPath);
+            if (entryIndex != GamePackage::InvalidEntry)
+            {
+                drpath_copy_and_append(absolutePathOrIdentifierOut, absolutePathOrIdentifierOutSize, pPackage->GetAbsolutePath(), pPackage->GetEntryPath(entryIndex));
+                drpath_remove_extension(absolutePathOrIdentifierOut);
+                return;
+            }
+        }
+
+        // When an asset is cached, the absolute path is used to retrieve the cached object. It is possible, however, for an asset to not actually
+        // be loaded from a file, in which case filePathOrIdentifier is used as the unique identifier without any modification.
+        if (!drfs_find_absolute_path(m_pVFS, filePathOrIdentifier, absolutePathOrIdentifierOut, absolutePathOrIdentifierOutSize))
+        {
+            // The file could not be found, but there may be a metadata file. It is possible that the data for an asset is
+            // entirely defined in the metadata file, we'll look for that file too.
+            char metadataPath[DRFS_MAX_PATH];
+            drpath_copy_and_append_extension(metadataPath, DRFS_MAX_PATH, filePathOrIdentifier, "gtdata");
+
+            if (drfs_find_absolute_path(m_pVFS, metadataPath, absolutePathOrIdentifierOut, absolutePathOrIdentifierOutSize))
+            {
+                // The metadata file was found. Later on we'll load the metadata for real, so we'll need to remove the ".gtdata" extension beforehand.
+                drpath_remove_extension(absolutePathOrIdentifierOut);
+            }
+            else
+            {
+                // The file nor it's metadata file could not be found, but the asset loader might be using it as a unique identifier, so we just use it as-is in this case.
+                strcpy_s(absolutePathOrIdentifierOut, absolutePathOrIdentifierOutSize, filePathOrIdentifier);
+            }
+        }
+    }
+
+    Asset* AssetLibrary::AcquireOrBeginLoad(const char* absolutePathOrIdentifier, AssetType explicitAssetType, InFlightLoad* &pLoadOut, bool &isNewLoadOut)
+    {
+        pLoadOut     = nullptr;
+        isNewLoadOut = false;
+
+        auto iExistingAsset = m_loadedAssets.Find(absolutePathOrIdentifier);
+        if (iExistingAsset != nullptr)
+        {
+            auto pExistingAsset = iExistingAsset->value;
+            assert(pExistingAsset != nullptr);
+            {
+                pExistingAsset->IncrementReferenceCount();
+            }
+
+            return pExistingAsset;
+        }
+
+        auto iInFlightLoad = m_inFlightLoads.Find(absolutePathOrIdentifier);
+        if (iInFlightLoad != nullptr)
+        {
+            pLoadOut = iInFlightLoad->value;
+            pLoadOut->requestCount += 1;
+
+            return nullptr;
+        }
+
+
+        AssetAllocator* pAllocator = nullptr;
+
+        AssetType assetType = explicitAssetType;
+        if (assetType == AssetType_Unknown)
+        {
+            pAllocator = this->FindAllocatorAndTypeByPath(absolutePathOrIdentifier, assetType);
+        }
+        else
+        {
+            pAllocator = this->FindAllocatorByType(assetType);
+        }
+
+        if (pAllocator == nullptr)
+        {
+            // Could not find a supported allocator.
+            return nullptr;
+        }
+
+        Asset* pAsset = pAllocator->CreateAsset(absolutePathOrIdentifier, assetType);
+        if (pAsset == nullptr)
+        {
+            // Failed to create an asset of the given type.
+            return nullptr;
+        }
+
+
+        auto pLoad = new InFlightLoad;
+        strcpy_s(pLoad->absolutePathOrIdentifier, absolutePathOrIdentifier);
+        pLoad->pAllocator    = pAllocator;
+        pLoad->pAsset        = pAsset;
+        pLoad->isComplete    = false;
+        pLoad->requestCount  = 1;
+        pLoad->holdCount     = 1;
+        pLoad->waiterCount   = 0;
+        pLoad->waitSemaphore = dr_create_semaphore(0);
+        m_inFlightLoads.Add(absolutePathOrIdentifier, pLoad);
+
+        pLoadOut     = pLoad;
+        isNewLoadOut = true;
+
+        return nullptr;
+    }
+
+    GamePackage* AssetLibrary::FindPackageByAbsolutePath(const char* absolutePathOrIdentifier, const char* &entryPathOut) const
+    {
+        for (size_t iPackage = 0; iPackage < m_packages.count; ++iPackage)
+        {
+            auto pPackage = m_packages[iPackage];
+            assert(pPackage != nullptr);
+
+            if (drpath_is_descendant(absolutePathOrIdentifier, pPackage->GetAbsolutePath()))
+            {
+                entryPathOut = absolutePathOrIdentifier + strlen(pPackage->GetAbsolutePath());
+                return pPackage;
+            }
+        }
+
+        entryPathOut = nullptr;
+        return nullptr;
+    }
+
+    bool AssetLibrary::LoadAssetData(Asset* pAsset, const char* absolutePathOrIdentifier, uint64_t &fileSizeInBytesOut)
+    {
+        assert(pAsset != nullptr);
+
+        fileSizeInBytesOut = 0;
+
+        const char* entryPath;
+        GamePackage* pPackage = this->FindPackageByAbsolutePath(absolutePathOrIdentifier, entryPath);
+        if (pPackage == nullptr)
+        {
+            // Load the metadata first. It does not matter if this fails so the return value doesn't need to be checked.
+            char metadataAbsolutePath[DRFS_MAX_PATH];
+            drpath_copy_and_append_extension(metadataAbsolutePath, DRFS_MAX_PATH, absolutePathOrIdentifier, "gtdata");
+            pAsset->LoadMetadata(metadataAbsolutePath, m_pVFS);
+
+            // Load the asset after the metadata.
+            if (!pAsset->Load(absolutePathOrIdentifier, m_pVFS))
+            {
+                return false;
+            }
+
+            drfs_file_info fileInfo;
+            if (drfs_get_file_info(m_pVFS, absolutePathOrIdentifier, &fileInfo) == drfs_success)
+            {
+                fileSizeInBytesOut = fileInfo.sizeInBytes;
+            }
+
+            return true;
+        }
+
+
+        // The asset is in a package. As above, the metadata is loaded first and it doesn't matter if it fails.
+        char metadataEntryPath[DRFS_MAX_PATH];
+        drpath_copy_and_append_extension(metadataEntryPath, DRFS_MAX_PATH, entryPath, "gtdata");
+
+        uint32_t metadataEntryIndex = pPackage->FindEntry(metadataEntryPath);
+        if (metadataEntryIndex != GamePackage::InvalidEntry)
+        {
+            void* pMetadataBuffer;
+            const void* pMetadata = AssetLibrary_GetPackageEntryData(pPackage, metadataEntryIndex, pMetadataBuffer);
+            if (pMetadata != nullptr)
+            {
+                pAsset->LoadMetadataFromMemory(pMetadata, static_cast<size_t>(pPackage->GetEntrySize(metadataEntryIndex)));
+            }
+
+            free(pMetadataBuffer);
+        }
+
+        uint32_t entryIndex = pPackage->FindEntry(entryPath);
+        if (entryIndex == GamePackage::InvalidEntry)
+        {
+            // The asset is defined entirely by it's metadata. This is the same as an asset whose file doesn't exist.
+            return pAsset->Load(absolutePathOrIdentifier, m_pVFS);
+        }
+
+        void* pBuffer;
+        const void* pData = AssetLibrary_GetPackageEntryData(pPackage, entryIndex, pBuffer);
+        if (pData == nullptr)
+        {
+            // The entry is corrupt.
+            return false;
+        }
+
+        bool result = pAsset->LoadFromMemory(absolutePathOrIdentifier, pData, static_cast<size_t>(pPackage->GetEntrySize(entryIndex)));
+        if (result)
+        {
+            fileSizeInBytesOut = pPackage->GetEntrySize(entryIndex);
+        }
+
+        free(pBuffer);
+        return result;
+    }
+
+    Asset* AssetLibrary::ExecuteLoad(InFlightLoad* pLoad)
+    {
+        GT_PROFILE_ZONE("AssetLibrary::ExecuteLoad");
+
+        assert(pLoad != nullptr);
+        assert(pLoad->pAsset != nullptr);
+
+        uint64_t fileSizeInBytes;
+        bool succeeded = this->LoadAssetData(pLoad->pAsset, pLoad->absolutePathOrIdentifier, fileSizeInBytes);
+
+
+        Asset* pAsset;
+        dr_lock_mutex(m_mutex);
+        {
+            pAsset = this->CompleteLoad(pLoad, succeeded, fileSizeInBytes);
+        }
+        dr_unlock_mutex(m_mutex);
+
+        return pAsset;
+    }
+
+    Asset* AssetLibrary::CompleteLoad(InFlightLoad* pLoad, bool succeeded, uint64_t fileSizeInBytes)
+    {
+        assert(pLoad != nullptr);
+        assert(!pLoad->isComplete);
+
+        m_inFlightLoads.Remove(pLoad->absolutePathOrIdentifier);
+
+        if (succeeded)
+        {
+            m_loadedAssets.Add(pLoad->absolutePathOrIdentifier, pLoad->pAsset);
+            m_bytesLoaded += fileSizeInBytes;
+
+            // The asset starts with a single reference which belongs to the first request. Every other request needs one as well.
+            for (size_t iRequest = 1; iRequest < pLoad->requestCount; ++iRequest)
+            {
+                pLoad->pAsset->IncrementReferenceCount();
+            }
+        }
+        else
+        {
+            // Failed to load the asset.
+            pLoad->pAllocator->DeleteAsset(pLoad->pAsset);
+            pLoad->pAsset = nullptr;
+        }
+
+        pLoad->isComplete = true;
+        Asset* pAsset = pLoad->pAsset;
+
+
+        for (size_t iAsyncLoad = 0; iAsyncLoad < pLoad->asyncLoads.count; ++iAsyncLoad)
+        {
+            auto pAsyncLoad = pLoad->asyncLoads[iAsyncLoad];
+            assert(pAsyncLoad != nullptr);
+            {
+                pAsyncLoad->pLoad  = nullptr;
+                pAsyncLoad->pAsset = pAsset;
+
+                m_pendingAsyncLoads.RemoveFirstOccuranceOf(pAsyncLoad);
+                m_completedAsyncLoads.PushBack(pAsyncLoad);
+            }
+        }
+        pLoad->asyncLoads.Clear();
+
+        for (size_t iWaiter = 0; iWaiter < pLoad->waiterCount; ++iWaiter)
+        {
+            dr_release_semaphore(pLoad->waitSemaphore);
+        }
+
+        this->ReleaseInFlightLoad(pLoad);
+
+        return pAsset;
+    }
+
+    Asset* AssetLibrary::WaitForInFlightLoad(InFlightLoad* pLoad)
+    {
+        assert(pLoad != nullptr);
+
+        // The hold keeps the load alive until we've read the result, since the loading thread will have released it's own hold by then.
+        pLoad->holdCount += 1;
+
+        if (!pLoad->isComplete)
+        {
+            pLoad->waiterCount += 1;
+
+            dr_unlock_mutex(m_mutex);
+            {
+                dr_wait_semaphore(pLoad->waitSemaphore);
+            }
+            dr_lock_mutex(m_mutex);
+
+            assert(pLoad->isComplete);
+        }
+
+        Asset* pAsset = pLoad->pAsset;
+        this->ReleaseInFlightLoad(pLoad);
+
+        return pAsset;
+    }
+
+    void AssetLibrary::ReleaseInFlightLoad(InFlightLoad* pLoad)
+    {
+        assert(pLoad != nullptr);
+        assert(pLoad->holdCount > 0);
+
+        pLoad->holdCount -= 1;
+        if (pLoad->holdCount == 0)
+        {
+            dr_delete_semaphore(pLoad->waitSemaphore);
+            delete pLoad;
+        }
+    }
+
+    AssetLibrary::AsyncLoad* AssetLibrary::FindAsyncLoad(AssetLoadHandle handle) const
+    {
+        for (size_t iAsyncLoad = 0; iAsyncLoad < m_pendingAsyncLoads.count; ++iAsyncLoad)
+        {
+            if (m_pendingAsyncLoads[iAsyncLoad]->handle == handle)
+            {
+                return m_pendingAsyncLoads[iAsyncLoad];
+            }
+        }
+
+        for (size_t iAsyncLoad = 0; iAsyncLoad < m_completedAsyncLoads.count; ++iAsyncLoad)
+        {
+            if (m_completedAsyncLoads[iAsyncLoad]->handle == handle)
+            {
+                return m_completedAsyncLoads[iAsyncLoad];
+            }
+        }
+
+        return nullptr;
+    }
+
     AssetAllocator* AssetLibrary::FindAllocatorAndTypeByPath(const char* filePath, AssetType &assetTypeOut)
     {
         for (size_t iAllocator = 0; iAllocator < m_allocators.GetCount(); ++iAllocator)
@@ -317,4 +1015,39 @@ namespace GT
 
         return nullptr;
     }
+
+    int AssetLibrary::LoaderThreadProc(void* pData)
+    {
+        auto pLibrary = reinterpret_cast<AssetLibrary*>(pData);
+        assert(pLibrary != nullptr);
+
+        ProfilerCapture::SetThreadName("Asset Loader");
+
+        while (dr_wait_semaphore(pLibrary->m_loadQueueSemaphore))
+        {
+            if (pLibrary->m_isTerminating)
+            {
+                break;
+            }
+
+            // The queue may be empty if the load was taken by a thread that wanted it straight away.
+            InFlightLoad* pLoad = nullptr;
+            dr_lock_mutex(pLibrary->m_mutex);
+            {
+                if (pLibrary->m_loadQueue.count > 0)
+                {
+                    pLoad = pLibrary->m_loadQueue[0];
+                    pLibrary->m_loadQueue.Remove(0);
+                }
+            }
+            dr_unlock_mutex(pLibrary->m_mutex);
+
+            if (pLoad != nullptr)
+            {
+                pLibrary->ExecuteLoad(pLoad);
+            }
+        }
+
+        return 0;
+    }
 }
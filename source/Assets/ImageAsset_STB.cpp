@@ -104,6 +104,31 @@ namespace GT
         }
     }
 
+    bool ImageAsset_STB::LoadFromMemory(const char* absolutePath, const void* pData, size_t dataSizeInBytes)
+    {
+        (void)absolutePath;
+
+        if (pData == nullptr || dataSizeInBytes > INT_MAX)
+        {
+            return false;
+        }
+
+        int imageWidth;
+        int imageHeight;
+        auto imageData = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(pData), static_cast<int>(dataSizeInBytes), &imageWidth, &imageHeight, nullptr, 4);
+        if (imageData != nullptr)
+        {
+            m_width  = static_cast<unsigned int>(imageWidth);
+            m_height = static_cast<unsigned int>(imageHeight);
+            m_format = GT::TextureFormat_RGBA8;
+            m_data   = imageData;
+
+            return true;
+        }
+
+        return false;
+    }
+
     unsigned int ImageAsset_STB::GetImageWidth() const
     {
         return m_width;
@@ -22,6 +22,9 @@ namespace GT
         /// @copydoc GT::Asset::Load()
         bool Load(const char* absolutePath, drfs_context* pVFS);
 
+        /// @copydoc GT::Asset::LoadFromMemory()
+        bool LoadFromMemory(const char* absolutePath, const void* pData, size_t dataSizeInBytes);
+
         /// @copydoc GT::ImageAsset::GetImageWidth()
         unsigned int GetImageWidth() const;
 
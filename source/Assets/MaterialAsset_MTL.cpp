@@ -23,28 +23,41 @@ namespace GT
     {
         size_t fileSize;
         char* pFileData = drfs_open_and_read_text_file(pVFS, absolutePath, &fileSize);
-        if (pFileData != NULL && fileSize > 6)
+        if (pFileData != NULL)
         {
-            bool result = true;
+            bool result = this->LoadFromMemory(absolutePath, pFileData, fileSize);
 
+            drfs_free(pFileData);
+            return result;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    bool MaterialAsset_MTL::LoadFromMemory(const char* absolutePath, const void* pData, size_t dataSizeInBytes)
+    {
+        (void)absolutePath;
+
+        if (pData != NULL && dataSizeInBytes > 6)
+        {
             drmtl_material materialSource;
-            if (drmtl_compile_wavefront_mtl(&materialSource, pFileData, fileSize, "FS_TexCoord"))
+            if (drmtl_compile_wavefront_mtl(&materialSource, reinterpret_cast<const char*>(pData), dataSizeInBytes, "FS_TexCoord"))
             {
+                free(m_pData);
+
                 m_dataSizeInBytes = materialSource.sizeInBytes;
                 m_pData = malloc(materialSource.sizeInBytes);
                 memcpy(m_pData, materialSource.pRawData, materialSource.sizeInBytes);
 
                 drmtl_uninit(&materialSource);
-                result = true;
+                return true;
             }
             else
             {
-                result = false;
+                return false;
             }
-
-
-            drfs_free(pFileData);
-            return result;
         }
         else
         {
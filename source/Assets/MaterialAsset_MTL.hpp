@@ -25,6 +25,9 @@ namespace GT
         /// @copydoc Asset::Load()
         bool Load(const char* absolutePath, drfs_context* pVFS);
 
+        /// @copydoc Asset::LoadFromMemory()
+        bool LoadFromMemory(const char* absolutePath, const void* pData, size_t dataSizeInBytes);
+
 
         /// @copydoc MaterialAsset::GetData()
         const void* GetData() const;
@@ -270,18 +270,36 @@ namespace GT
     bool ModelAsset_MD2::Load(const char* absolutePath, drfs_context* pVFS)
     {
         size_t fileSize;
-        uint8_t* pFileData = reinterpret_cast<uint8_t*>(drfs_open_and_read_binary_file(pVFS, absolutePath, &fileSize));
+        void* pFileData = drfs_open_and_read_binary_file(pVFS, absolutePath, &fileSize);
         if (pFileData != nullptr)
+        {
+            bool result = this->LoadFromMemory(absolutePath, pFileData, fileSize);
+
+            drfs_free(pFileData);
+            return result;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    bool ModelAsset_MD2::LoadFromMemory(const char* absolutePath, const void* pData, size_t fileSize)
+    {
+        (void)absolutePath;
+
+        auto pFileData = reinterpret_cast<const uint8_t*>(pData);
+        if (pFileData != nullptr && fileSize >= sizeof(md2_header))
         {
             bool result = true;
 
-            md2_header* header = reinterpret_cast<md2_header*>(pFileData);
+            auto header = reinterpret_cast<const md2_header*>(pFileData);
             if (header->ident == '2PDI' && header->version == 8)
             {
                 if (fileSize > static_cast<unsigned int>(header->ofs_glcmds))
                 {
-                    auto md2TexCoords = reinterpret_cast<md2_texcoord*        >(pFileData + header->ofs_st);
-                    auto md2Indices   = reinterpret_cast<md2_triangle_indices*>(pFileData + header->ofs_tris);
+                    auto md2TexCoords = reinterpret_cast<const md2_texcoord*        >(pFileData + header->ofs_st);
+                    auto md2Indices   = reinterpret_cast<const md2_triangle_indices*>(pFileData + header->ofs_tris);
 
                     // MD2 separates the position/texcoord/normal. We want them to be interlaced. To do this, we need to convert the position/texcoord index pair
                     // from MD2 into just a singular index. We do this by simply counting the number of unique combinations of index pairs.
@@ -332,8 +350,8 @@ namespace GT
                             {
                                 for (int32_t iFrame = 0; iFrame < header->num_frames; ++iFrame)
                                 {
-                                    auto frameHeader = reinterpret_cast<md2_frame_header*>((pFileData + header->ofs_frames) + (iFrame * header->framesize));
-                                    auto md2Vertices = reinterpret_cast<md2_vertex*      >((pFileData + header->ofs_frames) + (iFrame * header->framesize) + sizeof(md2_frame_header));
+                                    auto frameHeader = reinterpret_cast<const md2_frame_header*>((pFileData + header->ofs_frames) + (iFrame * header->framesize));
+                                    auto md2Vertices = reinterpret_cast<const md2_vertex*      >((pFileData + header->ofs_frames) + (iFrame * header->framesize) + sizeof(md2_frame_header));
 
                                     float position[3];
                                     position[0] = (md2Vertices[positionIndexMD2].v[0] * frameHeader->scale[0]) + frameHeader->translate[0];
@@ -387,9 +405,8 @@ namespace GT
                 // Magic number or version is incorrect.
                 result = false;
             }
-                
 
-            drfs_free(pFileData);
+
             return result;
         }
         else
@@ -34,6 +34,9 @@ namespace GT
         /// @copydoc ModelAsset::Load()
         bool Load(const char* absolutePath, drfs_context* pContext);
 
+        /// @copydoc Asset::LoadFromMemory()
+        bool LoadFromMemory(const char* absolutePath, const void* pData, size_t dataSizeInBytes);
+
 
         /// @copydoc ModelAsset::GetMeshCount()
         unsigned int GetMeshCount() const;
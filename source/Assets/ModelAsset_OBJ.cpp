@@ -208,6 +208,166 @@ namespace GT
 
 
 
+    /// Files are only parsed in parallel when each chunk would be at least this big.
+    static const size_t OBJ_MinParallelChunkSizeInBytes = 1024 * 1024;
+
+    /// Structure representing a range of lines in an OBJ file and the data that was parsed from it.
+    struct OBJChunk
+    {
+        OBJChunk()
+            : str(nullptr), strEnd(nullptr), positions(), texcoords(), normals(), faces()
+        {
+        }
+
+        /// The start of the chunk. This is always the beginning of a line.
+        const char* str;
+
+        /// The end of the chunk. This is always just past a new-line character, or the end of the file.
+        const char* strEnd;
+
+        Vector<glm::vec4> positions;
+        Vector<glm::vec4> texcoords;
+        Vector<glm::vec4> normals;
+        Vector<OBJFace>   faces;
+
+
+    private:    // No copying.
+        OBJChunk(const OBJChunk &);
+        OBJChunk & operator=(const OBJChunk &);
+    };
+
+    /// Parses every line in the given chunk.
+    void OBJ_ParseChunk(OBJChunk &chunk)
+    {
+        const char* str    = chunk.str;
+        const char* strEnd = chunk.strEnd;
+
+        // We just go over the file data line by line.
+        while (str < strEnd)
+        {
+            if (str + 1 < strEnd)
+            {
+                const uint16_t next16 = reinterpret_cast<const uint16_t*>(str)[0];
+
+                if (next16 == ' v' || next16 == '\tv')
+                {
+                    // Position. Only supporting X, Y and Z. W and colours are ignored.
+                    str += 2;
+
+                    float value[3];
+                    value[0] = OBJ_atof(str, strEnd, &str);
+                    value[1] = OBJ_atof(str, strEnd, &str);
+                    value[2] = OBJ_atof(str, strEnd, &str);
+
+                    chunk.positions.PushBack(glm::vec4(value[0], value[1], value[2], 1.0f));
+                }
+                else if (next16 == 'tv')
+                {
+                    // Texture Coordinate.
+                    str += 3;
+
+                    float value[2];
+                    value[0] = OBJ_atof(str, strEnd, &str);
+                    value[1] = OBJ_atof(str, strEnd, &str);
+
+                    chunk.texcoords.PushBack(glm::vec4(value[0], value[1], 0.0f, 0.0f));
+                }
+                else if (next16 == 'nv')
+                {
+                    // Normal.
+                    str += 3;
+
+                    float value[3];
+                    value[0] = OBJ_atof(str, strEnd, &str);
+                    value[1] = OBJ_atof(str, strEnd, &str);
+                    value[2] = OBJ_atof(str, strEnd, &str);
+
+                    chunk.normals.PushBack(glm::vec4(value[0], value[1], value[2], 0.0f));
+                }
+                else if (next16 == ' f' || next16 == '\tf')
+                {
+                    // Face. Only supporting triangles.
+                    str += 2;
+
+                    OBJFace face;
+                    OBJ_ParseFace(str, strEnd, face, &str);
+
+                    chunk.faces.PushBack(face);
+                }
+                else if (next16 == 'su')
+                {
+                    // "usemtl"
+                    str += 2;
+                    if (str + 5 < strEnd)
+                    {
+                        if (reinterpret_cast<const uint32_t*>(str)[0] == 'ltme')
+                        {
+
+                        }
+                    }
+                }
+                else
+                {
+                    // We don't know what the token is, so skip over the line.
+                }
+            }
+            else
+            {
+                // Empty line. Skip it.
+            }
+
+
+            // Move to the end of the line
+            while (str < strEnd && *str != '\n')
+            {
+                str += 1;
+            }
+
+            // Move past the new-line character which will take us to the beginning of the next line.
+            str += 1;
+        }
+    }
+
+    /// The entry point for the temporary threads created by ModelAsset_OBJ::Load().
+    int OBJ_ParseChunkThreadProc(void* pData)
+    {
+        auto pChunk = reinterpret_cast<OBJChunk*>(pData);
+        assert(pChunk != nullptr);
+
+        OBJ_ParseChunk(*pChunk);
+
+        return 0;
+    }
+
+    /// Appends every item in the source list to the end of the destination list.
+    template <typename T>
+    void OBJ_AppendRange(Vector<T> &dst, const Vector<T> &src)
+    {
+        if (src.count > 0)
+        {
+            if (dst.count + src.count > dst.bufferSize)
+            {
+                dst.Reserve(dst.count + src.count);
+            }
+
+            memcpy(dst.buffer + dst.count, src.buffer, src.count * sizeof(T));
+            dst.count += src.count;
+        }
+    }
+
+    /// Calculates a hash for the given face vertex for use with the unique vertex hash table.
+    inline uint32_t OBJ_HashFaceVertex(const OBJFaceVertex &faceVertex)
+    {
+        uint32_t hash = static_cast<uint32_t>(faceVertex.positionIndex) * 0x9E3779B1U;
+        hash = (hash ^ static_cast<uint32_t>(faceVertex.texcoordIndex)) * 0x85EBCA6BU;
+        hash = (hash ^ static_cast<uint32_t>(faceVertex.normalIndex))   * 0xC2B2AE35U;
+        hash ^= hash >> 16;
+
+        return hash;
+    }
+
+
+
     ModelAsset_OBJ::ModelAsset_OBJ(const char* absolutePathOrIdentifier, AssetType assetType)
         : ModelAsset(absolutePathOrIdentifier, assetType),
          m_vertexData(nullptr),
@@ -232,132 +392,125 @@ namespace GT
     {
         size_t fileSize;
         char* pFileData = drfs_open_and_read_text_file(pVFS, absolutePath, &fileSize);
-        if (pFileData != 0 && fileSize > 0)
+        if (pFileData != 0)
+        {
+            bool result = this->LoadFromMemory(absolutePath, pFileData, fileSize);
+
+            drfs_free(pFileData);
+            return result;
+        }
+        else
         {
-            Vector<glm::vec4>    positions;
-            Vector<glm::vec4>    texcoords;
-            Vector<glm::vec4>    normals;
-            Vector<OBJFace> faces;
+            return false;
+        }
+    }
+
+    bool ModelAsset_OBJ::LoadFromMemory(const char* absolutePath, const void* pData, size_t fileSize)
+    {
+        (void)absolutePath;
 
-            Vector<OBJFaceVertex> uniqueIndices;
-            Vector<uint32_t>      actualIndices;
+        auto pFileData = reinterpret_cast<const char*>(pData);
+        if (pFileData != 0 && fileSize > 0)
+        {
+            // The file is split into chunks at line boundaries which are parsed in parallel on temporary threads. Small files are not worth
+            // the overhead of creating threads for.
+            size_t chunkCount = Min(static_cast<size_t>(System::GetCPUCount()), fileSize / OBJ_MinParallelChunkSizeInBytes);
+            if (chunkCount == 0)
+            {
+                chunkCount = 1;
+            }
 
-            const char* str    = pFileData;
-            const char* strEnd = str + fileSize;
+            OBJChunk* pChunks = new OBJChunk[chunkCount];
 
-            // We just go over the file data line by line.
-            while (str < strEnd)
+            const char* chunkStart = pFileData;
+            const char* fileEnd    = pFileData + fileSize;
+            for (size_t iChunk = 0; iChunk < chunkCount; ++iChunk)
             {
-                if (str + 1 < strEnd)
+                const char* chunkEnd = fileEnd;
+                if (iChunk + 1 < chunkCount)
                 {
-                    const uint16_t next16 = reinterpret_cast<const uint16_t*>(str)[0];
-
-                    if (next16 == ' v' || next16 == '\tv')
+                    chunkEnd = Max(chunkStart, pFileData + (fileSize / chunkCount) * (iChunk + 1));
+                    while (chunkEnd < fileEnd && *chunkEnd != '\n')
                     {
-                        // Position. Only supporting X, Y and Z. W and colours are ignored.
-                        str += 2;
-
-                        float value[3];
-                        value[0] = OBJ_atof(str, strEnd, &str);
-                        value[1] = OBJ_atof(str, strEnd, &str);
-                        value[2] = OBJ_atof(str, strEnd, &str);
-
-                        positions.PushBack(glm::vec4(value[0], value[1], value[2], 1.0f));
+                        chunkEnd += 1;
                     }
-                    else if (next16 == 'tv')
-                    {
-                        // Texture Coordinate.
-                        str += 3;
-
-                        float value[2];
-                        value[0] = OBJ_atof(str, strEnd, &str);
-                        value[1] = OBJ_atof(str, strEnd, &str);
 
-                        texcoords.PushBack(glm::vec4(value[0], value[1], 0.0f, 0.0f));
-                    }
-                    else if (next16 == 'nv')
+                    if (chunkEnd < fileEnd)
                     {
-                        // Normal.
-                        str += 3;
-
-                        float value[3];
-                        value[0] = OBJ_atof(str, strEnd, &str);
-                        value[1] = OBJ_atof(str, strEnd, &str);
-                        value[2] = OBJ_atof(str, strEnd, &str);
-
-                        normals.PushBack(glm::vec4(value[0], value[1], value[2], 0.0f));
+                        chunkEnd += 1;  // <-- Include the new-line character so the next chunk begins at the start of a line.
                     }
-                    else if (next16 == ' f' || next16 == '\tf')
-                    {
-                        // Face. Only supporting triangles.
-                        str += 2;
+                }
 
-                        OBJFace face;
-                        OBJ_ParseFace(str, strEnd, face, &str);
+                pChunks[iChunk].str    = chunkStart;
+                pChunks[iChunk].strEnd = chunkEnd;
 
-                        faces.PushBack(face);
+                chunkStart = chunkEnd;
+            }
 
-                        for (size_t iVertex = 0; iVertex < 3; ++iVertex)
-                        {
-                            size_t existingIndexLocation;
-                            if (uniqueIndices.FindFirstIndexOf(face.v[iVertex], existingIndexLocation))
-                            {
-                                actualIndices.PushBack(static_cast<uint32_t>(existingIndexLocation));
-                            }
-                            else
-                            {
-                                actualIndices.PushBack(static_cast<uint32_t>(uniqueIndices.GetCount()));
-                                uniqueIndices.PushBack(face.v[iVertex]);
-                            }
-                        }
-                    }
-                    else if (next16 == 'su')
-                    {
-                        // "usemtl"
-                        str += 2;
-                        if (str + 5 < strEnd)
-                        {
-                            if (reinterpret_cast<const uint32_t*>(str)[0] == 'ltme')
-                            {
 
-                            }
-                        }
-                    }
-                    else
-                    {
-                        // We don't know what the token is, so skip over the line.
-                    }
+            // The calling thread parses the first chunk. Everything else gets a temporary thread.
+            Vector<dr_thread> threads(chunkCount);
+            for (size_t iChunk = 1; iChunk < chunkCount; ++iChunk)
+            {
+                dr_thread thread = dr_create_thread(OBJ_ParseChunkThreadProc, &pChunks[iChunk]);
+                if (thread != NULL)
+                {
+                    threads.PushBack(thread);
                 }
                 else
                 {
-                    // Empty line. Skip it.
+                    // Couldn't create the thread. Just parse the chunk on this thread instead.
+                    OBJ_ParseChunk(pChunks[iChunk]);
                 }
+            }
 
+            OBJ_ParseChunk(pChunks[0]);
 
-                // Move to the end of the line
-                while (str < strEnd && *str != '\n')
-                {
-                    str += 1;
-                }
+            for (size_t iThread = 0; iThread < threads.count; ++iThread)
+            {
+                dr_wait_thread(threads[iThread]);
+                dr_delete_thread(threads[iThread]);
+            }
 
-                // Move past the new-line character which will take us to the beginning of the next line.
-                str += 1;
+
+            // At this point the file has been parsed, so merge the chunks together. Face indices are absolute, so they don't need to be adjusted because the chunks are merged in
+            // the same order they appear in the file.
+            size_t positionCount = 0;
+            size_t texcoordCount = 0;
+            size_t normalCount   = 0;
+            size_t faceCount     = 0;
+            for (size_t iChunk = 0; iChunk < chunkCount; ++iChunk)
+            {
+                positionCount += pChunks[iChunk].positions.count;
+                texcoordCount += pChunks[iChunk].texcoords.count;
+                normalCount   += pChunks[iChunk].normals.count;
+                faceCount     += pChunks[iChunk].faces.count;
             }
 
-            // At this point the file has been parsed, so free the file data...
-            drfs_free(pFileData);
+            Vector<glm::vec4> positions(positionCount + 1);
+            Vector<glm::vec4> texcoords(texcoordCount + 1);
+            Vector<glm::vec4> normals(normalCount + 1);
+            Vector<OBJFace>   faces(faceCount);
+            for (size_t iChunk = 0; iChunk < chunkCount; ++iChunk)
+            {
+                OBJ_AppendRange(positions, pChunks[iChunk].positions);
+                OBJ_AppendRange(texcoords, pChunks[iChunk].texcoords);
+                OBJ_AppendRange(normals,   pChunks[iChunk].normals);
+                OBJ_AppendRange(faces,     pChunks[iChunk].faces);
+            }
+
+            delete [] pChunks;
 
-            // ... and start converting the data to our own format. OBJ separates positions, texture coordinates and normals, but we want them
-            // to be interlaced.
-            //
-            // If there is no position, texture coordinate or normal we will add a default one to the list.
+
+            // OBJ separates positions, texture coordinates and normals, but we want them to be interlaced. If there is no position, texture
+            // coordinate or normal we will add a default one to the list.
             if (positions.GetCount() == 0)
             {
                 positions.PushBack(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
             }
             if (texcoords.GetCount() == 0)
             {
-                positions.PushBack(glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
+                texcoords.PushBack(glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
             }
             if (normals.GetCount() == 0)
             {
@@ -365,6 +518,48 @@ namespace GT
             }
 
 
+            // Every unique p/t/n combination becomes a vertex. These are found with an open addressed hash table which maps the face vertex
+            // to it's index plus 1, with 0 marking an empty slot. There can't be more unique vertices than face vertices, so the table is
+            // sized up front such that it's never more than half full.
+            size_t faceVertexCount = faceCount * 3;
+
+            size_t slotCount = 64;
+            while (slotCount < faceVertexCount * 2)
+            {
+                slotCount *= 2;
+            }
+
+            Vector<uint32_t> slots(slotCount);
+            slots.Resize(slotCount);
+            memset(slots.buffer, 0, slotCount * sizeof(uint32_t));
+
+            Vector<OBJFaceVertex> uniqueIndices(faceVertexCount);
+            Vector<uint32_t>      actualIndices(faceVertexCount);
+
+            size_t slotMask = slotCount - 1;
+            for (size_t iFace = 0; iFace < faceCount; ++iFace)
+            {
+                for (size_t iVertex = 0; iVertex < 3; ++iVertex)
+                {
+                    const OBJFaceVertex &faceVertex = faces[iFace].v[iVertex];
+
+                    size_t iSlot = OBJ_HashFaceVertex(faceVertex) & slotMask;
+                    while (slots[iSlot] != 0 && !(uniqueIndices[slots[iSlot] - 1] == faceVertex))
+                    {
+                        iSlot = (iSlot + 1) & slotMask;
+                    }
+
+                    if (slots[iSlot] == 0)
+                    {
+                        uniqueIndices.PushBack(faceVertex);
+                        slots[iSlot] = static_cast<uint32_t>(uniqueIndices.GetCount());
+                    }
+
+                    actualIndices.PushBack(slots[iSlot] - 1);
+                }
+            }
+
+
 
             m_vertexCount = static_cast<unsigned int>(uniqueIndices.GetCount());
             m_vertexData  = new OBJMeshVertex[m_vertexCount];
@@ -377,55 +572,43 @@ namespace GT
             m_materialOffsetCountPair[1] = static_cast<uint32_t>(m_indexCount);
 
 
-            for (size_t iFace = 0; iFace < faces.GetCount(); ++iFace)
+            for (size_t iUniqueVertex = 0; iUniqueVertex < uniqueIndices.GetCount(); ++iUniqueVertex)
             {
-                for (size_t iVertex = 0; iVertex < 3; ++iVertex)
-                {
-                    size_t actualIndexLocation;
-                    if (uniqueIndices.FindFirstIndexOf(faces[iFace].v[iVertex], actualIndexLocation))
-                    {
-                        int positionIndexOBJ = faces[iFace].v[iVertex].positionIndex;
-                        int texcoordIndexOBJ = faces[iFace].v[iVertex].texcoordIndex;
-                        int normalIndexOBJ   = faces[iFace].v[iVertex].normalIndex;
-
-                        // The indices need to be normalized. An OBJ file can have positive and negative indices. Positive indices are 1-based indices that
-                        // one would typically expect. Negative indices are "relative" where all we need to do is add the vertex count to it.
-                        if (positionIndexOBJ > 0) {
-                            positionIndexOBJ -= 1;
-                        } else {
-                            positionIndexOBJ += static_cast<int>(positions.GetCount());
-                        }
+                int positionIndexOBJ = uniqueIndices[iUniqueVertex].positionIndex;
+                int texcoordIndexOBJ = uniqueIndices[iUniqueVertex].texcoordIndex;
+                int normalIndexOBJ   = uniqueIndices[iUniqueVertex].normalIndex;
+
+                // The indices need to be normalized. An OBJ file can have positive and negative indices. Positive indices are 1-based indices that
+                // one would typically expect. Negative indices are "relative" where all we need to do is add the vertex count to it.
+                if (positionIndexOBJ > 0) {
+                    positionIndexOBJ -= 1;
+                } else {
+                    positionIndexOBJ += static_cast<int>(positions.GetCount());
+                }
 
-                        if (texcoordIndexOBJ > 0) {
-                            texcoordIndexOBJ -= 1;
-                        } else {
-                            texcoordIndexOBJ += static_cast<int>(texcoords.GetCount());
-                        }
+                if (texcoordIndexOBJ > 0) {
+                    texcoordIndexOBJ -= 1;
+                } else {
+                    texcoordIndexOBJ += static_cast<int>(texcoords.GetCount());
+                }
 
-                        if (normalIndexOBJ > 0) {
-                            normalIndexOBJ -= 1;
-                        } else {
-                            normalIndexOBJ += static_cast<int>(normals.GetCount());
-                        }
+                if (normalIndexOBJ > 0) {
+                    normalIndexOBJ -= 1;
+                } else {
+                    normalIndexOBJ += static_cast<int>(normals.GetCount());
+                }
 
 
-                        m_vertexData[actualIndexLocation].position[0] = positions[positionIndexOBJ][0];
-                        m_vertexData[actualIndexLocation].position[1] = positions[positionIndexOBJ][1];
-                        m_vertexData[actualIndexLocation].position[2] = positions[positionIndexOBJ][2];
+                m_vertexData[iUniqueVertex].position[0] = positions[positionIndexOBJ][0];
+                m_vertexData[iUniqueVertex].position[1] = positions[positionIndexOBJ][1];
+                m_vertexData[iUniqueVertex].position[2] = positions[positionIndexOBJ][2];
 
-                        m_vertexData[actualIndexLocation].texcoord[0] = texcoords[texcoordIndexOBJ][0];
-                        m_vertexData[actualIndexLocation].texcoord[1] = texcoords[texcoordIndexOBJ][1];
+                m_vertexData[iUniqueVertex].texcoord[0] = texcoords[texcoordIndexOBJ][0];
+                m_vertexData[iUniqueVertex].texcoord[1] = texcoords[texcoordIndexOBJ][1];
 
-                        m_vertexData[actualIndexLocation].normal[0]   = normals[normalIndexOBJ][0];
-                        m_vertexData[actualIndexLocation].normal[1]   = normals[normalIndexOBJ][1];
-                        m_vertexData[actualIndexLocation].normal[2]   = normals[normalIndexOBJ][2];
-                    }
-                    else
-                    {
-                        // Should never hit this
-                        assert(false);
-                    }
-                }
+                m_vertexData[iUniqueVertex].normal[0]   = normals[normalIndexOBJ][0];
+                m_vertexData[iUniqueVertex].normal[1]   = normals[normalIndexOBJ][1];
+                m_vertexData[iUniqueVertex].normal[2]   = normals[normalIndexOBJ][2];
             }
 
             return true;
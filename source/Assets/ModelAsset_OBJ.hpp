@@ -32,6 +32,9 @@ namespace GT
         /// @copydoc ModelAsset::Load()
         bool Load(const char* absolutePath, drfs_context* pVFS);
 
+        /// @copydoc Asset::LoadFromMemory()
+        bool LoadFromMemory(const char* absolutePath, const void* pData, size_t dataSizeInBytes);
+
 
         /// @copydoc ModelAsset::GetMeshCount()
         unsigned int GetMeshCount() const;
@@ -40,6 +40,34 @@ namespace GT
         return false;
     }
 
+    bool SoundAsset::LoadFromMemory(const char* absolutePath, const void* pData, size_t dataSizeInBytes)
+    {
+        (void)absolutePath;
+
+        // The sound data is streamed from for as long as the asset is alive, so it needs to be copied.
+        if (pData != nullptr && dataSizeInBytes > 0)
+        {
+            m_dataInfo.pData = malloc(dataSizeInBytes);
+            if (m_dataInfo.pData != nullptr)
+            {
+                memcpy(m_dataInfo.pData, pData, dataSizeInBytes);
+                m_dataInfo.dataSize = dataSizeInBytes;
+
+                SoundStreamer streamer(m_dataInfo.pData, m_dataInfo.dataSize);
+                if (streamer.Initialize())
+                {
+                    m_dataInfo.format     = streamer.GetFormat();
+                    m_dataInfo.channels   = streamer.GetNumChannels();
+                    m_dataInfo.sampleRate = streamer.GetSampleRate();
+
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
     VoiceDesc SoundAsset::GetDataInfo() const
     {
         return m_dataInfo;
@@ -0,0 +1,552 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#include <GTGE/BVHSceneCullingManager.hpp>
+#include <GTGE/SceneNode.hpp>
+#include <GTGE/Profiler.hpp>
+
+#undef min
+#undef max
+
+namespace GT
+{
+    BVHSceneCullingManager::BVHSceneCullingManager()
+        : m_bvh(), m_objects(),
+          m_models(), m_pointLights(), m_spotLights(), m_particleSystems(), m_ambientLights(), m_directionalLights(),
+          m_visibleObjects()
+    {
+    }
+
+    BVHSceneCullingManager::~BVHSceneCullingManager()
+    {
+    }
+
+
+    void BVHSceneCullingManager::AddModel(SceneNode &sceneNode)
+    {
+        assert(!m_models.Exists(&sceneNode));
+        {
+            m_models.Add(&sceneNode, this->AddObject(sceneNode, ObjectType_Model));
+        }
+    }
+
+    void BVHSceneCullingManager::RemoveModel(SceneNode &sceneNode)
+    {
+        auto iObject = m_models.Find(&sceneNode);
+        if (iObject != nullptr)
+        {
+            this->RemoveObject(iObject->value);
+            m_models.RemoveByIndex(iObject->index);
+        }
+    }
+
+
+    void BVHSceneCullingManager::AddPointLight(SceneNode &sceneNode)
+    {
+        assert(!m_pointLights.Exists(&sceneNode));
+        {
+            m_pointLights.Add(&sceneNode, this->AddObject(sceneNode, ObjectType_PointLight));
+        }
+    }
+
+    void BVHSceneCullingManager::RemovePointLight(SceneNode &sceneNode)
+    {
+        auto iObject = m_pointLights.Find(&sceneNode);
+        if (iObject != nullptr)
+        {
+            this->RemoveObject(iObject->value);
+            m_pointLights.RemoveByIndex(iObject->index);
+        }
+    }
+
+
+    void BVHSceneCullingManager::AddSpotLight(SceneNode &sceneNode)
+    {
+        assert(!m_spotLights.Exists(&sceneNode));
+        {
+            m_spotLights.Add(&sceneNode, this->AddObject(sceneNode, ObjectType_SpotLight));
+        }
+    }
+
+    void BVHSceneCullingManager::RemoveSpotLight(SceneNode &sceneNode)
+    {
+        auto iObject = m_spotLights.Find(&sceneNode);
+        if (iObject != nullptr)
+        {
+            this->RemoveObject(iObject->value);
+            m_spotLights.RemoveByIndex(iObject->index);
+        }
+    }
+
+
+    void BVHSceneCullingManager::AddDirectionalLight(SceneNode &sceneNode)
+    {
+        assert(sceneNode.HasComponent<DirectionalLightComponent>());
+        {
+            assert(!m_directionalLights.Exists(&sceneNode));
+            {
+                m_directionalLights.PushBack(&sceneNode);
+            }
+        }
+    }
+
+    void BVHSceneCullingManager::RemoveDirectionalLight(SceneNode &sceneNode)
+    {
+        m_directionalLights.RemoveFirstOccuranceOf(&sceneNode);
+    }
+
+
+    void BVHSceneCullingManager::AddAmbientLight(SceneNode &sceneNode)
+    {
+        assert(sceneNode.HasComponent<AmbientLightComponent>());
+        {
+            assert(!m_ambientLights.Exists(&sceneNode));
+            {
+                m_ambientLights.PushBack(&sceneNode);
+            }
+        }
+    }
+
+    void BVHSceneCullingManager::RemoveAmbientLight(SceneNode &sceneNode)
+    {
+        m_ambientLights.RemoveFirstOccuranceOf(&sceneNode);
+    }
+
+
+    void BVHSceneCullingManager::AddParticleSystem(SceneNode &sceneNode)
+    {
+        assert(!m_particleSystems.Exists(&sceneNode));
+        {
+            m_particleSystems.Add(&sceneNode, this->AddObject(sceneNode, ObjectType_ParticleSystem));
+        }
+    }
+
+    void BVHSceneCullingManager::RemoveParticleSystem(SceneNode &sceneNode)
+    {
+        auto iObject = m_particleSystems.Find(&sceneNode);
+        if (iObject != nullptr)
+        {
+            this->RemoveObject(iObject->value);
+            m_particleSystems.RemoveByIndex(iObject->index);
+        }
+    }
+
+
+    void BVHSceneCullingManager::AddOccluder(SceneNode &sceneNode)
+    {
+        // Occlusion culling is not supported.
+        (void)sceneNode;
+    }
+
+    void BVHSceneCullingManager::RemoveOccluder(SceneNode &sceneNode)
+    {
+        (void)sceneNode;
+    }
+
+
+    void BVHSceneCullingManager::UpdateModelTransform(SceneNode &sceneNode)
+    {
+        auto iObject = m_models.Find(&sceneNode);
+        assert(iObject != nullptr);
+        {
+            this->UpdateObject(iObject->value);
+        }
+    }
+
+    void BVHSceneCullingManager::UpdatePointLightTransform(SceneNode &sceneNode)
+    {
+        auto iObject = m_pointLights.Find(&sceneNode);
+        assert(iObject != nullptr);
+        {
+            this->UpdateObject(iObject->value);
+        }
+    }
+
+    void BVHSceneCullingManager::UpdateSpotLightTransform(SceneNode &sceneNode)
+    {
+        auto iObject = m_spotLights.Find(&sceneNode);
+        assert(iObject != nullptr);
+        {
+            this->UpdateObject(iObject->value);
+        }
+    }
+
+    void BVHSceneCullingManager::UpdateDirectionalLightTransform(SceneNode &sceneNode)
+    {
+        // Directional lights are always visible.
+        (void)sceneNode;
+    }
+
+    void BVHSceneCullingManager::UpdateAmbientLightTransform(SceneNode &sceneNode)
+    {
+        // Ambient lights are always visible.
+        (void)sceneNode;
+    }
+
+    void BVHSceneCullingManager::UpdateParticleSystemTransform(SceneNode &sceneNode)
+    {
+        // The particles in a particle system are always defined in world space, so moving the scene node doesn't change the bounds.
+        (void)sceneNode;
+    }
+
+    void BVHSceneCullingManager::UpdateOccluderTransform(SceneNode &sceneNode)
+    {
+        (void)sceneNode;
+    }
+
+
+    void BVHSceneCullingManager::UpdateModelScale(SceneNode &sceneNode)
+    {
+        this->UpdateModelAABB(sceneNode);
+    }
+
+    void BVHSceneCullingManager::UpdateOccluderScale(SceneNode &sceneNode)
+    {
+        (void)sceneNode;
+    }
+
+
+    void BVHSceneCullingManager::UpdateModelAABB(SceneNode &sceneNode)
+    {
+        auto iObject = m_models.Find(&sceneNode);
+        assert(iObject != nullptr);
+        {
+            this->UpdateObject(iObject->value);
+        }
+    }
+
+    void BVHSceneCullingManager::UpdateParticleSystemAABB(SceneNode &sceneNode)
+    {
+        auto iObject = m_particleSystems.Find(&sceneNode);
+        assert(iObject != nullptr);
+        {
+            this->UpdateObject(iObject->value);
+        }
+    }
+
+
+
+    void BVHSceneCullingManager::GetGlobalAABB(glm::vec3 &aabbMin, glm::vec3 &aabbMax) const
+    {
+        m_bvh.GetGlobalAABB(aabbMin, aabbMax);
+    }
+
+
+    void BVHSceneCullingManager::ProcessVisibleSceneNodes(const glm::mat4 &mvp, VisibilityCallback &callback) const
+    {
+        GT_PROFILE_ZONE("BVHSceneCullingManager::ProcessVisibleSceneNodes");
+
+        m_bvh.Commit();
+
+        // The visible objects are all collected before any of them are passed to the callback, which keeps the tree traversal in
+        // a tight loop.
+        m_visibleObjects.Clear();
+
+        if ((this->GetFlags() & SceneCullingManager::NoFrustumCulling))
+        {
+            m_bvh.QueryAll(m_visibleObjects);
+        }
+        else
+        {
+            m_bvh.QueryFrustum(mvp, m_visibleObjects);
+        }
+
+        for (size_t i = 0; i < m_visibleObjects.count; ++i)
+        {
+            this->ProcessVisibleObject(m_objects.buffer[m_visibleObjects.buffer[i]], callback);
+        }
+
+
+        for (size_t i = 0; i < m_ambientLights.count; ++i)
+        {
+            callback.ProcessAmbientLight(*m_ambientLights[i]);
+        }
+
+        for (size_t i = 0; i < m_directionalLights.count; ++i)
+        {
+            callback.ProcessDirectionalLight(*m_directionalLights[i]);
+        }
+    }
+
+
+    void BVHSceneCullingManager::QueryPointLightContacts(const SceneNode &light, VisibilityCallback &callback) const
+    {
+        auto iObject = m_pointLights.Find(&light);
+        assert(iObject != nullptr);
+        {
+            this->QueryLightContacts(iObject->value, callback);
+        }
+    }
+
+    void BVHSceneCullingManager::QuerySpotLightContacts(const SceneNode &light, VisibilityCallback &callback) const
+    {
+        auto iObject = m_spotLights.Find(&light);
+        assert(iObject != nullptr);
+        {
+            this->QueryLightContacts(iObject->value, callback);
+        }
+    }
+
+    bool BVHSceneCullingManager::IsLightContactQueryThreadSafe() const
+    {
+        return true;
+    }
+
+
+
+    ////////////////////////////////////////////////
+    // Protected
+
+    uint32_t BVHSceneCullingManager::AddObject(SceneNode &sceneNode, ObjectType type)
+    {
+        CullingObject object;
+        object.sceneNode = &sceneNode;
+        object.type      = type;
+        object.position  = glm::vec3(0.0f);
+        object.direction = glm::vec3(0.0f, 0.0f, -1.0f);
+        object.radius    = 0.0f;
+        object.sinAngle  = 0.0f;
+        object.cosAngle  = 1.0f;
+
+        glm::vec3 aabbMin;
+        glm::vec3 aabbMax;
+        this->CalculateObjectAABB(object, aabbMin, aabbMax);
+
+        // IDs are handed out in order unless one has been freed, so the list only ever needs to grow by one.
+        uint32_t objectID = m_bvh.Add(aabbMin, aabbMax);
+        assert(objectID <= m_objects.count);
+        {
+            if (objectID == m_objects.count)
+            {
+                m_objects.PushBack(object);
+            }
+            else
+            {
+                m_objects[objectID] = object;
+            }
+        }
+
+        return objectID;
+    }
+
+    void BVHSceneCullingManager::RemoveObject(uint32_t objectID)
+    {
+        m_bvh.Remove(objectID);
+        m_objects[objectID].sceneNode = nullptr;
+    }
+
+    void BVHSceneCullingManager::UpdateObject(uint32_t objectID)
+    {
+        glm::vec3 aabbMin;
+        glm::vec3 aabbMax;
+        this->CalculateObjectAABB(m_objects[objectID], aabbMin, aabbMax);
+
+        m_bvh.Update(objectID, aabbMin, aabbMax);
+    }
+
+    void BVHSceneCullingManager::CalculateObjectAABB(CullingObject &object, glm::vec3 &aabbMinOut, glm::vec3 &aabbMaxOut) const
+    {
+        assert(object.sceneNode != nullptr);
+
+        auto &sceneNode = *object.sceneNode;
+
+        aabbMinOut = glm::vec3(0.0f);
+        aabbMaxOut = glm::vec3(0.0f);
+
+        switch (object.type)
+        {
+        case ObjectType_Model:
+            {
+                auto modelComponent = sceneNode.GetComponent<ModelComponent>();
+                if (modelComponent != nullptr && modelComponent->GetModel() != nullptr)
+                {
+                    glm::vec3 localMin;
+                    glm::vec3 localMax;
+                    modelComponent->GetModel()->GetAABB(localMin, localMax);
+
+                    glm::vec3 position;
+                    glm::quat orientation;
+                    glm::vec3 scale;
+                    sceneNode.GetWorldTransformComponents(position, orientation, scale);
+
+                    localMin *= scale;
+                    localMax *= scale;
+
+                    // The box around the rotated box. Each world axis picks up the local extents along it's row of the rotation.
+                    glm::mat3 rotation = glm::mat3_cast(orientation);
+                    glm::mat3 absRotation(glm::abs(rotation[0]), glm::abs(rotation[1]), glm::abs(rotation[2]));
+
+                    glm::vec3 centre  = position + rotation * ((localMin + localMax) * 0.5f);
+                    glm::vec3 extents = absRotation * ((localMax - localMin) * 0.5f);
+
+                    aabbMinOut = centre - extents;
+                    aabbMaxOut = centre + extents;
+                }
+
+                break;
+            }
+
+        case ObjectType_PointLight:
+            {
+                auto pointLightComponent = sceneNode.GetComponent<PointLightComponent>();
+                assert(pointLightComponent != nullptr);
+                {
+                    object.position = sceneNode.GetWorldPosition();
+                    object.radius   = pointLightComponent->GetRadius();
+
+                    aabbMinOut = object.position - glm::vec3(object.radius);
+                    aabbMaxOut = object.position + glm::vec3(object.radius);
+                }
+
+                break;
+            }
+
+        case ObjectType_SpotLight:
+            {
+                auto spotLightComponent = sceneNode.GetComponent<SpotLightComponent>();
+                assert(spotLightComponent != nullptr);
+                {
+                    // The cone has it's apex at the scene node and the same base radius as DefaultSceneCullingManager's cone shape.
+                    float length     = spotLightComponent->GetLength();
+                    float baseRadius = glm::sin(glm::radians(spotLightComponent->GetOuterAngle())) * length;
+                    float slant      = glm::sqrt(length*length + baseRadius*baseRadius);
+
+                    object.position  = sceneNode.GetWorldPosition();
+                    object.direction = sceneNode.GetWorldForwardVector();
+                    object.radius    = length;
+                    object.sinAngle  = (slant > 0.0f) ? baseRadius / slant : 0.0f;
+                    object.cosAngle  = (slant > 0.0f) ? length     / slant : 1.0f;
+
+                    // The bounds of the base disc, combined with the apex.
+                    glm::vec3 baseCentre  = object.position + object.direction * length;
+                    glm::vec3 baseExtents = baseRadius * glm::sqrt(glm::max(glm::vec3(1.0f) - object.direction * object.direction, glm::vec3(0.0f)));
+
+                    aabbMinOut = glm::min(object.position, baseCentre - baseExtents);
+                    aabbMaxOut = glm::max(object.position, baseCentre + baseExtents);
+                }
+
+                break;
+            }
+
+        case ObjectType_ParticleSystem:
+            {
+                auto particleSystemComponent = sceneNode.GetComponent<ParticleSystemComponent>();
+                if (particleSystemComponent != nullptr && particleSystemComponent->GetParticleSystem() != nullptr)
+                {
+                    particleSystemComponent->GetParticleSystem()->GetAABB(aabbMinOut, aabbMaxOut);
+                }
+
+                break;
+            }
+
+        default: break;
+        }
+    }
+
+    void BVHSceneCullingManager::ProcessVisibleObject(const CullingObject &object, VisibilityCallback &callback) const
+    {
+        assert(object.sceneNode != nullptr);
+
+        auto &sceneNode = *object.sceneNode;
+        if (sceneNode.IsVisible())
+        {
+            switch (object.type)
+            {
+            case ObjectType_Model:
+                {
+                    auto modelComponent = sceneNode.GetComponent<ModelComponent>();
+                    if (modelComponent != nullptr && modelComponent->GetModel() != nullptr && modelComponent->IsModelVisible())
+                    {
+                        callback.ProcessModel(sceneNode);
+                    }
+
+                    break;
+                }
+
+            case ObjectType_PointLight:
+                {
+                    callback.ProcessPointLight(sceneNode);
+                    break;
+                }
+
+            case ObjectType_SpotLight:
+                {
+                    callback.ProcessSpotLight(sceneNode);
+                    break;
+                }
+
+            case ObjectType_ParticleSystem:
+                {
+                    auto particleSystemComponent = sceneNode.GetComponent<ParticleSystemComponent>();
+                    if (particleSystemComponent != nullptr && particleSystemComponent->GetParticleSystem() != nullptr)
+                    {
+                        callback.ProcessParticleSystem(sceneNode);
+                    }
+
+                    break;
+                }
+
+            default: break;
+            }
+        }
+    }
+
+    void BVHSceneCullingManager::QueryLightContacts(uint32_t lightID, VisibilityCallback &callback) const
+    {
+        auto &light = m_objects.buffer[lightID];
+        assert(light.type == ObjectType_PointLight || light.type == ObjectType_SpotLight);
+
+        glm::vec3 lightMin;
+        glm::vec3 lightMax;
+        m_bvh.GetAABB(lightID, lightMin, lightMax);
+
+        Vector<uint32_t> candidates;
+        m_bvh.QueryAABB(lightMin, lightMax, candidates);
+
+        for (size_t i = 0; i < candidates.count; ++i)
+        {
+            uint32_t objectID = candidates.buffer[i];
+
+            auto &object = m_objects.buffer[objectID];
+            if (object.type != ObjectType_Model && object.type != ObjectType_ParticleSystem)
+            {
+                continue;
+            }
+
+            glm::vec3 aabbMin;
+            glm::vec3 aabbMax;
+            m_bvh.GetAABB(objectID, aabbMin, aabbMax);
+
+            bool touching;
+            if (light.type == ObjectType_PointLight)
+            {
+                // The closest point in the box to the centre of the sphere.
+                glm::vec3 closest = glm::clamp(light.position, aabbMin, aabbMax) - light.position;
+                touching = glm::dot(closest, closest) <= light.radius * light.radius;
+            }
+            else
+            {
+                // The cone is tested against the sphere around the box, which is conservative but cheap.
+                glm::vec3 centre = (aabbMin + aabbMax) * 0.5f;
+                float     radius = glm::length(aabbMax - aabbMin) * 0.5f;
+
+                glm::vec3 offset   = centre - light.position;
+                float     axial    = glm::dot(offset, light.direction);
+                float     radial   = glm::length(offset - light.direction * axial);
+
+                touching = axial >= -radius && axial <= light.radius + radius && (radial * light.cosAngle - axial * light.sinAngle) <= radius;
+            }
+
+            if (touching)
+            {
+                if (object.type == ObjectType_Model)
+                {
+                    callback.ProcessModel(*object.sceneNode);
+                }
+                else
+                {
+                    callback.ProcessParticleSystem(*object.sceneNode);
+                }
+            }
+        }
+    }
+}
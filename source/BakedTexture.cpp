@@ -0,0 +1,243 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#include <GTGE/BakedTexture.hpp>
+#include <GTGE/Core/Image.hpp>
+#include <GTGE/Core/ImageUtils.hpp>
+#include <GTGE/Core/Vector.hpp>
+#include <GTGE/external/stb_dxt.h>
+#include <cstring>
+
+namespace GT
+{
+    /// Determines whether or not the given format can be stored in a baked texture.
+    static bool BakedTexture_IsSupportedFormat(ImageFormat format)
+    {
+        return format == ImageFormat_RGB8 || format == ImageFormat_RGBA8 || format == ImageFormat_DXT1 || format == ImageFormat_DXT5;
+    }
+
+    /// Determines whether or not any texel of the given RGBA8 mipmap is not fully opaque.
+    static bool BakedTexture_HasTranslucentTexels(const Mipmap &mipmap)
+    {
+        auto texels = static_cast<const uint8_t*>(mipmap.data);
+
+        size_t texelCount = static_cast<size_t>(mipmap.width) * mipmap.height;
+        for (size_t iTexel = 0; iTexel < texelCount; ++iTexel)
+        {
+            if (texels[iTexel*4 + 3] != 255)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /// Block-compresses the given RGB8 or RGBA8 mipmap.
+    ///
+    /// @remarks
+    ///     'pDataOut' must be at least ImageUtils::CalculateDataSize() bytes for the compressed format.
+    static void BakedTexture_CompressMipmap(const Mipmap &mipmap, ImageFormat compressedFormat, uint8_t* pDataOut)
+    {
+        auto texels         = static_cast<const uint8_t*>(mipmap.data);
+        auto componentCount = GetImageFormatComponentCount(mipmap.format);
+        auto blockSize      = GetImageFormatBlockSizeInBytes(compressedFormat);
+
+        uint8_t block[4*4*4];
+
+        for (unsigned int blockY = 0; blockY < mipmap.height; blockY += 4)
+        {
+            for (unsigned int blockX = 0; blockX < mipmap.width; blockX += 4)
+            {
+                for (unsigned int y = 0; y < 4; ++y)
+                {
+                    for (unsigned int x = 0; x < 4; ++x)
+                    {
+                        // Mipmaps smaller than a block are padded by repeating the last row and column.
+                        unsigned int texelX = Min(blockX + x, mipmap.width  - 1);
+                        unsigned int texelY = Min(blockY + y, mipmap.height - 1);
+
+                        auto src = texels + ((static_cast<size_t>(texelY) * mipmap.width) + texelX) * componentCount;
+                        auto dst = block  + ((y * 4) + x) * 4;
+
+                        dst[0] = src[0];
+                        dst[1] = src[1];
+                        dst[2] = src[2];
+                        dst[3] = (componentCount == 4) ? src[3] : 255;
+                    }
+                }
+
+                stb_compress_dxt_block(pDataOut, block, (compressedFormat == ImageFormat_DXT5) ? 1 : 0, STB_DXT_HIGHQUAL);
+                pDataOut += blockSize;
+            }
+        }
+    }
+
+
+    BakedTexture::BakedTexture()
+        : m_header(), m_pMipmapData()
+    {
+    }
+
+
+    bool BakedTexture::Parse(const void* pData, size_t dataSize)
+    {
+        if (pData == nullptr || dataSize < sizeof(BakedTextureHeader))
+        {
+            return false;
+        }
+
+        BakedTextureHeader header;
+        memcpy(&header, pData, sizeof(header));
+
+        if (header.magic != BakedTexture::Magic || header.version != BakedTexture::Version)
+        {
+            return false;
+        }
+
+        if (!BakedTexture_IsSupportedFormat(static_cast<ImageFormat>(header.format)) || header.width == 0 || header.height == 0)
+        {
+            return false;
+        }
+
+        if (header.mipmapCount == 0 || header.mipmapCount > BakedTexture::MaxMipmapCount || header.mipmapCount > ImageUtils::CalculateMipmapCount(header.width, header.height))
+        {
+            return false;
+        }
+
+
+        // Every mipmap must lie inside the data.
+        const uint8_t* pMipmapData[BakedTexture::MaxMipmapCount];
+
+        size_t offset = sizeof(BakedTextureHeader);
+        for (uint32_t iMipmap = 0; iMipmap < header.mipmapCount; ++iMipmap)
+        {
+            size_t mipmapSize = ImageUtils::CalculateDataSize(ImageUtils::CalculateMipmapWidth(iMipmap, header.width), ImageUtils::CalculateMipmapHeight(iMipmap, header.height), static_cast<ImageFormat>(header.format));
+            if (mipmapSize > dataSize - offset)
+            {
+                return false;
+            }
+
+            pMipmapData[iMipmap] = static_cast<const uint8_t*>(pData) + offset;
+            offset += mipmapSize;
+        }
+
+
+        m_header = header;
+        memcpy(m_pMipmapData, pMipmapData, header.mipmapCount * sizeof(const uint8_t*));
+
+        return true;
+    }
+
+
+    unsigned int BakedTexture::GetMipmapWidth(uint32_t mipmapIndex) const
+    {
+        assert(mipmapIndex < m_header.mipmapCount);
+        return ImageUtils::CalculateMipmapWidth(mipmapIndex, m_header.width);
+    }
+
+    unsigned int BakedTexture::GetMipmapHeight(uint32_t mipmapIndex) const
+    {
+        assert(mipmapIndex < m_header.mipmapCount);
+        return ImageUtils::CalculateMipmapHeight(mipmapIndex, m_header.height);
+    }
+
+    const void* BakedTexture::GetMipmapData(uint32_t mipmapIndex) const
+    {
+        assert(mipmapIndex < m_header.mipmapCount);
+        return m_pMipmapData[mipmapIndex];
+    }
+
+
+    bool BakedTexture::Bake(drfs_context* pVFS, const char* sourceAbsolutePath, const char* outputAbsolutePath, bool flip, bool compress, ThreadPool* pThreadPool)
+    {
+        Image source(sourceAbsolutePath);
+        if (!source.IsLinkedToFile())
+        {
+            return false;
+        }
+
+        source.PullAllMipmaps();
+
+        ImageFormat sourceFormat = source.GetFormat();
+        if (source.GetBaseMipmapData() == nullptr || (sourceFormat != ImageFormat_RGB8 && sourceFormat != ImageFormat_RGBA8))
+        {
+            return false;
+        }
+
+
+        // The image is flipped before loading so that every mipmap is generated in the right orientation.
+        Image image;
+        if (flip)
+        {
+            image.FlipVertically();
+        }
+
+        if (!image.Load(source.GetWidth(), source.GetHeight(), sourceFormat, source.GetBaseMipmapData()) || !image.GenerateMipmaps(MipmapFilter_Box, pThreadPool))
+        {
+            return false;
+        }
+
+        uint32_t mipmapCount = static_cast<uint32_t>(Min(image.GetMipmapCount(), static_cast<size_t>(BakedTexture::MaxMipmapCount)));
+
+
+        // The base dimensions need to be multiples of 4 for compression. Everything else stays as it is.
+        ImageFormat bakedFormat = sourceFormat;
+        if (compress && (image.GetWidth() % 4) == 0 && (image.GetHeight() % 4) == 0)
+        {
+            if (sourceFormat == ImageFormat_RGBA8 && BakedTexture_HasTranslucentTexels(image.GetMipmap(0)))
+            {
+                bakedFormat = ImageFormat_DXT5;
+            }
+            else
+            {
+                bakedFormat = ImageFormat_DXT1;
+            }
+        }
+
+
+        drfs_file* pOutputFile;
+        if (drfs_open(pVFS, outputAbsolutePath, DRFS_WRITE | DRFS_CREATE_DIRS, &pOutputFile) != drfs_success)
+        {
+            return false;
+        }
+
+        BakedTextureHeader header;
+        header.magic       = BakedTexture::Magic;
+        header.version     = BakedTexture::Version;
+        header.format      = static_cast<uint32_t>(bakedFormat);
+        header.width       = image.GetWidth();
+        header.height      = image.GetHeight();
+        header.mipmapCount = mipmapCount;
+        header.flags       = flip ? BakedTextureFlag_Flipped : 0;
+        header.reserved    = 0;
+
+        bool result = drfs_write(pOutputFile, &header, sizeof(header), nullptr) == drfs_success;
+
+        Vector<uint8_t> compressedData;
+        for (uint32_t iMipmap = 0; iMipmap < mipmapCount && result; ++iMipmap)
+        {
+            auto &mipmap = image.GetMipmap(iMipmap);
+
+            if (IsImageFormatCompressed(bakedFormat))
+            {
+                compressedData.Resize(ImageUtils::CalculateDataSize(mipmap.width, mipmap.height, bakedFormat));
+                BakedTexture_CompressMipmap(mipmap, bakedFormat, compressedData.buffer);
+
+                result = drfs_write(pOutputFile, compressedData.buffer, static_cast<unsigned int>(compressedData.count), nullptr) == drfs_success;
+            }
+            else
+            {
+                result = drfs_write(pOutputFile, mipmap.data, static_cast<unsigned int>(mipmap.GetDataSizeInBytes()), nullptr) == drfs_success;
+            }
+        }
+
+        drfs_close(pOutputFile);
+
+        if (!result)
+        {
+            drfs_delete_file(pVFS, outputAbsolutePath);
+        }
+
+        return result;
+    }
+}
@@ -71,17 +71,23 @@ namespace GT
         }
     }
 
-    void ProcessVertexShader(CPUVertexShader &shader, size_t firstVertexID, size_t lastVertexID)
+    void ProcessVertexShader(CPUVertexShader &shader, size_t firstVertexID, size_t endVertexID, size_t threadIndex)
     {
+        // The shader may have a specialised kernel for the whole range.
+        if (shader.ProcessVertexRange(shader.m_input, shader.m_output, firstVertexID, endVertexID, threadIndex))
+        {
+            return;
+        }
+
         // We need to iterate over each vertex and process it.
-        for (size_t i = firstVertexID; i <= lastVertexID; ++i)
+        for (size_t i = firstVertexID; i < endVertexID; ++i)
         {
             // The first step is to copy the vertex data to the output buffer.
             auto vertexOutput = shader.m_output + (i * shader.m_vertexSizeInFloats);
             auto vertexInput  = shader.m_input  + (i * shader.m_vertexSizeInFloats);
 
             // Now we can process the vertex.
-            CPUVertexShader::Vertex vertex(i, vertexOutput, shader.m_format);
+            CPUVertexShader::Vertex vertex(static_cast<unsigned int>(i), static_cast<unsigned int>(threadIndex), vertexOutput, shader.m_format);
             if (shader.m_usingPosition)  vertex.Position  = GetVertexAttribute4(vertexInput, shader.m_positionComponentCount,  shader.m_positionOffset);
             if (shader.m_usingTexCoord)  vertex.TexCoord  = GetVertexAttribute4(vertexInput, shader.m_texCoordComponentCount,  shader.m_texCoordOffset);
             if (shader.m_usingNormal)    vertex.Normal    = GetVertexAttribute4(vertexInput, shader.m_normalComponentCount,    shader.m_normalOffset);
@@ -101,7 +107,7 @@ namespace GT
 
 
     CPUVertexShader::CPUVertexShader()
-        : m_input(nullptr), m_vertexCount(0), m_format(), m_vertexSizeInFloats(m_format.GetSize()), m_output(nullptr),
+        : m_input(nullptr), m_vertexCount(0), m_format(), m_vertexSizeInFloats(m_format.GetSize()), m_output(nullptr), m_threadCount(1),
           m_usingPosition(false), m_usingTexCoord(false), m_usingNormal(false), m_usingTangent(false), m_usingBitangent(false),
           m_positionComponentCount(0), m_positionOffset(0),
           m_texCoordComponentCount(0), m_texCoordOffset(0),
@@ -116,27 +122,58 @@ namespace GT
     }
 
 
-    bool CPUVertexShader::Execute(const float* input, size_t vertexCount, const VertexFormat &format, float* output, size_t threadCount)
+    /// Structure passed to the temporary threads created by CPUVertexShader::Execute().
+    struct CPUVertexShaderThreadData
     {
-        (void)threadCount;
+        CPUVertexShader* pShader;
+        size_t threadIndex;
+    };
 
-        if (input != nullptr && output != nullptr)
+    bool CPUVertexShader::Execute(const float* input, size_t vertexCount, const VertexFormat &format, float* output, size_t threadCount)
+    {
+        if (this->BeginExecute(input, vertexCount, format, output, threadCount))
         {
             this->OnStartExecute();
             {
-                m_input              = input;
-                m_vertexCount        = vertexCount;
-                m_format             = format;
-                m_vertexSizeInFloats = m_format.GetSize();
-                m_output             = output;
-
-                m_usingPosition  = m_format.GetAttributeInfo(VertexAttribs::Position,  m_positionComponentCount,  m_positionOffset);
-                m_usingTexCoord  = m_format.GetAttributeInfo(VertexAttribs::TexCoord,  m_texCoordComponentCount,  m_texCoordOffset);
-                m_usingNormal    = m_format.GetAttributeInfo(VertexAttribs::Normal,    m_normalComponentCount,    m_normalOffset);
-                m_usingTangent   = m_format.GetAttributeInfo(VertexAttribs::Tangent,   m_tangentComponentCount,   m_tangentOffset);
-                m_usingBitangent = m_format.GetAttributeInfo(VertexAttribs::Bitangent, m_bitangentComponentCount, m_bitangentOffset);
-
-                ProcessVertexShader(*this, 0, m_vertexCount - 1);
+                if (m_threadCount > 1)
+                {
+                    // The calling thread does the first chunk. Everything else gets a temporary thread.
+                    Vector<CPUVertexShaderThreadData> threadData(m_threadCount);
+                    Vector<dr_thread> threads(m_threadCount);
+                    for (size_t iThread = 1; iThread < m_threadCount; ++iThread)
+                    {
+                        CPUVertexShaderThreadData data;
+                        data.pShader     = this;
+                        data.threadIndex = iThread;
+                        threadData.PushBack(data);
+                    }
+
+                    for (size_t iThread = 1; iThread < m_threadCount; ++iThread)
+                    {
+                        dr_thread thread = dr_create_thread(ExecuteThreadProc, &threadData[iThread - 1]);
+                        if (thread != NULL)
+                        {
+                            threads.PushBack(thread);
+                        }
+                        else
+                        {
+                            // Couldn't create the thread. Just do the chunk on this thread instead.
+                            ExecuteThreadProc(&threadData[iThread - 1]);
+                        }
+                    }
+
+                    ExecuteJob(0, 0, this);
+
+                    for (size_t iThread = 0; iThread < threads.count; ++iThread)
+                    {
+                        dr_wait_thread(threads[iThread]);
+                        dr_delete_thread(threads[iThread]);
+                    }
+                }
+                else
+                {
+                    ProcessVertexShader(*this, 0, m_vertexCount, 0);
+                }
             }
             this->OnEndExecute();
 
@@ -146,6 +183,25 @@ namespace GT
         return false;
     }
 
+    bool CPUVertexShader::Execute(const float* input, size_t vertexCount, const VertexFormat &format, float* output, ThreadPool &threadPool)
+    {
+        if (this->BeginExecute(input, vertexCount, format, output, threadPool.GetThreadCount()))
+        {
+            this->OnStartExecute();
+            {
+                // Each job is a chunk of vertices. The job index is used as the thread index for ProcessVertex() because that's what's
+                // used to index per-thread state. Using the pool's thread index would not work because a single pool thread can end up
+                // processing more than one chunk.
+                threadPool.Run(m_threadCount, ExecuteJob, this);
+            }
+            this->OnEndExecute();
+
+            return true;
+        }
+
+        return false;
+    }
+
 
     void CPUVertexShader::OnStartExecute()
     {
@@ -155,14 +211,89 @@ namespace GT
     {
     }
 
+    bool CPUVertexShader::ProcessVertexRange(const float* input, float* output, size_t firstVertexID, size_t endVertexID, size_t threadIndex)
+    {
+        (void)input;
+        (void)output;
+        (void)firstVertexID;
+        (void)endVertexID;
+        (void)threadIndex;
+
+        return false;
+    }
+
+
+
+    bool CPUVertexShader::BeginExecute(const float* input, size_t vertexCount, const VertexFormat &format, float* output, size_t threadCount)
+    {
+        if (input == nullptr || output == nullptr)
+        {
+            return false;
+        }
+
+        m_input              = input;
+        m_vertexCount        = vertexCount;
+        m_format             = format;
+        m_vertexSizeInFloats = m_format.GetSize();
+        m_output             = output;
+
+        m_usingPosition  = m_format.GetAttributeInfo(VertexAttribs::Position,  m_positionComponentCount,  m_positionOffset);
+        m_usingTexCoord  = m_format.GetAttributeInfo(VertexAttribs::TexCoord,  m_texCoordComponentCount,  m_texCoordOffset);
+        m_usingNormal    = m_format.GetAttributeInfo(VertexAttribs::Normal,    m_normalComponentCount,    m_normalOffset);
+        m_usingTangent   = m_format.GetAttributeInfo(VertexAttribs::Tangent,   m_tangentComponentCount,   m_tangentOffset);
+        m_usingBitangent = m_format.GetAttributeInfo(VertexAttribs::Bitangent, m_bitangentComponentCount, m_bitangentOffset);
+
+        // We don't want to be splitting tiny meshes across threads. The overhead would outweigh the benefit.
+        size_t maxThreadCount = Max(static_cast<size_t>(1), m_vertexCount / MinVerticesPerThread);
+        m_threadCount = Clamp(threadCount, static_cast<size_t>(1), maxThreadCount);
+
+        return true;
+    }
+
+    void CPUVertexShader::GetThreadVertexRange(size_t threadIndex, size_t &firstVertexIDOut, size_t &endVertexIDOut) const
+    {
+        assert(threadIndex < m_threadCount);
+
+        size_t verticesPerThread = m_vertexCount / m_threadCount;
+        size_t remainder         = m_vertexCount % m_threadCount;
+
+        // The remainder is spread across the first few threads so no thread gets more than one extra vertex.
+        firstVertexIDOut = (threadIndex * verticesPerThread) + Min(threadIndex, remainder);
+        endVertexIDOut   = firstVertexIDOut + verticesPerThread + ((threadIndex < remainder) ? 1 : 0);
+    }
+
+    void CPUVertexShader::ExecuteJob(size_t jobIndex, size_t threadIndex, void* pUserData)
+    {
+        (void)threadIndex;
+
+        auto pShader = reinterpret_cast<CPUVertexShader*>(pUserData);
+        assert(pShader != nullptr);
+
+        size_t firstVertexID;
+        size_t endVertexID;
+        pShader->GetThreadVertexRange(jobIndex, firstVertexID, endVertexID);
+
+        ProcessVertexShader(*pShader, firstVertexID, endVertexID, jobIndex);
+    }
+
+    int CPUVertexShader::ExecuteThreadProc(void* pData)
+    {
+        auto pThreadData = reinterpret_cast<CPUVertexShaderThreadData*>(pData);
+        assert(pThreadData != nullptr);
+
+        ExecuteJob(pThreadData->threadIndex, pThreadData->threadIndex, pThreadData->pShader);
+
+        return 0;
+    }
+
 
 
 
     ///////////////////////////////////////
     // CPUVertexShader::Vertex
 
-    CPUVertexShader::Vertex::Vertex(unsigned int id, float* data, const VertexFormat &format)
-        : id(id), data(data), format(format),
+    CPUVertexShader::Vertex::Vertex(unsigned int id, unsigned int threadIndex, float* data, const VertexFormat &format)
+        : id(id), threadIndex(threadIndex), data(data), format(format),
           Position(0.0f, 0.0f, 0.0f, 1.0f),
           TexCoord(),
           Normal(),
@@ -180,6 +311,11 @@ namespace GT
         return this->id;
     }
 
+    unsigned int CPUVertexShader::Vertex::GetThreadIndex() const
+    {
+        return this->threadIndex;
+    }
+
     glm::vec4 CPUVertexShader::Vertex::Get(int attribute)
     {
         glm::vec4 value(0.0f, 0.0f, 0.0f, 1.0f);
@@ -4,23 +4,85 @@
 
 namespace GT
 {
-    /*
-    glm::simdVec4 mul(const glm::simdMat4 &m, const glm::simdVec4 &v)
+#if defined(GT_BUILD_SSE2)
+    /// Loads a 3-component vector into the xyz components of a register, setting w to the given value. This never reads past the third float.
+    static inline __m128 Skinning_Load3(const float* pData, __m128 w)
     {
-        __m128 v0 = _mm_mul_ps(m[0].Data, _mm_shuffle_ps(v.Data, v.Data, _MM_SHUFFLE(0,0,0,0)));
-        __m128 v1 = _mm_mul_ps(m[1].Data, _mm_shuffle_ps(v.Data, v.Data, _MM_SHUFFLE(1,1,1,1)));
-        __m128 v2 = _mm_mul_ps(m[2].Data, _mm_shuffle_ps(v.Data, v.Data, _MM_SHUFFLE(2,2,2,2)));
-        __m128 v3 = _mm_mul_ps(m[3].Data, _mm_shuffle_ps(v.Data, v.Data, _MM_SHUFFLE(3,3,3,3)));
+        __m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(pData)));
+        __m128 z  = _mm_load_ss(pData + 2);
+        __m128 zw = _mm_unpacklo_ps(z, w);
 
-        return glm::simdVec4(_mm_add_ps(_mm_add_ps(v0, v1), _mm_add_ps(v2, v3)));
+        return _mm_movelh_ps(xy, zw);
     }
-    */
+
+    /// Stores the xyz components of a register. This never writes past the third float.
+    static inline void Skinning_Store3(float* pData, __m128 v)
+    {
+        _mm_storel_pi(reinterpret_cast<__m64*>(pData), v);
+        _mm_store_ss(pData + 2, _mm_movehl_ps(v, v));
+    }
+
+    /// Multiplies a column-major matrix by a vector.
+    static inline __m128 Skinning_Mul(const __m128 m[4], __m128 v)
+    {
+        __m128 v0 = _mm_mul_ps(m[0], _mm_shuffle_ps(v, v, _MM_SHUFFLE(0,0,0,0)));
+        __m128 v1 = _mm_mul_ps(m[1], _mm_shuffle_ps(v, v, _MM_SHUFFLE(1,1,1,1)));
+        __m128 v2 = _mm_mul_ps(m[2], _mm_shuffle_ps(v, v, _MM_SHUFFLE(2,2,2,2)));
+        __m128 v3 = _mm_mul_ps(m[3], _mm_shuffle_ps(v, v, _MM_SHUFFLE(3,3,3,3)));
+
+        return _mm_add_ps(_mm_add_ps(v0, v1), _mm_add_ps(v2, v3));
+    }
+
+    /// Blends the skinning transforms of the bones affecting a vertex into a single matrix.
+    ///
+    /// Since skinning is linear, transforming by the blended matrix gives the same result as blending the transformed vectors, but it means
+    /// we only need to do a single matrix/vector multiply per attribute rather than one per bone.
+    static inline void Skinning_BlendMatrices(const glm::mat4* skinningPalette, const SkinningVertexAttribute &skinningData, __m128 blendedOut[4])
+    {
+    #if defined(GT_BUILD_AVX)
+        __m256 m01 = _mm256_setzero_ps();
+        __m256 m23 = _mm256_setzero_ps();
+
+        for (size_t i = 0; i < skinningData.bones.count; ++i)
+        {
+            const float* pTransform = &skinningPalette[skinningData.bones.buffer[i].boneIndex][0][0];
+            __m256 weight = _mm256_set1_ps(skinningData.bones.buffer[i].weight);
+
+            m01 = _mm256_add_ps(m01, _mm256_mul_ps(weight, _mm256_loadu_ps(pTransform + 0)));
+            m23 = _mm256_add_ps(m23, _mm256_mul_ps(weight, _mm256_loadu_ps(pTransform + 8)));
+        }
+
+        blendedOut[0] = _mm256_castps256_ps128(m01);
+        blendedOut[1] = _mm256_extractf128_ps(m01, 1);
+        blendedOut[2] = _mm256_castps256_ps128(m23);
+        blendedOut[3] = _mm256_extractf128_ps(m23, 1);
+    #else
+        blendedOut[0] = _mm_setzero_ps();
+        blendedOut[1] = _mm_setzero_ps();
+        blendedOut[2] = _mm_setzero_ps();
+        blendedOut[3] = _mm_setzero_ps();
+
+        for (size_t i = 0; i < skinningData.bones.count; ++i)
+        {
+            const float* pTransform = &skinningPalette[skinningData.bones.buffer[i].boneIndex][0][0];
+            __m128 weight = _mm_set1_ps(skinningData.bones.buffer[i].weight);
+
+            blendedOut[0] = _mm_add_ps(blendedOut[0], _mm_mul_ps(weight, _mm_loadu_ps(pTransform +  0)));
+            blendedOut[1] = _mm_add_ps(blendedOut[1], _mm_mul_ps(weight, _mm_loadu_ps(pTransform +  4)));
+            blendedOut[2] = _mm_add_ps(blendedOut[2], _mm_mul_ps(weight, _mm_loadu_ps(pTransform +  8)));
+            blendedOut[3] = _mm_add_ps(blendedOut[3], _mm_mul_ps(weight, _mm_loadu_ps(pTransform + 12)));
+        }
+    #endif
+    }
+#endif
 
 
     CPUVertexShader_Skinning::CPUVertexShader_Skinning()
         : CPUVertexShader(),
-          bones(nullptr), skinningVertexAttributes(nullptr),
-          aabbMin(FLT_MAX), aabbMax(-FLT_MAX)
+          skinningPalette(nullptr), skinningVertexAttributes(nullptr),
+          aabbMin(FLT_MAX), aabbMax(-FLT_MAX),
+          threadAABBs(),
+          useFastPath(false), positionOffset(-1), normalOffset(-1), tangentOffset(-1), bitangentOffset(-1)
     {
     }
 
@@ -29,9 +91,9 @@ namespace GT
     }
 
 
-    void CPUVertexShader_Skinning::SetBoneBuffer(const Bone* const* bonesIn)
+    void CPUVertexShader_Skinning::SetSkinningPalette(const glm::mat4* palette)
     {
-        this->bones = bonesIn;
+        this->skinningPalette = palette;
     }
 
     void CPUVertexShader_Skinning::SetSkinningVertexAttributes(const SkinningVertexAttribute* attributes)
@@ -56,6 +118,49 @@ namespace GT
     {
         this->aabbMin = glm::vec4( FLT_MAX);
         this->aabbMax = glm::vec4(-FLT_MAX);
+
+        this->threadAABBs.Resize(this->GetExecutionThreadCount());
+        for (size_t i = 0; i < this->threadAABBs.count; ++i)
+        {
+            this->threadAABBs[i].min = this->aabbMin;
+            this->threadAABBs[i].max = this->aabbMax;
+        }
+
+
+        // We can only use the specialised kernel if the attributes it cares about are all 3 components.
+        this->useFastPath     = false;
+        this->positionOffset  = -1;
+        this->normalOffset    = -1;
+        this->tangentOffset   = -1;
+        this->bitangentOffset = -1;
+
+    #if defined(GT_BUILD_SSE2)
+        auto &format = this->GetExecutionFormat();
+
+        if (format.GetAttributeComponentCount(VertexAttribs::Position) == 3 && format.GetAttributeComponentCount(VertexAttribs::Normal) == 3)
+        {
+            int tangentComponentCount   = format.GetAttributeComponentCount(VertexAttribs::Tangent);
+            int bitangentComponentCount = format.GetAttributeComponentCount(VertexAttribs::Bitangent);
+
+            if ((tangentComponentCount == -1 || tangentComponentCount == 3) && (bitangentComponentCount == -1 || bitangentComponentCount == 3))
+            {
+                this->useFastPath     = true;
+                this->positionOffset  = format.GetAttributeOffset(VertexAttribs::Position);
+                this->normalOffset    = format.GetAttributeOffset(VertexAttribs::Normal);
+                this->tangentOffset   = (tangentComponentCount   == 3) ? format.GetAttributeOffset(VertexAttribs::Tangent)   : -1;
+                this->bitangentOffset = (bitangentComponentCount == 3) ? format.GetAttributeOffset(VertexAttribs::Bitangent) : -1;
+            }
+        }
+    #endif
+    }
+
+    void CPUVertexShader_Skinning::OnEndExecute()
+    {
+        for (size_t i = 0; i < this->threadAABBs.count; ++i)
+        {
+            this->aabbMin = glm::min(this->threadAABBs[i].min, this->aabbMin);
+            this->aabbMax = glm::max(this->threadAABBs[i].max, this->aabbMax);
+        }
     }
 
 
@@ -80,13 +185,9 @@ namespace GT
         // For each bone...
         for (size_t i = 0; i < skinningData.bones.count; ++i)
         {
-            auto bone   = this->bones[skinningData.bones[i].boneIndex];
             auto weight = skinningData.bones[i].weight;
 
-            assert(bone != nullptr);
-
-            
-            const glm::mat4 &skinningTransform = bone->GetSkinningTransform();
+            const glm::mat4 &skinningTransform = this->skinningPalette[skinningData.bones[i].boneIndex];
             
             newPosition  += weight * (skinningTransform * vertex.Position);
             newNormal    += weight * (skinningTransform * vertex.Normal);
@@ -99,7 +200,85 @@ namespace GT
         vertex.Tangent   = newTangent;
         vertex.Bitangent = newBitangent;
 
-        this->aabbMin = glm::min(vertex.Position, this->aabbMin);
-        this->aabbMax = glm::max(vertex.Position, this->aabbMax);
+        auto &threadAABB = this->threadAABBs.buffer[vertex.GetThreadIndex()];
+        threadAABB.min = glm::min(vertex.Position, threadAABB.min);
+        threadAABB.max = glm::max(vertex.Position, threadAABB.max);
+    }
+
+    bool CPUVertexShader_Skinning::ProcessVertexRange(const float* input, float* output, size_t firstVertexID, size_t endVertexID, size_t threadIndex)
+    {
+    #if defined(GT_BUILD_SSE2)
+        if (!this->useFastPath)
+        {
+            return false;
+        }
+
+        assert(this->skinningVertexAttributes != nullptr);
+        assert(this->skinningPalette != nullptr);
+
+        size_t vertexSize = this->GetExecutionVertexSizeInFloats();
+
+        // Attributes we don't transform (texture coordinates, etc.) still need to end up in the output buffer. We just copy the whole range
+        // in one go and then overwrite the attributes we do transform.
+        if (input != output)
+        {
+            memcpy(output + (firstVertexID * vertexSize), input + (firstVertexID * vertexSize), (endVertexID - firstVertexID) * vertexSize * sizeof(float));
+        }
+
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one  = _mm_set1_ps(1.0f);
+
+        __m128 aabbMinSIMD = _mm_set1_ps( FLT_MAX);
+        __m128 aabbMaxSIMD = _mm_set1_ps(-FLT_MAX);
+
+        for (size_t i = firstVertexID; i < endVertexID; ++i)
+        {
+            const float* vertexInput  = input  + (i * vertexSize);
+                  float* vertexOutput = output + (i * vertexSize);
+
+            __m128 transform[4];
+            Skinning_BlendMatrices(this->skinningPalette, this->skinningVertexAttributes[i], transform);
+
+            __m128 position = Skinning_Mul(transform, Skinning_Load3(vertexInput + this->positionOffset, one));
+            __m128 normal   = Skinning_Mul(transform, Skinning_Load3(vertexInput + this->normalOffset,   zero));
+
+            Skinning_Store3(vertexOutput + this->positionOffset, position);
+            Skinning_Store3(vertexOutput + this->normalOffset,   normal);
+
+            if (this->tangentOffset != -1)
+            {
+                Skinning_Store3(vertexOutput + this->tangentOffset, Skinning_Mul(transform, Skinning_Load3(vertexInput + this->tangentOffset, zero)));
+            }
+
+            if (this->bitangentOffset != -1)
+            {
+                Skinning_Store3(vertexOutput + this->bitangentOffset, Skinning_Mul(transform, Skinning_Load3(vertexInput + this->bitangentOffset, zero)));
+            }
+
+            aabbMinSIMD = _mm_min_ps(aabbMinSIMD, position);
+            aabbMaxSIMD = _mm_max_ps(aabbMaxSIMD, position);
+        }
+
+
+        // The bounds only need to be written back once for the whole range.
+        glm::vec4 rangeMin;
+        glm::vec4 rangeMax;
+        _mm_storeu_ps(&rangeMin.x, aabbMinSIMD);
+        _mm_storeu_ps(&rangeMax.x, aabbMaxSIMD);
+
+        auto &threadAABB = this->threadAABBs.buffer[threadIndex];
+        threadAABB.min = glm::min(rangeMin, threadAABB.min);
+        threadAABB.max = glm::max(rangeMax, threadAABB.max);
+
+        return true;
+    #else
+        (void)input;
+        (void)output;
+        (void)firstVertexID;
+        (void)endVertexID;
+        (void)threadIndex;
+
+        return false;
+    #endif
     }
 }
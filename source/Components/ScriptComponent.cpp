@@ -13,12 +13,14 @@ namespace GT
     GTENGINE_IMPL_COMPONENT_ATTRIBS(ScriptComponent, "Script")
 
     ScriptComponent::ScriptComponent(SceneNode &node)
-        : Component(node), scripts(), scriptRelativePaths(), publicVariables(), hasOnStartupBeenCalled(false)
+        : Component(node), scripts(), scriptRelativePaths(), publicVariables(), hasOnStartupBeenCalled(false),
+          referencedScript(nullptr), sceneNodeTableReference(Script::NoReference), onUpdateReference(Script::NoReference)
     {
     }
 
     ScriptComponent::~ScriptComponent()
     {
+        this->ReleaseScriptReferences();
         this->Clear();
     }
 
@@ -582,6 +584,43 @@ namespace GT
     }
 
 
+    void ScriptComponent::SetScriptReferences(Script &script, int sceneNodeTable, int onUpdate)
+    {
+        if (this->referencedScript != nullptr)
+        {
+            if (this->sceneNodeTableReference != sceneNodeTable) { this->referencedScript->ReleaseReference(this->sceneNodeTableReference); }
+            if (this->onUpdateReference       != onUpdate)       { this->referencedScript->ReleaseReference(this->onUpdateReference);       }
+        }
+
+        this->referencedScript        = &script;
+        this->sceneNodeTableReference = sceneNodeTable;
+        this->onUpdateReference       = onUpdate;
+    }
+
+    void ScriptComponent::ReleaseScriptReferences()
+    {
+        this->ReleaseScriptEventHandlerReferences();
+
+        if (this->referencedScript != nullptr)
+        {
+            this->referencedScript->ReleaseReference(this->sceneNodeTableReference);
+        }
+
+        this->referencedScript        = nullptr;
+        this->sceneNodeTableReference = Script::NoReference;
+    }
+
+    void ScriptComponent::ReleaseScriptEventHandlerReferences()
+    {
+        if (this->referencedScript != nullptr)
+        {
+            this->referencedScript->ReleaseReference(this->onUpdateReference);
+        }
+
+        this->onUpdateReference = Script::NoReference;
+    }
+
+
     size_t ScriptComponent::GetPublicVariableCount() const
     {
         return this->publicVariables.count;
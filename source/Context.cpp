@@ -44,6 +44,9 @@ namespace GT
         /// A pointer to the file to read the config data from.
         drfs_file* pFile;
 
+        /// The paths of the game packages to mount, relative to the executable. These are mounted once the asset library has started.
+        Vector<String> packagePaths;
+
     } AppConfigData;
 
     static unsigned int app_config_read(void* pUserData, void* pDataOut, unsigned int bytesToRead)
@@ -75,6 +78,15 @@ namespace GT
             pData->pContext->AddBaseDirectoryRelativeToExe(valueWithoutQuotes);
             return;
         }
+
+        if (strcmp(key, "Package") == 0)
+        {
+            char valueWithoutQuotes[4096];
+            dr_next_token(value, valueWithoutQuotes, sizeof(valueWithoutQuotes));
+
+            pData->packagePaths.PushBack(valueWithoutQuotes);
+            return;
+        }
     }
 
     static void app_config_error(void* pUserData, const char* message, unsigned int line)
@@ -96,6 +108,8 @@ namespace GT
           m_pAudioContext(nullptr), m_pAudioPlaybackDevice(nullptr), m_soundWorld(*this),
           m_assetLibrary(),
           m_scriptLibrary(*this), m_particleSystemLibrary(*this), m_prefabLibrary(*this), m_modelLibrary(*this), m_materialLibrary(*this), m_shaderLibrary(*this), m_vertexArrayLibrary(*this), m_textureLibrary(*this),
+          m_threadPool(),
+          m_stats(), m_hasUnendedStatsFrame(false), m_lastDrawCallCount(0), m_lastScriptCallCount(0), m_lastAssetBytesLoaded(0),
           m_gameStateManager(gameStateManager),
           isInitialised(false), closing(false),
           eventQueue(), eventQueueLock(NULL),
@@ -146,6 +160,9 @@ namespace GT
 
         m_cmdline = cmdline;
 
+        // The thread that starts up the context is the main thread, which is how it will be labelled in profiler captures.
+        ProfilerCapture::SetThreadName("Main");
+
 
         // We need to initialize the virtual file system early so we can do things like create logs and cache files.
         m_pVFS = drfs_create_context();
@@ -192,12 +209,33 @@ namespace GT
 
 
 
+        //// Thread Pool ////
+        //
+        // The calling thread participates in each batch so we leave one logical CPU for it.
+        unsigned int cpuCount = System::GetCPUCount();
+        if (!m_threadPool.Startup((cpuCount > 1) ? cpuCount - 1 : 0))
+        {
+            this->LogError("Failed to initialize thread pool.");
+        }
+
+
         //// Asset Library ////
         if (!m_assetLibrary.Startup(m_pVFS))
         {
             this->LogError("Failed to initialize asset library.");
         }
 
+        for (size_t iPackage = 0; iPackage < cfg.packagePaths.count; ++iPackage)
+        {
+            char packageAbsolutePath[DRFS_MAX_PATH];
+            drpath_to_absolute(cfg.packagePaths[iPackage].c_str(), this->GetExecutableDirectoryAbsolutePath(), packageAbsolutePath, sizeof(packageAbsolutePath));
+
+            if (!m_assetLibrary.MountPackage(packageAbsolutePath))
+            {
+                this->LogErrorf("Failed to mount game package: %s", packageAbsolutePath);
+            }
+        }
+
 
 
 
@@ -421,12 +459,19 @@ namespace GT
         m_shaderLibrary.Shutdown();
         m_vertexArrayLibrary.Shutdown();
         m_textureLibrary.Shutdown();     
+
+        // The asset library goes after the other libraries since they hold references to it's assets. This also stops the asset loader threads.
+        m_assetLibrary.Shutdown();
         
 
         // We shutdown major sub-systems before logging. This allows us to log shutdown info.
         Renderer::Shutdown();
 
 
+        // Worker threads are the last thing to go since any of the above sub-systems may have been using them.
+        m_threadPool.Shutdown();
+
+
         // GTLib's window management module.
         ShutdownWindowManager();
     }
@@ -667,8 +712,12 @@ namespace GT
 
     void Context::StepGUI(double deltaTimeInSecondsIn)
     {
+        double guiStartTime = Timing::GetTimeInSeconds();
+
         this->gui.Step(deltaTimeInSecondsIn);
         this->gui.Paint();
+
+        m_stats.Add(EngineStat_GUITime, (Timing::GetTimeInSeconds() - guiStartTime) * 1000.0);
     }
 
 
@@ -1001,7 +1050,7 @@ namespace GT
 
 
 
-    bool Context::PackageForDistribution(const char* outputDirectory, const char* executableName)
+    bool Context::PackageForDistribution(const char* outputDirectory, const char* executableName, bool packAssets, bool bakeTextures)
     {
         char absoluteOutputDirectory[DRFS_MAX_PATH];
         drpath_copy_and_append(absoluteOutputDirectory, sizeof(absoluteOutputDirectory), this->GetExecutableDirectoryAbsolutePath(), outputDirectory);
@@ -1018,6 +1067,16 @@ namespace GT
 
         GamePackager packager(absoluteOutputDirectory);
 
+        if (packAssets)
+        {
+            packager.EnablePackage("data.gtpak");
+        }
+
+        if (bakeTextures)
+        {
+            packager.EnableTextureBaking();
+        }
+
 
         // We will start by copying over the data directories, not including the executable directory.
         assert(drfs_get_base_directory_count(this->GetVFS()) > 0);
@@ -1043,6 +1102,12 @@ namespace GT
             packager.CopyExecutable(this->GetExecutableAbsolutePath(), executableName);
         }
 
+        if (!packager.WritePackage())
+        {
+            this->LogError("Failed to write game package.");
+            return false;
+        }
+
         packager.WriteConfig();
 
         return true;
@@ -1166,8 +1231,20 @@ namespace GT
 
     void Context::DoFrame()
     {
+        GT_PROFILE_ZONE("Context::DoFrame");
+
         // The first thing we do is retrieve the delta time...
-        this->deltaTimeInSeconds = Min(this->updateTimer.Update(), 1.0);
+        double frameTimeInSeconds = this->updateTimer.Update();
+        this->deltaTimeInSeconds = Min(frameTimeInSeconds, 1.0);
+
+        // The stats of the previous frame are ended now that we know how long it took, including the buffer swap.
+        if (m_hasUnendedStatsFrame)
+        {
+            this->EndStatsFrame(frameTimeInSeconds);
+        }
+
+        // Asynchronous asset loads that finished since the last frame have their callbacks called here so they are always on the main thread.
+        m_assetLibrary.DispatchCompletedLoads();
 
         // We also need to increment the total running time, but only if we're not paused.
         if (!this->IsPaused())
@@ -1193,10 +1270,30 @@ namespace GT
 
         // Now we can let the game know that we've finished the frame...
         m_gameStateManager.OnEndFrame(*this);
+
+        m_hasUnendedStatsFrame = true;
+    }
+
+    void Context::EndStatsFrame(double frameTimeInSeconds)
+    {
+        uint64_t drawCallCount    = Renderer::GetDrawCallCount();
+        uint64_t scriptCallCount  = this->script.GetCallCount();
+        uint64_t assetBytesLoaded = m_assetLibrary.GetBytesLoaded();
+
+        m_stats.Add(EngineStat_DrawCalls,        static_cast<double>(drawCallCount    - m_lastDrawCallCount));
+        m_stats.Add(EngineStat_ScriptCallbacks,  static_cast<double>(scriptCallCount  - m_lastScriptCallCount));
+        m_stats.Add(EngineStat_AssetBytesLoaded, static_cast<double>(assetBytesLoaded - m_lastAssetBytesLoaded));
+        m_stats.EndFrame(frameTimeInSeconds);
+
+        m_lastDrawCallCount    = drawCallCount;
+        m_lastScriptCallCount  = scriptCallCount;
+        m_lastAssetBytesLoaded = assetBytesLoaded;
     }
 
     void Context::Update()
     {
+        GT_PROFILE_ZONE("Context::Update");
+
         // If the editor is open it also needs to be updated.
         if (this->editor.IsOpen())
         {
@@ -1214,6 +1311,8 @@ namespace GT
 
     void Context::Draw()
     {
+        GT_PROFILE_ZONE("Context::Draw");
+
         // NOTE:
         //
         // We're not currently calling any OnDraw events. The problem is with the multi-threading nature of the engine. Events here are called from a different thread
@@ -0,0 +1,199 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#include <GTGE/Core/FrameAllocator.hpp>
+#include <cstdlib>
+#include <cstdint>
+#include <cassert>
+
+namespace GT
+{
+    /// The alignment of the data section of each block. Allocations with a larger alignment are padded within the block.
+    static const size_t FrameAllocator_BlockDataAlignment = 16;
+
+    /// Retrieves the size of the block header, padded so the block's data is aligned.
+    static size_t FrameAllocator_GetBlockHeaderSize(size_t headerSize)
+    {
+        return (headerSize + (FrameAllocator_BlockDataAlignment - 1)) & ~(FrameAllocator_BlockDataAlignment - 1);
+    }
+
+
+    FrameAllocator::FrameAllocator(size_t initialBlockSizeInBytes)
+        : m_firstBlock(nullptr), m_currentBlock(nullptr), m_initialBlockSizeInBytes(initialBlockSizeInBytes), m_lastDestructor(nullptr),
+          m_allocationCount(0), m_allocatedBytes(0), m_lastFrameAllocationCount(0), m_lastFrameAllocatedBytes(0), m_peakAllocatedBytes(0),
+          m_capacity(0), m_blockAllocationCount(0)
+    {
+    }
+
+    FrameAllocator::~FrameAllocator()
+    {
+        this->Reset();
+        this->FreeBlocks();
+    }
+
+
+    void* FrameAllocator::Allocate(size_t sizeInBytes, size_t alignment)
+    {
+        void* memory = this->AllocateFromBlocks(sizeInBytes, alignment);
+        if (memory != nullptr)
+        {
+            m_allocationCount += 1;
+            m_allocatedBytes  += sizeInBytes;
+        }
+
+        return memory;
+    }
+
+    void FrameAllocator::Reset()
+    {
+        // Destructors are called in reverse order so that objects created later, which may reference earlier ones, go first.
+        for (auto record = m_lastDestructor; record != nullptr; record = record->prev)
+        {
+            record->destruct(record->object);
+        }
+        m_lastDestructor = nullptr;
+
+
+        // If the frame spilled into more than one block we replace them all with a single block that can hold the whole frame. This
+        // is what stops the allocator from hitting the heap every frame after it has warmed up.
+        if (m_firstBlock != nullptr && m_firstBlock->next != nullptr)
+        {
+            size_t usedBytes = 0;
+            for (auto block = m_firstBlock; block != nullptr; block = block->next)
+            {
+                usedBytes += block->offset;
+            }
+
+            this->FreeBlocks();
+            this->AppendNewBlock(usedBytes + (usedBytes / 2));
+        }
+
+        for (auto block = m_firstBlock; block != nullptr; block = block->next)
+        {
+            block->offset = 0;
+        }
+        m_currentBlock = m_firstBlock;
+
+
+        if (m_allocatedBytes > m_peakAllocatedBytes)
+        {
+            m_peakAllocatedBytes = m_allocatedBytes;
+        }
+
+        m_lastFrameAllocationCount = m_allocationCount;
+        m_lastFrameAllocatedBytes  = m_allocatedBytes;
+        m_allocationCount          = 0;
+        m_allocatedBytes           = 0;
+    }
+
+
+
+    ////////////////////////////////////////
+    // Private
+
+    void* FrameAllocator::AllocateFromBlocks(size_t sizeInBytes, size_t alignment)
+    {
+        assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+        // Blocks after the current one are left over from before the last reset, so they're still worth trying before we go to the heap.
+        for (auto block = m_currentBlock; block != nullptr; block = block->next)
+        {
+            void* memory = AllocateFromBlock(block, sizeInBytes, alignment);
+            if (memory != nullptr)
+            {
+                m_currentBlock = block;
+                return memory;
+            }
+        }
+
+        auto newBlock = this->AppendNewBlock(sizeInBytes + alignment);
+        if (newBlock == nullptr)
+        {
+            return nullptr;
+        }
+
+        m_currentBlock = newBlock;
+        return AllocateFromBlock(newBlock, sizeInBytes, alignment);
+    }
+
+    void* FrameAllocator::AllocateFromBlock(Block* block, size_t sizeInBytes, size_t alignment)
+    {
+        assert(block != nullptr);
+
+        auto data    = reinterpret_cast<uintptr_t>(block) + FrameAllocator_GetBlockHeaderSize(sizeof(Block));
+        auto address = (data + block->offset + (alignment - 1)) & ~static_cast<uintptr_t>(alignment - 1);
+        auto offset  = static_cast<size_t>(address - data);
+
+        if (offset + sizeInBytes > block->sizeInBytes)
+        {
+            return nullptr;
+        }
+
+        block->offset = offset + sizeInBytes;
+        return reinterpret_cast<void*>(address);
+    }
+
+    FrameAllocator::Block* FrameAllocator::AppendNewBlock(size_t minSizeInBytes)
+    {
+        // Each new block is at least double the size of the last one so that a frame which keeps growing only needs a few blocks.
+        size_t sizeInBytes = m_initialBlockSizeInBytes;
+        for (auto block = m_firstBlock; block != nullptr; block = block->next)
+        {
+            if (block->sizeInBytes * 2 > sizeInBytes)
+            {
+                sizeInBytes = block->sizeInBytes * 2;
+            }
+        }
+
+        if (sizeInBytes < minSizeInBytes)
+        {
+            sizeInBytes = minSizeInBytes;
+        }
+
+
+        auto newBlock = reinterpret_cast<Block*>(malloc(FrameAllocator_GetBlockHeaderSize(sizeof(Block)) + sizeInBytes));
+        if (newBlock == nullptr)
+        {
+            return nullptr;
+        }
+
+        newBlock->next        = nullptr;
+        newBlock->sizeInBytes = sizeInBytes;
+        newBlock->offset      = 0;
+
+        if (m_firstBlock == nullptr)
+        {
+            m_firstBlock = newBlock;
+        }
+        else
+        {
+            auto lastBlock = m_firstBlock;
+            while (lastBlock->next != nullptr)
+            {
+                lastBlock = lastBlock->next;
+            }
+
+            lastBlock->next = newBlock;
+        }
+
+        m_capacity             += sizeInBytes;
+        m_blockAllocationCount += 1;
+
+        return newBlock;
+    }
+
+    void FrameAllocator::FreeBlocks()
+    {
+        auto block = m_firstBlock;
+        while (block != nullptr)
+        {
+            auto next = block->next;
+            free(block);
+
+            block = next;
+        }
+
+        m_firstBlock   = nullptr;
+        m_currentBlock = nullptr;
+        m_capacity     = 0;
+    }
+}
@@ -237,7 +237,7 @@ namespace GT
         return false;
     }
 
-    bool Image::GenerateMipmaps()
+    bool Image::GenerateMipmaps(MipmapFilter filter, ThreadPool* pThreadPool)
     {
         // In order to generate mipmaps, we must have at least a base mipmap.
         if (m_mipmaps.count > 0 && m_mipmaps[0].IsValid())
@@ -248,7 +248,7 @@ namespace GT
                 if (!mipmap.IsValid())              // We don't generate mipmaps for already-valid mipmaps.
                 {
                     auto &sourceMipmap = m_mipmaps[i - 1];
-                    MipmapGenerator::Generate(sourceMipmap, mipmap);
+                    MipmapGenerator::Generate(sourceMipmap, mipmap, filter, pThreadPool);
 
                     this->OnMipmapChanged(static_cast<unsigned int>(i));
                 }
@@ -43,6 +43,11 @@ namespace GT
                 return width * 4;
             }
 
+            if (IsImageFormatCompressed(format))
+            {
+                return ((width + 3) / 4) * GetImageFormatBlockSizeInBytes(format);
+            }
+
             if (format != ImageFormat_None)
             {
                 return width * GetTexelSizeInBytes(format);
@@ -53,6 +58,11 @@ namespace GT
 
         size_t CalculateDataSize(unsigned int width, unsigned int height, ImageFormat format)
         {
+            if (IsImageFormatCompressed(format))
+            {
+                return ((height + 3) / 4) * ImageUtils::CalculatePitch(width, format);
+            }
+
             return height * ImageUtils::CalculatePitch(width, format);
         }
 
@@ -74,15 +84,17 @@ namespace GT
         {
             if (srcBuffer != nullptr)
             {
-                size_t pitch      = ImageUtils::CalculatePitch(width, format);
-                size_t resultSize = pitch * height;
+                // The pitch of a compressed format is the size of a row of blocks, so those are copied a row of blocks at a time.
+                size_t       pitch      = ImageUtils::CalculatePitch(width, format);
+                unsigned int rowCount   = IsImageFormatCompressed(format) ? (height + 3) / 4 : height;
+                size_t       resultSize = pitch * rowCount;
 
                 if (flip)
                 {
                     // When flipped, we copy bottom up.
-                    for (unsigned int i = 0; i < height; ++i)
+                    for (unsigned int i = 0; i < rowCount; ++i)
                     {
-                        char* sourceRow = ((char *)srcBuffer) + ((height - i - 1) * pitch);
+                        char* sourceRow = ((char *)srcBuffer) + ((rowCount - i - 1) * pitch);
                         char* destRow   = ((char *)dstBuffer) + (i * pitch);
 
                         memcpy(destRow, sourceRow, pitch);
@@ -0,0 +1,114 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#include <GTGE/Core/MappedFile.hpp>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace GT
+{
+    MappedFile::MappedFile()
+        : m_pData(nullptr), m_size(0)
+#if defined(_WIN32)
+        , m_hFile(nullptr), m_hFileMapping(nullptr)
+#endif
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        this->Close();
+    }
+
+
+    bool MappedFile::Open(const char* absolutePath)
+    {
+        this->Close();
+
+#if defined(_WIN32)
+        HANDLE hFile = CreateFileA(absolutePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(hFile);
+            return false;
+        }
+
+        HANDLE hFileMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (hFileMapping == NULL)
+        {
+            CloseHandle(hFile);
+            return false;
+        }
+
+        void* pData = MapViewOfFile(hFileMapping, FILE_MAP_READ, 0, 0, 0);
+        if (pData == NULL)
+        {
+            CloseHandle(hFileMapping);
+            CloseHandle(hFile);
+            return false;
+        }
+
+        m_hFile        = hFile;
+        m_hFileMapping = hFileMapping;
+        m_pData        = reinterpret_cast<const uint8_t*>(pData);
+        m_size         = static_cast<size_t>(fileSize.QuadPart);
+#else
+        int fd = open(absolutePath, O_RDONLY);
+        if (fd == -1)
+        {
+            return false;
+        }
+
+        struct stat fileInfo;
+        if (fstat(fd, &fileInfo) != 0 || fileInfo.st_size == 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        // The mapping stays valid after the file is closed.
+        void* pData = mmap(nullptr, static_cast<size_t>(fileInfo.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if (pData == MAP_FAILED)
+        {
+            return false;
+        }
+
+        m_pData = reinterpret_cast<const uint8_t*>(pData);
+        m_size  = static_cast<size_t>(fileInfo.st_size);
+#endif
+
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_pData != nullptr)
+        {
+#if defined(_WIN32)
+            UnmapViewOfFile(m_pData);
+            CloseHandle(m_hFileMapping);
+            CloseHandle(m_hFile);
+
+            m_hFileMapping = nullptr;
+            m_hFile        = nullptr;
+#else
+            munmap(const_cast<uint8_t*>(m_pData), m_size);
+#endif
+
+            m_pData = nullptr;
+            m_size  = 0;
+        }
+    }
+}
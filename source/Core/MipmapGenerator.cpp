@@ -2,229 +2,623 @@
 
 #include <GTGE/Core/MipmapGenerator.hpp>
 #include <GTGE/Core/ImageUtils.hpp>
+#include <GTGE/Core/ThreadPool.hpp>
 #include <GTGE/Core/stdlib.hpp>
 #include <cstdint>
+#include <cmath>
 
 namespace GT
 {
-    bool MipmapGenerator::Generate(const Mipmap &source, Mipmap &dest)
+    /// Mipmaps with fewer destination texels than this are always generated on the calling thread.
+    static const size_t MipmapGenerator_MinParallelTexelCount = 128 * 128;
+
+    /// The rough number of destination texels generated by each job when a mipmap is split across threads.
+    static const size_t MipmapGenerator_TexelsPerJob = 16384;
+
+    /// The number of destination texels of an RGB8 row that are summed vertically at a time.
+    static const unsigned int MipmapGenerator_RGB8ChunkSize = 256;
+
+
+    struct MipmapGenerator_Job;
+
+    /// The function signature for generating the destination rows in the range [firstRow, endRow) of a job.
+    typedef void (* MipmapGenerator_RowsProc)(const MipmapGenerator_Job &job, unsigned int firstRow, unsigned int endRow);
+
+    /// Structure describing the generation of a single mipmap, which may be split into ranges of rows.
+    struct MipmapGenerator_Job
     {
-        dest.DeleteLocalData();
+        /// The function that generates a range of rows.
+        MipmapGenerator_RowsProc rowsProc;
 
-        dest.format = source.format;
-        dest.width  = ImageUtils::CalculateMipmapWidth(1, source.width);
-        dest.height = ImageUtils::CalculateMipmapHeight(1, source.height);
-        dest.data   = malloc(ImageUtils::CalculateDataSize(dest.width, dest.height, dest.format));
+        /// The dimensions of the source mipmap.
+        unsigned int sourceWidth;
+        unsigned int sourceHeight;
 
-        unsigned int componentCount = GetImageFormatComponentCount(dest.format);
-        unsigned int componentSize  = GetImageFormatComponentSize(dest.format);
+        /// The dimensions of the destination mipmap.
+        unsigned int destWidth;
+        unsigned int destHeight;
+
+        /// The number of components in each texel.
+        unsigned int componentCount;
+
+        /// The source and destination image data.
+        const void* sourceData;
+              void* destData;
 
-        if (dest.format == ImageFormat_RGB8)
+        /// The number of rows generated by each job when the mipmap is split across threads.
+        unsigned int rowsPerJob;
+    };
+
+
+    /// ThreadPoolJobProc for generating a range of rows of a mipmap.
+    static void MipmapGenerator_GenerateRowsJob(size_t jobIndex, size_t threadIndex, void* pUserData)
+    {
+        (void)threadIndex;
+
+        auto &job = *reinterpret_cast<const MipmapGenerator_Job*>(pUserData);
+
+        unsigned int firstRow = static_cast<unsigned int>(jobIndex) * job.rowsPerJob;
+        job.rowsProc(job, firstRow, Min(firstRow + job.rowsPerJob, job.destHeight));
+    }
+
+    /// Generates every row of the given job, splitting them across the given thread pool if it's worthwhile.
+    static void MipmapGenerator_Run(MipmapGenerator_Job &job, ThreadPool* pThreadPool)
+    {
+        size_t destTexelCount = static_cast<size_t>(job.destWidth) * job.destHeight;
+
+        if (pThreadPool != nullptr && pThreadPool->GetWorkerThreadCount() > 0 && destTexelCount >= MipmapGenerator_MinParallelTexelCount)
         {
-            MipmapGenerator::GenerateRGB8(source.width, source.height, source.data, dest.data);
+            job.rowsPerJob = static_cast<unsigned int>(Max(MipmapGenerator_TexelsPerJob / job.destWidth, static_cast<size_t>(1)));
+            pThreadPool->Run((job.destHeight + job.rowsPerJob - 1) / job.rowsPerJob, MipmapGenerator_GenerateRowsJob, &job);
         }
-        else if (dest.format == ImageFormat_RGBA8)
+        else
         {
-            MipmapGenerator::GenerateRGBA8(source.width, source.height, source.data, dest.data);
+            job.rowsProc(job, 0, job.destHeight);
         }
-        else
+    }
+
+    /// Initializes a job for generating the whole of the next mipmap down from a source mipmap with the given dimensions.
+    static MipmapGenerator_Job MipmapGenerator_CreateJob(MipmapGenerator_RowsProc rowsProc, unsigned int sourceWidth, unsigned int sourceHeight, unsigned int componentCount, const void* sourceData, void* destData)
+    {
+        MipmapGenerator_Job job;
+        job.rowsProc       = rowsProc;
+        job.sourceWidth    = sourceWidth;
+        job.sourceHeight   = sourceHeight;
+        job.destWidth      = ImageUtils::CalculateMipmapWidth(1, sourceWidth);
+        job.destHeight     = ImageUtils::CalculateMipmapHeight(1, sourceHeight);
+        job.componentCount = componentCount;
+        job.sourceData     = sourceData;
+        job.destData       = destData;
+        job.rowsPerJob     = job.destHeight;
+
+        return job;
+    }
+
+
+
+    ///////////////////////////////////////
+    // RGBA8
+
+    /// MipmapGenerator_RowsProc for RGBA8 images.
+    static void MipmapGenerator_GenerateRowsRGBA8(const MipmapGenerator_Job &job, unsigned int firstRow, unsigned int endRow)
+    {
+        const uint8_t* sourceData = reinterpret_cast<const uint8_t*>(job.sourceData);
+              uint8_t* destData   = reinterpret_cast<      uint8_t*>(job.destData);
+
+        size_t sourcePitch = static_cast<size_t>(job.sourceWidth) * 4;
+        size_t destPitch   = static_cast<size_t>(job.destWidth)   * 4;
+
+        for (unsigned int iRow = firstRow; iRow < endRow; ++iRow)
         {
-            // Now we need to generate the mipmap depending on the format data type.
-            int componentDataType = GetImageFormatDataType(dest.format);
-            if (componentDataType == ImageFormatDataTypes::Integer)
+            // Sources that are a single texel high or wide reuse the last row or column rather than reading past the end.
+            const uint8_t* row0    = sourceData + ((iRow << 1) * sourcePitch);
+            const uint8_t* row1    = sourceData + (Min((iRow << 1) + 1, job.sourceHeight - 1) * sourcePitch);
+                  uint8_t* destRow = destData   + (iRow * destPitch);
+
+            // The SIMD loops only ever run when the source is at least two texels wide, in which case every pair of source texels is
+            // inside the row.
+            unsigned int iCol = 0;
+
+        #if defined(GT_BUILD_AVX2)
+            // The same as the SSE2 loop below, 8 destination texels at a time. The pack works within each 128-bit lane, so the 64-bit
+            // pieces of the result need reordering.
+            const __m256i zero256 = _mm256_setzero_si256();
+            for (; iCol + 8 <= job.destWidth; iCol += 8)
             {
-                switch (componentSize)
-                {
-                case 1: MipmapGenerator::Generate<uint8_t >(source.width, source.height, componentCount, source.data, dest.data); break;
-                case 2: MipmapGenerator::Generate<uint16_t>(source.width, source.height, componentCount, source.data, dest.data); break;
-                case 4: MipmapGenerator::Generate<uint32_t>(source.width, source.height, componentCount, source.data, dest.data); break;
-                case 8: MipmapGenerator::Generate<uint64_t>(source.width, source.height, componentCount, source.data, dest.data); break;
+                __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + (iCol << 3)));
+                __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + (iCol << 3) + 32));
+                __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + (iCol << 3)));
+                __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + (iCol << 3) + 32));
 
-                default:
-                    {
-                        // Error. Unknown or unsupported component size.
-                        return false;
-                    }
-                }
+                __m256i aLo = _mm256_add_epi16(_mm256_unpacklo_epi8(a0, zero256), _mm256_unpacklo_epi8(a1, zero256));
+                __m256i aHi = _mm256_add_epi16(_mm256_unpackhi_epi8(a0, zero256), _mm256_unpackhi_epi8(a1, zero256));
+                __m256i bLo = _mm256_add_epi16(_mm256_unpacklo_epi8(b0, zero256), _mm256_unpacklo_epi8(b1, zero256));
+                __m256i bHi = _mm256_add_epi16(_mm256_unpackhi_epi8(b0, zero256), _mm256_unpackhi_epi8(b1, zero256));
+
+                __m256i a = _mm256_srli_epi16(_mm256_add_epi16(_mm256_unpacklo_epi64(aLo, aHi), _mm256_unpackhi_epi64(aLo, aHi)), 2);
+                __m256i b = _mm256_srli_epi16(_mm256_add_epi16(_mm256_unpacklo_epi64(bLo, bHi), _mm256_unpackhi_epi64(bLo, bHi)), 2);
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destRow + (iCol << 2)), _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), _MM_SHUFFLE(3, 1, 2, 0)));
             }
-            else if (componentDataType == ImageFormatDataTypes::Float)
+        #endif
+
+        #if defined(GT_BUILD_SSE2)
+            // 4 destination texels at a time. The components are widened to 16 bits, summed vertically, and then summed horizontally with
+            // the neighbouring texel before they're packed back down.
+            const __m128i zero = _mm_setzero_si128();
+            for (; iCol + 4 <= job.destWidth; iCol += 4)
             {
-                switch (componentSize)
-                {
-                case 4: MipmapGenerator::Generate<float >(source.width, source.height, componentCount, source.data, dest.data); break;
-                case 8: MipmapGenerator::Generate<double>(source.width, source.height, componentCount, source.data, dest.data); break;
+                __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + (iCol << 3)));
+                __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + (iCol << 3) + 16));
+                __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + (iCol << 3)));
+                __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + (iCol << 3) + 16));
 
-                default:
-                    {
-                        // Error. Unknown or unsupported component size.
-                        return false;
-                    }
-                }
+                __m128i aLo = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(a1, zero));
+                __m128i aHi = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(a1, zero));
+                __m128i bLo = _mm_add_epi16(_mm_unpacklo_epi8(b0, zero), _mm_unpacklo_epi8(b1, zero));
+                __m128i bHi = _mm_add_epi16(_mm_unpackhi_epi8(b0, zero), _mm_unpackhi_epi8(b1, zero));
+
+                __m128i a = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(aLo, aHi), _mm_unpackhi_epi64(aLo, aHi)), 2);
+                __m128i b = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(bLo, bHi), _mm_unpackhi_epi64(bLo, bHi)), 2);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destRow + (iCol << 2)), _mm_packus_epi16(a, b));
             }
-            else
+        #endif
+
+            for (; iCol < job.destWidth; ++iCol)
             {
-                // Error. Can't generate mipmaps with this format.
-                return false;
+                unsigned int col0 = (iCol << 1) * 4;
+                unsigned int col1 = Min((iCol << 1) + 1, job.sourceWidth - 1) * 4;
+
+                for (unsigned int iComp = 0; iComp < 4; ++iComp)
+                {
+                    unsigned int accumulated = row0[col0 + iComp] + row1[col0 + iComp] + row1[col1 + iComp] + row0[col1 + iComp];
+                    destRow[(iCol << 2) + iComp] = static_cast<uint8_t>(accumulated >> 2);
+                }
             }
         }
-
-        return true;
     }
 
 
-    void MipmapGenerator::GenerateRGB8(unsigned int sourceWidth, unsigned int sourceHeight, const void* sourceDataIn, void* destDataIn)
+
+    ///////////////////////////////////////
+    // RGB8
+
+#if defined(GT_BUILD_SSE2)
+    /// Generates a single row of an RGB8 mipmap from a pair of source rows that are at least two texels wide.
+    ///
+    /// Texels are three bytes, which doesn't split evenly into SIMD registers. Instead, the pair of rows is summed with SIMD into a
+    /// buffer of 16-bit sums, a chunk at a time, and then neighbouring sums are added together.
+    static void MipmapGenerator_GenerateRowRGB8(const uint8_t* row0, const uint8_t* row1, uint8_t* destRow, unsigned int destWidth)
     {
-        const uint8_t* sourceData = reinterpret_cast<const uint8_t*>(sourceDataIn);
-              uint8_t* destData   = reinterpret_cast<      uint8_t*>(destDataIn);
+        uint16_t sums[MipmapGenerator_RGB8ChunkSize * 6];
 
-        unsigned int destWidth  = ImageUtils::CalculateMipmapWidth(1, sourceWidth);
-        unsigned int destHeight = ImageUtils::CalculateMipmapHeight(1, sourceHeight);
+        for (unsigned int iChunkCol = 0; iChunkCol < destWidth; iChunkCol += MipmapGenerator_RGB8ChunkSize)
+        {
+            unsigned int chunkWidth = Min(destWidth - iChunkCol, MipmapGenerator_RGB8ChunkSize);
+
+            const uint8_t* chunk0    = row0 + (iChunkCol * 6);
+            const uint8_t* chunk1    = row1 + (iChunkCol * 6);
+                  size_t   byteCount = chunkWidth * 6;
+
+            size_t iByte = 0;
+
+        #if defined(GT_BUILD_AVX2)
+            // The unpacks work within each 128-bit lane, so the halves need to be put back in order before they're stored.
+            const __m256i zero256 = _mm256_setzero_si256();
+            for (; iByte + 32 <= byteCount; iByte += 32)
+            {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk0 + iByte));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk1 + iByte));
+
+                __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(a, zero256), _mm256_unpacklo_epi8(b, zero256));
+                __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(a, zero256), _mm256_unpackhi_epi8(b, zero256));
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums + iByte +  0), _mm256_permute2x128_si256(lo, hi, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums + iByte + 16), _mm256_permute2x128_si256(lo, hi, 0x31));
+            }
+        #endif
+
+            const __m128i zero = _mm_setzero_si128();
+            for (; iByte + 16 <= byteCount; iByte += 16)
+            {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk0 + iByte));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk1 + iByte));
 
-        unsigned int destTexelIndex = 0;
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + iByte + 0), _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + iByte + 8), _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)));
+            }
+
+            for (; iByte < byteCount; ++iByte)
+            {
+                sums[iByte] = static_cast<uint16_t>(chunk0[iByte] + chunk1[iByte]);
+            }
 
-        unsigned int texel00 = 0;
-        unsigned int texel01 = sourceWidth * 3;
-        unsigned int texel11 = sourceWidth * 3 + 3;
-        unsigned int texel10 = 3;
 
-        for (unsigned int iRow = 0; iRow < destHeight; ++iRow)
+            uint8_t* destChunk = destRow + (iChunkCol * 3);
+            for (unsigned int iCol = 0; iCol < chunkWidth; ++iCol)
+            {
+                destChunk[iCol*3 + 0] = static_cast<uint8_t>((sums[iCol*6 + 0] + sums[iCol*6 + 3]) >> 2);
+                destChunk[iCol*3 + 1] = static_cast<uint8_t>((sums[iCol*6 + 1] + sums[iCol*6 + 4]) >> 2);
+                destChunk[iCol*3 + 2] = static_cast<uint8_t>((sums[iCol*6 + 2] + sums[iCol*6 + 5]) >> 2);
+            }
+        }
+    }
+#endif
+
+    /// MipmapGenerator_RowsProc for RGB8 images.
+    static void MipmapGenerator_GenerateRowsRGB8(const MipmapGenerator_Job &job, unsigned int firstRow, unsigned int endRow)
+    {
+        const uint8_t* sourceData = reinterpret_cast<const uint8_t*>(job.sourceData);
+              uint8_t* destData   = reinterpret_cast<      uint8_t*>(job.destData);
+
+        size_t sourcePitch = static_cast<size_t>(job.sourceWidth) * 3;
+        size_t destPitch   = static_cast<size_t>(job.destWidth)   * 3;
+
+        for (unsigned int iRow = firstRow; iRow < endRow; ++iRow)
         {
-            for (unsigned int iCol = 0; iCol < destWidth; ++iCol)
+            // Sources that are a single texel high or wide reuse the last row or column rather than reading past the end.
+            const uint8_t* row0    = sourceData + ((iRow << 1) * sourcePitch);
+            const uint8_t* row1    = sourceData + (Min((iRow << 1) + 1, job.sourceHeight - 1) * sourcePitch);
+                  uint8_t* destRow = destData   + (iRow * destPitch);
+
+        #if defined(GT_BUILD_SSE2)
+            if (job.sourceWidth > 1)
             {
-                // 00
-                unsigned int accumulatedR = sourceData[texel00 + 0];
-                unsigned int accumulatedG = sourceData[texel00 + 1];
-                unsigned int accumulatedB = sourceData[texel00 + 2];
+                MipmapGenerator_GenerateRowRGB8(row0, row1, destRow, job.destWidth);
+                continue;
+            }
+        #endif
 
-                // 01
-                accumulatedR += sourceData[texel01 + 0];
-                accumulatedG += sourceData[texel01 + 1];
-                accumulatedB += sourceData[texel01 + 2];
+            for (unsigned int iCol = 0; iCol < job.destWidth; ++iCol)
+            {
+                unsigned int col0 = (iCol << 1) * 3;
+                unsigned int col1 = Min((iCol << 1) + 1, job.sourceWidth - 1) * 3;
+
+                for (unsigned int iComp = 0; iComp < 3; ++iComp)
+                {
+                    unsigned int accumulated = row0[col0 + iComp] + row1[col0 + iComp] + row1[col1 + iComp] + row0[col1 + iComp];
+                    destRow[(iCol * 3) + iComp] = static_cast<uint8_t>(accumulated >> 2);
+                }
+            }
+        }
+    }
 
-                // 11
-                accumulatedR += sourceData[texel11 + 0];
-                accumulatedG += sourceData[texel11 + 1];
-                accumulatedB += sourceData[texel11 + 2];
 
-                // 10
-                accumulatedR += sourceData[texel10 + 0];
-                accumulatedG += sourceData[texel10 + 1];
-                accumulatedB += sourceData[texel10 + 2];
 
+    ///////////////////////////////////////
+    // sRGB
 
-                // Construct the final value.
-                destData[destTexelIndex + 0] = static_cast<uint8_t>(accumulatedR >> 2);
-                destData[destTexelIndex + 1] = static_cast<uint8_t>(accumulatedG >> 2);
-                destData[destTexelIndex + 2] = static_cast<uint8_t>(accumulatedB >> 2);
+    /// The lookup tables for converting between 8-bit sRGB and 16-bit linear values.
+    struct MipmapGenerator_SRGBTables
+    {
+        MipmapGenerator_SRGBTables()
+        {
+            for (unsigned int i = 0; i < 256; ++i)
+            {
+                toLinear[i] = static_cast<uint16_t>(ToLinear(i / 255.0) * 65535.0 + 0.5);
 
+                // The linear value halfway between this sRGB value and the one before it.
+                toSRGBThresholds[i] = (i == 0) ? 0 : static_cast<uint32_t>(std::ceil(ToLinear((i - 0.5) / 255.0) * 65535.0));
+            }
 
-                destTexelIndex += 3;
+            // Never reached, which saves a bounds check in ToSRGB().
+            toSRGBThresholds[256] = 65536;
 
+            uint8_t value = 0;
+            for (unsigned int iBucket = 0; iBucket < 4096; ++iBucket)
+            {
+                while (toSRGBThresholds[value + 1] <= (iBucket << 4))
+                {
+                    value += 1;
+                }
 
-                texel00 += 6;
-                texel01 += 6;
-                texel11 += 6;
-                texel10 += 6;
+                toSRGBBuckets[iBucket] = value;
             }
+        }
 
-            texel00 += sourceWidth * 3;
-            texel01 += sourceWidth * 3;
-            texel11 += sourceWidth * 3;
-            texel10 += sourceWidth * 3;
+        static double ToLinear(double value)
+        {
+            return (value <= 0.04045) ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
         }
+
+        /// Converts a 16-bit linear value to the nearest 8-bit sRGB value.
+        ///
+        /// @remarks
+        ///     The buckets are 16 linear values wide, and the closest two thresholds are further apart than that, so at most one step is
+        ///     needed after the bucket lookup.
+        uint8_t ToSRGB(unsigned int linear) const
+        {
+            unsigned int result = toSRGBBuckets[linear >> 4];
+            result += (toSRGBThresholds[result + 1] <= linear) ? 1 : 0;
+
+            return static_cast<uint8_t>(result);
+        }
+
+
+        /// Maps each 8-bit sRGB value to a 16-bit linear value.
+        uint16_t toLinear[256];
+
+        /// The smallest 16-bit linear value that maps to each 8-bit sRGB value.
+        uint32_t toSRGBThresholds[257];
+
+        /// The sRGB value at the start of each range of 16 linear values.
+        uint8_t toSRGBBuckets[4096];
+    };
+
+    /// Retrieves the sRGB lookup tables, building them on the first call.
+    static const MipmapGenerator_SRGBTables & MipmapGenerator_GetSRGBTables()
+    {
+        static const MipmapGenerator_SRGBTables tables;
+        return tables;
     }
 
-    void MipmapGenerator::GenerateRGBA8(unsigned int sourceWidth, unsigned int sourceHeight, const void* sourceDataIn, void* destDataIn)
+    /// MipmapGenerator_RowsProc for RGB8 and RGBA8 images that store their colours in sRGB.
+    ///
+    /// Each colour component needs table lookups, which can't be done with SSE2 or AVX2, so this is left to the compiler. Images this is
+    /// used on are still split across threads like any other.
+    static void MipmapGenerator_GenerateRowsSRGB8(const MipmapGenerator_Job &job, unsigned int firstRow, unsigned int endRow)
     {
-        const uint32_t rMask = 0xFF000000;
-        const uint32_t gMask = 0x00FF0000;
-        const uint32_t bMask = 0x0000FF00;
-        const uint32_t aMask = 0x000000FF;
-        const uint32_t rShift = 24;
-        const uint32_t gShift = 16;
-        const uint32_t bShift = 8;
-        const uint32_t aShift = 0;
+        auto &tables = MipmapGenerator_GetSRGBTables();
 
-        const uint32_t* sourceData = reinterpret_cast<const uint32_t*>(sourceDataIn);
-              uint32_t* destData   = reinterpret_cast<      uint32_t*>(destDataIn);
+        const uint8_t* sourceData = reinterpret_cast<const uint8_t*>(job.sourceData);
+              uint8_t* destData   = reinterpret_cast<      uint8_t*>(job.destData);
 
-        unsigned int destWidth  = ImageUtils::CalculateMipmapWidth(1, sourceWidth);
-        unsigned int destHeight = ImageUtils::CalculateMipmapHeight(1, sourceHeight);
+        unsigned int componentCount = job.componentCount;
 
-        unsigned int destTexelIndex = 0;
+        size_t sourcePitch = static_cast<size_t>(job.sourceWidth) * componentCount;
+        size_t destPitch   = static_cast<size_t>(job.destWidth)   * componentCount;
 
-        unsigned int texel00 = 0;
-        unsigned int texel01 = sourceWidth;
-        unsigned int texel11 = sourceWidth + 1;
-        unsigned int texel10 = 1;
+        for (unsigned int iRow = firstRow; iRow < endRow; ++iRow)
+        {
+            // Sources that are a single texel high or wide reuse the last row or column rather than reading past the end.
+            const uint8_t* row0    = sourceData + ((iRow << 1) * sourcePitch);
+            const uint8_t* row1    = sourceData + (Min((iRow << 1) + 1, job.sourceHeight - 1) * sourcePitch);
+                  uint8_t* destRow = destData   + (iRow * destPitch);
 
-        unsigned int temp00;
-        unsigned int temp01;
-        unsigned int temp11;
-        unsigned int temp10;
+            for (unsigned int iCol = 0; iCol < job.destWidth; ++iCol)
+            {
+                const uint8_t* texel00 = row0 + (iCol << 1) * componentCount;
+                const uint8_t* texel01 = row1 + (iCol << 1) * componentCount;
+                const uint8_t* texel11 = row1 + Min((iCol << 1) + 1, job.sourceWidth - 1) * componentCount;
+                const uint8_t* texel10 = row0 + Min((iCol << 1) + 1, job.sourceWidth - 1) * componentCount;
 
-        unsigned int accumulatedR;
-        unsigned int accumulatedG;
-        unsigned int accumulatedB;
-        unsigned int accumulatedA;
+                uint8_t* destTexel = destRow + iCol * componentCount;
 
-        for (unsigned int iRow = 0; iRow < destHeight; ++iRow)
+                for (unsigned int iComp = 0; iComp < 3; ++iComp)
+                {
+                    unsigned int accumulated = tables.toLinear[texel00[iComp]] + tables.toLinear[texel01[iComp]] + tables.toLinear[texel11[iComp]] + tables.toLinear[texel10[iComp]];
+                    destTexel[iComp] = tables.ToSRGB((accumulated + 2) >> 2);
+                }
+
+                if (componentCount == 4)
+                {
+                    destTexel[3] = static_cast<uint8_t>((texel00[3] + texel01[3] + texel11[3] + texel10[3]) >> 2);
+                }
+            }
+        }
+    }
+
+
+
+    ///////////////////////////////////////
+    // 32-bit Float
+
+    /// MipmapGenerator_RowsProc for images with 32-bit floating point components.
+    ///
+    /// The components are added in the same order as MipmapGenerator::GenerateRows<float>(), so the results are identical to it.
+    static void MipmapGenerator_GenerateRowsFloat32(const MipmapGenerator_Job &job, unsigned int firstRow, unsigned int endRow)
+    {
+        unsigned int componentCount = job.componentCount;
+
+        // Only 1, 2 and 4 components split evenly into SIMD registers. A source that is a single texel wide has nothing to pair up.
+    #if defined(GT_BUILD_SSE2)
+        bool useSIMD = (componentCount == 1 || componentCount == 2 || componentCount == 4) && job.sourceWidth > 1;
+    #else
+        bool useSIMD = false;
+    #endif
+
+        if (!useSIMD)
         {
-            for (unsigned int iCol = 0; iCol < destWidth; ++iCol)
+            MipmapGenerator::GenerateRows<float>(job.sourceWidth, job.sourceHeight, componentCount, job.sourceData, job.destData, firstRow, endRow);
+            return;
+        }
+
+
+        const float* sourceData = reinterpret_cast<const float*>(job.sourceData);
+              float* destData   = reinterpret_cast<      float*>(job.destData);
+
+        size_t sourcePitch = static_cast<size_t>(job.sourceWidth) * componentCount;
+        size_t destPitch   = static_cast<size_t>(job.destWidth)   * componentCount;
+
+        for (unsigned int iRow = firstRow; iRow < endRow; ++iRow)
+        {
+            // Sources that are a single texel high reuse the last row rather than reading past the end.
+            const float* row0    = sourceData + ((iRow << 1) * sourcePitch);
+            const float* row1    = sourceData + (Min((iRow << 1) + 1, job.sourceHeight - 1) * sourcePitch);
+                  float* destRow = destData   + (iRow * destPitch);
+
+            // Every component of the destination row. Destination component i is made from source components i and i + componentCount
+            // of the texel pair, so the SIMD loops below just need to separate the even and odd texels of each row.
+            size_t destCount = static_cast<size_t>(job.destWidth) * componentCount;
+            size_t iDest     = 0;
+
+        #if defined(GT_BUILD_AVX)
+            if (componentCount == 4)
+            {
+                const __m256 quarter256 = _mm256_set1_ps(0.25f);
+                for (; iDest + 8 <= destCount; iDest += 8)
+                {
+                    __m256 a0 = _mm256_loadu_ps(row0 + (iDest << 1));
+                    __m256 b0 = _mm256_loadu_ps(row0 + (iDest << 1) + 8);
+                    __m256 a1 = _mm256_loadu_ps(row1 + (iDest << 1));
+                    __m256 b1 = _mm256_loadu_ps(row1 + (iDest << 1) + 8);
+
+                    __m256 even0 = _mm256_permute2f128_ps(a0, b0, 0x20);
+                    __m256 odd0  = _mm256_permute2f128_ps(a0, b0, 0x31);
+                    __m256 even1 = _mm256_permute2f128_ps(a1, b1, 0x20);
+                    __m256 odd1  = _mm256_permute2f128_ps(a1, b1, 0x31);
+
+                    _mm256_storeu_ps(destRow + iDest, _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(even0, even1), odd1), odd0), quarter256));
+                }
+            }
+        #endif
+
+        #if defined(GT_BUILD_SSE2)
+            const __m128 quarter = _mm_set1_ps(0.25f);
+            for (; iDest + 4 <= destCount; iDest += 4)
+            {
+                __m128 a0 = _mm_loadu_ps(row0 + (iDest << 1));
+                __m128 b0 = _mm_loadu_ps(row0 + (iDest << 1) + 4);
+                __m128 a1 = _mm_loadu_ps(row1 + (iDest << 1));
+                __m128 b1 = _mm_loadu_ps(row1 + (iDest << 1) + 4);
+
+                __m128 even0;
+                __m128 odd0;
+                __m128 even1;
+                __m128 odd1;
+                if (componentCount == 1)
+                {
+                    even0 = _mm_shuffle_ps(a0, b0, _MM_SHUFFLE(2, 0, 2, 0));
+                    odd0  = _mm_shuffle_ps(a0, b0, _MM_SHUFFLE(3, 1, 3, 1));
+                    even1 = _mm_shuffle_ps(a1, b1, _MM_SHUFFLE(2, 0, 2, 0));
+                    odd1  = _mm_shuffle_ps(a1, b1, _MM_SHUFFLE(3, 1, 3, 1));
+                }
+                else if (componentCount == 2)
+                {
+                    even0 = _mm_shuffle_ps(a0, b0, _MM_SHUFFLE(1, 0, 1, 0));
+                    odd0  = _mm_shuffle_ps(a0, b0, _MM_SHUFFLE(3, 2, 3, 2));
+                    even1 = _mm_shuffle_ps(a1, b1, _MM_SHUFFLE(1, 0, 1, 0));
+                    odd1  = _mm_shuffle_ps(a1, b1, _MM_SHUFFLE(3, 2, 3, 2));
+                }
+                else
+                {
+                    even0 = a0;
+                    odd0  = b0;
+                    even1 = a1;
+                    odd1  = b1;
+                }
+
+                _mm_storeu_ps(destRow + iDest, _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(even0, even1), odd1), odd0), quarter));
+            }
+        #endif
+
+            for (; iDest < destCount; ++iDest)
             {
-                temp00 = sourceData[texel00];
-                temp01 = sourceData[texel01];
-                temp11 = sourceData[texel11];
-                temp10 = sourceData[texel10];
+                size_t iSource = ((iDest / componentCount) * componentCount * 2) + (iDest % componentCount);
+                destRow[iDest] = (row0[iSource] + row1[iSource] + row1[iSource + componentCount] + row0[iSource + componentCount]) / 4.0f;
+            }
+        }
+    }
+
 
-                // 00
-                accumulatedR  = (temp00 & rMask) >> rShift;
-                accumulatedG  = (temp00 & gMask) >> gShift;
-                accumulatedB  = (temp00 & bMask) >> bShift;
-                accumulatedA  = (temp00 & aMask) >> aShift;
 
-                // 01
-                accumulatedR += (temp01 & rMask) >> rShift;
-                accumulatedG += (temp01 & gMask) >> gShift;
-                accumulatedB += (temp01 & bMask) >> bShift;
-                accumulatedA += (temp01 & aMask) >> aShift;
+    ///////////////////////////////////////
+    // Generic
 
-                // 11
-                accumulatedR += (temp11 & rMask) >> rShift;
-                accumulatedG += (temp11 & gMask) >> gShift;
-                accumulatedB += (temp11 & bMask) >> bShift;
-                accumulatedA += (temp11 & aMask) >> aShift;
+    /// MipmapGenerator_RowsProc for every other format, which just uses MipmapGenerator::GenerateRows<T>().
+    template <typename T>
+    static void MipmapGenerator_GenerateRowsGeneric(const MipmapGenerator_Job &job, unsigned int firstRow, unsigned int endRow)
+    {
+        MipmapGenerator::GenerateRows<T>(job.sourceWidth, job.sourceHeight, job.componentCount, job.sourceData, job.destData, firstRow, endRow);
+    }
 
-                // 10
-                accumulatedR += (temp10 & rMask) >> rShift;
-                accumulatedG += (temp10 & gMask) >> gShift;
-                accumulatedB += (temp10 & bMask) >> bShift;
-                accumulatedA += (temp10 & aMask) >> aShift;
 
 
-                // Construct the final value.
-                uint32_t finalColour =
-                    ((accumulatedA >> 2) << aShift) |
-                    ((accumulatedB >> 2) << bShift) |
-                    ((accumulatedG >> 2) << gShift) |
-                    ((accumulatedR >> 2) << rShift);
+    bool MipmapGenerator::Generate(const Mipmap &source, Mipmap &dest, MipmapFilter filter, ThreadPool* pThreadPool)
+    {
+        GT_PROFILE_ZONE("MipmapGenerator::Generate");
+
+        dest.DeleteLocalData();
 
-                destData[destTexelIndex] = finalColour;
+        dest.format = source.format;
+        dest.width  = ImageUtils::CalculateMipmapWidth(1, source.width);
+        dest.height = ImageUtils::CalculateMipmapHeight(1, source.height);
+        dest.data   = malloc(ImageUtils::CalculateDataSize(dest.width, dest.height, dest.format));
 
+        unsigned int componentCount = GetImageFormatComponentCount(dest.format);
+        unsigned int componentSize  = GetImageFormatComponentSize(dest.format);
 
-                ++destTexelIndex;
+        MipmapGenerator_RowsProc rowsProc = nullptr;
 
+        if (dest.format == ImageFormat_RGB8 || dest.format == ImageFormat_RGBA8)
+        {
+            if (filter == MipmapFilter_SRGB)
+            {
+                // The tables are built here so that it happens before any other threads need them.
+                MipmapGenerator_GetSRGBTables();
+                rowsProc = MipmapGenerator_GenerateRowsSRGB8;
+            }
+            else
+            {
+                rowsProc = (dest.format == ImageFormat_RGB8) ? MipmapGenerator_GenerateRowsRGB8 : MipmapGenerator_GenerateRowsRGBA8;
+            }
+        }
+        else
+        {
+            // Now we need to generate the mipmap depending on the format data type.
+            int componentDataType = GetImageFormatDataType(dest.format);
+            if (componentDataType == ImageFormatDataTypes::Integer)
+            {
+                switch (componentSize)
+                {
+                case 1: rowsProc = MipmapGenerator_GenerateRowsGeneric<uint8_t >; break;
+                case 2: rowsProc = MipmapGenerator_GenerateRowsGeneric<uint16_t>; break;
+                case 4: rowsProc = MipmapGenerator_GenerateRowsGeneric<uint32_t>; break;
+                case 8: rowsProc = MipmapGenerator_GenerateRowsGeneric<uint64_t>; break;
 
-                texel00 += 2;
-                texel01 += 2;
-                texel11 += 2;
-                texel10 += 2;
+                default:
+                    {
+                        // Error. Unknown or unsupported component size.
+                        return false;
+                    }
+                }
             }
+            else if (componentDataType == ImageFormatDataTypes::Float)
+            {
+                switch (componentSize)
+                {
+                case 4: rowsProc = MipmapGenerator_GenerateRowsFloat32;          break;
+                case 8: rowsProc = MipmapGenerator_GenerateRowsGeneric<double>; break;
 
-            texel00 += sourceWidth;
-            texel01 += sourceWidth;
-            texel11 += sourceWidth;
-            texel10 += sourceWidth;
+                default:
+                    {
+                        // Error. Unknown or unsupported component size.
+                        return false;
+                    }
+                }
+            }
+            else
+            {
+                // Error. Can't generate mipmaps with this format.
+                return false;
+            }
         }
+
+        auto job = MipmapGenerator_CreateJob(rowsProc, source.width, source.height, componentCount, source.data, dest.data);
+        MipmapGenerator_Run(job, pThreadPool);
+
+        return true;
+    }
+
+
+    void MipmapGenerator::GenerateRGB8(unsigned int sourceWidth, unsigned int sourceHeight, const void* sourceData, void* destData)
+    {
+        auto job = MipmapGenerator_CreateJob(MipmapGenerator_GenerateRowsRGB8, sourceWidth, sourceHeight, 3, sourceData, destData);
+        MipmapGenerator_Run(job, nullptr);
+    }
+
+    void MipmapGenerator::GenerateRGBA8(unsigned int sourceWidth, unsigned int sourceHeight, const void* sourceData, void* destData)
+    {
+        auto job = MipmapGenerator_CreateJob(MipmapGenerator_GenerateRowsRGBA8, sourceWidth, sourceHeight, 4, sourceData, destData);
+        MipmapGenerator_Run(job, nullptr);
+    }
+
+    void MipmapGenerator::GenerateSRGB8(unsigned int sourceWidth, unsigned int sourceHeight, unsigned int componentCount, const void* sourceData, void* destData)
+    {
+        assert(componentCount == 3 || componentCount == 4);
+
+        auto job = MipmapGenerator_CreateJob(MipmapGenerator_GenerateRowsSRGB8, sourceWidth, sourceHeight, componentCount, sourceData, destData);
+        MipmapGenerator_Run(job, nullptr);
     }
 }
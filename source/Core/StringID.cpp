@@ -0,0 +1,322 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#include <GTGE/Core/StringID.hpp>
+#include <GTGE/Core/Math.hpp>
+#include <dr_libs/dr.h>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace GT
+{
+    /// Loads a 32-bit value with acquire semantics, so that everything written before the matching StringTable_StoreRelease() is
+    /// visible to the calling thread.
+    static inline uint32_t StringTable_LoadAcquire(const volatile uint32_t* pValue)
+    {
+    #if defined(_MSC_VER)
+        // x86 and x64 do not reorder loads with other loads, so only the compiler needs to be stopped from moving later loads up.
+        uint32_t value = *pValue;
+        _ReadWriteBarrier();
+        return value;
+    #else
+        return __atomic_load_n(pValue, __ATOMIC_ACQUIRE);
+    #endif
+    }
+
+    /// Stores a 32-bit value with release semantics, publishing everything written before it to threads that load it with
+    /// StringTable_LoadAcquire().
+    static inline void StringTable_StoreRelease(volatile uint32_t* pValue, uint32_t value)
+    {
+    #if defined(_MSC_VER)
+        // x86 and x64 do not reorder stores with other stores, so only the compiler needs to be stopped from moving earlier stores down.
+        _ReadWriteBarrier();
+        *pValue = value;
+    #else
+        __atomic_store_n(pValue, value, __ATOMIC_RELEASE);
+    #endif
+    }
+
+
+    /// The number of entries in each page of the string table. The entries are stored in fixed size pages so they never move, which
+    /// is what lets GetInternedString() run without a lock. See StringTable::count for how new entries are published.
+    static const uint32_t StringTable_PageSize = 1024;
+
+    /// The maximum number of pages. This limits the table to about 4 million strings.
+    static const uint32_t StringTable_MaxPageCount = 4096;
+
+
+    /// Structure representing an interned string.
+    struct StringTableEntry
+    {
+        /// The null terminated string.
+        char* str;
+
+        /// The length of the string, in chars.
+        size_t length;
+
+        /// The hash of the string.
+        uint32_t hash;
+    };
+
+    /// The global string table.
+    class StringTable
+    {
+    public:
+
+        StringTable()
+            : lock(dr_create_mutex()), pages(), count(0), slots(nullptr), slotMask(0)
+        {
+        }
+
+        ~StringTable()
+        {
+            for (uint32_t iPage = 0; iPage < StringTable_MaxPageCount && this->pages[iPage] != nullptr; ++iPage)
+            {
+                for (uint32_t iEntry = 0; iEntry < StringTable_PageSize; ++iEntry)
+                {
+                    free(this->pages[iPage][iEntry].str);
+                }
+
+                free(this->pages[iPage]);
+            }
+
+            free(this->slots);
+            dr_delete_mutex(this->lock);
+        }
+
+
+        /// Retrieves the entry of the given ID. The ID must be valid.
+        const StringTableEntry & GetEntry(StringID id) const
+        {
+            return this->pages[(id - 1) / StringTable_PageSize][(id - 1) % StringTable_PageSize];
+        }
+
+        /// Determines whether or not the given ID has been given out. This does not need the lock, and if it returns true the entry of
+        /// the ID, and the page it is in, can be read without the lock.
+        bool IsValidID(StringID id) const
+        {
+            return id != InvalidStringID && id <= StringTable_LoadAcquire(&this->count);
+        }
+
+
+        /// Finds the ID of the given string. The lock must be held.
+        StringID Find(const char* str, size_t length, uint32_t hash) const
+        {
+            if (this->slots == nullptr)
+            {
+                return InvalidStringID;
+            }
+
+            for (uint32_t iSlot = hash & this->slotMask; this->slots[iSlot] != InvalidStringID; iSlot = (iSlot + 1) & this->slotMask)
+            {
+                auto &entry = this->GetEntry(this->slots[iSlot]);
+                if (entry.hash == hash && entry.length == length && memcmp(entry.str, str, length) == 0)
+                {
+                    return this->slots[iSlot];
+                }
+            }
+
+            return InvalidStringID;
+        }
+
+        /// Adds a new string, returning it's ID. The lock must be held and the string must not already exist.
+        StringID Add(const char* str, size_t length, uint32_t hash)
+        {
+            // The slot table is kept at most half full.
+            if ((this->count + 1) * 2 > this->slotMask + 1 || this->slots == nullptr)
+            {
+                if (!this->GrowSlots())
+                {
+                    return InvalidStringID;
+                }
+            }
+
+            uint32_t iPage  = this->count / StringTable_PageSize;
+            uint32_t iEntry = this->count % StringTable_PageSize;
+            if (iPage >= StringTable_MaxPageCount)
+            {
+                return InvalidStringID;
+            }
+
+            if (this->pages[iPage] == nullptr)
+            {
+                this->pages[iPage] = static_cast<StringTableEntry*>(calloc(StringTable_PageSize, sizeof(StringTableEntry)));
+                if (this->pages[iPage] == nullptr)
+                {
+                    return InvalidStringID;
+                }
+            }
+
+            char* strCopy = static_cast<char*>(malloc(length + 1));
+            if (strCopy == nullptr)
+            {
+                return InvalidStringID;
+            }
+
+            memcpy(strCopy, str, length);
+            strCopy[length] = '\0';
+
+            auto &entry = this->pages[iPage][iEntry];
+            entry.str    = strCopy;
+            entry.length = length;
+            entry.hash   = hash;
+
+            // The entry and the page must be fully written before the new count is visible to threads reading without the lock.
+            StringID id = this->count + 1;
+            StringTable_StoreRelease(&this->count, id);
+
+            this->InsertSlot(id, hash);
+
+            return id;
+        }
+
+
+        /// The lock for adding strings and searching the slots.
+        dr_mutex lock;
+
+    private:
+
+        /// Doubles the size of the slot table.
+        bool GrowSlots()
+        {
+            uint32_t newSlotCount = (this->slots == nullptr) ? 256 : (this->slotMask + 1) * 2;
+
+            auto newSlots = static_cast<StringID*>(calloc(newSlotCount, sizeof(StringID)));
+            if (newSlots == nullptr)
+            {
+                return false;
+            }
+
+            free(this->slots);
+            this->slots    = newSlots;
+            this->slotMask = newSlotCount - 1;
+
+            for (StringID id = 1; id <= this->count; ++id)
+            {
+                this->InsertSlot(id, this->GetEntry(id).hash);
+            }
+
+            return true;
+        }
+
+        /// Inserts an ID into the slot table.
+        void InsertSlot(StringID id, uint32_t hash)
+        {
+            uint32_t iSlot = hash & this->slotMask;
+            while (this->slots[iSlot] != InvalidStringID)
+            {
+                iSlot = (iSlot + 1) & this->slotMask;
+            }
+
+            this->slots[iSlot] = id;
+        }
+
+
+        /// The pages of entries. The entry of an ID is at index ID - 1.
+        StringTableEntry* pages[StringTable_MaxPageCount];
+
+        /// The number of strings in the table. This is also the last ID that was given out. This is only changed while the lock is
+        /// held, but it's read without the lock by IsValidID(), so it's only ever increased with a release store after the new entry
+        /// has been written, and IsValidID() reads it with an acquire load. Entries and page pointers never change once published.
+        volatile uint32_t count;
+
+        /// The open-addressed hash table of IDs, with InvalidStringID marking an empty slot.
+        StringID* slots;
+
+        /// The number of slots minus one.
+        uint32_t slotMask;
+
+
+    private:    // No copying.
+        StringTable(const StringTable &);
+        StringTable & operator=(const StringTable &);
+    };
+
+    /// Retrieves the global string table, creating it on first use.
+    static StringTable & GetStringTable()
+    {
+        static StringTable table;
+        return table;
+    }
+
+
+    StringID InternString(const char* str, ptrdiff_t strLength)
+    {
+        if (str == nullptr)
+        {
+            return InvalidStringID;
+        }
+
+        size_t   length = (strLength == -1) ? strlen(str) : static_cast<size_t>(strLength);
+        uint32_t hash   = Hash(str, static_cast<ptrdiff_t>(length));
+
+        auto &table = GetStringTable();
+        dr_lock_mutex(table.lock);
+        {
+            StringID id = table.Find(str, length, hash);
+            if (id == InvalidStringID)
+            {
+                id = table.Add(str, length, hash);
+            }
+
+            dr_unlock_mutex(table.lock);
+            return id;
+        }
+    }
+
+    StringID FindStringID(const char* str, ptrdiff_t strLength)
+    {
+        if (str == nullptr)
+        {
+            return InvalidStringID;
+        }
+
+        size_t   length = (strLength == -1) ? strlen(str) : static_cast<size_t>(strLength);
+        uint32_t hash   = Hash(str, static_cast<ptrdiff_t>(length));
+
+        auto &table = GetStringTable();
+        dr_lock_mutex(table.lock);
+        {
+            StringID id = table.Find(str, length, hash);
+
+            dr_unlock_mutex(table.lock);
+            return id;
+        }
+    }
+
+    const char* GetInternedString(StringID id)
+    {
+        auto &table = GetStringTable();
+        if (table.IsValidID(id))
+        {
+            return table.GetEntry(id).str;
+        }
+
+        return nullptr;
+    }
+
+    size_t GetInternedStringLength(StringID id)
+    {
+        auto &table = GetStringTable();
+        if (table.IsValidID(id))
+        {
+            return table.GetEntry(id).length;
+        }
+
+        return 0;
+    }
+
+    uint32_t GetInternedStringHash(StringID id)
+    {
+        auto &table = GetStringTable();
+        if (table.IsValidID(id))
+        {
+            return table.GetEntry(id).hash;
+        }
+
+        return 0;
+    }
+}
@@ -0,0 +1,210 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#include <GTGE/Core/ThreadPool.hpp>
+
+namespace GT
+{
+    ThreadPool::ThreadPool()
+        : m_pWorkerThreads(nullptr), m_workerThreadCount(0),
+          m_wakeSemaphore(NULL), m_doneSemaphore(NULL), m_jobLock(NULL), m_isBatchActive(false),
+          m_jobProc(nullptr), m_pJobUserData(nullptr), m_jobCount(0), m_nextJobIndex(0),
+          m_isTerminating(false)
+    {
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        this->Shutdown();
+    }
+
+
+    bool ThreadPool::Startup(unsigned int workerThreadCount)
+    {
+        if (m_jobLock != NULL)
+        {
+            return false;   // Already started.
+        }
+
+        m_jobLock       = dr_create_mutex();
+        m_wakeSemaphore = dr_create_semaphore(0);
+        m_doneSemaphore = dr_create_semaphore(0);
+
+        if (m_jobLock == NULL || m_wakeSemaphore == NULL || m_doneSemaphore == NULL)
+        {
+            this->Shutdown();
+            return false;
+        }
+
+
+        m_isTerminating = false;
+
+        if (workerThreadCount > 0)
+        {
+            m_pWorkerThreads = new WorkerThread[workerThreadCount];
+
+            for (unsigned int i = 0; i < workerThreadCount; ++i)
+            {
+                m_pWorkerThreads[i].pThreadPool = this;
+                m_pWorkerThreads[i].threadIndex = i + 1;
+                m_pWorkerThreads[i].thread      = dr_create_thread(WorkerThreadProc, &m_pWorkerThreads[i]);
+
+                if (m_pWorkerThreads[i].thread == NULL)
+                {
+                    break;
+                }
+
+                m_workerThreadCount += 1;
+            }
+        }
+
+        return true;
+    }
+
+    void ThreadPool::Shutdown()
+    {
+        if (m_jobLock == NULL)
+        {
+            return;
+        }
+
+        // Every worker thread needs to be woken up so they can see that they need to terminate.
+        m_isTerminating = true;
+        for (unsigned int i = 0; i < m_workerThreadCount; ++i)
+        {
+            dr_release_semaphore(m_wakeSemaphore);
+        }
+
+        for (unsigned int i = 0; i < m_workerThreadCount; ++i)
+        {
+            dr_wait_thread(m_pWorkerThreads[i].thread);
+            dr_delete_thread(m_pWorkerThreads[i].thread);
+        }
+
+        delete [] m_pWorkerThreads;
+        m_pWorkerThreads    = nullptr;
+        m_workerThreadCount = 0;
+
+
+        if (m_doneSemaphore != NULL) { dr_delete_semaphore(m_doneSemaphore); m_doneSemaphore = NULL; }
+        if (m_wakeSemaphore != NULL) { dr_delete_semaphore(m_wakeSemaphore); m_wakeSemaphore = NULL; }
+        if (m_jobLock       != NULL) { dr_delete_mutex(m_jobLock);           m_jobLock       = NULL; }
+    }
+
+
+    void ThreadPool::Run(size_t jobCount, ThreadPoolJobProc jobProc, void* pUserData)
+    {
+        if (jobCount == 0 || jobProc == nullptr)
+        {
+            return;
+        }
+
+        // The worker threads can only be working on one batch at a time. If they're busy, or if there's nothing to distribute the
+        // work to, we just run everything on the calling thread. This is also what makes it safe to call Run() from inside a job.
+        bool isDistributing = false;
+        if (m_workerThreadCount > 0 && jobCount > 1)
+        {
+            dr_lock_mutex(m_jobLock);
+            {
+                if (!m_isBatchActive)
+                {
+                    m_isBatchActive = true;
+                    m_jobProc       = jobProc;
+                    m_pJobUserData  = pUserData;
+                    m_jobCount      = jobCount;
+                    m_nextJobIndex  = 0;
+                    isDistributing  = true;
+                }
+            }
+            dr_unlock_mutex(m_jobLock);
+        }
+
+        if (!isDistributing)
+        {
+            for (size_t iJob = 0; iJob < jobCount; ++iJob)
+            {
+                jobProc(iJob, 0, pUserData);
+            }
+
+            return;
+        }
+
+
+        // We only wake up as many workers as there are jobs for. The calling thread takes one of the jobs itself.
+        size_t wakeCount = Min(static_cast<size_t>(m_workerThreadCount), jobCount - 1);
+        for (size_t i = 0; i < wakeCount; ++i)
+        {
+            dr_release_semaphore(m_wakeSemaphore);
+        }
+
+        this->ProcessJobs(0);
+
+        // Every worker that was woken up will release the done semaphore exactly once. We can't return until they've all finished
+        // because the job data is owned by the caller.
+        for (size_t i = 0; i < wakeCount; ++i)
+        {
+            dr_wait_semaphore(m_doneSemaphore);
+        }
+
+        dr_lock_mutex(m_jobLock);
+        {
+            m_jobProc       = nullptr;
+            m_pJobUserData  = nullptr;
+            m_jobCount      = 0;
+            m_isBatchActive = false;
+        }
+        dr_unlock_mutex(m_jobLock);
+    }
+
+
+
+    ////////////////////////////////////////
+    // Private
+
+    void ThreadPool::ProcessJobs(size_t threadIndex)
+    {
+        for (;;)
+        {
+            size_t jobIndex;
+
+            dr_lock_mutex(m_jobLock);
+            {
+                jobIndex = m_nextJobIndex;
+                if (jobIndex < m_jobCount)
+                {
+                    m_nextJobIndex += 1;
+                }
+            }
+            dr_unlock_mutex(m_jobLock);
+
+            if (jobIndex >= m_jobCount)
+            {
+                break;
+            }
+
+            m_jobProc(jobIndex, threadIndex, m_pJobUserData);
+        }
+    }
+
+    int ThreadPool::WorkerThreadProc(void* pData)
+    {
+        auto pWorkerThread = reinterpret_cast<WorkerThread*>(pData);
+        assert(pWorkerThread != nullptr);
+
+        auto pThreadPool = pWorkerThread->pThreadPool;
+        assert(pThreadPool != nullptr);
+
+        while (dr_wait_semaphore(pThreadPool->m_wakeSemaphore))
+        {
+            if (pThreadPool->m_isTerminating)
+            {
+                break;
+            }
+
+            pThreadPool->ProcessJobs(pWorkerThread->threadIndex);
+
+            dr_release_semaphore(pThreadPool->m_doneSemaphore);
+        }
+
+        return 0;
+    }
+}
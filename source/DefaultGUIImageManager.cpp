@@ -3,6 +3,8 @@
 #include <GTGE/DefaultGUIImageManager.hpp>
 #include <GTGE/Rendering/Renderer.hpp>
 #include <GTGE/Core/ImageLoader.hpp>
+#include <GTGE/Assets/ImageAsset.hpp>
+#include <GTGE/GTEngine.hpp>
 
 namespace GT
 {
@@ -99,6 +101,34 @@ namespace GT
                 // Not a supported format. Fall through and return null.
             }
         }
+        else
+        {
+            // The image may have been packed into a game package, in which case it's decoded by the asset library.
+            auto &assetLibrary = g_Context->GetAssetLibrary();
+
+            char absolutePath[DRFS_MAX_PATH];
+            if (assetLibrary.FindAbsolutePath(filePath, absolutePath, sizeof(absolutePath)) && assetLibrary.IsPackagePath(absolutePath))
+            {
+                GUIImageHandle image = 0;
+
+                auto pAsset = assetLibrary.Load(absolutePath);
+                if (pAsset != nullptr)
+                {
+                    if (pAsset->GetClass() == AssetClass_Image)
+                    {
+                        auto pImageAsset = reinterpret_cast<ImageAsset*>(pAsset);
+                        if (pImageAsset->GetImageFormat() == TextureFormat_RGBA8)
+                        {
+                            image = this->CreateImage(pImageAsset->GetImageWidth(), pImageAsset->GetImageHeight(), GUIImageFormat_RGBA8, pImageAsset->GetImageData());
+                        }
+                    }
+
+                    assetLibrary.Unload(pAsset);
+                }
+
+                return image;
+            }
+        }
         
         return 0;
     }
@@ -3,6 +3,9 @@
 #include <GTGE/DefaultSceneCullingManager.hpp>
 #include <GTGE/SceneNode.hpp>
 #include <GTGE/CollisionGroups.hpp>
+#include <GTGE/Profiler.hpp>
+#include "BulletCollision/NarrowPhaseCollision/btGjkEpa2.h"
+#include "BulletCollision/NarrowPhaseCollision/btPersistentManifold.h"
 
 #if defined(_MSC_VER)
     #pragma warning(push)
@@ -410,6 +413,8 @@ namespace GT
 
     void DefaultSceneCullingManager::ProcessVisibleSceneNodes(const glm::mat4 &mvpIn, VisibilityCallback &callbackIn) const
     {
+        GT_PROFILE_ZONE("DefaultSceneCullingManager::ProcessVisibleSceneNodes");
+
         auto flags = this->GetFlags();
 
         // TODO: Occlusion culling is disabled for now since it's unstable at the moment. Need to look into this.
@@ -508,6 +513,151 @@ namespace GT
         }
     }
 
+    bool DefaultSceneCullingManager::IsLightContactQueryThreadSafe() const
+    {
+        return true;
+    }
+
+    void DefaultSceneCullingManager::QueryPointLightContactsConcurrent(const SceneNode &light, VisibilityCallback &callbackIn) const
+    {
+        auto iCullingObject = this->pointLights.Find(&light);
+        assert(iCullingObject != nullptr);
+        {
+            auto cullingObject = iCullingObject->value;
+            assert(cullingObject != nullptr);
+            {
+                this->QueryLightContactsConcurrent(*cullingObject, callbackIn);
+            }
+        }
+    }
+
+    void DefaultSceneCullingManager::QuerySpotLightContactsConcurrent(const SceneNode &light, VisibilityCallback &callbackIn) const
+    {
+        auto iCullingObject = this->spotLights.Find(&light);
+        assert(iCullingObject != nullptr);
+        {
+            auto cullingObject = iCullingObject->value;
+            assert(cullingObject != nullptr);
+            {
+                this->QueryLightContactsConcurrent(*cullingObject, callbackIn);
+            }
+        }
+    }
+
+
+    void DefaultSceneCullingManager::QueryLightContactsConcurrent(const CullingObject &light, VisibilityCallback &callback) const
+    {
+        auto proxy = light.collisionObject.getBroadphaseHandle();
+        if (proxy != nullptr)
+        {
+            // aabbTest() is not const, but it only reads from the tree.
+            LightContactAabbCallback aabbCallback(light, callback);
+            const_cast<btDbvtBroadphase &>(m_world.GetBroadphase()).aabbTest(proxy->m_aabbMin, proxy->m_aabbMax, aabbCallback);
+        }
+    }
+
+
+    /// Determines whether or not two convex shapes are within the given contact breaking threshold of each other, including their margins.
+    static bool DefaultSceneCullingManager_ConvexShapesOverlap(const btConvexShape* shapeA, const btTransform &transformA, const btConvexShape* shapeB, const btTransform &transformB, btScalar contactBreakingThreshold)
+    {
+        // Distance() works on the shapes without their margins, so the margins are added back on here. A sphere is entirely margin.
+        btGjkEpaSolver2::sResults results;
+        if (btGjkEpaSolver2::Distance(shapeA, transformA, shapeB, transformB, transformB.getOrigin() - transformA.getOrigin(), results))
+        {
+            return results.distance <= shapeA->getMargin() + shapeB->getMargin() + contactBreakingThreshold;
+        }
+
+        // The shapes couldn't be separated, so they're penetrating.
+        return true;
+    }
+
+    /// Determines whether or not two collision objects would be in contact in a contact test. Only convex shapes and compounds of convex
+    /// shapes are tested. Culling objects only ever use boxes, spheres and cones, so any other shape is treated as not touching.
+    static bool DefaultSceneCullingManager_CollisionObjectsOverlap(const btCollisionObject &objectA, const btCollisionObject &objectB)
+    {
+        auto shapeA = objectA.getCollisionShape();
+        auto shapeB = objectB.getCollisionShape();
+        if (shapeA == nullptr || shapeB == nullptr)
+        {
+            return false;
+        }
+
+        // This is the threshold the dispatcher gives the manifold of a contact test. Points further apart than this are dropped.
+        btScalar contactBreakingThreshold = btMin(shapeA->getContactBreakingThreshold(gContactBreakingThreshold), shapeB->getContactBreakingThreshold(gContactBreakingThreshold));
+
+        // The culling objects always wrap their shape in a compound, so the children are tested against each other.
+        const btCompoundShape* compoundA = shapeA->isCompound() ? static_cast<const btCompoundShape*>(shapeA) : nullptr;
+        const btCompoundShape* compoundB = shapeB->isCompound() ? static_cast<const btCompoundShape*>(shapeB) : nullptr;
+
+        int childCountA = (compoundA != nullptr) ? compoundA->getNumChildShapes() : 1;
+        int childCountB = (compoundB != nullptr) ? compoundB->getNumChildShapes() : 1;
+
+        for (int iChildA = 0; iChildA < childCountA; ++iChildA)
+        {
+            auto childShapeA = (compoundA != nullptr) ? compoundA->getChildShape(iChildA) : shapeA;
+            auto transformA  = (compoundA != nullptr) ? objectA.getWorldTransform() * compoundA->getChildTransform(iChildA) : objectA.getWorldTransform();
+
+            for (int iChildB = 0; iChildB < childCountB; ++iChildB)
+            {
+                auto childShapeB = (compoundB != nullptr) ? compoundB->getChildShape(iChildB) : shapeB;
+                auto transformB  = (compoundB != nullptr) ? objectB.getWorldTransform() * compoundB->getChildTransform(iChildB) : objectB.getWorldTransform();
+
+                if (!childShapeA->isConvex() || !childShapeB->isConvex())
+                {
+                    continue;
+                }
+
+                if (DefaultSceneCullingManager_ConvexShapesOverlap(static_cast<const btConvexShape*>(childShapeA), transformA, static_cast<const btConvexShape*>(childShapeB), transformB, contactBreakingThreshold))
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+
+    bool DefaultSceneCullingManager::LightContactAabbCallback::process(const btBroadphaseProxy* proxy)
+    {
+        assert(proxy != nullptr);
+
+        // The same filtering as a contact test.
+        if ((proxy->m_collisionFilterGroup & this->light.collisionMask) == 0 || (this->light.collisionGroup & proxy->m_collisionFilterMask) == 0)
+        {
+            return true;
+        }
+
+        auto collisionObject = static_cast<const btCollisionObject*>(proxy->m_clientObject);
+        assert(collisionObject != nullptr);
+
+        if (collisionObject == &this->light.collisionObject)
+        {
+            return true;
+        }
+
+
+        // We assume the user pointer is the culling object.
+        auto cullingObject = static_cast<const CullingObject*>(collisionObject->getUserPointer());
+        assert(cullingObject != nullptr);
+        {
+            if (DefaultSceneCullingManager_CollisionObjectsOverlap(this->light.collisionObject, *collisionObject))
+            {
+                // We can determine the object type by looking at the collision group.
+                if ((cullingObject->collisionGroup & CollisionGroups::Model))
+                {
+                    this->callback.ProcessModel(cullingObject->sceneNode);
+                }
+                else if ((cullingObject->collisionGroup & CollisionGroups::ParticleSystem))
+                {
+                    this->callback.ProcessParticleSystem(cullingObject->sceneNode);
+                }
+            }
+        }
+
+        return true;
+    }
+
 
 
 
@@ -2,6 +2,7 @@
 
 #include <GTGE/DefaultScenePhysicsManager.hpp>
 #include <GTGE/SceneNode.hpp>
+#include <GTGE/Profiler.hpp>
 
 namespace GT
 {
@@ -152,6 +153,8 @@ namespace GT
 
     void DefaultScenePhysicsManager::Step(double deltaTimeInSeconds)
     {
+        GT_PROFILE_ZONE("DefaultScenePhysicsManager::Step");
+
         this->world.Step(static_cast<btScalar>(deltaTimeInSeconds * this->speedScale), 10, 0.00833f);
     }
 
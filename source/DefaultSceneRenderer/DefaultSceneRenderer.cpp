@@ -5,6 +5,7 @@
 #include <GTGE/DefaultSceneRenderer/DefaultSceneRenderer_MultiPassPipeline.hpp>
 #include <GTGE/ShaderLibrary.hpp>
 #include <GTGE/Context.hpp>
+#include <GTGE/Profiler.hpp>
 
 #if defined(_MSC_VER)
     #pragma warning(push)
@@ -18,7 +19,7 @@ namespace GT
 
     DefaultSceneRenderer::DefaultSceneRenderer(Context &context)
         : m_context(context),
-          viewportFramebuffers(), m_materialShaders(), depthPassShader(nullptr), externalMeshes(),
+          viewportFramebuffers(), m_materialShaders(), m_frameAllocator(), m_meshListPool(), depthPassShader(nullptr), externalMeshes(),
           directionalShadowMapFramebuffer(1, 1), pointShadowMapFramebuffer(1, 1), spotShadowMapFramebuffer(1, 1),
           fullscreenTriangleVA(nullptr),
           shadowMapShader(nullptr), pointShadowMapShader(nullptr),
@@ -28,7 +29,7 @@ namespace GT
           shaderBuilder(),
           luminanceChain(context),
           materialUniformNames(),
-          isHDREnabled(true), isBloomEnabled(true), hdrExposure(1.0f), bloomFactor(1.0f),
+          isHDREnabled(true), isBloomEnabled(true), isParticleIndexReuseEnabled(true), isParallelLightContactQueriesEnabled(true), hdrExposure(1.0f), bloomFactor(1.0f),
           directionalShadowMapSize(1024), pointShadowMapSize(256), spotShadowMapSize(512),
           materialLibraryEventHandler(*this)
     {
@@ -104,6 +105,11 @@ namespace GT
             }
         }
 
+        for (size_t i = 0; i < m_meshListPool.count; ++i)
+        {
+            delete m_meshListPool[i];
+        }
+
         Renderer::DeleteVertexArray(this->fullscreenTriangleVA);
 
         m_context.GetMaterialLibrary().RemoveEventHandler(this->materialLibraryEventHandler);
@@ -118,13 +124,30 @@ namespace GT
     void DefaultSceneRenderer::End(Scene &scene)
     {
         (void)scene;
+
+        // Every visibility processor for the frame has been destructed by now, so everything they allocated can be released at once.
+        m_frameAllocator.Reset();
     }
 
     void DefaultSceneRenderer::RenderViewport(Scene &scene, SceneViewport &viewport)
     {
+        GT_PROFILE_ZONE("DefaultSceneRenderer::RenderViewport");
+
+        auto &stats = scene.GetContext().GetStats();
+        double cullingStartTime = Timing::GetTimeInSeconds();
+
         // 0) Retrieve visible objects.
-        DefaultSceneRenderer_VisibilityProcessor visibleObjects(scene, viewport);
-        scene.QueryVisibleSceneNodes(viewport.GetMVPMatrix(), visibleObjects);
+        DefaultSceneRenderer_VisibilityProcessor visibleObjects(scene, viewport, m_frameAllocator, m_meshListPool);
+        visibleObjects.reuseParticleIndices  = this->isParticleIndexReuseEnabled;
+        visibleObjects.parallelLightContacts = this->isParallelLightContactQueriesEnabled;
+
+        {
+            GT_PROFILE_ZONE("DefaultSceneRenderer::RenderViewport - Visibility");
+            scene.QueryVisibleSceneNodes(viewport.GetMVPMatrix(), visibleObjects);
+        }
+
+        double renderStartTime = Timing::GetTimeInSeconds();
+        stats.Add(EngineStat_CullingTime, (renderStartTime - cullingStartTime) * 1000.0);
 
         // All external meshes are considered visible. Not going to do any frustum culling here.
         for (size_t i = 0; i < this->externalMeshes.count; ++i)
@@ -145,6 +168,8 @@ namespace GT
         // Post-processing needs to be done after everything has been added.
         visibleObjects.PostProcess();
 
+        stats.Add(EngineStat_VisibleMeshes, static_cast<double>(visibleObjects.GetMeshCount()));
+
 
         // We'll want to grab the framebuffer and set a few defaults.
         auto framebuffer = this->GetViewportFramebuffer(viewport);
@@ -194,6 +219,8 @@ namespace GT
         // Here we just render the final image. Basically, this is just the post-process step. This will eventually be made into a proper
         // pipeline stage.
         this->RenderFinalComposition(framebuffer, framebuffer->colourBuffer0);
+
+        stats.Add(EngineStat_RenderTime, (Timing::GetTimeInSeconds() - renderStartTime) * 1000.0);
     }
 
     void DefaultSceneRenderer::AddViewport(SceneViewport &viewport)
@@ -310,6 +337,28 @@ namespace GT
                 this->DisableBloom();
             }
         }
+        else if (Strings::Equal(name, "IsParticleIndexReuseEnabled"))
+        {
+            if (value)
+            {
+                this->EnableParticleIndexReuse();
+            }
+            else
+            {
+                this->DisableParticleIndexReuse();
+            }
+        }
+        else if (Strings::Equal(name, "IsParallelLightContactQueriesEnabled"))
+        {
+            if (value)
+            {
+                this->EnableParallelLightContactQueries();
+            }
+            else
+            {
+                this->DisableParallelLightContactQueries();
+            }
+        }
     }
 
     void DefaultSceneRenderer::SetProperty(const char* name, const glm::vec2 &value)
@@ -381,6 +430,14 @@ namespace GT
         {
             return this->IsBloomEnabled();
         }
+        else if (Strings::Equal(name, "IsParticleIndexReuseEnabled"))
+        {
+            return this->IsParticleIndexReuseEnabled();
+        }
+        else if (Strings::Equal(name, "IsParallelLightContactQueriesEnabled"))
+        {
+            return this->IsParallelLightContactQueriesEnabled();
+        }
 
         return false;
     }
@@ -446,6 +503,38 @@ namespace GT
     }
 
 
+    void DefaultSceneRenderer::EnableParticleIndexReuse()
+    {
+        this->isParticleIndexReuseEnabled = true;
+    }
+
+    void DefaultSceneRenderer::DisableParticleIndexReuse()
+    {
+        this->isParticleIndexReuseEnabled = false;
+    }
+
+    bool DefaultSceneRenderer::IsParticleIndexReuseEnabled() const
+    {
+        return this->isParticleIndexReuseEnabled;
+    }
+
+
+    void DefaultSceneRenderer::EnableParallelLightContactQueries()
+    {
+        this->isParallelLightContactQueriesEnabled = true;
+    }
+
+    void DefaultSceneRenderer::DisableParallelLightContactQueries()
+    {
+        this->isParallelLightContactQueriesEnabled = false;
+    }
+
+    bool DefaultSceneRenderer::IsParallelLightContactQueriesEnabled() const
+    {
+        return this->isParallelLightContactQueriesEnabled;
+    }
+
+
     void DefaultSceneRenderer::SetHDRExposure(float newExposure)
     {
         this->hdrExposure = newExposure;
@@ -550,6 +639,8 @@ namespace GT
 
     Texture2D* DefaultSceneRenderer::RenderDirectionalLightShadowMap(DefaultSceneRendererDirectionalLight &light, size_t shadowMapIndex)
     {
+        GT_PROFILE_ZONE("DefaultSceneRenderer::RenderDirectionalLightShadowMap");
+
         assert(shadowMapIndex == 0);    // <-- temp assert until we add support for multiple shadow maps.
         (void)shadowMapIndex;
 
@@ -582,7 +673,7 @@ namespace GT
             assert(mesh.vertexArray != nullptr);
             {
                 // Shader setup.
-                this->shadowMapShader->SetUniform("PVMMatrix", lightProjectionView * mesh.transform);
+                this->shadowMapShader->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_PVMMatrix), lightProjectionView * mesh.transform);
                 Renderer::PushPendingUniforms(*this->shadowMapShader);
 
 
@@ -602,8 +693,8 @@ namespace GT
 
             // Shader.
             Renderer::SetCurrentShader(this->shadowBlurShaderX);
-            this->shadowBlurShaderX->SetUniform("Texture", this->directionalShadowMapFramebuffer.colourBuffer);
-            this->shadowBlurShaderX->SetUniform("TextureSizeReciprocal", 1.0f / static_cast<float>(this->directionalShadowMapFramebuffer.colourBuffer->GetWidth()));
+            this->shadowBlurShaderX->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_Texture), this->directionalShadowMapFramebuffer.colourBuffer);
+            this->shadowBlurShaderX->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_TextureSizeReciprocal), 1.0f / static_cast<float>(this->directionalShadowMapFramebuffer.colourBuffer->GetWidth()));
             Renderer::PushPendingUniforms(*this->shadowBlurShaderX);
 
             // Draw.
@@ -616,8 +707,8 @@ namespace GT
 
             // Shader.
             Renderer::SetCurrentShader(this->shadowBlurShaderY);
-            this->shadowBlurShaderY->SetUniform("Texture", this->directionalShadowMapFramebuffer.blurBuffer);
-            this->shadowBlurShaderY->SetUniform("TextureSizeReciprocal", 1.0f / static_cast<float>(this->directionalShadowMapFramebuffer.colourBuffer->GetHeight()));
+            this->shadowBlurShaderY->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_Texture), this->directionalShadowMapFramebuffer.blurBuffer);
+            this->shadowBlurShaderY->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_TextureSizeReciprocal), 1.0f / static_cast<float>(this->directionalShadowMapFramebuffer.colourBuffer->GetHeight()));
             Renderer::PushPendingUniforms(*this->shadowBlurShaderY);
 
             // Draw.
@@ -634,6 +725,8 @@ namespace GT
 
     TextureCube* DefaultSceneRenderer::RenderPointLightShadowMap(DefaultSceneRendererPointLight &light, size_t shadowMapIndex)
     {
+        GT_PROFILE_ZONE("DefaultSceneRenderer::RenderPointLightShadowMap");
+
         assert(shadowMapIndex == 0);    // <-- temp assert until we add support for multiple shadow maps.
         (void)shadowMapIndex;
 
@@ -658,6 +751,8 @@ namespace GT
 
     Texture2D* DefaultSceneRenderer::RenderSpotLightShadowMap(DefaultSceneRendererSpotLight &light, size_t shadowMapIndex)
     {
+        GT_PROFILE_ZONE("DefaultSceneRenderer::RenderSpotLightShadowMap");
+
         assert(shadowMapIndex == 0);    // <-- temp assert until we add support for multiple shadow maps.
         (void)shadowMapIndex;
 
@@ -690,7 +785,7 @@ namespace GT
             assert(mesh.vertexArray != nullptr);
             {
                 // Shader setup.
-                this->shadowMapShader->SetUniform("PVMMatrix", lightProjectionView * mesh.transform);
+                this->shadowMapShader->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_PVMMatrix), lightProjectionView * mesh.transform);
                 Renderer::PushPendingUniforms(*this->shadowMapShader);
 
 
@@ -710,8 +805,8 @@ namespace GT
 
             // Shader.
             Renderer::SetCurrentShader(this->shadowBlurShaderX);
-            this->shadowBlurShaderX->SetUniform("Texture", this->spotShadowMapFramebuffer.colourBuffer);
-            this->shadowBlurShaderX->SetUniform("TextureSizeReciprocal", 1.0f / static_cast<float>(this->spotShadowMapFramebuffer.colourBuffer->GetWidth()));
+            this->shadowBlurShaderX->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_Texture), this->spotShadowMapFramebuffer.colourBuffer);
+            this->shadowBlurShaderX->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_TextureSizeReciprocal), 1.0f / static_cast<float>(this->spotShadowMapFramebuffer.colourBuffer->GetWidth()));
             Renderer::PushPendingUniforms(*this->shadowBlurShaderX);
 
             // Draw.
@@ -724,8 +819,8 @@ namespace GT
 
             // Shader.
             Renderer::SetCurrentShader(this->shadowBlurShaderY);
-            this->shadowBlurShaderY->SetUniform("Texture", this->spotShadowMapFramebuffer.blurBuffer);
-            this->shadowBlurShaderY->SetUniform("TextureSizeReciprocal", 1.0f / static_cast<float>(this->spotShadowMapFramebuffer.colourBuffer->GetHeight()));
+            this->shadowBlurShaderY->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_Texture), this->spotShadowMapFramebuffer.blurBuffer);
+            this->shadowBlurShaderY->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_TextureSizeReciprocal), 1.0f / static_cast<float>(this->spotShadowMapFramebuffer.colourBuffer->GetHeight()));
             Renderer::PushPendingUniforms(*this->shadowBlurShaderY);
 
             // Draw.
@@ -762,8 +857,8 @@ namespace GT
             assert(mesh.vertexArray != nullptr);
             {
                 // Shader setup.
-                this->pointShadowMapShader->SetUniform("PVMMatrix",       projectionView * mesh.transform);
-                this->pointShadowMapShader->SetUniform("ViewModelMatrix", faceViewMatrix * mesh.transform);
+                this->pointShadowMapShader->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_PVMMatrix),       projectionView * mesh.transform);
+                this->pointShadowMapShader->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_ViewModelMatrix), faceViewMatrix * mesh.transform);
                 Renderer::PushPendingUniforms(*this->pointShadowMapShader);
 
 
@@ -787,8 +882,8 @@ namespace GT
 
             // Shader.
             Renderer::SetCurrentShader(this->shadowBlurShaderX);
-            this->shadowBlurShaderX->SetUniform("Texture", this->pointShadowMapFramebuffer.blurBuffer0);
-            this->shadowBlurShaderX->SetUniform("TextureSizeReciprocal", 1.0f / static_cast<float>(this->pointShadowMapFramebuffer.blurBuffer0->GetWidth()));
+            this->shadowBlurShaderX->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_Texture), this->pointShadowMapFramebuffer.blurBuffer0);
+            this->shadowBlurShaderX->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_TextureSizeReciprocal), 1.0f / static_cast<float>(this->pointShadowMapFramebuffer.blurBuffer0->GetWidth()));
             Renderer::PushPendingUniforms(*this->shadowBlurShaderX);
 
             // Draw.
@@ -801,8 +896,8 @@ namespace GT
 
             // Shader.
             Renderer::SetCurrentShader(this->shadowBlurShaderY);
-            this->shadowBlurShaderY->SetUniform("Texture", this->pointShadowMapFramebuffer.blurBuffer1);
-            this->shadowBlurShaderY->SetUniform("TextureSizeReciprocal", 1.0f / static_cast<float>(this->pointShadowMapFramebuffer.blurBuffer1->GetHeight()));
+            this->shadowBlurShaderY->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_Texture), this->pointShadowMapFramebuffer.blurBuffer1);
+            this->shadowBlurShaderY->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_TextureSizeReciprocal), 1.0f / static_cast<float>(this->pointShadowMapFramebuffer.blurBuffer1->GetHeight()));
             Renderer::PushPendingUniforms(*this->shadowBlurShaderY);
 
             // Draw.
@@ -985,6 +1080,8 @@ namespace GT
 
     void DefaultSceneRenderer::RenderFinalComposition(DefaultSceneRendererFramebuffer* framebuffer, Texture2D* sourceColourBuffer)
     {
+        GT_PROFILE_ZONE("DefaultSceneRenderer::RenderFinalComposition");
+
         Renderer::DisableDepthTest();
         Renderer::DisableDepthWrites();
         Renderer::DisableStencilTest();
@@ -1016,17 +1113,17 @@ namespace GT
             if (this->IsBloomEnabled())
             {
                 Renderer::SetCurrentShader(this->finalCompositionShaderHDR);
-                this->finalCompositionShaderHDR->SetUniform("ColourBuffer",    sourceColourBuffer);
-                this->finalCompositionShaderHDR->SetUniform("LuminanceBuffer", this->luminanceChain.GetLuminanceBuffer());
-                this->finalCompositionShaderHDR->SetUniform("BloomBuffer",     framebuffer->bloomBuffer);
-                this->finalCompositionShaderHDR->SetUniform("BloomFactor",     this->bloomFactor);
+                this->finalCompositionShaderHDR->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_ColourBuffer),    sourceColourBuffer);
+                this->finalCompositionShaderHDR->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_LuminanceBuffer), this->luminanceChain.GetLuminanceBuffer());
+                this->finalCompositionShaderHDR->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_BloomBuffer),     framebuffer->bloomBuffer);
+                this->finalCompositionShaderHDR->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_BloomFactor),     this->bloomFactor);
                 Renderer::PushPendingUniforms(*this->finalCompositionShaderHDR);
             }
             else
             {
                 Renderer::SetCurrentShader(this->finalCompositionShaderHDRNoBloom);
-                this->finalCompositionShaderHDRNoBloom->SetUniform("ColourBuffer",    sourceColourBuffer);
-                this->finalCompositionShaderHDRNoBloom->SetUniform("LuminanceBuffer", this->luminanceChain.GetLuminanceBuffer());
+                this->finalCompositionShaderHDRNoBloom->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_ColourBuffer),    sourceColourBuffer);
+                this->finalCompositionShaderHDRNoBloom->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_LuminanceBuffer), this->luminanceChain.GetLuminanceBuffer());
                 Renderer::PushPendingUniforms(*this->finalCompositionShaderHDRNoBloom);
             }
         }
@@ -1043,7 +1140,7 @@ namespace GT
 
             // Shader Setup.
             Renderer::SetCurrentShader(this->finalCompositionShaderLDR);
-            this->finalCompositionShaderLDR->SetUniform("ColourBuffer", sourceColourBuffer);
+            this->finalCompositionShaderLDR->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_ColourBuffer), sourceColourBuffer);
             Renderer::PushPendingUniforms(*this->finalCompositionShaderLDR);
         }
 
@@ -1065,7 +1162,7 @@ namespace GT
 
         // Shader Setup.
         Renderer::SetCurrentShader(this->bloomShader);
-        this->bloomShader->SetUniform("ColourBuffer", sourceColourBuffer);
+        this->bloomShader->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_ColourBuffer), sourceColourBuffer);
         Renderer::PushPendingUniforms(*this->bloomShader);
 
         // Draw.
@@ -1081,8 +1178,8 @@ namespace GT
 
             // Shader.
             Renderer::SetCurrentShader(this->bloomBlurShaderX);
-            this->bloomBlurShaderX->SetUniform("Texture",               framebuffer->bloomBuffer);
-            this->bloomBlurShaderX->SetUniform("TextureSizeReciprocal", 1.0f / static_cast<float>(framebuffer->bloomBlurBuffer->GetWidth()));
+            this->bloomBlurShaderX->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_Texture),               framebuffer->bloomBuffer);
+            this->bloomBlurShaderX->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_TextureSizeReciprocal), 1.0f / static_cast<float>(framebuffer->bloomBlurBuffer->GetWidth()));
             Renderer::PushPendingUniforms(*this->bloomBlurShaderX);
 
             // Draw.
@@ -1095,8 +1192,8 @@ namespace GT
 
             // Shader.
             Renderer::SetCurrentShader(this->bloomBlurShaderY);
-            this->bloomBlurShaderY->SetUniform("Texture",               framebuffer->bloomBlurBuffer);
-            this->bloomBlurShaderY->SetUniform("TextureSizeReciprocal", 1.0f / static_cast<float>(framebuffer->bloomBlurBuffer->GetHeight()));
+            this->bloomBlurShaderY->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_Texture),               framebuffer->bloomBlurBuffer);
+            this->bloomBlurShaderY->SetUniform(this->materialUniformNames.GetUniformName(RendererUniform_TextureSizeReciprocal), 1.0f / static_cast<float>(framebuffer->bloomBlurBuffer->GetHeight()));
             Renderer::PushPendingUniforms(*this->bloomBlurShaderY);
 
             // Draw.
@@ -13,7 +13,9 @@ namespace GT
           m_buffers(),
           m_shaders(),
           m_baseWidth(0),
-          m_baseHeight(0)
+          m_baseHeight(0),
+          m_inputTextureNameID(InternString("InputTexture")),
+          m_exposureNameID(InternString("Exposure"))
     {
         this->m_framebuffer = Renderer::CreateFramebuffer();
     }
@@ -93,11 +95,11 @@ namespace GT
                     assert(shader != nullptr);
                     {
                         Renderer::SetCurrentShader(shader);
-                        shader->SetUniform("InputTexture", inputTexture);
+                        shader->SetUniform(this->m_inputTextureNameID, inputTexture);
 
                         if (iBuffer == this->m_buffers.count - 1)
                         {
-                            shader->SetUniform("Exposure", glm::vec2(exposure, exposure * (1.0f / (exposure + 1.0f))));
+                            shader->SetUniform(this->m_exposureNameID, glm::vec2(exposure, exposure * (1.0f / (exposure + 1.0f))));
                         }
 
                         Renderer::PushPendingUniforms(shader);
@@ -12,19 +12,33 @@ namespace GT
         {
             this->lightUniforms.PushBack(LightIndexUniformNames(i));
         }
+
+        this->uniformNames[RendererUniform_PVMMatrix]             = InternString("PVMMatrix");
+        this->uniformNames[RendererUniform_ModelMatrix]           = InternString("ModelMatrix");
+        this->uniformNames[RendererUniform_ViewModelMatrix]       = InternString("ViewModelMatrix");
+        this->uniformNames[RendererUniform_NormalMatrix]          = InternString("NormalMatrix");
+        this->uniformNames[RendererUniform_DiffuseLighting]       = InternString("DiffuseLighting");
+        this->uniformNames[RendererUniform_SpecularLighting]      = InternString("SpecularLighting");
+        this->uniformNames[RendererUniform_BackgroundTexture]     = InternString("BackgroundTexture");
+        this->uniformNames[RendererUniform_ColourBuffer]          = InternString("ColourBuffer");
+        this->uniformNames[RendererUniform_LuminanceBuffer]       = InternString("LuminanceBuffer");
+        this->uniformNames[RendererUniform_BloomBuffer]           = InternString("BloomBuffer");
+        this->uniformNames[RendererUniform_BloomFactor]           = InternString("BloomFactor");
+        this->uniformNames[RendererUniform_Texture]               = InternString("Texture");
+        this->uniformNames[RendererUniform_TextureSizeReciprocal] = InternString("TextureSizeReciprocal");
     } 
 
-    const char* DefaultSceneRenderer_MaterialUniformNameCache::GetLightUniformName(MaterialUniformNameID nameID, int index)
+    StringID DefaultSceneRenderer_MaterialUniformNameCache::GetLightUniformName(MaterialUniformNameID nameID, int index)
     {
         // Need to keep allocating until we have the index.
-        if (index > static_cast<int>(lightUniforms.count))
+        if (index >= static_cast<int>(lightUniforms.count))
         {
-            for (int i = static_cast<int>(lightUniforms.count); i < index; ++i)
+            for (int i = static_cast<int>(lightUniforms.count); i <= index; ++i)
             {
                 this->lightUniforms.PushBack(LightIndexUniformNames(i));
             }
         }
 
-        return this->lightUniforms[index].names[nameID].c_str();
+        return this->lightUniforms[index].names[nameID];
     }
 }
\ No newline at end of file
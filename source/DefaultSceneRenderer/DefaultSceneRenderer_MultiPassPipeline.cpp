@@ -3,6 +3,7 @@
 #include <GTGE/DefaultSceneRenderer/DefaultSceneRenderer.hpp>
 #include <GTGE/DefaultSceneRenderer/DefaultSceneRenderer_MultiPassPipeline.hpp>
 #include <GTGE/DefaultSceneRenderer/DefaultSceneRenderer_VisibilityProcessor.hpp>
+#include <GTGE/Profiler.hpp>
 
 namespace GT
 {
@@ -28,6 +29,8 @@ namespace GT
 
     void DefaultSceneRenderer_MultiPassPipeline::Execute()
     {
+        GT_PROFILE_ZONE("DefaultSceneRenderer_MultiPassPipeline::Execute");
+
         // Clear.
         if (this->visibleObjects.opaqueObjects.count     > 0 || this->visibleObjects.transparentObjects.count     > 0 ||
             this->visibleObjects.opaqueObjectsLast.count > 0 || this->visibleObjects.transparentObjectsLast.count > 0)
@@ -76,6 +79,8 @@ namespace GT
 
     void DefaultSceneRenderer_MultiPassPipeline::OpaquePass()
     {
+        GT_PROFILE_ZONE("DefaultSceneRenderer_MultiPassPipeline::OpaquePass");
+
         if (this->opaqueObjects != nullptr && this->opaqueObjects->count > 0)
         {
             // We'll do a depth pre-pass because since the scene is complex enough to use the multi-pass pipeline, it's probably complex
@@ -124,6 +129,8 @@ namespace GT
 
     void DefaultSceneRenderer_MultiPassPipeline::TransparentPass()
     {
+        GT_PROFILE_ZONE("DefaultSceneRenderer_MultiPassPipeline::TransparentPass");
+
         struct SortedMesh
         {
             float distanceToCamera;
@@ -256,6 +263,8 @@ namespace GT
 
     void DefaultSceneRenderer_MultiPassPipeline::DepthPass()
     {
+        GT_PROFILE_ZONE("DefaultSceneRenderer_MultiPassPipeline::DepthPass");
+
         assert(this->opaqueObjects != nullptr);
 
 
@@ -278,7 +287,7 @@ namespace GT
                                 {
                                     // Shader setup.
                                     Renderer::SetCurrentShader(shader);
-                                    shader->SetUniform("PVMMatrix", this->visibleObjects.projectionViewMatrix * mesh.transform);
+                                    shader->SetUniform(this->renderer.GetMaterialUniformNameCache().GetUniformName(RendererUniform_PVMMatrix), this->visibleObjects.projectionViewMatrix * mesh.transform);
                                     Renderer::PushPendingUniforms(*shader);
 
 
@@ -304,6 +313,8 @@ namespace GT
 
     void DefaultSceneRenderer_MultiPassPipeline::OpaqueLightingPass()
     {
+        GT_PROFILE_ZONE("DefaultSceneRenderer_MultiPassPipeline::OpaqueLightingPass");
+
         if (this->visibleObjects.lightManager.GetTotalLightCount() > 0)
         {
             // If we're not splitting the shadow-casting lights (i.e. grouping them all together with non-shadow-casting lights) we will
@@ -541,6 +552,8 @@ namespace GT
 
     void DefaultSceneRenderer_MultiPassPipeline::OpaqueMaterialPass()
     {
+        GT_PROFILE_ZONE("DefaultSceneRenderer_MultiPassPipeline::OpaqueMaterialPass");
+
         // We can assert that the current framebuffer will be the main one. All we need to do is change the draw buffer.
         int outputBuffer[] = {ColourBuffer0Index};
         Renderer::SetDrawBuffers(1, outputBuffer);
@@ -821,20 +834,20 @@ namespace GT
                     shader->SetUniform(this->renderer.GetMaterialUniformNameCache().GetLightUniformName(MaterialUniforms_ShadowSpotLightFS_ShadowMap, 0), this->renderer.GetSpotShadowMapByIndex(0));
                 }
 
-                shader->SetUniform("ModelMatrix",       mesh.transform);
-                shader->SetUniform("ViewModelMatrix",   viewModelMatrix);
-                shader->SetUniform("NormalMatrix",      normalMatrix);
-                shader->SetUniform("PVMMatrix",         visibleObjects.projectionViewMatrix * mesh.transform);
+                shader->SetUniform(this->renderer.GetMaterialUniformNameCache().GetUniformName(RendererUniform_ModelMatrix),       mesh.transform);
+                shader->SetUniform(this->renderer.GetMaterialUniformNameCache().GetUniformName(RendererUniform_ViewModelMatrix),   viewModelMatrix);
+                shader->SetUniform(this->renderer.GetMaterialUniformNameCache().GetUniformName(RendererUniform_NormalMatrix),      normalMatrix);
+                shader->SetUniform(this->renderer.GetMaterialUniformNameCache().GetUniformName(RendererUniform_PVMMatrix),         visibleObjects.projectionViewMatrix * mesh.transform);
 
                 if ((shaderFlags & DefaultSceneRenderer_MaterialShaderID::GetLightingFromTextures))
                 {
-                    shader->SetUniform("DiffuseLighting",  this->viewportFramebuffer.lightingBuffer0);
-                    shader->SetUniform("SpecularLighting", this->viewportFramebuffer.lightingBuffer1);
+                    shader->SetUniform(this->renderer.GetMaterialUniformNameCache().GetUniformName(RendererUniform_DiffuseLighting),  this->viewportFramebuffer.lightingBuffer0);
+                    shader->SetUniform(this->renderer.GetMaterialUniformNameCache().GetUniformName(RendererUniform_SpecularLighting), this->viewportFramebuffer.lightingBuffer1);
                 }
 
                 if (mesh.material->IsRefractive())
                 {
-                    shader->SetUniform("BackgroundTexture", this->viewportFramebuffer.colourBuffer1);
+                    shader->SetUniform(this->renderer.GetMaterialUniformNameCache().GetUniformName(RendererUniform_BackgroundTexture), this->viewportFramebuffer.colourBuffer1);
                 }
 
 
@@ -896,7 +909,7 @@ namespace GT
             assert(highlightShader != nullptr);
             {
                 Renderer::SetCurrentShader(highlightShader);
-                highlightShader->SetUniform("PVMMatrix", visibleObjects.projectionViewMatrix * mesh.transform);
+                highlightShader->SetUniform(this->renderer.GetMaterialUniformNameCache().GetUniformName(RendererUniform_PVMMatrix), visibleObjects.projectionViewMatrix * mesh.transform);
                 Renderer::PushPendingUniforms(*highlightShader);
 
 
@@ -917,7 +930,7 @@ namespace GT
         assert(shader != nullptr);
         {
             Renderer::SetCurrentShader(shader);
-            shader->SetUniform("ColourBuffer", this->viewportFramebuffer.colourBuffer0);
+            shader->SetUniform(this->renderer.GetMaterialUniformNameCache().GetUniformName(RendererUniform_ColourBuffer), this->viewportFramebuffer.colourBuffer0);
             Renderer::PushPendingUniforms(*shader);
         }
 
@@ -2,13 +2,282 @@
 
 #include <GTGE/DefaultSceneRenderer/DefaultSceneRenderer_VisibilityProcessor.hpp>
 #include <GTGE/Scene.hpp>
+#include <GTGE/Profiler.hpp>
 
 namespace GT
 {
     static const glm::vec3 HighlightColour      = glm::vec3(1.0f, 0.66f, 0.33f);
     static const glm::vec3 ChildHighlightColour = glm::vec3(1.0f, 0.8f, 0.6f);
 
-    DefaultSceneRenderer_VisibilityProcessor::DefaultSceneRenderer_VisibilityProcessor(Scene &sceneIn, SceneViewport &viewportIn)
+
+    /// The maximum number of particles processed by a single particle quad job.
+    static const size_t DefaultSceneRenderer_ParticleQuadJobSize = 256;
+
+    /// Structure representing an emitter whose vertex array is mapped while it's quads are generated.
+    struct DefaultSceneRenderer_ParticleQuadEmitter
+    {
+        /// The emitter.
+        const ParticleEmitter* emitter;
+
+        /// The lights touching the particle system that owns the emitter.
+        const DefaultSceneRenderer_LightGroup* lights;
+
+        /// The mapped vertex data.
+        float* vertices;
+
+        /// The mapped index data. This is null if the indices don't need to be generated.
+        unsigned int* indices;
+    };
+
+    /// Structure representing a range of particles in an emitter whose quads are generated by a single job.
+    struct DefaultSceneRenderer_ParticleQuadJob
+    {
+        /// The emitter that owns the particles.
+        const ParticleEmitter* emitter;
+
+        /// The start of the emitter's mapped vertex data. This is the start of the whole buffer, not the job's slice of it.
+        float* vertices;
+
+        /// The start of the emitter's mapped index data, or null if the indices don't need to be generated.
+        unsigned int* indices;
+
+        /// The size of a vertex, in floats.
+        size_t vertexSize;
+
+        /// The index of the first particle in the range.
+        size_t firstParticle;
+
+        /// The index of the particle one past the end of the range.
+        size_t endParticle;
+    };
+
+    /// Structure containing every particle quad job for a frame.
+    struct DefaultSceneRenderer_ParticleQuadBatch
+    {
+        /// The inverse of the view orientation so that the quads face the camera.
+        glm::quat inverseView;
+
+        /// The jobs.
+        Vector<DefaultSceneRenderer_ParticleQuadJob> jobs;
+    };
+
+    /// ThreadPoolJobProc for generating the quads of a range of particles.
+    ///
+    /// Each particle always writes to the same 4 vertices and 6 indices based on it's index, so jobs never overlap.
+    static void DefaultSceneRenderer_GenerateParticleQuads(size_t jobIndex, size_t threadIndex, void* pUserData)
+    {
+        (void)threadIndex;
+
+        GT_PROFILE_ZONE("DefaultSceneRenderer_GenerateParticleQuads");
+
+        auto batch = reinterpret_cast<const DefaultSceneRenderer_ParticleQuadBatch*>(pUserData);
+        assert(batch != nullptr);
+
+        auto &job       = batch->jobs[jobIndex];
+        auto &particles = job.emitter->GetParticles();
+
+        size_t vertexSize = job.vertexSize;
+        auto   vertices   = job.vertices;
+        auto   indices    = job.indices;
+
+        for (size_t iParticle = job.firstParticle; iParticle < job.endParticle; ++iParticle)
+        {
+            // Vertices.
+            auto vertex0 = vertices + (iParticle * 4 * vertexSize);
+            auto vertex1 = vertex0 + vertexSize;
+            auto vertex2 = vertex1 + vertexSize;
+            auto vertex3 = vertex2 + vertexSize;
+
+            const glm::vec4 &scale           = particles.scales[iParticle];
+            const glm::vec4 &texCoordBounds0 = particles.texCoordBounds0[iParticle];
+            const glm::vec4 &texCoordBounds1 = particles.texCoordBounds1[iParticle];
+            const glm::vec4 &colour          = particles.colours[iParticle];
+
+            glm::quat absoluteOrientation = batch->inverseView * particles.orientations[iParticle];
+
+
+            glm::mat4 transform = glm::mat4_cast(absoluteOrientation);
+            transform[0] *= scale.x;
+            transform[1] *= scale.y;
+            transform[2] *= scale.z;
+            transform[3]  = particles.positions[iParticle];
+
+            glm::vec4 position0 = transform * glm::vec4(-0.5f, -0.5f, 0.0f, 1.0f);
+            glm::vec4 position1 = transform * glm::vec4( 0.5f, -0.5f, 0.0f, 1.0f);
+            glm::vec4 position2 = transform * glm::vec4( 0.5f,  0.5f, 0.0f, 1.0f);
+            glm::vec4 position3 = transform * glm::vec4(-0.5f,  0.5f, 0.0f, 1.0f);
+
+            glm::vec4 texcoord0     = glm::vec4(texCoordBounds0.x, texCoordBounds0.y, texCoordBounds1.x, texCoordBounds1.y);
+            glm::vec4 texcoord1     = glm::vec4(texCoordBounds0.z, texCoordBounds0.y, texCoordBounds1.z, texCoordBounds1.y);
+            glm::vec4 texcoord2     = glm::vec4(texCoordBounds0.z, texCoordBounds0.w, texCoordBounds1.z, texCoordBounds1.w);
+            glm::vec4 texcoord3     = glm::vec4(texCoordBounds0.x, texCoordBounds0.w, texCoordBounds1.x, texCoordBounds1.w);
+
+            glm::vec4 normal    = absoluteOrientation * glm::vec4(0.0f, 0.0f, 1.0f, 0.0f); normal.w = particles.uvTileInterpolationFactors[iParticle];
+
+            vertex0[0]  = position0.x; vertex0[1]  = position0.y; vertex0[2]  = position0.z; vertex0[3]  = 1.0f;
+            vertex0[4]  = texcoord0.x; vertex0[5]  = texcoord0.y; vertex0[6]  = texcoord0.z; vertex0[7]  = texcoord0.w;
+            vertex0[8]  = normal.x;    vertex0[9]  = normal.y;    vertex0[10] = normal.z;    vertex0[11] = normal.w;
+            vertex0[12] = colour.x;    vertex0[13] = colour.y;    vertex0[14] = colour.z;    vertex0[15] = colour.w;
+
+            vertex1[0]  = position1.x; vertex1[1]  = position1.y; vertex1[2]  = position1.z; vertex1[3]  = 1.1f;
+            vertex1[4]  = texcoord1.x; vertex1[5]  = texcoord1.y; vertex1[6]  = texcoord1.z; vertex1[7]  = texcoord1.w;
+            vertex1[8]  = normal.x;    vertex1[9]  = normal.y;    vertex1[10] = normal.z;    vertex1[11] = normal.w;
+            vertex1[12] = colour.x;    vertex1[13] = colour.y;    vertex1[14] = colour.z;    vertex1[15] = colour.w;
+
+            vertex2[0]  = position2.x; vertex2[1]  = position2.y; vertex2[2]  = position2.z; vertex2[3]  = 1.2f;
+            vertex2[4]  = texcoord2.x; vertex2[5]  = texcoord2.y; vertex2[6]  = texcoord2.z; vertex2[7]  = texcoord2.w;
+            vertex2[8]  = normal.x;    vertex2[9]  = normal.y;    vertex2[10] = normal.z;    vertex2[11] = normal.w;
+            vertex2[12] = colour.x;    vertex2[13] = colour.y;    vertex2[14] = colour.z;    vertex2[15] = colour.w;
+
+            vertex3[0]  = position3.x; vertex3[1]  = position3.y; vertex3[2]  = position3.z; vertex3[3]  = 1.3f;
+            vertex3[4]  = texcoord3.x; vertex3[5]  = texcoord3.y; vertex3[6]  = texcoord3.z; vertex3[7]  = texcoord3.w;
+            vertex3[8]  = normal.x;    vertex3[9]  = normal.y;    vertex3[10] = normal.z;    vertex3[11] = normal.w;
+            vertex3[12] = colour.x;    vertex3[13] = colour.y;    vertex3[14] = colour.z;    vertex3[15] = colour.w;
+
+
+            // Indices.
+            if (indices != nullptr)
+            {
+                unsigned int firstVertex = static_cast<unsigned int>(iParticle * 4);
+
+                indices[(iParticle * 6) + 0] = firstVertex + 0;
+                indices[(iParticle * 6) + 1] = firstVertex + 1;
+                indices[(iParticle * 6) + 2] = firstVertex + 2;
+                indices[(iParticle * 6) + 3] = firstVertex + 2;
+                indices[(iParticle * 6) + 4] = firstVertex + 3;
+                indices[(iParticle * 6) + 5] = firstVertex + 0;
+            }
+        }
+    }
+
+
+    /// The number of lights whose contacts are queried by a single job.
+    static const size_t DefaultSceneRenderer_LightContactJobSize = 8;
+
+    /// Structure representing a model or particle system touching a light, as recorded by a parallel light contact query.
+    struct DefaultSceneRenderer_LightContact
+    {
+        /// The index of the light. Point lights come first, followed by spot lights.
+        uint32_t lightIndex;
+
+        /// The light group of the model or particle system touching the light.
+        DefaultSceneRenderer_LightGroup* lightGroup;
+    };
+
+    /// Visibility callback that records the contacts of a single light into a buffer rather than adding them to the light groups.
+    class DefaultSceneRenderer_LightContactRecorder : public SceneCullingManager::VisibilityCallback
+    {
+    public:
+
+        /// Constructor.
+        DefaultSceneRenderer_LightContactRecorder(const DefaultSceneRenderer_VisibilityProcessor &ownerIn, uint32_t lightIndexIn, Vector<DefaultSceneRenderer_LightContact> &contactsIn)
+            : owner(ownerIn), lightIndex(lightIndexIn), contacts(contactsIn)
+        {
+        }
+
+
+        /// SceneCullingManager::VisibilityCallback::ProcessModel().
+        void ProcessModel(const SceneNode &sceneNode)
+        {
+            auto iModel = this->owner.visibleModels.Find(sceneNode.GetComponent<ModelComponent>());
+            if (iModel != nullptr)
+            {
+                DefaultSceneRenderer_LightContact contact;
+                contact.lightIndex = this->lightIndex;
+                contact.lightGroup = iModel->value;
+                this->contacts.PushBack(contact);
+            }
+        }
+
+        /// SceneCullingManager::VisibilityCallback::ProcessParticleSystem().
+        void ProcessParticleSystem(const SceneNode &sceneNode)
+        {
+            auto iParticleSystem = this->owner.visibleParticleSystems.Find(sceneNode.GetComponent<ParticleSystemComponent>());
+            if (iParticleSystem != nullptr)
+            {
+                DefaultSceneRenderer_LightContact contact;
+                contact.lightIndex = this->lightIndex;
+                contact.lightGroup = iParticleSystem->value;
+                this->contacts.PushBack(contact);
+            }
+        }
+
+
+    private:
+
+        /// The visibility processor whose models and particle systems are being looked up. This is only read from.
+        const DefaultSceneRenderer_VisibilityProcessor &owner;
+
+        /// The index of the light being queried.
+        uint32_t lightIndex;
+
+        /// The buffer to record the contacts into.
+        Vector<DefaultSceneRenderer_LightContact> &contacts;
+
+
+    private:    // No copying.
+        DefaultSceneRenderer_LightContactRecorder(const DefaultSceneRenderer_LightContactRecorder &);
+        DefaultSceneRenderer_LightContactRecorder & operator=(const DefaultSceneRenderer_LightContactRecorder &);
+    };
+
+    /// Structure containing everything the light contact jobs need.
+    struct DefaultSceneRenderer_LightContactBatch
+    {
+        /// The visibility processor whose lights are being queried.
+        const DefaultSceneRenderer_VisibilityProcessor* owner;
+
+        /// The culling manager to query.
+        const SceneCullingManager* cullingManager;
+
+        /// The number of point lights. Light indices from this point are spot lights.
+        size_t pointLightCount;
+
+        /// The total number of lights.
+        size_t lightCount;
+
+        /// The contact buffer of each thread, indexed by the thread index.
+        Vector<DefaultSceneRenderer_LightContact>* threadContacts;
+    };
+
+    /// ThreadPoolJobProc for querying the contacts of a range of lights.
+    static void DefaultSceneRenderer_QueryLightContacts(size_t jobIndex, size_t threadIndex, void* pUserData)
+    {
+        GT_PROFILE_ZONE("DefaultSceneRenderer_QueryLightContacts");
+
+        auto batch = reinterpret_cast<const DefaultSceneRenderer_LightContactBatch*>(pUserData);
+        assert(batch != nullptr);
+
+        auto &lightManager = batch->owner->lightManager;
+        auto &contacts     = batch->threadContacts[threadIndex];
+
+        size_t firstLight = jobIndex * DefaultSceneRenderer_LightContactJobSize;
+        size_t endLight   = Min(firstLight + DefaultSceneRenderer_LightContactJobSize, batch->lightCount);
+
+        for (size_t iLight = firstLight; iLight < endLight; ++iLight)
+        {
+            DefaultSceneRenderer_LightContactRecorder recorder(*batch->owner, static_cast<uint32_t>(iLight), contacts);
+
+            if (iLight < batch->pointLightCount)
+            {
+                auto lightComponent = lightManager.pointLights.buffer[iLight]->key;
+                assert(lightComponent != nullptr);
+                {
+                    batch->cullingManager->QueryPointLightContactsConcurrent(lightComponent->GetNode(), recorder);
+                }
+            }
+            else
+            {
+                auto lightComponent = lightManager.spotLights.buffer[iLight - batch->pointLightCount]->key;
+                assert(lightComponent != nullptr);
+                {
+                    batch->cullingManager->QuerySpotLightContactsConcurrent(lightComponent->GetNode(), recorder);
+                }
+            }
+        }
+    }
+
+
+    DefaultSceneRenderer_VisibilityProcessor::DefaultSceneRenderer_VisibilityProcessor(Scene &sceneIn, SceneViewport &viewportIn, FrameAllocator &frameAllocatorIn, Vector<Vector<DefaultSceneRendererMesh>*> &meshListPoolIn)
         : scene(sceneIn),
           opaqueObjects(), transparentObjects(), opaqueObjectsLast(), transparentObjectsLast(),
           lightManager(),
@@ -16,7 +285,9 @@ namespace GT
           visibleModels(), modelsToAnimate(),
           visibleParticleSystems(),
           allLights(),
-          projectionMatrix(), viewMatrix(), projectionViewMatrix()
+          projectionMatrix(), viewMatrix(), projectionViewMatrix(),
+          reuseParticleIndices(true), parallelLightContacts(true),
+          frameAllocator(frameAllocatorIn), meshListPool(meshListPoolIn)
     {
         auto cameraNode = viewportIn.GetCameraNode();
         if (cameraNode != nullptr)
@@ -33,32 +304,18 @@ namespace GT
 
     DefaultSceneRenderer_VisibilityProcessor::~DefaultSceneRenderer_VisibilityProcessor()
     {
+        // The mesh lists go back to the pool with their buffers intact. Everything else lives in the frame allocator and is released
+        // when the renderer resets it.
         for (size_t i = 0; i < this->opaqueObjects.count; ++i)
         {
-            delete this->opaqueObjects.buffer[i]->value;
+            this->opaqueObjects.buffer[i]->value->Clear();
+            this->meshListPool.PushBack(this->opaqueObjects.buffer[i]->value);
         }
 
         for (size_t i = 0; i < this->opaqueObjectsLast.count; ++i)
         {
-            delete this->opaqueObjectsLast.buffer[i]->value;
-        }
-
-
-
-        for (size_t i = 0; i < this->visibleMeshes.count; ++i)
-        {
-            delete this->visibleMeshes.buffer[i]->value;
-        }
-
-
-        for (size_t i = 0; i < this->visibleModels.count; ++i)
-        {
-            delete this->visibleModels.buffer[i]->value;
-        }
-
-        for (size_t i = 0; i < this->visibleParticleSystems.count; ++i)
-        {
-            delete this->visibleParticleSystems.buffer[i]->value;
+            this->opaqueObjectsLast.buffer[i]->value->Clear();
+            this->meshListPool.PushBack(this->opaqueObjectsLast.buffer[i]->value);
         }
     }
 
@@ -73,12 +330,15 @@ namespace GT
                 auto model = modelComponent->GetModel();
                 if (model != nullptr)
                 {
-                    this->visibleModels.Add(modelComponent, new DefaultSceneRenderer_LightGroup);
+                    this->visibleModels.Add(modelComponent, this->frameAllocator.New<DefaultSceneRenderer_LightGroup>());
 
                     // If the model is animated, we don't want to mark it as such, but not actually apply the animation yet.
                     if (model->IsAnimating() && !model->IsAnimationPaused())
                     {
                         this->modelsToAnimate.PushBack(modelComponent);
+
+                        // The update manager uses this next frame to decide how often the animation needs to be evaluated.
+                        model->MarkAsSeen(glm::length(glm::vec3(this->viewMatrix * glm::vec4(sceneNode.GetWorldPosition(), 1.0f))));
                     }
 
 
@@ -87,7 +347,7 @@ namespace GT
                         auto mesh = model->meshes[iMesh];
                         assert(mesh != nullptr);
                         {
-                            this->visibleMeshes.Add(mesh, new DefaultSceneRendererMesh);
+                            this->visibleMeshes.Add(mesh, this->frameAllocator.New<DefaultSceneRendererMesh>());
                         }
                     }
                 }
@@ -138,7 +398,7 @@ namespace GT
         {
             if (!this->visibleParticleSystems.Exists(particleSystemComponent))
             {
-                this->visibleParticleSystems.Add(particleSystemComponent, new DefaultSceneRenderer_LightGroup);
+                this->visibleParticleSystems.Add(particleSystemComponent, this->frameAllocator.New<DefaultSceneRenderer_LightGroup>());
             }
         }
     }
@@ -196,7 +456,7 @@ namespace GT
                         }
                         else
                         {
-                            objectList = new Vector<DefaultSceneRendererMesh>(100);
+                            objectList = this->AcquireMeshList();
                             this->opaqueObjects.Add(&materialDefinition, objectList);
                         }
                     }
@@ -209,7 +469,7 @@ namespace GT
                         }
                         else
                         {
-                            objectList = new Vector<DefaultSceneRendererMesh>(100);
+                            objectList = this->AcquireMeshList();
                             this->opaqueObjectsLast.Add(&materialDefinition, objectList);
                         }
                     }
@@ -223,39 +483,38 @@ namespace GT
         }
     }
 
-    void DefaultSceneRenderer_VisibilityProcessor::PostProcess()
+    size_t DefaultSceneRenderer_VisibilityProcessor::GetMeshCount() const
     {
-        // We need to now query the objects contained inside the volumes of the point and spot lights.
-        const auto &cullingManager = scene.GetCullingManager();
+        size_t meshCount = this->transparentObjects.count + this->transparentObjectsLast.count;
+
+        for (size_t i = 0; i < this->opaqueObjects.count; ++i)
         {
-            // Point Lights.
-            for (size_t iPointLight = 0; iPointLight < this->lightManager.pointLights.count; ++iPointLight)
-            {
-                auto lightComponent = this->lightManager.pointLights.buffer[iPointLight]->key;
-                auto light          = this->lightManager.pointLights.buffer[iPointLight]->value;
+            meshCount += this->opaqueObjects.buffer[i]->value->count;
+        }
 
-                assert(lightComponent != nullptr);
-                assert(light          != nullptr);
-                {
-                    PointLightContactsCallback callback(*this, iPointLight, light->IsShadowCasting());
-                    cullingManager.QueryPointLightContacts(lightComponent->GetNode(), callback);
-                }
-            }
+        for (size_t i = 0; i < this->opaqueObjectsLast.count; ++i)
+        {
+            meshCount += this->opaqueObjectsLast.buffer[i]->value->count;
+        }
 
+        return meshCount;
+    }
 
-            // Spot Lights.
-            for (size_t iSpotLight = 0; iSpotLight < this->lightManager.spotLights.count; ++iSpotLight)
-            {
-                auto lightComponent = this->lightManager.spotLights.buffer[iSpotLight]->key;
-                auto light          = this->lightManager.spotLights.buffer[iSpotLight]->value;
+    void DefaultSceneRenderer_VisibilityProcessor::PostProcess()
+    {
+        GT_PROFILE_ZONE("DefaultSceneRenderer_VisibilityProcessor::PostProcess");
 
-                assert(lightComponent != nullptr);
-                assert(light          != nullptr);
-                {
-                    SpotLightContactsCallback callback(*this, iSpotLight, light->IsShadowCasting());
-                    cullingManager.QuerySpotLightContacts(lightComponent->GetNode(), callback);
-                }
-            }
+        // We need to now query the objects contained inside the volumes of the point and spot lights. Each light is an independent
+        // query, so with lots of lights it's worth spreading them across threads if the culling manager allows it.
+        size_t lightCount = this->lightManager.pointLights.count + this->lightManager.spotLights.count;
+        if (this->parallelLightContacts && lightCount > DefaultSceneRenderer_LightContactJobSize &&
+            this->scene.GetCullingManager().IsLightContactQueryThreadSafe() && this->scene.GetContext().GetThreadPool().GetWorkerThreadCount() > 0)
+        {
+            this->QueryLightContactsParallel();
+        }
+        else
+        {
+            this->QueryLightContactsSerial();
         }
 
 
@@ -263,7 +522,7 @@ namespace GT
         // spot lights need to be determined by the scene.
         for (size_t iModel = 0; iModel < this->visibleModels.count; ++iModel)
         {
-            auto modelLights = this->visibleModels.buffer[iModel]->value;
+            auto modelLights = this->visibleModels.buffer[iModel].value;
             assert(modelLights != nullptr);
             {
                 for (size_t iAmbientLight = 0; iAmbientLight < this->lightManager.ambientLights.count; ++iAmbientLight)
@@ -294,7 +553,7 @@ namespace GT
         // As above, but now with particle systems.
         for (size_t iParticleSystem = 0; iParticleSystem < this->visibleParticleSystems.count; ++iParticleSystem)
         {
-            auto particleSystemLights = this->visibleParticleSystems.buffer[iParticleSystem]->value;
+            auto particleSystemLights = this->visibleParticleSystems.buffer[iParticleSystem].value;
             assert(particleSystemLights != nullptr);
             {
                 for (size_t iAmbientLight = 0; iAmbientLight < this->lightManager.ambientLights.count; ++iAmbientLight)
@@ -330,8 +589,8 @@ namespace GT
         // We now need to create the mesh objects that will be drawn. These are created from the model components.
         for (size_t iModel = 0; iModel < this->visibleModels.count; ++iModel)
         {
-            auto modelComponent = this->visibleModels.buffer[iModel]->key;
-            auto modelLights    = this->visibleModels.buffer[iModel]->value;
+            auto modelComponent = this->visibleModels.buffer[iModel].key;
+            auto modelLights    = this->visibleModels.buffer[iModel].value;
 
             assert(modelComponent != nullptr);
             assert(modelLights    != nullptr);
@@ -383,13 +642,18 @@ namespace GT
 
 
 
-        // Now we need to build the mesh to draw for each particle system.
-        glm::quat inverseView = glm::quat(glm::inverse(glm::quat_cast(this->viewMatrix)));
+        // Now we need to build the mesh to draw for each particle system. This is done in three stages. First we allocate and map the vertex
+        // array of every emitter and split it's particles up into jobs. The jobs are then run in parallel, with each one writing into it's
+        // own slice of an emitter's vertex array. Finally, the vertex arrays are unmapped and the meshes added.
+        DefaultSceneRenderer_ParticleQuadBatch particleQuadBatch;
+        particleQuadBatch.inverseView = glm::quat(glm::inverse(glm::quat_cast(this->viewMatrix)));
+
+        Vector<DefaultSceneRenderer_ParticleQuadEmitter> particleQuadEmitters;
 
         for (size_t iParticleSystem = 0; iParticleSystem < this->visibleParticleSystems.count; ++iParticleSystem)
         {
-            auto particleSystemComponent = this->visibleParticleSystems.buffer[iParticleSystem]->key;
-            auto particleSystemLights    = this->visibleParticleSystems.buffer[iParticleSystem]->value;
+            auto particleSystemComponent = this->visibleParticleSystems.buffer[iParticleSystem].key;
+            auto particleSystemLights    = this->visibleParticleSystems.buffer[iParticleSystem].value;
 
             assert(particleSystemComponent != nullptr);
             assert(particleSystemLights    != nullptr);
@@ -409,104 +673,48 @@ namespace GT
                                 if (particleCount > 0)
                                 {
                                     // Pre-allocate.
-                                    vertexArray.SetVertexData(nullptr, particleCount * 4);
-                                    vertexArray.SetIndexData( nullptr, particleCount * 6);
+                                    vertexArray.SetVertexData(nullptr, static_cast<unsigned int>(particleCount * 4));
+
+                                    // The indices are always the same quad pattern, so if the index buffer already has enough of them we
+                                    // can leave it alone. SetIndexData() only keeps the existing contents if it doesn't need to reallocate,
+                                    // which it won't do when the buffer is at least as big as we need, but no more than double.
+                                    unsigned int indexCount           = static_cast<unsigned int>(particleCount * 6);
+                                    bool         needsIndexGeneration = true;
+
+                                    if (this->reuseParticleIndices && vertexArray.GetIndexCount() >= indexCount && vertexArray.GetIndexBufferSize() <= indexCount * 2)
+                                    {
+                                        needsIndexGeneration = false;
+                                    }
+
+                                    if (vertexArray.GetIndexCount() != indexCount || needsIndexGeneration)
+                                    {
+                                        vertexArray.SetIndexData(nullptr, indexCount);
+                                    }
+
 
+                                    DefaultSceneRenderer_ParticleQuadEmitter quadEmitter;
+                                    quadEmitter.emitter  = emitter;
+                                    quadEmitter.lights   = particleSystemLights;
+                                    quadEmitter.vertices = vertexArray.MapVertexData();
+                                    quadEmitter.indices  = (needsIndexGeneration) ? vertexArray.MapIndexData() : nullptr;
 
-                                    // Build the data.
-                                    auto vertices = vertexArray.MapVertexData();
-                                    auto indices  = vertexArray.MapIndexData();
-                                
-                                    assert(vertices != nullptr);
-                                    assert(indices  != nullptr);
+                                    assert(quadEmitter.vertices != nullptr);
+                                    assert(quadEmitter.indices  != nullptr || !needsIndexGeneration);
                                     {
-                                        for (size_t iParticle = 0; iParticle < particleCount; ++iParticle)
+                                        particleQuadEmitters.PushBack(quadEmitter);
+
+                                        for (size_t firstParticle = 0; firstParticle < particleCount; firstParticle += DefaultSceneRenderer_ParticleQuadJobSize)
                                         {
-                                            auto &particle = emitter->GetParticle(iParticle);
-                                            {
-                                                // Vertices.
-                                                size_t vertexSize = vertexArray.GetFormat().GetSize();
-
-                                                auto vertex0 = vertices + (iParticle * 4 * vertexSize);
-                                                auto vertex1 = vertex0 + vertexSize;
-                                                auto vertex2 = vertex1 + vertexSize;
-                                                auto vertex3 = vertex2 + vertexSize;
-
-                                                glm::quat absoluteOrientation = inverseView * particle.orientation;
-
-
-                                                glm::mat4 transform = glm::mat4_cast(absoluteOrientation);
-                                                transform[0] *= particle.scale.x;
-                                                transform[1] *= particle.scale.y;
-                                                transform[2] *= particle.scale.z;
-                                                transform[3]  = particle.position;
-
-                                                glm::vec4 position0 = transform * glm::vec4(-0.5f, -0.5f, 0.0f, 1.0f);
-                                                glm::vec4 position1 = transform * glm::vec4( 0.5f, -0.5f, 0.0f, 1.0f);
-                                                glm::vec4 position2 = transform * glm::vec4( 0.5f,  0.5f, 0.0f, 1.0f);
-                                                glm::vec4 position3 = transform * glm::vec4(-0.5f,  0.5f, 0.0f, 1.0f);
-
-                                                glm::vec4 texcoord0     = glm::vec4(particle.uTexCoordMin0, particle.vTexCoordMin0, particle.uTexCoordMin1, particle.vTexCoordMin1);
-                                                glm::vec4 texcoord1     = glm::vec4(particle.uTexCoordMax0, particle.vTexCoordMin0, particle.uTexCoordMax1, particle.vTexCoordMin1);
-                                                glm::vec4 texcoord2     = glm::vec4(particle.uTexCoordMax0, particle.vTexCoordMax0, particle.uTexCoordMax1, particle.vTexCoordMax1);
-                                                glm::vec4 texcoord3     = glm::vec4(particle.uTexCoordMin0, particle.vTexCoordMax0, particle.uTexCoordMin1, particle.vTexCoordMax1);
-
-                                                glm::vec4 normal0   = absoluteOrientation * glm::vec4(0.0f, 0.0f, 1.0f, 0.0f); normal0.w = particle.uvTileInterpolationFactor;
-                                                glm::vec4 normal1   = normal0;
-                                                glm::vec4 normal2   = normal0;
-                                                glm::vec4 normal3   = normal0;
-
-                                                glm::vec4 colour0   = particle.colour;
-                                                glm::vec4 colour1   = particle.colour;
-                                                glm::vec4 colour2   = particle.colour;
-                                                glm::vec4 colour3   = particle.colour;
-
-                                                vertex0[0]  = position0.x; vertex0[1]  = position0.y; vertex0[2]  = position0.z; vertex0[3]  = 1.0f;
-                                                vertex0[4]  = texcoord0.x; vertex0[5]  = texcoord0.y; vertex0[6]  = texcoord0.z; vertex0[7]  = texcoord0.w;
-                                                vertex0[8]  = normal0.x;   vertex0[9]  = normal0.y;   vertex0[10] = normal0.z;   vertex0[11] = normal0.w;
-                                                vertex0[12] = colour0.x;   vertex0[13] = colour0.y;   vertex0[14] = colour0.z;   vertex0[15] = colour0.w;
-
-                                                vertex1[0]  = position1.x; vertex1[1]  = position1.y; vertex1[2]  = position1.z; vertex1[3]  = 1.1f;
-                                                vertex1[4]  = texcoord1.x; vertex1[5]  = texcoord1.y; vertex1[6]  = texcoord1.z; vertex1[7]  = texcoord1.w;
-                                                vertex1[8]  = normal1.x;   vertex1[9]  = normal1.y;   vertex1[10] = normal1.z;   vertex1[11] = normal1.w;
-                                                vertex1[12] = colour1.x;   vertex1[13] = colour1.y;   vertex1[14] = colour1.z;   vertex1[15] = colour1.w;
-
-                                                vertex2[0]  = position2.x; vertex2[1]  = position2.y; vertex2[2]  = position2.z; vertex2[3]  = 1.2f;
-                                                vertex2[4]  = texcoord2.x; vertex2[5]  = texcoord2.y; vertex2[6]  = texcoord2.z; vertex2[7]  = texcoord2.w;
-                                                vertex2[8]  = normal2.x;   vertex2[9]  = normal2.y;   vertex2[10] = normal2.z;   vertex2[11] = normal2.w;
-                                                vertex2[12] = colour2.x;   vertex2[13] = colour2.y;   vertex2[14] = colour2.z;   vertex2[15] = colour2.w;
-
-                                                vertex3[0]  = position3.x; vertex3[1]  = position3.y; vertex3[2]  = position3.z; vertex3[3]  = 1.3f;
-                                                vertex3[4]  = texcoord3.x; vertex3[5]  = texcoord3.y; vertex3[6]  = texcoord3.z; vertex3[7]  = texcoord3.w;
-                                                vertex3[8]  = normal3.x;   vertex3[9]  = normal3.y;   vertex3[10] = normal3.z;   vertex3[11] = normal3.w;
-                                                vertex3[12] = colour3.x;   vertex3[13] = colour3.y;   vertex3[14] = colour3.z;   vertex3[15] = colour3.w;
-
-
-
-                                                // Indices.
-                                                indices[(iParticle * 6) + 0] = (iParticle * 4) + 0;
-                                                indices[(iParticle * 6) + 1] = (iParticle * 4) + 1;
-                                                indices[(iParticle * 6) + 2] = (iParticle * 4) + 2;
-                                                indices[(iParticle * 6) + 3] = (iParticle * 4) + 2;
-                                                indices[(iParticle * 6) + 4] = (iParticle * 4) + 3;
-                                                indices[(iParticle * 6) + 5] = (iParticle * 4) + 0;
-                                            }
+                                            DefaultSceneRenderer_ParticleQuadJob job;
+                                            job.emitter       = emitter;
+                                            job.vertices      = quadEmitter.vertices;
+                                            job.indices       = quadEmitter.indices;
+                                            job.vertexSize    = vertexArray.GetFormat().GetSize();
+                                            job.firstParticle = firstParticle;
+                                            job.endParticle   = Min(firstParticle + DefaultSceneRenderer_ParticleQuadJobSize, particleCount);
+                                            particleQuadBatch.jobs.PushBack(job);
                                         }
                                     }
-                                
-                                    vertexArray.UnmapVertexData();
-                                    vertexArray.UnmapIndexData();
-                                
-
-
-                                    DefaultSceneRendererMesh mesh;
-                                    mesh.vertexArray    = &vertexArray;
-                                    mesh.drawMode       = DrawMode_Triangles;
-                                    mesh.material       = emitter->GetMaterial();
-                                    mesh.transform      = glm::mat4();
-                                    mesh.touchingLights = particleSystemLights;
-                                    mesh.flags          = SceneRendererMesh::NoNormalMapping;   // No normal mapping on particles.
-                                    this->AddMesh(mesh);
                                 }
                             }
                         }
@@ -515,6 +723,30 @@ namespace GT
             }
         }
 
+        this->scene.GetContext().GetThreadPool().Run(particleQuadBatch.jobs.count, DefaultSceneRenderer_GenerateParticleQuads, &particleQuadBatch);
+
+        for (size_t iQuadEmitter = 0; iQuadEmitter < particleQuadEmitters.count; ++iQuadEmitter)
+        {
+            auto &quadEmitter = particleQuadEmitters[iQuadEmitter];
+            auto &vertexArray = quadEmitter.emitter->GetVertexArray();
+
+            vertexArray.UnmapVertexData();
+            if (quadEmitter.indices != nullptr)
+            {
+                vertexArray.UnmapIndexData();
+            }
+
+
+            DefaultSceneRendererMesh mesh;
+            mesh.vertexArray    = &vertexArray;
+            mesh.drawMode       = DrawMode_Triangles;
+            mesh.material       = quadEmitter.emitter->GetMaterial();
+            mesh.transform      = glm::mat4();
+            mesh.touchingLights = quadEmitter.lights;
+            mesh.flags          = SceneRendererMesh::NoNormalMapping;   // No normal mapping on particles.
+            this->AddMesh(mesh);
+        }
+
 
 
 
@@ -581,13 +813,15 @@ namespace GT
                 auto model = modelComponent->GetModel();
                 assert(model != nullptr);
                 {
+                    // This catches up the pose if the animation was only advanced while the model was out of view, and skips skinning if
+                    // the pose hasn't changed since the last time it was drawn.
+                    const_cast<Model*>(model)->ApplySkinning();
+
                     for (size_t iMesh = 0; iMesh < model->meshes.count; ++iMesh)
                     {
                         auto mesh = model->meshes[iMesh];
                         assert(mesh != nullptr);
                         {
-                            mesh->ApplySkinning();
-
                             // Now we now give the renderer the mesh so it can render it.
                             auto iModelLights = this->visibleModels.Find(modelComponent);
                             assert(iModelLights != nullptr);
@@ -618,4 +852,148 @@ namespace GT
             }
         }
     }
+
+
+
+    ///////////////////////////////////////////////////////
+    // Private
+
+    void DefaultSceneRenderer_VisibilityProcessor::QueryLightContactsSerial()
+    {
+        GT_PROFILE_ZONE("DefaultSceneRenderer_VisibilityProcessor::QueryLightContactsSerial");
+
+        const auto &cullingManager = scene.GetCullingManager();
+        {
+            // Point Lights.
+            for (size_t iPointLight = 0; iPointLight < this->lightManager.pointLights.count; ++iPointLight)
+            {
+                auto lightComponent = this->lightManager.pointLights.buffer[iPointLight]->key;
+                auto light          = this->lightManager.pointLights.buffer[iPointLight]->value;
+
+                assert(lightComponent != nullptr);
+                assert(light          != nullptr);
+                {
+                    PointLightContactsCallback callback(*this, iPointLight, light->IsShadowCasting());
+                    cullingManager.QueryPointLightContacts(lightComponent->GetNode(), callback);
+                }
+            }
+
+
+            // Spot Lights.
+            for (size_t iSpotLight = 0; iSpotLight < this->lightManager.spotLights.count; ++iSpotLight)
+            {
+                auto lightComponent = this->lightManager.spotLights.buffer[iSpotLight]->key;
+                auto light          = this->lightManager.spotLights.buffer[iSpotLight]->value;
+
+                assert(lightComponent != nullptr);
+                assert(light          != nullptr);
+                {
+                    SpotLightContactsCallback callback(*this, iSpotLight, light->IsShadowCasting());
+                    cullingManager.QuerySpotLightContacts(lightComponent->GetNode(), callback);
+                }
+            }
+        }
+    }
+
+    void DefaultSceneRenderer_VisibilityProcessor::QueryLightContactsParallel()
+    {
+        GT_PROFILE_ZONE("DefaultSceneRenderer_VisibilityProcessor::QueryLightContactsParallel");
+
+        auto &threadPool = this->scene.GetContext().GetThreadPool();
+
+        DefaultSceneRenderer_LightContactBatch batch;
+        batch.owner           = this;
+        batch.cullingManager  = &this->scene.GetCullingManager();
+        batch.pointLightCount = this->lightManager.pointLights.count;
+        batch.lightCount      = this->lightManager.pointLights.count + this->lightManager.spotLights.count;
+        batch.threadContacts  = new Vector<DefaultSceneRenderer_LightContact>[threadPool.GetThreadCount()];
+
+        size_t jobCount = (batch.lightCount + DefaultSceneRenderer_LightContactJobSize - 1) / DefaultSceneRenderer_LightContactJobSize;
+        threadPool.Run(jobCount, DefaultSceneRenderer_QueryLightContacts, &batch);
+
+
+        // The contacts are merged with a counting sort on the light index. All of the contacts of a light are recorded by the same job
+        // so they are already in the order the culling manager reported them. This makes the light groups come out the same as the
+        // serial path no matter how the jobs were distributed.
+        Vector<uint32_t> lightOffsets;
+        lightOffsets.Resize(batch.lightCount + 1);
+        for (size_t iLight = 0; iLight < lightOffsets.count; ++iLight)
+        {
+            lightOffsets[iLight] = 0;
+        }
+
+        for (size_t iThread = 0; iThread < threadPool.GetThreadCount(); ++iThread)
+        {
+            auto &contacts = batch.threadContacts[iThread];
+            for (size_t iContact = 0; iContact < contacts.count; ++iContact)
+            {
+                lightOffsets[contacts[iContact].lightIndex + 1] += 1;
+            }
+        }
+
+        for (size_t iLight = 1; iLight < lightOffsets.count; ++iLight)
+        {
+            lightOffsets[iLight] += lightOffsets[iLight - 1];
+        }
+
+        Vector<DefaultSceneRenderer_LightContact> sortedContacts;
+        sortedContacts.Resize(lightOffsets[batch.lightCount]);
+
+        for (size_t iThread = 0; iThread < threadPool.GetThreadCount(); ++iThread)
+        {
+            auto &contacts = batch.threadContacts[iThread];
+            for (size_t iContact = 0; iContact < contacts.count; ++iContact)
+            {
+                sortedContacts[lightOffsets[contacts[iContact].lightIndex]++] = contacts[iContact];
+            }
+        }
+
+        delete [] batch.threadContacts;
+
+
+        for (size_t iContact = 0; iContact < sortedContacts.count; ++iContact)
+        {
+            auto &contact = sortedContacts[iContact];
+            assert(contact.lightGroup != nullptr);
+
+            if (contact.lightIndex < batch.pointLightCount)
+            {
+                uint32_t iPointLight = contact.lightIndex;
+                if (!this->lightManager.pointLights.buffer[iPointLight]->value->IsShadowCasting())
+                {
+                    contact.lightGroup->AddPointLight(iPointLight);
+                }
+                else
+                {
+                    contact.lightGroup->AddShadowPointLight(iPointLight);
+                }
+            }
+            else
+            {
+                uint32_t iSpotLight = contact.lightIndex - static_cast<uint32_t>(batch.pointLightCount);
+                if (!this->lightManager.spotLights.buffer[iSpotLight]->value->IsShadowCasting())
+                {
+                    contact.lightGroup->AddSpotLight(iSpotLight);
+                }
+                else
+                {
+                    contact.lightGroup->AddShadowSpotLight(iSpotLight);
+                }
+            }
+        }
+    }
+
+
+    Vector<DefaultSceneRendererMesh>* DefaultSceneRenderer_VisibilityProcessor::AcquireMeshList()
+    {
+        if (this->meshListPool.count > 0)
+        {
+            auto meshList = this->meshListPool[this->meshListPool.count - 1];
+            this->meshListPool.PopBack();
+
+            return meshList;
+        }
+
+        return new Vector<DefaultSceneRendererMesh>(100);
+    }
 }
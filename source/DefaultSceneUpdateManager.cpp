@@ -4,11 +4,15 @@
 #include <GTGE/Scene.hpp>
 #include <GTGE/SceneNode.hpp>
 #include <GTGE/Scripting.hpp>
+#include <GTGE/Context.hpp>
+#include <GTGE/Profiler.hpp>
 
 namespace GT
 {
     DefaultSceneUpdateManager::DefaultSceneUpdateManager()
-        : sceneNodes()
+        : sceneNodes(),
+          m_pThreadPool(nullptr), m_parallelUpdateBatchSize(64), m_stepResults(), m_isSteppingSynchronous(false), m_currentDeltaTimeInSeconds(0.0),
+          m_isAnimationLODEnabled(false), m_animationLODDistance(50.0f), m_animationLODDistantInterval(4), m_animationLODHiddenInterval(10), m_animationLODFrameIndex(0)
     {
     }
 
@@ -42,10 +46,32 @@ namespace GT
     void DefaultSceneUpdateManager::RemoveSceneNode(SceneNode &sceneNode)
     {
         this->sceneNodes.RemoveFirstOccuranceOf(&sceneNode);
+
+        // A script removing a scene node that has not been stepped yet. It must not be touched once it has been removed.
+        if (m_isSteppingSynchronous)
+        {
+            for (size_t i = 0; i < m_stepResults.count; ++i)
+            {
+                if (m_stepResults.buffer[i].sceneNode == &sceneNode)
+                {
+                    m_stepResults.buffer[i].sceneNode = nullptr;
+                }
+            }
+        }
     }
 
     void DefaultSceneUpdateManager::Step(double deltaTimeInSeconds, SceneCullingManager &cullingManager)
     {
+        GT_PROFILE_ZONE("DefaultSceneUpdateManager::Step");
+
+        m_animationLODFrameIndex += 1;
+
+        if (m_pThreadPool != nullptr && m_pThreadPool->GetWorkerThreadCount() > 0 && this->sceneNodes.count >= m_parallelUpdateBatchSize)
+        {
+            this->StepParallel(deltaTimeInSeconds, cullingManager);
+            return;
+        }
+
         for (size_t i = 0; i < this->sceneNodes.count; ++i)
         {
             auto sceneNode = this->sceneNodes[i];
@@ -57,6 +83,44 @@ namespace GT
     }
 
 
+    void DefaultSceneUpdateManager::EnableParallelUpdate(ThreadPool &threadPool)
+    {
+        m_pThreadPool = &threadPool;
+    }
+
+    void DefaultSceneUpdateManager::DisableParallelUpdate()
+    {
+        m_pThreadPool = nullptr;
+    }
+
+    void DefaultSceneUpdateManager::SetParallelUpdateBatchSize(size_t batchSize)
+    {
+        m_parallelUpdateBatchSize = Max(batchSize, static_cast<size_t>(1));
+    }
+
+
+    void DefaultSceneUpdateManager::EnableAnimationLOD()
+    {
+        m_isAnimationLODEnabled = true;
+    }
+
+    void DefaultSceneUpdateManager::DisableAnimationLOD()
+    {
+        m_isAnimationLODEnabled = false;
+    }
+
+    void DefaultSceneUpdateManager::SetAnimationLODDistance(float distance)
+    {
+        m_animationLODDistance = distance;
+    }
+
+    void DefaultSceneUpdateManager::SetAnimationLODIntervals(uint32_t distantInterval, uint32_t hiddenInterval)
+    {
+        m_animationLODDistantInterval = Max(distantInterval, 1U);
+        m_animationLODHiddenInterval  = hiddenInterval;
+    }
+
+
 
     /////////////////////////////////////////////////////////
     // Protected Methods.
@@ -70,8 +134,10 @@ namespace GT
             auto model = modelComponent->GetModel();
             if (model != nullptr && model->IsAnimating() && !model->IsAnimationPaused())
             {
-                model->StepAnimation(deltaTimeInSeconds);
-                cullingManager.UpdateModelAABB(node);
+                if (this->StepModelAnimation(node, *model, deltaTimeInSeconds))
+                {
+                    cullingManager.UpdateModelAABB(node);
+                }
             }
         }
 
@@ -86,6 +152,8 @@ namespace GT
                 {
                     particleSystem->Update(deltaTimeInSeconds);
                     cullingManager.UpdateParticleSystemAABB(node);
+
+                    this->AddLiveParticleStat(node, *particleSystem);
                 }
             }
         }
@@ -106,4 +174,190 @@ namespace GT
             }
         }
     }
+
+    uint32_t DefaultSceneUpdateManager::StepSceneNodeConcurrent(SceneNode &node, double deltaTimeInSeconds)
+    {
+        uint32_t result = StepResult_None;
+
+        auto modelComponent = node.GetComponent<ModelComponent>();
+        if (modelComponent != nullptr)
+        {
+            auto model = modelComponent->GetModel();
+            if (model != nullptr && model->IsAnimating() && !model->IsAnimationPaused())
+            {
+                if (this->StepModelAnimation(node, *model, deltaTimeInSeconds))
+                {
+                    result |= StepResult_ModelAnimated;
+                }
+            }
+        }
+
+        auto particleSystemComponent = node.GetComponent<ParticleSystemComponent>();
+        if (particleSystemComponent != nullptr)
+        {
+            if (particleSystemComponent->IsPlaying())
+            {
+                auto particleSystem = particleSystemComponent->GetParticleSystem();
+                if (particleSystem != nullptr)
+                {
+                    particleSystem->Update(deltaTimeInSeconds);
+                    result |= StepResult_ParticlesUpdated;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    void DefaultSceneUpdateManager::StepSceneNodeSynchronous(SceneNode &node, double deltaTimeInSeconds, SceneCullingManager &cullingManager, uint32_t stepResult)
+    {
+        // The animation and particles have already been stepped. The culling manager just needs to know about the new bounds.
+        if ((stepResult & StepResult_ModelAnimated) != 0)
+        {
+            cullingManager.UpdateModelAABB(node);
+        }
+
+        if ((stepResult & StepResult_ParticlesUpdated) != 0)
+        {
+            cullingManager.UpdateParticleSystemAABB(node);
+
+            auto particleSystem = node.GetComponent<ParticleSystemComponent>()->GetParticleSystem();
+            assert(particleSystem != nullptr);
+            {
+                this->AddLiveParticleStat(node, *particleSystem);
+            }
+        }
+
+
+        node.OnUpdate(deltaTimeInSeconds);
+
+
+        auto registeredScript = node.GetScene()->GetRegisteredScript();
+        if (registeredScript != nullptr)
+        {
+            auto scriptComponent = node.GetComponent<ScriptComponent>();
+            if (scriptComponent != nullptr && scriptComponent->HasOnUpdate())
+            {
+                GT::PostSceneNodeEvent_OnUpdate(*registeredScript, node, deltaTimeInSeconds);
+            }
+        }
+    }
+
+    void DefaultSceneUpdateManager::AddLiveParticleStat(SceneNode &node, const ParticleSystem &particleSystem)
+    {
+        auto context = node.GetContext();
+        if (context != nullptr)
+        {
+            context->GetStats().Add(EngineStat_LiveParticles, static_cast<double>(particleSystem.GetParticleCount()));
+        }
+    }
+
+    bool DefaultSceneUpdateManager::StepModelAnimation(const SceneNode &node, Model &model, double deltaTimeInSeconds)
+    {
+        // The renderer records the distance to the model each frame it sees it. This is reset so that a model is only treated as
+        // visible while the renderer keeps seeing it.
+        float seenDistance = model.GetSeenDistance();
+        model.ResetSeenDistance();
+
+        if (!m_isAnimationLODEnabled || (seenDistance >= 0.0f && seenDistance <= m_animationLODDistance))
+        {
+            model.StepAnimation(deltaTimeInSeconds);
+            return true;
+        }
+
+
+        // The frame a model is evaluated on is offset by it's ID so that they don't all land on the same frame.
+        uint32_t frameIndex = m_animationLODFrameIndex + static_cast<uint32_t>(node.GetID());
+
+        if (seenDistance >= 0.0f)
+        {
+            // The model is visible but far away. The step is held back rather than advancing the playback time, because otherwise
+            // the renderer would see an out of date pose and evaluate it anyway.
+            if ((frameIndex % m_animationLODDistantInterval) == 0)
+            {
+                model.StepAnimation(deltaTimeInSeconds);
+                return true;
+            }
+
+            model.DeferAnimationStep(deltaTimeInSeconds);
+            return false;
+        }
+        else
+        {
+            // Nobody could see the model. Only the playback time is moved. The renderer will catch up the pose if it sees it again.
+            model.AdvanceAnimation(deltaTimeInSeconds);
+
+            if (m_animationLODHiddenInterval != 0 && (frameIndex % m_animationLODHiddenInterval) == 0)
+            {
+                model.UpdateAnimationPose();
+                return true;
+            }
+
+            return false;
+        }
+    }
+
+
+
+    /////////////////////////////////////////////////////////
+    // Private Methods.
+
+    void DefaultSceneUpdateManager::StepParallel(double deltaTimeInSeconds, SceneCullingManager &cullingManager)
+    {
+        assert(m_pThreadPool != nullptr);
+
+        // Phase 1: animation and particles across the thread pool. Each job handles a contiguous range of scene nodes and writes the
+        // results into its own range of m_stepResults so there's no need for any synchronization.
+        size_t sceneNodeCount = this->sceneNodes.count;
+        m_stepResults.Resize(sceneNodeCount);
+        m_currentDeltaTimeInSeconds = deltaTimeInSeconds;
+
+        for (size_t i = 0; i < sceneNodeCount; ++i)
+        {
+            m_stepResults.buffer[i].sceneNode  = this->sceneNodes.buffer[i];
+            m_stepResults.buffer[i].stepResult = StepResult_None;
+        }
+
+        size_t jobCount = (sceneNodeCount + m_parallelUpdateBatchSize - 1) / m_parallelUpdateBatchSize;
+        m_pThreadPool->Run(jobCount, StepParallelJob, this);
+
+
+        // Phase 2: culling, OnUpdate() and scripts on this thread in the same order as the serial path. This goes through the
+        // snapshot so that each scene node is matched with its own results even if scripts add or remove scene nodes. Scene nodes
+        // that are removed are skipped, and scene nodes that are added are stepped from the next step.
+        m_isSteppingSynchronous = true;
+
+        for (size_t i = 0; i < sceneNodeCount; ++i)
+        {
+            auto &stepped = m_stepResults.buffer[i];
+            if (stepped.sceneNode != nullptr)
+            {
+                this->StepSceneNodeSynchronous(*stepped.sceneNode, deltaTimeInSeconds, cullingManager, stepped.stepResult);
+            }
+        }
+
+        m_isSteppingSynchronous = false;
+    }
+
+    void DefaultSceneUpdateManager::StepParallelJob(size_t jobIndex, size_t threadIndex, void* pUserData)
+    {
+        (void)threadIndex;
+
+        GT_PROFILE_ZONE("DefaultSceneUpdateManager::StepParallelJob");
+
+        auto pUpdateManager = reinterpret_cast<DefaultSceneUpdateManager*>(pUserData);
+        assert(pUpdateManager != nullptr);
+
+        size_t firstIndex = jobIndex * pUpdateManager->m_parallelUpdateBatchSize;
+        size_t lastIndex  = Min(firstIndex + pUpdateManager->m_parallelUpdateBatchSize, pUpdateManager->m_stepResults.count);
+
+        for (size_t i = firstIndex; i < lastIndex; ++i)
+        {
+            auto &stepped = pUpdateManager->m_stepResults.buffer[i];
+            assert(stepped.sceneNode != nullptr);
+            {
+                stepped.stepResult = pUpdateManager->StepSceneNodeConcurrent(*stepped.sceneNode, pUpdateManager->m_currentDeltaTimeInSeconds);
+            }
+        }
+    }
 }
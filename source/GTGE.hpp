@@ -40,6 +40,13 @@
 #include <direct.h>
 #endif
 
+// SIMD headers.
+#if defined(GT_BUILD_AVX)
+#include <immintrin.h>
+#elif defined(GT_BUILD_SSE2)
+#include <emmintrin.h>
+#endif
+
 // Platform headers.
 #ifdef _WIN32
 #if !defined(WINVER)
@@ -195,11 +202,16 @@
 #include "../include/GTGE/Core/Vector.hpp"
 #include "../include/GTGE/Core/List.hpp"
 #include "../include/GTGE/Core/Map.hpp"
+#include "../include/GTGE/Core/HashMap.hpp"
+#include "../include/GTGE/Core/StringID.hpp"
 #include "../include/GTGE/Core/Dictionary.hpp"
 #include "../include/GTGE/Core/SortedVector.hpp"
+#include "../include/GTGE/Core/MappedFile.hpp"
 #include "../include/GTGE/Core/Deserializer.hpp"
 #include "../include/GTGE/Core/Serializer.hpp"
 #include "../include/GTGE/Core/System.hpp"
+#include "../include/GTGE/Core/ThreadPool.hpp"
+#include "../include/GTGE/Core/FrameAllocator.hpp"
 #include "../include/GTGE/Core/Timing/TimingCommon.hpp"
 #include "../include/GTGE/Core/Timing/Benchmarker.hpp"
 #include "../include/GTGE/Core/Timing/Stopwatch.hpp"
@@ -309,6 +321,7 @@
 #include "../include/GTGE/AABB.hpp"
 #include "../include/GTGE/AlignedType.hpp"
 #include "../include/GTGE/Bone.hpp"
+#include "../include/GTGE/SkeletonPose.hpp"
 #include "../include/GTGE/CollisionGroups.hpp"
 #include "../include/GTGE/Component.hpp"
 #include "../include/GTGE/ConvexHullBuildSettings.hpp"
@@ -325,6 +338,7 @@
 #include "../include/GTGE/Animation/AnimationSequence.hpp"
 #include "../include/GTGE/Animation/AnimationTrack.hpp"
 #include "../include/GTGE/Animation/Animation.hpp"
+#include "../include/GTGE/Animation/AnimationClip.hpp"
 
 #include "../include/GTGE/Assets/AssetTypes.hpp"
 #include "../include/GTGE/Assets/AssetMetadata.hpp"
@@ -530,6 +544,7 @@
 #include "Core/FontEngine_Win32.cpp"
 #include "Core/FontEventHandler.cpp"
 #include "Core/FontServer.cpp"
+#include "Core/FrameAllocator.cpp"
 #include "Core/GlyphCache.cpp"
 #include "Core/GlyphMapLayout.cpp"
 #include "Core/GlyphMapManager.cpp"
@@ -540,14 +555,17 @@
 #include "Core/ImageLoader_PNG.cpp"
 #include "Core/ImageUtils.cpp"
 #include "Core/Keyboard.cpp"
+#include "Core/MappedFile.cpp"
 #include "Core/Mipmap.cpp"
 #include "Core/MipmapGenerator.cpp"
 #include "Core/Mouse.cpp"
 #include "Core/Parse.cpp"
 #include "Core/stdio.cpp"
+#include "Core/StringID.cpp"
 #include "Core/System.cpp"
 #include "Core/TextManager.cpp"
 #include "Core/TextMesh.cpp"
+#include "Core/ThreadPool.cpp"
 #include "Core/ToString.cpp"
 #include "Core/Window.cpp"
 #include "Core/WindowEventCallback.cpp"
@@ -559,6 +577,7 @@
 #include "Animation/AnimationSequence.cpp"
 #include "Animation/AnimationTrack.cpp"
 #include "Animation/Animation.cpp"
+#include "Animation/AnimationClip.cpp"
 
 #include "Assets/Asset.cpp"
 #include "Assets/AssetAllocator.cpp"
@@ -699,6 +718,8 @@
 
 #include "Utilities/DynamicCharacterController.cpp"
 
+#include "BakedTexture.cpp"
+#include "BVHSceneCullingManager.cpp"
 #include "Bone.cpp"
 #include "Component.cpp"
 #include "Context.cpp"
@@ -714,6 +735,7 @@
 #include "Editor.cpp"
 #include "GameEventFilter.cpp"
 #include "GameEventQueue.cpp"
+#include "GamePackage.cpp"
 #include "GamePackager.cpp"
 #include "GameScript.cpp"
 #include "GameStateManager.cpp"
@@ -748,6 +770,7 @@
 #include "Profiler.cpp"
 #include "Projectile.cpp"
 #include "Scene.cpp"
+#include "SceneCullingBVH.cpp"
 #include "SceneCullingDbvtPolicy.cpp"
 #include "SceneDeserializeCallback.cpp"
 #include "SceneEventHandler.cpp"
@@ -770,6 +793,8 @@
 #include "ShaderParameter.cpp"
 #include "ShaderParameterCache.cpp"
 #include "ShadowVolume.cpp"
+#include "SkeletonPose.cpp"
+#include "StatsRegistry.cpp"
 #include "Texture2DLibrary.cpp"
 #include "VertexArrayLibrary.cpp"
 
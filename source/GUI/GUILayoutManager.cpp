@@ -2,6 +2,7 @@
 
 #include <GTGE/GUI/GUILayoutManager.hpp>
 #include <GTGE/GUI/GUIServer.hpp>
+#include <GTGE/Profiler.hpp>
 
 namespace GT
 {
@@ -75,6 +76,8 @@ namespace GT
 
     void GUILayoutManager::Validate()
     {
+        GT_PROFILE_ZONE("GUILayoutManager::Validate");
+
         while (this->invalidElements.root != nullptr)
         {
             auto iElement = this->invalidElements.root;
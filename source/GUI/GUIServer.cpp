@@ -7,6 +7,7 @@
 #include <GTGE/Core/Strings/Equal.hpp>
 #include <GTGE/Core/ToString.hpp>
 #include <GTGE/GTEngine.hpp>
+#include <GTGE/Profiler.hpp>
 #include <cassert>
 
 // GUIServer
@@ -492,6 +493,8 @@ namespace GT
 
     void GUIServer::Step(double deltaInSeconds)
     {
+        GT_PROFILE_ZONE("GUIServer::Step");
+
         this->isStepping = true;
         {
             // We update the step time in case the host application is using automatic deltas.
@@ -539,6 +542,8 @@ namespace GT
 
     void GUIServer::Paint(int left, int top, int right, int bottom)
     {
+        GT_PROFILE_ZONE("GUIServer::Paint");
+
         assert(left <= right);
         assert(top  <= bottom);
 
@@ -0,0 +1,670 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#include <GTGE/GamePackage.hpp>
+
+namespace GT
+{
+    /// Normalizes a single path character so that paths compare case-insensitively and with either kind of slash.
+    static inline char GamePackage_NormalizePathChar(char c)
+    {
+        if (c == '\\')
+        {
+            return '/';
+        }
+
+        if (c >= 'A' && c <= 'Z')
+        {
+            return c - 'A' + 'a';
+        }
+
+        return c;
+    }
+
+    /// Skips the leading slashes of a path.
+    static inline const char* GamePackage_SkipLeadingSlashes(const char* path)
+    {
+        while (*path == '/' || *path == '\\')
+        {
+            path += 1;
+        }
+
+        return path;
+    }
+
+    /// Determines whether or not two paths are equal once they're normalized.
+    static bool GamePackage_PathsEqual(const char* a, const char* b)
+    {
+        a = GamePackage_SkipLeadingSlashes(a);
+        b = GamePackage_SkipLeadingSlashes(b);
+
+        while (*a != '\0' && *b != '\0')
+        {
+            if (GamePackage_NormalizePathChar(*a) != GamePackage_NormalizePathChar(*b))
+            {
+                return false;
+            }
+
+            a += 1;
+            b += 1;
+        }
+
+        return *a == *b;
+    }
+
+
+
+    ///////////////////////////////////////////
+    // LZ4
+    //
+    // Entries are compressed in the LZ4 block format. Each entry is a single block, so there is no frame header. The compressor is a simple
+    // greedy one with a single hash table, which is fine for something that is only run when packaging a game. The decompressor validates
+    // every offset and length against the buffers since it's reading from a file.
+
+    static const size_t   LZ4_MinMatch        = 4;
+    static const size_t   LZ4_LastLiterals    = 5;      // The last 5 bytes of a block are always literals.
+    static const size_t   LZ4_MatchFindLimit  = 12;     // The last match must start at least 12 bytes before the end of the block.
+    static const size_t   LZ4_MaxOffset       = 65535;
+    static const uint32_t LZ4_HashLog         = 12;
+
+    static inline uint32_t LZ4_Read32(const uint8_t* p)
+    {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static inline uint32_t LZ4_Hash(uint32_t sequence)
+    {
+        return (sequence * 2654435761U) >> (32 - LZ4_HashLog);
+    }
+
+    /// Writes the extra bytes of a literal or match length that didn't fit in the token.
+    static inline uint8_t* LZ4_WriteLength(uint8_t* pOut, size_t length)
+    {
+        while (length >= 255)
+        {
+            *pOut++ = 255;
+            length -= 255;
+        }
+
+        *pOut++ = static_cast<uint8_t>(length);
+        return pOut;
+    }
+
+    /// Calculates the size of the buffer needed to compress the given number of bytes in the worst case.
+    static size_t LZ4_CompressBound(size_t srcSize)
+    {
+        return srcSize + (srcSize / 255) + 16;
+    }
+
+    /// Compresses a block.
+    ///
+    /// @return The size of the compressed data, or 0 if it does not fit in the output buffer.
+    static size_t LZ4_CompressBlock(const uint8_t* pSrc, size_t srcSize, uint8_t* pDst, size_t dstCapacity)
+    {
+        const uint8_t* ip     = pSrc;
+        const uint8_t* anchor = pSrc;
+        const uint8_t* iend   = pSrc + srcSize;
+
+        uint8_t* op   = pDst;
+        uint8_t* oend = pDst + dstCapacity;
+
+        if (srcSize >= LZ4_MatchFindLimit + 1)
+        {
+            const uint8_t* mflimit    = iend - LZ4_MatchFindLimit;
+            const uint8_t* matchlimit = iend - LZ4_LastLiterals;
+
+            Vector<uint32_t> hashTable;
+            hashTable.Resize(1 << LZ4_HashLog);
+            for (size_t i = 0; i < hashTable.count; ++i)
+            {
+                hashTable[i] = UINT32_MAX;
+            }
+
+            while (ip < mflimit)
+            {
+                uint32_t sequence  = LZ4_Read32(ip);
+                uint32_t hash      = LZ4_Hash(sequence);
+                uint32_t candidate = hashTable[hash];
+                hashTable[hash] = static_cast<uint32_t>(ip - pSrc);
+
+                if (candidate == UINT32_MAX || static_cast<size_t>(ip - pSrc) - candidate > LZ4_MaxOffset || LZ4_Read32(pSrc + candidate) != sequence)
+                {
+                    ip += 1;
+                    continue;
+                }
+
+
+                const uint8_t* match    = pSrc + candidate;
+                const uint8_t* matchEnd = ip + LZ4_MinMatch;
+                const uint8_t* ref      = match + LZ4_MinMatch;
+                while (matchEnd < matchlimit && *matchEnd == *ref)
+                {
+                    matchEnd += 1;
+                    ref      += 1;
+                }
+
+                size_t literalLength = static_cast<size_t>(ip - anchor);
+                size_t matchLength   = static_cast<size_t>(matchEnd - ip) - LZ4_MinMatch;
+
+                // Token, extra literal length bytes, literals, offset, extra match length bytes.
+                size_t sequenceSize = 1 + (literalLength / 255 + 1) + literalLength + 2 + (matchLength / 255 + 1);
+                if (sequenceSize > static_cast<size_t>(oend - op))
+                {
+                    return 0;
+                }
+
+                uint8_t* pToken = op++;
+                *pToken = static_cast<uint8_t>((Min(literalLength, static_cast<size_t>(15)) << 4) | Min(matchLength, static_cast<size_t>(15)));
+
+                if (literalLength >= 15)
+                {
+                    op = LZ4_WriteLength(op, literalLength - 15);
+                }
+
+                memcpy(op, anchor, literalLength);
+                op += literalLength;
+
+                uint16_t offset = static_cast<uint16_t>(ip - match);
+                *op++ = static_cast<uint8_t>(offset & 0xFF);
+                *op++ = static_cast<uint8_t>(offset >> 8);
+
+                if (matchLength >= 15)
+                {
+                    op = LZ4_WriteLength(op, matchLength - 15);
+                }
+
+                ip     = matchEnd;
+                anchor = ip;
+            }
+        }
+
+
+        // The last sequence is only literals.
+        size_t literalLength = static_cast<size_t>(iend - anchor);
+        if (1 + (literalLength / 255 + 1) + literalLength > static_cast<size_t>(oend - op))
+        {
+            return 0;
+        }
+
+        *op++ = static_cast<uint8_t>(Min(literalLength, static_cast<size_t>(15)) << 4);
+        if (literalLength >= 15)
+        {
+            op = LZ4_WriteLength(op, literalLength - 15);
+        }
+
+        memcpy(op, anchor, literalLength);
+        op += literalLength;
+
+        return static_cast<size_t>(op - pDst);
+    }
+
+    /// Decompresses a block.
+    ///
+    /// @return True if the block decompresses to exactly dstSize bytes; false if the data is corrupt.
+    static bool LZ4_DecompressBlock(const uint8_t* pSrc, size_t srcSize, uint8_t* pDst, size_t dstSize)
+    {
+        const uint8_t* ip   = pSrc;
+        const uint8_t* iend = pSrc + srcSize;
+
+        uint8_t* op   = pDst;
+        uint8_t* oend = pDst + dstSize;
+
+        while (ip < iend)
+        {
+            uint8_t token = *ip++;
+
+            // Literals.
+            size_t literalLength = token >> 4;
+            if (literalLength == 15)
+            {
+                uint8_t b;
+                do
+                {
+                    if (ip >= iend)
+                    {
+                        return false;
+                    }
+
+                    b = *ip++;
+                    literalLength += b;
+                } while (b == 255);
+            }
+
+            if (literalLength > static_cast<size_t>(iend - ip) || literalLength > static_cast<size_t>(oend - op))
+            {
+                return false;
+            }
+
+            memcpy(op, ip, literalLength);
+            op += literalLength;
+            ip += literalLength;
+
+            // The last sequence has no match.
+            if (ip == iend)
+            {
+                break;
+            }
+
+
+            // Match.
+            if (iend - ip < 2)
+            {
+                return false;
+            }
+
+            size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+            ip += 2;
+
+            if (offset == 0 || offset > static_cast<size_t>(op - pDst))
+            {
+                return false;
+            }
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15)
+            {
+                uint8_t b;
+                do
+                {
+                    if (ip >= iend)
+                    {
+                        return false;
+                    }
+
+                    b = *ip++;
+                    matchLength += b;
+                } while (b == 255);
+            }
+            matchLength += LZ4_MinMatch;
+
+            if (matchLength > static_cast<size_t>(oend - op))
+            {
+                return false;
+            }
+
+            // The match can overlap the output, so this needs to be copied a byte at a time.
+            const uint8_t* match = op - offset;
+            for (size_t i = 0; i < matchLength; ++i)
+            {
+                op[i] = match[i];
+            }
+            op += matchLength;
+        }
+
+        return op == oend;
+    }
+
+
+
+    ///////////////////////////////////////////
+    // GamePackage
+
+    GamePackage::GamePackage()
+        : m_absolutePath(),
+          m_file(),
+          m_pMappedData(nullptr), m_mappedSize(0),
+          m_pEntries(nullptr), m_entryCount(0), m_pStrings(nullptr)
+    {
+    }
+
+    GamePackage::~GamePackage()
+    {
+        this->Close();
+    }
+
+
+    bool GamePackage::Open(const char* absolutePath)
+    {
+        this->Close();
+
+        if (!m_file.Open(absolutePath) || m_file.GetSize() < sizeof(GamePackageFooter))
+        {
+            m_file.Close();
+            return false;
+        }
+
+        m_pMappedData = reinterpret_cast<const uint8_t*>(m_file.GetData());
+        m_mappedSize  = m_file.GetSize();
+
+
+        // Validate everything up front so that nothing needs to be checked when reading entries.
+        GamePackageFooter footer;
+        memcpy(&footer, m_pMappedData + m_mappedSize - sizeof(footer), sizeof(footer));
+
+        uint64_t footerOffset = m_mappedSize - sizeof(footer);
+        bool isValid =
+            footer.magic   == Magic   &&
+            footer.version == Version &&
+            footer.alignment != 0 && (footer.alignment & (footer.alignment - 1)) == 0 && (footer.alignment % 8) == 0 &&
+            footer.tocOffset % 8 == 0 &&
+            footer.tocOffset <= footerOffset && footer.entryCount <= (footerOffset - footer.tocOffset) / sizeof(GamePackageEntry) &&
+            footer.stringsOffset >= footer.tocOffset + footer.entryCount * sizeof(GamePackageEntry) &&
+            footer.stringsOffset <= footerOffset && footer.stringsSize <= footerOffset - footer.stringsOffset &&
+            (footer.entryCount == 0 || (footer.stringsSize > 0 && m_pMappedData[footer.stringsOffset + footer.stringsSize - 1] == '\0'));
+
+        if (isValid)
+        {
+            m_pEntries   = reinterpret_cast<const GamePackageEntry*>(m_pMappedData + footer.tocOffset);
+            m_entryCount = footer.entryCount;
+            m_pStrings   = reinterpret_cast<const char*>(m_pMappedData + footer.stringsOffset);
+
+            for (uint32_t iEntry = 0; iEntry < m_entryCount && isValid; ++iEntry)
+            {
+                auto &entry = m_pEntries[iEntry];
+
+                bool isCompressed = (entry.flags & GamePackageEntryFlag_Compressed) != 0;
+                isValid =
+                    entry.dataOffset % footer.alignment == 0 &&
+                    entry.dataOffset <= footer.tocOffset && entry.storedSize <= footer.tocOffset - entry.dataOffset &&
+                    entry.pathOffset < footer.stringsSize &&
+                    (isCompressed || entry.storedSize == entry.size) &&
+                    (iEntry == 0 || m_pEntries[iEntry - 1].pathHash <= entry.pathHash);
+            }
+        }
+
+        if (!isValid)
+        {
+            this->Close();
+            return false;
+        }
+
+        m_absolutePath = absolutePath;
+        return true;
+    }
+
+    void GamePackage::Close()
+    {
+        m_file.Close();
+
+        m_pMappedData  = nullptr;
+        m_mappedSize   = 0;
+        m_absolutePath = "";
+        m_pEntries     = nullptr;
+        m_entryCount   = 0;
+        m_pStrings     = nullptr;
+    }
+
+
+    uint32_t GamePackage::FindEntry(const char* relativePath) const
+    {
+        uint64_t hash = HashPath(relativePath);
+
+        // Find the first entry with the hash...
+        uint32_t lo = 0;
+        uint32_t hi = m_entryCount;
+        while (lo < hi)
+        {
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (m_pEntries[mid].pathHash < hash)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+
+        // ... and then compare the paths of every entry with that hash in case of a collision.
+        for (uint32_t iEntry = lo; iEntry < m_entryCount && m_pEntries[iEntry].pathHash == hash; ++iEntry)
+        {
+            if (GamePackage_PathsEqual(m_pStrings + m_pEntries[iEntry].pathOffset, relativePath))
+            {
+                return iEntry;
+            }
+        }
+
+        return InvalidEntry;
+    }
+
+    const char* GamePackage::GetEntryPath(uint32_t entryIndex) const
+    {
+        return m_pStrings + this->GetEntry(entryIndex).pathOffset;
+    }
+
+    uint64_t GamePackage::GetEntrySize(uint32_t entryIndex) const
+    {
+        return this->GetEntry(entryIndex).size;
+    }
+
+    bool GamePackage::IsEntryCompressed(uint32_t entryIndex) const
+    {
+        return (this->GetEntry(entryIndex).flags & GamePackageEntryFlag_Compressed) != 0;
+    }
+
+    const void* GamePackage::GetEntryData(uint32_t entryIndex) const
+    {
+        auto &entry = this->GetEntry(entryIndex);
+        if ((entry.flags & GamePackageEntryFlag_Compressed) != 0)
+        {
+            return nullptr;
+        }
+
+        return m_pMappedData + entry.dataOffset;
+    }
+
+    bool GamePackage::ReadEntry(uint32_t entryIndex, void* pDataOut) const
+    {
+        auto &entry = this->GetEntry(entryIndex);
+        if ((entry.flags & GamePackageEntryFlag_Compressed) != 0)
+        {
+            return LZ4_DecompressBlock(m_pMappedData + entry.dataOffset, static_cast<size_t>(entry.storedSize), reinterpret_cast<uint8_t*>(pDataOut), static_cast<size_t>(entry.size));
+        }
+        else
+        {
+            memcpy(pDataOut, m_pMappedData + entry.dataOffset, static_cast<size_t>(entry.size));
+            return true;
+        }
+    }
+
+
+    uint64_t GamePackage::HashPath(const char* relativePath)
+    {
+        // 64-bit FNV-1a.
+        uint64_t hash = 14695981039346656037ULL;
+        for (const char* c = GamePackage_SkipLeadingSlashes(relativePath); *c != '\0'; ++c)
+        {
+            hash ^= static_cast<uint8_t>(GamePackage_NormalizePathChar(*c));
+            hash *= 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+
+    const GamePackageEntry & GamePackage::GetEntry(uint32_t entryIndex) const
+    {
+        assert(entryIndex < m_entryCount);
+        return m_pEntries[entryIndex];
+    }
+
+
+
+    ///////////////////////////////////////////
+    // GamePackageWriter
+
+    GamePackageWriter::GamePackageWriter(uint32_t alignment)
+        : m_alignment(Max(alignment, 8U)),
+          m_files(),
+          m_unreadableFiles()
+    {
+        assert((m_alignment & (m_alignment - 1)) == 0);
+    }
+
+    GamePackageWriter::~GamePackageWriter()
+    {
+        for (size_t iFile = 0; iFile < m_files.count; ++iFile)
+        {
+            delete m_files[iFile];
+        }
+    }
+
+
+    void GamePackageWriter::AddFile(const char* sourceAbsolutePath, const char* relativePath, bool compress)
+    {
+        auto pFile = new File;
+        pFile->sourceAbsolutePath = sourceAbsolutePath;
+        pFile->relativePath       = GamePackage_SkipLeadingSlashes(relativePath);
+        pFile->pathHash           = GamePackage::HashPath(relativePath);
+        pFile->compress           = compress;
+
+        m_files.PushBack(pFile);
+    }
+
+
+    bool GamePackageWriter::Write(drfs_context* pVFS, const char* outputAbsolutePath)
+    {
+        // The files are sorted by hash and path first. The sort is stable so that when there are duplicates, the one that was added first
+        // comes first and the rest can be skipped.
+        Vector<File*> sortedFiles(m_files);
+        std::stable_sort(sortedFiles.buffer, sortedFiles.buffer + sortedFiles.count, [](const File* a, const File* b) -> bool {
+            return a->pathHash < b->pathHash;
+        });
+
+
+        m_unreadableFiles.Clear();
+
+        drfs_file* pOutputFile;
+        if (drfs_open(pVFS, outputAbsolutePath, DRFS_WRITE | DRFS_CREATE_DIRS, &pOutputFile) != drfs_success)
+        {
+            return false;
+        }
+
+        bool result = true;
+
+        Vector<GamePackageEntry> entries;
+        entries.Reserve(sortedFiles.count);
+
+        Vector<char> strings;
+        uint64_t offset = 0;
+
+        Vector<uint8_t> compressedData;
+        static const uint8_t padding[256] = {0};
+
+        for (size_t iFile = 0; iFile < sortedFiles.count && result; ++iFile)
+        {
+            auto pFile = sortedFiles[iFile];
+
+            // Skip duplicates of the previous files with the same hash.
+            bool isDuplicate = false;
+            for (size_t iPrevFile = iFile; iPrevFile > 0 && sortedFiles[iPrevFile - 1]->pathHash == pFile->pathHash; --iPrevFile)
+            {
+                if (GamePackage_PathsEqual(sortedFiles[iPrevFile - 1]->relativePath.c_str(), pFile->relativePath.c_str()))
+                {
+                    isDuplicate = true;
+                    break;
+                }
+            }
+
+            if (isDuplicate)
+            {
+                continue;
+            }
+
+
+            size_t fileSize = 0;
+            void* pFileData = drfs_open_and_read_binary_file(pVFS, pFile->sourceAbsolutePath.c_str(), &fileSize);
+            if (pFileData == nullptr)
+            {
+                m_unreadableFiles.PushBack(pFile->sourceAbsolutePath);
+                continue;
+            }
+
+            const void* pStoredData = pFileData;
+            size_t storedSize = fileSize;
+            uint32_t flags = 0;
+
+            // Compressed data is only kept if it saves at least an eighth of the size, since otherwise it's not worth decompressing.
+            if (pFile->compress && fileSize > 0)
+            {
+                compressedData.Resize(LZ4_CompressBound(fileSize));
+
+                size_t compressedSize = LZ4_CompressBlock(reinterpret_cast<const uint8_t*>(pFileData), fileSize, compressedData.buffer, compressedData.count);
+                if (compressedSize > 0 && compressedSize < fileSize - fileSize / 8)
+                {
+                    pStoredData = compressedData.buffer;
+                    storedSize  = compressedSize;
+                    flags      |= GamePackageEntryFlag_Compressed;
+                }
+            }
+
+
+            // Pad up to the alignment.
+            uint64_t paddingSize = (m_alignment - (offset % m_alignment)) % m_alignment;
+            while (paddingSize > 0 && result)
+            {
+                uint64_t chunkSize = Min(paddingSize, static_cast<uint64_t>(sizeof(padding)));
+                result = drfs_write(pOutputFile, padding, static_cast<unsigned int>(chunkSize), nullptr) == drfs_success;
+
+                offset      += chunkSize;
+                paddingSize -= chunkSize;
+            }
+
+            if (result && storedSize > 0)
+            {
+                result = drfs_write(pOutputFile, pStoredData, static_cast<unsigned int>(storedSize), nullptr) == drfs_success;
+            }
+
+
+            GamePackageEntry entry;
+            entry.pathHash   = pFile->pathHash;
+            entry.dataOffset = offset;
+            entry.storedSize = storedSize;
+            entry.size       = fileSize;
+            entry.pathOffset = static_cast<uint32_t>(strings.count);
+            entry.flags      = flags;
+            entries.PushBack(entry);
+
+            // Paths are stored without leading slashes and with forward slashes so that they can be appended to the package's path as-is.
+            for (const char* c = GamePackage_SkipLeadingSlashes(pFile->relativePath.c_str()); *c != '\0'; ++c)
+            {
+                strings.PushBack((*c == '\\') ? '/' : *c);
+            }
+            strings.PushBack('\0');
+
+            offset += storedSize;
+
+            drfs_free(pFileData);
+        }
+
+
+        // The table of contents needs to be 8 byte aligned so it can be read in place.
+        if (result)
+        {
+            uint64_t paddingSize = (8 - (offset % 8)) % 8;
+            if (paddingSize > 0)
+            {
+                result = drfs_write(pOutputFile, padding, static_cast<unsigned int>(paddingSize), nullptr) == drfs_success;
+                offset += paddingSize;
+            }
+        }
+
+        GamePackageFooter footer;
+        footer.magic         = GamePackage::Magic;
+        footer.version       = GamePackage::Version;
+        footer.entryCount    = static_cast<uint32_t>(entries.count);
+        footer.alignment     = m_alignment;
+        footer.tocOffset     = offset;
+        footer.stringsOffset = footer.tocOffset + entries.count * sizeof(GamePackageEntry);
+        footer.stringsSize   = strings.count;
+
+        if (result && entries.count > 0)
+        {
+            result = drfs_write(pOutputFile, entries.buffer, static_cast<unsigned int>(entries.count * sizeof(GamePackageEntry)), nullptr) == drfs_success;
+        }
+
+        if (result && strings.count > 0)
+        {
+            result = drfs_write(pOutputFile, strings.buffer, static_cast<unsigned int>(strings.count), nullptr) == drfs_success;
+        }
+
+        if (result)
+        {
+            result = drfs_write(pOutputFile, &footer, sizeof(footer), nullptr) == drfs_success;
+        }
+
+        drfs_close(pOutputFile);
+        return result && m_unreadableFiles.count == 0;
+    }
+}
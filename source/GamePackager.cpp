@@ -1,6 +1,8 @@
 // Copyright (C) 2011 - 2014 David Reid. See included LICENCE file.
 
 #include <GTGE/GamePackager.hpp>
+#include <GTGE/GamePackage.hpp>
+#include <GTGE/BakedTexture.hpp>
 #include <GTGE/IO.hpp>
 #include <GTGE/GTEngine.hpp>
 
@@ -9,12 +11,37 @@ namespace GT
     GamePackager::GamePackager(const char* outputDirectoryAbsolutePathIn)
         : outputDirectoryAbsolutePath(outputDirectoryAbsolutePathIn),
           dataDirectoryRelativePaths(),
-          executableRelativePath()
+          executableRelativePath(),
+          packageWriter(nullptr),
+          packageRelativePath(),
+          packedBakedTextureAbsolutePaths(),
+          compressPackage(false),
+          bakeTextures(false),
+          compressTextures(false)
     {
     }
 
     GamePackager::~GamePackager()
     {
+        delete this->packageWriter;
+    }
+
+
+    void GamePackager::EnablePackage(const char* packageRelativePathIn, bool compress)
+    {
+        if (this->packageWriter == nullptr)
+        {
+            this->packageWriter = new GamePackageWriter;
+        }
+
+        this->packageRelativePath = packageRelativePathIn;
+        this->compressPackage     = compress;
+    }
+
+    void GamePackager::EnableTextureBaking(bool compress)
+    {
+        this->bakeTextures     = true;
+        this->compressTextures = compress;
     }
 
 
@@ -74,7 +101,65 @@ namespace GT
                         }
                     }
 
-                    this->CopyFile(fileAbsolutePath, (String(destinationRelativePath) + "/" + fileName).c_str());
+                    // Baked textures are made again from the images below, so any existing ones are left behind.
+                    if (this->bakeTextures && drpath_extension_equal(fileName, "gttexture"))
+                    {
+                        continue;
+                    }
+
+                    // Files that are loaded through the asset library, the texture library or the model library are packed rather than copied
+                    // over, along with any baked textures that are being kept. Entries are relative to the root data directory, which is the
+                    // first segment of the destination path.
+                    String entryPath;
+                    if (this->packageWriter != nullptr && (drpath_extension_equal(fileName, "gtdata") || drpath_extension_equal(fileName, "gttexture") || g_Context->GetAssetLibrary().GetAssetTypeByPath(fileAbsolutePath) != AssetType_Unknown || GT::IsSupportedModelExtension(fileName)))
+                    {
+                        const char* entryDirectory = strchr(destinationRelativePath, '/');
+                        if (entryDirectory != nullptr)
+                        {
+                            entryPath = String(entryDirectory + 1) + "/" + fileName;
+                        }
+                        else
+                        {
+                            entryPath = fileName;
+                        }
+
+                        this->packageWriter->AddFile(fileAbsolutePath, entryPath.c_str(), this->compressPackage);
+                    }
+                    else
+                    {
+                        this->CopyFile(fileAbsolutePath, (String(destinationRelativePath) + "/" + fileName).c_str());
+                    }
+
+                    // The texture is baked after the image is copied so that it's newer than the copy. Textures of packed images are baked to a
+                    // temporary file next to the package and packed along with the image. The temporary files are deleted in WritePackage().
+                    if (this->bakeTextures && Texture2DLibrary::IsExtensionSupported(drpath_extension(fileName)))
+                    {
+                        String bakedAbsolutePath;
+                        if (!entryPath.IsEmpty())
+                        {
+                            char bakedFileName[64];
+                            IO::snprintf(bakedFileName, sizeof(bakedFileName), ".%u.gttexture", static_cast<unsigned int>(this->packedBakedTextureAbsolutePaths.count));
+
+                            bakedAbsolutePath = this->outputDirectoryAbsolutePath + "/" + this->packageRelativePath + bakedFileName;
+                        }
+                        else
+                        {
+                            bakedAbsolutePath = this->outputDirectoryAbsolutePath + "/" + destinationRelativePath + "/" + fileName + ".gttexture";
+                        }
+
+                        if (BakedTexture::Bake(g_Context->GetVFS(), fileAbsolutePath, bakedAbsolutePath.c_str(), Renderer::HasFlippedTextures(), this->compressTextures, &g_Context->GetThreadPool()))
+                        {
+                            if (!entryPath.IsEmpty())
+                            {
+                                this->packageWriter->AddFile(bakedAbsolutePath.c_str(), (entryPath + ".gttexture").c_str(), this->compressPackage);
+                                this->packedBakedTextureAbsolutePaths.PushBack(bakedAbsolutePath);
+                            }
+                        }
+                        else
+                        {
+                            g_Context->Logf("Texture not baked: %s", fileAbsolutePath);
+                        }
+                    }
                 }
             } while (drfs_next(g_Context->GetVFS(), &iFile));
         }
@@ -109,6 +194,32 @@ namespace GT
     }
 
 
+    bool GamePackager::WritePackage()
+    {
+        if (this->packageWriter == nullptr)
+        {
+            return true;
+        }
+
+        bool result = this->packageWriter->Write(g_Context->GetVFS(), (this->outputDirectoryAbsolutePath + "/" + this->packageRelativePath).c_str());
+
+        auto &unreadableFiles = this->packageWriter->GetUnreadableFiles();
+        for (size_t iFile = 0; iFile < unreadableFiles.count; ++iFile)
+        {
+            g_Context->LogErrorf("Could not read %s. It has been left out of the game package.", unreadableFiles[iFile].c_str());
+        }
+
+        // The baked textures of packed images are only needed until they're in the package.
+        for (size_t iFile = 0; iFile < this->packedBakedTextureAbsolutePaths.count; ++iFile)
+        {
+            drfs_delete_file(g_Context->GetVFS(), this->packedBakedTextureAbsolutePaths[iFile].c_str());
+        }
+        this->packedBakedTextureAbsolutePaths.Clear();
+
+        return result;
+    }
+
+
     bool GamePackager::WriteConfig()
     {
         if (!this->executableRelativePath.IsEmpty())
@@ -140,6 +251,15 @@ namespace GT
                 dataDirectoryConfigPaths.PushBack(dataDirectoryRelativePath);
             }
 
+            // The game package is relative to the executable in the same way.
+            char packageConfigPath[DRFS_MAX_PATH] = "";
+            if (this->packageWriter != nullptr)
+            {
+                char packageAbsolutePath[DRFS_MAX_PATH];
+                drpath_append_and_clean(packageAbsolutePath, sizeof(packageAbsolutePath), this->outputDirectoryAbsolutePath.c_str(), this->packageRelativePath.c_str());
+                drpath_to_relative(packageAbsolutePath, executableDirectory, packageConfigPath, sizeof(packageConfigPath));
+            }
+
             //Path configPath(executableDirectory.c_str());
             //configPath.Append("config.lua");
 
@@ -151,10 +271,14 @@ namespace GT
             {
                 for (size_t iDataDirectory = 0; iDataDirectory < dataDirectoryConfigPaths.count; ++iDataDirectory)
                 {
-                    auto index = static_cast<int>(iDataDirectory + 1);       // +1 because Lua is 1 based.
-                    auto path  = dataDirectoryConfigPaths[iDataDirectory].c_str();
+                    auto path = dataDirectoryConfigPaths[iDataDirectory].c_str();
 
-                    drfs_write_string(pFile, String::CreateFormatted("BaseDirectory \"%s\"\n", index, path).c_str());
+                    drfs_write_string(pFile, String::CreateFormatted("BaseDirectory \"%s\"\n", path).c_str());
+                }
+
+                if (packageConfigPath[0] != '\0')
+                {
+                    drfs_write_string(pFile, String::CreateFormatted("Package \"%s\"\n", packageConfigPath).c_str());
                 }
 
 
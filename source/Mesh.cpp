@@ -88,11 +88,11 @@ namespace GT
     }
 
 
-    void Mesh::SetSkinningData(const Bone* const* bones, const SkinningVertexAttribute* skinningVertexAttributes)
+    void Mesh::SetSkinningData(const glm::mat4* skinningPalette, const SkinningVertexAttribute* skinningVertexAttributes)
     {
         // Delete any previous data just in case. We should never actually have any, but we'll do it anyway just to be sure.
         delete this->skinningData;
-        this->skinningData = new MeshSkinningData(bones, skinningVertexAttributes, *this->geometry);
+        this->skinningData = new MeshSkinningData(skinningPalette, skinningVertexAttributes, *this->geometry);
     }
 
 
@@ -121,10 +121,11 @@ namespace GT
             if (this->skinningData != nullptr)
             {
                 CPUVertexShader_Skinning shader;
-                shader.SetBoneBuffer(this->skinningData->bones);
+                shader.SetSkinningPalette(this->skinningData->skinningPalette);
                 shader.SetSkinningVertexAttributes(this->skinningData->skinningVertexAttributes);
 
-                shader.Execute(srcVertices, this->geometry->GetVertexCount(), this->geometry->GetFormat(), dstVertices);
+                shader.Execute(srcVertices, this->geometry->GetVertexCount(), this->geometry->GetFormat(), dstVertices, m_context.GetThreadPool());
+                m_context.GetStats().Add(EngineStat_SkinnedVertices, static_cast<double>(this->geometry->GetVertexCount()));
 
                 // After executing, we need the AABBs.
                 shader.GetAABB(aabbMinOut, aabbMaxOut);
@@ -14,8 +14,21 @@
 
 namespace GT
 {
+    /// Calculates the number of slots to use for a vertex hash table containing the given number of vertices. This keeps the table at most
+    /// half full so the probe sequences stay short, and is always a power of two.
+    static size_t MeshBuilder_CalculateVertexHashTableSlotCount(size_t vertexCount)
+    {
+        size_t slotCount = 64;
+        while (slotCount < vertexCount * 2)
+        {
+            slotCount *= 2;
+        }
+
+        return slotCount;
+    }
+
     MeshBuilder::MeshBuilder(size_t vertexSizeInFloats)
-        : vertexSizeInFloats(vertexSizeInFloats), vertexBuffer(), indexBuffer(), checkDuplicatesOnEmit(true)
+        : vertexSizeInFloats(vertexSizeInFloats), vertexBuffer(), indexBuffer(), checkDuplicatesOnEmit(true), vertexHashTable(), hashedVertexCount(0), weldEpsilon(0.0f)
     {
     }
 
@@ -35,6 +48,19 @@ namespace GT
             {
                 this->vertexBuffer.PushBack(vertexData[i]);
             }
+
+            if (this->checkDuplicatesOnEmit)
+            {
+                // The table is kept at most half full so the probe sequences stay short.
+                if ((static_cast<size_t>(index) + 1) * 2 > this->vertexHashTable.count)
+                {
+                    this->RebuildVertexHashTable(Max(this->vertexHashTable.count * 2, static_cast<size_t>(64)));
+                }
+                else
+                {
+                    this->InsertIntoVertexHashTable(index, this->HashVertex(this->vertexBuffer.buffer + (index * vertexSizeInFloats)));
+                }
+            }
         }
 
         // Now we just add the index to the end.
@@ -55,12 +81,26 @@ namespace GT
     bool MeshBuilder::Find(const float* vertexData, unsigned int &indexOut)
     {
         size_t vertexCount = this->vertexBuffer.count / vertexSizeInFloats;
+        if (vertexCount == 0)
+        {
+            return false;
+        }
 
-        for (size_t i = 0; i < vertexCount; ++i)
+        // The hash table will be out of sync if duplicate checking was disabled while vertices were being emitted, in which case it needs
+        // to be rebuilt before it can be used.
+        if (this->hashedVertexCount != vertexCount)
         {
-            if (this->Equal(this->vertexBuffer.buffer + (i * vertexSizeInFloats), vertexData))
+            this->RebuildVertexHashTable(MeshBuilder_CalculateVertexHashTableSlotCount(vertexCount));
+        }
+
+
+        size_t mask = this->vertexHashTable.count - 1;
+        for (size_t iSlot = this->HashVertex(vertexData) & mask; this->vertexHashTable.buffer[iSlot] != 0; iSlot = (iSlot + 1) & mask)
+        {
+            unsigned int index = this->vertexHashTable.buffer[iSlot] - 1;
+            if (this->WeldEqual(this->vertexBuffer.buffer + (index * vertexSizeInFloats), vertexData))
             {
-                indexOut = static_cast<unsigned int>(i);
+                indexOut = index;
                 return true;
             }
         }
@@ -68,9 +108,8 @@ namespace GT
         return false;
     }
 
-    bool MeshBuilder::Equal(const float* vertexData0, const float* vertexData1)
+    bool MeshBuilder::Equal(const float* vertexData0, const float* vertexData1) const
     {
-        // TODO: Look into SSE instrinsics for an optimization for appropriately aligned formats. P3T2N3 should benefit from this...
         for (size_t i = 0; i < vertexSizeInFloats; ++i)
         {
             if (vertexData0[i] != vertexData1[i])
@@ -83,10 +122,128 @@ namespace GT
         return true;
     }
 
+    void MeshBuilder::SetWeldEpsilon(float epsilon)
+    {
+        if (this->weldEpsilon != epsilon)
+        {
+            this->weldEpsilon = epsilon;
+
+            // Every existing vertex needs to be re-hashed with the new epsilon. The table may be smaller than the vertex count if duplicate
+            // checking was disabled while vertices were being emitted, so it's sized from the vertex count rather than reused as-is.
+            if (this->vertexHashTable.count > 0)
+            {
+                this->RebuildVertexHashTable(MeshBuilder_CalculateVertexHashTableSlotCount(this->vertexBuffer.count / vertexSizeInFloats));
+            }
+        }
+    }
+
     void MeshBuilder::Clear()
     {
         this->vertexBuffer.Clear();
         this->indexBuffer.Clear();
+
+        for (size_t i = 0; i < this->vertexHashTable.count; ++i)
+        {
+            this->vertexHashTable.buffer[i] = 0;
+        }
+
+        this->hashedVertexCount = 0;
+    }
+
+
+    uint32_t MeshBuilder::HashVertex(const float* vertexData) const
+    {
+        // FNV-1a over 32-bit words, followed by a final mix. Each word is either the bit pattern of the float, or the quantized value when an epsilon is set.
+        uint32_t hash = 2166136261U;
+
+        if (this->weldEpsilon > 0.0f)
+        {
+            double invEpsilon = 1.0 / this->weldEpsilon;
+            for (size_t i = 0; i < vertexSizeInFloats; ++i)
+            {
+                int64_t quantized = static_cast<int64_t>(std::floor(vertexData[i] * invEpsilon + 0.5));
+
+                hash = (hash ^ static_cast<uint32_t>(quantized))       * 16777619U;
+                hash = (hash ^ static_cast<uint32_t>(quantized >> 32)) * 16777619U;
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < vertexSizeInFloats; ++i)
+            {
+                // -0 and +0 compare equal so they need to hash the same.
+                uint32_t bits = 0;
+                if (vertexData[i] != 0.0f)
+                {
+                    std::memcpy(&bits, vertexData + i, sizeof(bits));
+                }
+
+                hash = (hash ^ bits) * 16777619U;
+            }
+        }
+
+        // Since we're hashing whole words, the low bits of the hash only depend on the low bits of each word. These are usually zero for
+        // floats, so the bits need to be mixed before they're used to index into the table.
+        hash ^= hash >> 16;
+        hash *= 0x85EBCA6BU;
+        hash ^= hash >> 13;
+        hash *= 0xC2B2AE35U;
+        hash ^= hash >> 16;
+
+        return hash;
+    }
+
+    bool MeshBuilder::WeldEqual(const float* vertexData0, const float* vertexData1) const
+    {
+        if (this->weldEpsilon > 0.0f)
+        {
+            double invEpsilon = 1.0 / this->weldEpsilon;
+            for (size_t i = 0; i < vertexSizeInFloats; ++i)
+            {
+                if (std::floor(vertexData0[i] * invEpsilon + 0.5) != std::floor(vertexData1[i] * invEpsilon + 0.5))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+        else
+        {
+            return this->Equal(vertexData0, vertexData1);
+        }
+    }
+
+    void MeshBuilder::RebuildVertexHashTable(size_t newSlotCount)
+    {
+        assert((newSlotCount & (newSlotCount - 1)) == 0);
+
+        this->vertexHashTable.Resize(newSlotCount);
+        for (size_t i = 0; i < newSlotCount; ++i)
+        {
+            this->vertexHashTable.buffer[i] = 0;
+        }
+
+        this->hashedVertexCount = 0;
+
+        size_t vertexCount = this->vertexBuffer.count / vertexSizeInFloats;
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            this->InsertIntoVertexHashTable(static_cast<unsigned int>(i), this->HashVertex(this->vertexBuffer.buffer + (i * vertexSizeInFloats)));
+        }
+    }
+
+    void MeshBuilder::InsertIntoVertexHashTable(unsigned int index, uint32_t hash)
+    {
+        size_t mask  = this->vertexHashTable.count - 1;
+        size_t iSlot = hash & mask;
+        while (this->vertexHashTable.buffer[iSlot] != 0)
+        {
+            iSlot = (iSlot + 1) & mask;
+        }
+
+        this->vertexHashTable.buffer[iSlot] = index + 1;
+        this->hashedVertexCount += 1;
     }
 }
 
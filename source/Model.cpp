@@ -18,20 +18,22 @@ namespace GT
 #if 0
     Model::Model()
         : definition(NullModelDefinition),
-          meshes(), bones(),
+          meshes(), bones(), skeletonPose(),
           aabbMin(), aabbMax(), isAABBValid(false),
-          animation(), animationChannelBones(), animationKeyCache(),
-          animationPlaybackSpeed(1.0)
+          animation(), animationClipBoneIndices(),
+          animationPlaybackSpeed(1.0), deferredAnimationStep(0.0),
+          isAnimationPoseOutOfDate(false), isSkinningOutOfDate(true), animationSeenDistance(-1.0f)
     {
     }
 #endif
 
     Model::Model(const ModelDefinition &definitionIn)
         : definition(definitionIn),
-          meshes(), bones(),
+          meshes(), bones(), skeletonPose(),
           aabbMin(), aabbMax(), isAABBValid(false),
-          animation(), animationChannelBones(), animationKeyCache(),
-          animationPlaybackSpeed(1.0)
+          animation(), animationClipBoneIndices(),
+          animationPlaybackSpeed(1.0), deferredAnimationStep(0.0),
+          isAnimationPoseOutOfDate(false), isSkinningOutOfDate(true), animationSeenDistance(-1.0f)
     {
         // This will get the model into the correct state.
         this->OnDefinitionChanged();
@@ -62,7 +64,10 @@ namespace GT
         auto newMesh = this->AttachMesh(geometryIn, materialFileName);
         if (newMesh != nullptr)
         {
-            newMesh->SetSkinningData(this->bones.buffer, skinningVertexAttributes);
+            newMesh->SetSkinningData(this->skeletonPose.GetSkinningPalette(), skinningVertexAttributes);
+
+            // The new mesh has not been skinned yet.
+            this->isSkinningOutOfDate = true;
         }
 
         return newMesh;
@@ -97,6 +102,11 @@ namespace GT
                 parentBone->AttachChild(*bone);
             }
         }
+
+
+        // The pose needs to be rebuilt now that the hierarchy has changed.
+        this->skeletonPose.Build(this->bones);
+        this->isSkinningOutOfDate = true;
     }
 
     void Model::CopyAnimation(const Animation &sourceAnimation, const Map<Bone*, AnimationChannel*> &sourceAnimationChannelBones)
@@ -108,29 +118,18 @@ namespace GT
         }
 
 
-        // Here we add all of our channels to the animation. They will be empty to begin with, but filled below.
+        // The keys are not copied into channels of our own. The definition has already baked them into a clip that is shared by every
+        // model, in the same order as the channel map. Channel 'i' of that clip drives the bone at animationClipBoneIndices[i].
         for (size_t iChannel = 0; iChannel < sourceAnimationChannelBones.count; ++iChannel)
         {
-            auto sourceChannel = sourceAnimationChannelBones.buffer[iChannel]->value;
-            auto sourceBone    = sourceAnimationChannelBones.buffer[iChannel]->key;
+            auto sourceBone = sourceAnimationChannelBones.buffer[iChannel]->key;
 
-            auto bone = this->GetBoneByName(sourceBone->GetName());
+            size_t boneIndex;
+            auto bone = this->GetBoneByName(sourceBone->GetName(), &boneIndex);
             assert(bone != nullptr);
+            (void)bone;
 
-            auto &newChannel = this->animation.CreateChannel();
-            this->animationChannelBones.Add(bone, &newChannel);
-
-            // Now we loop through all the keys and add them.
-            auto &sourceKeys = sourceChannel->GetKeys();
-            for (size_t iKey = 0; iKey < sourceKeys.count; ++iKey)
-            {
-                auto sourceKey = static_cast<TransformAnimationKey*>(sourceKeys.buffer[iKey]->value);
-
-                auto newKey = new TransformAnimationKey(sourceKey->position, sourceKey->rotation, sourceKey->scale);
-                this->animationKeyCache.PushBack(newKey);
-
-                newChannel.SetKey(sourceKeys.buffer[iKey]->key, newKey);
-            }
+            this->animationClipBoneIndices.PushBack(boneIndex);
         }
 
 
@@ -600,54 +599,102 @@ namespace GT
 
     void Model::StepAnimation(double step)
     {
-        this->animation.Step(step * this->animationPlaybackSpeed);
+        this->AdvanceAnimation(step);
+        this->UpdateAnimationPose();
+    }
+
+    void Model::AdvanceAnimation(double step)
+    {
+        this->animation.Step((step + this->deferredAnimationStep) * this->animationPlaybackSpeed);
+        this->deferredAnimationStep = 0.0;
+
+        this->isAnimationPoseOutOfDate = true;
+    }
+
+    void Model::DeferAnimationStep(double step)
+    {
+        this->deferredAnimationStep += step;
+    }
 
-        glm::vec3 boneAABBMin = glm::vec3( FLT_MAX);
-        glm::vec3 boneAABBMax = glm::vec3(-FLT_MAX);
+    void Model::UpdateAnimationPose()
+    {
+        if (!this->isAnimationPoseOutOfDate)
+        {
+            return;
+        }
 
-        // Now that we've stepped the animation, we need to update the bone positions.
+        // The playback time has moved since the pose was last evaluated, so the bones need to be brought up to date.
         size_t startKeyFrame;
         size_t endKeyFrame;
         auto interpolationFactor = this->animation.GetKeyFramesAtCurrentPlayback(startKeyFrame, endKeyFrame);
 
-        for (size_t i = 0; i < this->animationChannelBones.count; ++i)
-        {
-            auto iChannelBone = this->animationChannelBones.buffer[i];
+        auto &animationClip = this->definition.animationClip;
+        assert(animationClip.GetChannelCount() == this->animationClipBoneIndices.count);
 
-            auto firstKey = static_cast<TransformAnimationKey*>(iChannelBone->value->GetKey(startKeyFrame));
-            auto endKey   = static_cast<TransformAnimationKey*>(iChannelBone->value->GetKey(endKeyFrame));
-            auto bone     = iChannelBone->key;
+        for (size_t i = 0; i < this->animationClipBoneIndices.count; ++i)
+        {
+            size_t boneIndex = this->animationClipBoneIndices.buffer[i];
 
-            if (firstKey != nullptr && endKey != nullptr)
+            glm::vec3 position;
+            glm::quat rotation;
+            glm::vec3 scale;
+            if (animationClip.Sample(i, startKeyFrame, endKeyFrame, interpolationFactor, position, rotation, scale))
             {
-                glm::vec3 position = glm::mix(  firstKey->position, endKey->position, interpolationFactor);
-                glm::quat rotation = glm::slerp(firstKey->rotation, endKey->rotation, interpolationFactor);
-                glm::vec3 scale    = glm::mix(  firstKey->scale,    endKey->scale,    interpolationFactor);
-
+                // The bones are kept up to date so their relative and absolute transforms can still be queried, but the skinning
+                // transforms are calculated by the pose.
+                auto bone = this->bones.buffer[boneIndex];
                 bone->SetPosition(position);
                 bone->SetRotation(rotation);
                 bone->SetScale(scale);
+
+                this->skeletonPose.SetLocalTransform(boneIndex, position, rotation, scale);
             }
         }
 
-        // Now we need to loop over each channel again and update the skinning transformations. It's important that this is done separately from the
-        // loop above to ensure all dependants have been updated beforehand.
-        for (size_t i = 0; i < this->animationChannelBones.count; ++i)
-        {
-            glm::vec3 position;
-            glm::quat devnull0;
-            glm::vec3 devnull1;
-            this->animationChannelBones.buffer[i]->key->UpdateSkinningTransform(position, devnull0, devnull1);
+        // Now the whole skeleton is evaluated in one pass, which writes the skinning palette used by the meshes.
+        this->skeletonPose.Evaluate();
 
-            boneAABBMin = glm::min(boneAABBMin, position);
-            boneAABBMax = glm::max(boneAABBMax, position);
-        }
+        glm::vec3 boneAABBMin;
+        glm::vec3 boneAABBMax;
+        this->skeletonPose.GetBoneAABB(boneAABBMin, boneAABBMax);
 
 
         // The AABB needs to be set, but with bone AABB padding applied.
         boneAABBMin -= this->definition.GetAnimationAABBPadding();
         boneAABBMax += this->definition.GetAnimationAABBPadding();
         this->SetAABB(boneAABBMin, boneAABBMax);
+
+        this->isAnimationPoseOutOfDate = false;
+        this->isSkinningOutOfDate      = true;
+    }
+
+    void Model::ApplySkinning()
+    {
+        // If the animation was advanced while nobody could see the model, this is where the skipped evaluation is caught up.
+        this->UpdateAnimationPose();
+
+        if (this->isSkinningOutOfDate)
+        {
+            for (size_t iMesh = 0; iMesh < this->meshes.count; ++iMesh)
+            {
+                auto mesh = this->meshes[iMesh];
+                assert(mesh != nullptr);
+                {
+                    mesh->ApplySkinning();
+                }
+            }
+
+            this->isSkinningOutOfDate = false;
+        }
+    }
+
+
+    void Model::MarkAsSeen(float cameraDistance) const
+    {
+        if (this->animationSeenDistance < 0.0f || cameraDistance < this->animationSeenDistance)
+        {
+            this->animationSeenDistance = cameraDistance;
+        }
     }
 
     bool Model::IsAnimating() const
@@ -709,14 +756,12 @@ namespace GT
             delete this->bones.buffer[i];
         }
         this->bones.Clear();
+        this->skeletonPose.Clear();
 
-        // Animation keys.
-        for (size_t i = 0; i < this->animationKeyCache.count; ++i)
-        {
-            delete this->animationKeyCache[i];
-        }
-        this->animationKeyCache.Clear();
-        this->animationChannelBones.Clear();
+        // Animation.
+        this->animationClipBoneIndices.Clear();
+        this->deferredAnimationStep    = 0.0;
+        this->isAnimationPoseOutOfDate = false;
 
 
         // The AABB is no longer valid.
@@ -10,7 +10,7 @@ namespace GT
     ModelDefinition::ModelDefinition(Context &context)
         : m_context(context), absolutePath(), relativePath(),
           meshes(), m_bones(),
-          m_animation(), animationChannelBones(), animationKeyCache(),
+          m_animation(), animationChannelBones(), animationKeyCache(), animationClip(),
           animationAABBPadding(0.25f),
           m_convexHulls(), convexHullBuildSettings()
     {
@@ -53,7 +53,7 @@ namespace GT
         {
             strcpy_s(newRelativePath, sizeof(newRelativePath), fileNameIn);
 
-            if (drfs_find_absolute_path(g_Context->GetVFS(), fileNameIn, newAbsolutePath, sizeof(newAbsolutePath)))
+            if (!g_Context->GetAssetLibrary().FindAbsolutePath(fileNameIn, newAbsolutePath, sizeof(newAbsolutePath)))
             {
                 return false;
             }
@@ -74,6 +74,44 @@ namespace GT
         }
 
 
+        // Models in a game package are loaded straight out of it. The packager leaves out foreign files that have a newer native file, so a
+        // foreign file in the package takes priority over the native one and there's nothing to serialize afterwards.
+        auto &assetLibrary = g_Context->GetAssetLibrary();
+        if (assetLibrary.IsPackagePath(newAbsolutePath))
+        {
+            bool successful = false;
+
+            size_t dataSize;
+            void* pBuffer;
+            const void* pData = assetLibrary.GetPackageFileData(newAbsolutePath, dataSize, pBuffer);
+            if (pData != nullptr)
+            {
+                successful = this->LoadFromForeignFile(newAbsolutePath, pData, dataSize);
+            }
+            else
+            {
+                free(pBuffer);
+
+                pData = assetLibrary.GetPackageFileData(nativeAbsolutePath, dataSize, pBuffer);
+                if (pData != nullptr)
+                {
+                    successful = this->LoadFromNativeFile(nativeAbsolutePath, pData, dataSize);
+                }
+            }
+
+            free(pBuffer);
+
+            if (successful)
+            {
+                this->absolutePath = newAbsolutePath;
+                this->relativePath = newRelativePath;
+            }
+
+            needsSerialize = false;
+            return successful;
+        }
+
+
         bool loadFromNativeFile = false;
 
         // We need file info of both the foreign and native files. If the foreign file is different to the file that would used to generate
@@ -161,6 +199,17 @@ namespace GT
         this->animationChannelBones.Add(&bone, &channel);
     }
 
+    void ModelDefinition::BakeAnimationClip()
+    {
+        Vector<const AnimationChannel*> channels(this->animationChannelBones.count);
+        for (size_t iChannel = 0; iChannel < this->animationChannelBones.count; ++iChannel)
+        {
+            channels.PushBack(this->animationChannelBones.buffer[iChannel]->value);
+        }
+
+        this->animationClip.Bake(m_animation, channels);
+    }
+
     void ModelDefinition::BuildConvexDecomposition(ConvexHullBuildSettings &settings)
     {
         // We need to delete the old convex hulls.
@@ -228,6 +277,7 @@ namespace GT
         this->animationKeyCache.Clear();
 
         this->animationChannelBones.Clear();
+        this->animationClip.Clear();
     }
 
     void ModelDefinition::ClearNamedAnimationSegments()
@@ -789,8 +839,12 @@ namespace GT
 
 
                         // Parents.
-                        auto boneParentIndices = static_cast<uint32_t*>(malloc(boneCount * sizeof(uint32_t)));
-                        deserializer.Read(boneParentIndices, boneCount * sizeof(uint32_t));
+                        void* boneParentIndicesBuffer;
+                        auto boneParentIndices = static_cast<const uint32_t*>(deserializer.ReadBlock(boneCount * sizeof(uint32_t), boneParentIndicesBuffer, alignof(uint32_t)));
+                        if (boneParentIndices == nullptr)
+                        {
+                            return false;
+                        }
 
                         for (uint32_t iBone = 0; iBone < boneCount; ++iBone)
                         {
@@ -802,7 +856,7 @@ namespace GT
                             }
                         }
 
-                        free(boneParentIndices);
+                        free(boneParentIndicesBuffer);
                     }
                     else
                     {
@@ -881,14 +935,21 @@ namespace GT
                             {
                                 newMesh.skinningVertexAttributes = new SkinningVertexAttribute[skinningVertexAttributeCount];
 
-                                auto counts = static_cast<uint16_t*>(malloc(skinningVertexAttributeCount * sizeof(uint16_t)));
-                                deserializer.Read(counts, skinningVertexAttributeCount * sizeof(uint16_t));
+                                void* countsBuffer;
+                                auto counts = static_cast<const uint16_t*>(deserializer.ReadBlock(skinningVertexAttributeCount * sizeof(uint16_t), countsBuffer, alignof(uint16_t)));
 
-                                uint32_t totalBoneWeights;
+                                uint32_t totalBoneWeights = 0;
                                 deserializer.Read(totalBoneWeights);
 
-                                auto boneWeights = static_cast<BoneWeightPair*>(malloc(totalBoneWeights * sizeof(BoneWeightPair)));
-                                deserializer.Read(boneWeights, totalBoneWeights * sizeof(BoneWeightPair));
+                                void* boneWeightsBuffer;
+                                auto boneWeights = static_cast<const BoneWeightPair*>(deserializer.ReadBlock(totalBoneWeights * sizeof(BoneWeightPair), boneWeightsBuffer, alignof(BoneWeightPair)));
+
+                                if (counts == nullptr || boneWeights == nullptr)
+                                {
+                                    free(countsBuffer);
+                                    free(boneWeightsBuffer);
+                                    return false;
+                                }
 
 
                                 auto currentBoneWeight = boneWeights;
@@ -906,8 +967,8 @@ namespace GT
                                     }
                                 }
 
-                                free(counts);
-                                free(boneWeights);
+                                free(countsBuffer);
+                                free(boneWeightsBuffer);
                             }
 
 
@@ -1048,25 +1109,32 @@ namespace GT
                         uint32_t convexHullCount;
                         deserializer.Read(convexHullCount);
 
-                        uint32_t* vertexCounts = static_cast<uint32_t*>(malloc(convexHullCount * sizeof(uint32_t)));
-                        uint32_t* indexCounts  = static_cast<uint32_t*>(malloc(convexHullCount * sizeof(uint32_t)));
+                        void* vertexCountsBuffer;
+                        void* indexCountsBuffer;
+                        auto vertexCounts = static_cast<const uint32_t*>(deserializer.ReadBlock(convexHullCount * sizeof(uint32_t), vertexCountsBuffer, alignof(uint32_t)));
+                        auto indexCounts  = static_cast<const uint32_t*>(deserializer.ReadBlock(convexHullCount * sizeof(uint32_t), indexCountsBuffer,  alignof(uint32_t)));
 
-                        deserializer.Read(vertexCounts, convexHullCount * sizeof(uint32_t));
-                        deserializer.Read(indexCounts,  convexHullCount * sizeof(uint32_t));
 
-
-                        uint32_t totalVertexCount;
+                        uint32_t totalVertexCount = 0;
                         deserializer.Read(totalVertexCount);
 
-                        uint32_t totalIndexCount;
+                        uint32_t totalIndexCount = 0;
                         deserializer.Read(totalIndexCount);
 
 
-                        auto vertices = static_cast<float*   >(malloc(totalVertexCount * sizeof(float)));
-                        auto indices  = static_cast<uint32_t*>(malloc(totalIndexCount  * sizeof(uint32_t)));
+                        void* verticesBuffer;
+                        void* indicesBuffer;
+                        auto vertices = static_cast<const float*   >(deserializer.ReadBlock(totalVertexCount * sizeof(float),    verticesBuffer, alignof(float)));
+                        auto indices  = static_cast<const uint32_t*>(deserializer.ReadBlock(totalIndexCount  * sizeof(uint32_t), indicesBuffer,  alignof(uint32_t)));
 
-                        deserializer.Read(vertices, totalVertexCount * sizeof(float));
-                        deserializer.Read(indices,  totalIndexCount  * sizeof(uint32_t));
+                        if (vertexCounts == nullptr || indexCounts == nullptr || vertices == nullptr || indices == nullptr)
+                        {
+                            free(vertexCountsBuffer);
+                            free(indexCountsBuffer);
+                            free(verticesBuffer);
+                            free(indicesBuffer);
+                            return false;
+                        }
 
 
                         auto currentVertices = vertices;
@@ -1089,10 +1157,10 @@ namespace GT
                         deserializer.Read(this->convexHullBuildSettings);
 
 
-                        free(vertexCounts);
-                        free(indexCounts);
-                        free(vertices);
-                        free(indices);
+                        free(vertexCountsBuffer);
+                        free(indexCountsBuffer);
+                        free(verticesBuffer);
+                        free(indicesBuffer);
                     }
                     else
                     {
@@ -1127,6 +1195,9 @@ namespace GT
         }
 
 
+        // Every model of this definition samples the same baked clip, so it is baked once here rather than by each model.
+        this->BakeAnimationClip();
+
         // If we get here, we were successful.
         return true;
     }
@@ -1135,9 +1206,24 @@ namespace GT
     ////////////////////////////////////////////////////////
     // Private
 
-    bool ModelDefinition::LoadFromNativeFile(const String &absolutePathIn)
+    bool ModelDefinition::LoadFromNativeFile(const String &absolutePathIn, const void* pData, size_t dataSize)
     {
-        // When loading from a native file, all we need to do is deserialize.
+        if (pData != nullptr)
+        {
+            BasicDeserializer deserializer(pData, dataSize);
+            return this->Deserialize(deserializer);
+        }
+
+        // When loading from a native file, all we need to do is deserialize. We prefer to map the file so the bulk data can be read without
+        // any intermediary copies, but that only works for files that aren't inside an archive.
+        {
+            MappedFileDeserializer deserializer(absolutePathIn.c_str());
+            if (deserializer.IsOpen())
+            {
+                return this->Deserialize(deserializer);
+            }
+        }
+
         bool successful = false;
 
         drfs_file* pFile;
@@ -1152,9 +1238,9 @@ namespace GT
         return successful;
     }
 
-    bool ModelDefinition::LoadFromForeignFile(const String &absolutePathIn)
+    bool ModelDefinition::LoadFromForeignFile(const String &absolutePathIn, const void* pData, size_t dataSize)
     {
         // Currently, all foreign formats are loaded via Assimp.
-        return this->LoadFromAssimpFile(absolutePathIn);
+        return this->LoadFromAssimpFile(absolutePathIn, pData, dataSize);
     }
 }
@@ -427,12 +427,22 @@ namespace GT
 
 
 
-    bool ModelDefinition::LoadFromAssimpFile(const String &absolutePathIn)
+    bool ModelDefinition::LoadFromAssimpFile(const String &absolutePathIn, const void* pData, size_t dataSize)
     {
         Assimp::Importer importer;
         importer.SetPropertyInteger(AI_CONFIG_PP_RVC_FLAGS, AssimpRemovedComponentsFlags);
 
-        auto scene = importer.ReadFile(absolutePathIn.c_str(), AssimpReadFileFlags);
+        // Assimp can't tell the format of data in memory by itself, so it's given the extension as a hint.
+        const aiScene* scene;
+        if (pData != nullptr)
+        {
+            scene = importer.ReadFileFromMemory(pData, dataSize, AssimpReadFileFlags, drpath_extension(absolutePathIn.c_str()));
+        }
+        else
+        {
+            scene = importer.ReadFile(absolutePathIn.c_str(), AssimpReadFileFlags);
+        }
+
         if (scene != nullptr)
         {
             auto root = scene->mRootNode;
@@ -553,6 +563,8 @@ namespace GT
                     }
                 }
 
+                this->BakeAnimationClip();
+
                 return true;
             }
             else
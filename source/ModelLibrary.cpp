@@ -321,7 +321,7 @@ namespace GT
     bool ModelLibrary::FindAbsolutePath(const char* relativePath, String &absolutePath)
     {
         char absolutePathTemp[DRFS_MAX_PATH];
-        if (!drfs_find_absolute_path(g_Context->GetVFS(), relativePath, absolutePathTemp, sizeof(absolutePathTemp)))
+        if (!g_Context->GetAssetLibrary().FindAbsolutePath(relativePath, absolutePathTemp, sizeof(absolutePathTemp)))
         {
             char adjustedRelativePath[DRFS_MAX_PATH];
             strcpy_s(adjustedRelativePath, sizeof(adjustedRelativePath), relativePath);
@@ -332,7 +332,7 @@ namespace GT
                 drpath_append_extension(adjustedRelativePath, sizeof(adjustedRelativePath), "gtmodel");
             }
 
-            if (!drfs_find_absolute_path(g_Context->GetVFS(), adjustedRelativePath, absolutePathTemp, sizeof(absolutePathTemp))) {
+            if (!g_Context->GetAssetLibrary().FindAbsolutePath(adjustedRelativePath, absolutePathTemp, sizeof(absolutePathTemp))) {
                 return false;
             }
         }
@@ -84,7 +84,7 @@ namespace GT
           functions(),
           random(),
           timeSinceLastEmission(1.0 / emissionRatePerSecond),
-          particles(),
+          particles(), m_lifetimeRatios(),
           m_aabbMin(), m_aabbMax(),
           vertexArray(Renderer::CreateVertexArray(VertexArrayUsage_Dynamic, VertexFormat::P4T4N4C4))
     {
@@ -105,7 +105,7 @@ namespace GT
           functions(),
           random(other.random),
           timeSinceLastEmission(other.timeSinceLastEmission),
-          particles(other.particles),
+          particles(other.particles), m_lifetimeRatios(),
           m_aabbMin(other.m_aabbMin), m_aabbMax(other.m_aabbMax),
           vertexArray(Renderer::CreateVertexArray(VertexArrayUsage_Dynamic, VertexFormat::P4T4N4C4))
     {
@@ -259,7 +259,7 @@ namespace GT
 
         for (int i = 0; i < spawnCount; ++i)
         {
-            auto &particle = this->particles.PushNewParticle();
+            size_t iNewParticle = this->particles.PushNewParticle();
 
 
 
@@ -321,110 +321,189 @@ namespace GT
             glm::mat4 transform = glm::mat4_cast(m_orientation);
             transform[3] = glm::vec4(m_position, 1.0f);
 
-            particle.scale = glm::vec4(
+            this->particles.scales[iNewParticle] = glm::vec4(
                 this->random.Next(this->startScaleMin.x, this->startScaleMax.x),
                 this->random.Next(this->startScaleMin.y, this->startScaleMax.y),
                 this->random.Next(this->startScaleMin.z, this->startScaleMax.z),
                 1.0f);
 
-            particle.orientation = glm::quat(glm::radians(glm::vec3(
+            this->particles.orientations[iNewParticle] = glm::quat(glm::radians(glm::vec3(
                 this->random.Next(this->startRotationMin.x, this->startRotationMax.x),
                 this->random.Next(this->startRotationMin.y, this->startRotationMax.y),
                 this->random.Next(this->startRotationMin.z, this->startRotationMax.z))));
 
-            particle.position            = transform * spawnPosition;
-            particle.spawnLinearVelocity = (m_orientation * spawnDirection) * static_cast<float>(this->random.Next(this->startSpeedMin, this->startSpeedMax));
+            this->particles.positions[iNewParticle]             = transform * spawnPosition;
+            this->particles.spawnLinearVelocities[iNewParticle] = (m_orientation * spawnDirection) * static_cast<float>(this->random.Next(this->startSpeedMin, this->startSpeedMax));
 
 
-            particle.timeLeftToDeath = particle.lifetime = this->random.Next(this->lifetimeMin, this->lifetimeMax);
+            this->particles.timesLeftToDeath[iNewParticle] = this->particles.lifetimes[iNewParticle] = static_cast<float>(this->random.Next(this->lifetimeMin, this->lifetimeMax));
         }
 
 
 
 
-        // Here we will update any still-alive particles.
-        glm::vec4 aabbMin = glm::vec4( FLT_MAX);
-        glm::vec4 aabbMax = glm::vec4(-FLT_MAX);
+        // Here we will update any still-alive particles. Each property is updated in it's own pass over the relevant streams.
+        //
+        // Particles are aged first so that the dead ones can be removed before doing any other work on them.
+        {
+            size_t particleCount = this->particles.GetCount();
+            size_t simdCount     = 0;
 
+            auto timesLeftToDeath = this->particles.timesLeftToDeath;
 
-        const float    uTexCoordSize  = 1.0f / this->textureTilesX;
-        const float    vTexCoordSize  = 1.0f / this->textureTilesY;
-        const uint32_t tileCount      = this->textureTilesX * this->textureTilesY;
+        #if defined(GT_BUILD_SSE2)
+            const __m128 deltaTime4 = _mm_set1_ps(deltaTimeInSecondsF);
+
+            simdCount = particleCount & ~static_cast<size_t>(3);
+            for (size_t iParticle = 0; iParticle < simdCount; iParticle += 4)
+            {
+                _mm_store_ps(timesLeftToDeath + iParticle, _mm_sub_ps(_mm_load_ps(timesLeftToDeath + iParticle), deltaTime4));
+            }
+        #endif
+
+            for (size_t iParticle = simdCount; iParticle < particleCount; ++iParticle)
+            {
+                timesLeftToDeath[iParticle] -= deltaTimeInSecondsF;
+            }
+
+            this->particles.RemoveDeadParticles();
+        }
+
+
+        size_t particleCount = this->particles.GetCount();
+
+        auto positions                = this->particles.positions;
+        auto orientations             = this->particles.orientations;
+        auto linearVelocities         = this->particles.linearVelocities;
+        auto angularVelocities        = this->particles.angularVelocities;
+        auto spawnLinearVelocities    = this->particles.spawnLinearVelocities;
+        auto gravityLinearVelocities  = this->particles.gravityLinearVelocities;
+        auto functionLinearVelocities = this->particles.functionLinearVelocities;
 
 
-        size_t iParticle = 0;
-        while (iParticle < this->particles.GetCount())
+        // Lifetime ratios. These are used by the functions and texture tiles.
+        m_lifetimeRatios.Resize(particleCount);
+        auto lifetimeRatios = m_lifetimeRatios.buffer;
         {
-            auto &particle = this->GetParticle(iParticle);
+            auto lifetimes        = this->particles.lifetimes;
+            auto timesLeftToDeath = this->particles.timesLeftToDeath;
+            size_t simdCount      = 0;
+
+        #if defined(GT_BUILD_SSE2)
+            const __m128 one4 = _mm_set1_ps(1.0f);
+
+            simdCount = particleCount & ~static_cast<size_t>(3);
+            for (size_t iParticle = 0; iParticle < simdCount; iParticle += 4)
             {
-                particle.timeLeftToDeath -= deltaTimeInSeconds;
-                if (particle.timeLeftToDeath <= 0.0)
-                {
-                    // The particle is dead. Needs to be removed.
-                    this->particles.Remove(iParticle);
-                }
-                else
-                {
-                    // The particle is still alive. We need to update it.
-                    //
-                    // For now, we will just move it in the direction of the emitter for the sake of testing.
-                    particle.gravityLinearVelocity += gravity;
-                    particle.linearVelocity         = particle.gravityLinearVelocity + particle.spawnLinearVelocity + particle.functionLinearVelocity;
-
-                    particle.position              += particle.linearVelocity * deltaTimeInSecondsF;
-                    particle.orientation            = particle.orientation * MixFromOrigin(particle.angularVelocity, deltaTimeInSecondsF);
-
-                    // At this point we need to run all of the functions that are currently being used by the emitter.
-                    float lifetimeRatio = static_cast<float>(1.0 - (particle.timeLeftToDeath / particle.lifetime));
-                    for (size_t iFunction = 0; iFunction < this->functions.count; ++iFunction)
-                    {
-                        auto function = this->functions[iFunction];
-                        assert(function != nullptr);
-                        {
-                            function->Execute(particle, lifetimeRatio);
-                        }
-                    }
+                _mm_storeu_ps(lifetimeRatios + iParticle, _mm_sub_ps(one4, _mm_div_ps(_mm_load_ps(timesLeftToDeath + iParticle), _mm_load_ps(lifetimes + iParticle))));
+            }
+        #endif
 
+            for (size_t iParticle = simdCount; iParticle < particleCount; ++iParticle)
+            {
+                lifetimeRatios[iParticle] = 1.0f - (timesLeftToDeath[iParticle] / lifetimes[iParticle]);
+            }
+        }
 
-                    // The tile we pick will depend on the lifetime ratio of the particle.
-                    float currentTile = glm::floor(lifetimeRatio * (tileCount - 1));
 
-                    float uvTile0 = currentTile;
-                    float uvTile1 = (currentTile < tileCount - 1) ? currentTile + 1 : currentTile;
-                    
+        // Linear velocity and position.
+        glm::vec4 aabbMin = glm::vec4( FLT_MAX);
+        glm::vec4 aabbMax = glm::vec4(-FLT_MAX);
 
-                    float uStartTile0      = glm::mod(uvTile0, static_cast<float>(this->textureTilesX));
-                    float vStartTile0      = glm::floor(uvTile0 / this->textureTilesX);
+    #if defined(GT_BUILD_SSE2)
+        {
+            const __m128 gravity4   = _mm_loadu_ps(&gravity.x);
+            const __m128 deltaTime4 = _mm_set1_ps(deltaTimeInSecondsF);
 
-                    particle.uTexCoordMin0 =        uStartTile0 / this->textureTilesX;
-                    particle.uTexCoordMax0 = particle.uTexCoordMin0 + uTexCoordSize;
-                    particle.vTexCoordMin0 = 1.0f - vStartTile0 / this->textureTilesY - vTexCoordSize;
-                    particle.vTexCoordMax0 = particle.vTexCoordMin0 + vTexCoordSize;
+            __m128 aabbMin4 = _mm_loadu_ps(&aabbMin.x);
+            __m128 aabbMax4 = _mm_loadu_ps(&aabbMax.x);
 
+            for (size_t iParticle = 0; iParticle < particleCount; ++iParticle)
+            {
+                __m128 gravityLinearVelocity = _mm_add_ps(_mm_load_ps(&gravityLinearVelocities[iParticle].x), gravity4);
+                __m128 linearVelocity        = _mm_add_ps(_mm_add_ps(gravityLinearVelocity, _mm_load_ps(&spawnLinearVelocities[iParticle].x)), _mm_load_ps(&functionLinearVelocities[iParticle].x));
+                __m128 position              = _mm_add_ps(_mm_load_ps(&positions[iParticle].x), _mm_mul_ps(linearVelocity, deltaTime4));
 
-                    float uStartTile1      = glm::mod(uvTile1, static_cast<float>(this->textureTilesX));
-                    float vStartTile1      = glm::floor(uvTile1 / this->textureTilesX);
+                _mm_store_ps(&gravityLinearVelocities[iParticle].x, gravityLinearVelocity);
+                _mm_store_ps(&linearVelocities[iParticle].x,        linearVelocity);
+                _mm_store_ps(&positions[iParticle].x,               position);
 
-                    particle.uTexCoordMin1 =        uStartTile1 / this->textureTilesX;
-                    particle.uTexCoordMax1 = particle.uTexCoordMin1 + uTexCoordSize;
-                    particle.vTexCoordMin1 = 1.0f - vStartTile1 / this->textureTilesY - vTexCoordSize;
-                    particle.vTexCoordMax1 = particle.vTexCoordMin1 + vTexCoordSize;
+                aabbMin4 = _mm_min_ps(aabbMin4, position);
+                aabbMax4 = _mm_max_ps(aabbMax4, position);
+            }
 
+            _mm_storeu_ps(&aabbMin.x, aabbMin4);
+            _mm_storeu_ps(&aabbMax.x, aabbMax4);
+        }
+    #else
+        for (size_t iParticle = 0; iParticle < particleCount; ++iParticle)
+        {
+            gravityLinearVelocities[iParticle] += gravity;
+            linearVelocities[iParticle]         = gravityLinearVelocities[iParticle] + spawnLinearVelocities[iParticle] + functionLinearVelocities[iParticle];
+            positions[iParticle]               += linearVelocities[iParticle] * deltaTimeInSecondsF;
 
-                    particle.uvTileInterpolationFactor = (uvTile1 - (lifetimeRatio * (tileCount - 1)));
+            aabbMin = glm::min(aabbMin, positions[iParticle]);
+            aabbMax = glm::max(aabbMax, positions[iParticle]);
+        }
+    #endif
 
 
-                    // We need to check the position against the AABB.
-                    aabbMin = glm::min(aabbMin, particle.position);
-                    aabbMax = glm::max(aabbMax, particle.position);
+        // Orientation.
+        for (size_t iParticle = 0; iParticle < particleCount; ++iParticle)
+        {
+            orientations[iParticle] = orientations[iParticle] * MixFromOrigin(angularVelocities[iParticle], deltaTimeInSecondsF);
+        }
 
 
-                    ++iParticle;
-                }
+        // At this point we need to run all of the functions that are currently being used by the emitter.
+        for (size_t iFunction = 0; iFunction < this->functions.count; ++iFunction)
+        {
+            auto function = this->functions[iFunction];
+            assert(function != nullptr);
+            {
+                function->Execute(this->particles, 0, particleCount, lifetimeRatios);
             }
         }
 
 
+        // Texture tiles. The tile we pick will depend on the lifetime ratio of the particle.
+        const float    uTexCoordSize  = 1.0f / this->textureTilesX;
+        const float    vTexCoordSize  = 1.0f / this->textureTilesY;
+        const uint32_t tileCount      = this->textureTilesX * this->textureTilesY;
+
+        auto texCoordBounds0            = this->particles.texCoordBounds0;
+        auto texCoordBounds1            = this->particles.texCoordBounds1;
+        auto uvTileInterpolationFactors = this->particles.uvTileInterpolationFactors;
+
+        for (size_t iParticle = 0; iParticle < particleCount; ++iParticle)
+        {
+            float lifetimeRatio = lifetimeRatios[iParticle];
+            float currentTile   = glm::floor(lifetimeRatio * (tileCount - 1));
+
+            float uvTile0 = currentTile;
+            float uvTile1 = (currentTile < tileCount - 1) ? currentTile + 1 : currentTile;
+            
+
+            float uStartTile0 = glm::mod(uvTile0, static_cast<float>(this->textureTilesX));
+            float vStartTile0 = glm::floor(uvTile0 / this->textureTilesX);
+
+            float uTexCoordMin0 =        uStartTile0 / this->textureTilesX;
+            float vTexCoordMin0 = 1.0f - vStartTile0 / this->textureTilesY - vTexCoordSize;
+            texCoordBounds0[iParticle] = glm::vec4(uTexCoordMin0, vTexCoordMin0, uTexCoordMin0 + uTexCoordSize, vTexCoordMin0 + vTexCoordSize);
+
+
+            float uStartTile1 = glm::mod(uvTile1, static_cast<float>(this->textureTilesX));
+            float vStartTile1 = glm::floor(uvTile1 / this->textureTilesX);
+
+            float uTexCoordMin1 =        uStartTile1 / this->textureTilesX;
+            float vTexCoordMin1 = 1.0f - vStartTile1 / this->textureTilesY - vTexCoordSize;
+            texCoordBounds1[iParticle] = glm::vec4(uTexCoordMin1, vTexCoordMin1, uTexCoordMin1 + uTexCoordSize, vTexCoordMin1 + vTexCoordSize);
+
+
+            uvTileInterpolationFactors[iParticle] = (uvTile1 - (lifetimeRatio * (tileCount - 1)));
+        }
+
+
         m_aabbMin = glm::vec3(aabbMin.x, aabbMin.y, aabbMin.z);
         m_aabbMax = glm::vec3(aabbMax.x, aabbMax.y, aabbMax.z);
         
@@ -813,7 +892,10 @@ namespace GT
 
             for (uint32_t iParticle = 0; iParticle < particleCount; ++iParticle)
             {
-                this->SerializeParticle(intermediarySerializer, this->particles.GetParticle(iParticle));
+                Particle particle;
+                this->particles.GetParticle(iParticle, particle);
+
+                this->SerializeParticle(intermediarySerializer, particle);
             }
 
 
@@ -918,10 +1000,10 @@ namespace GT
 
                             for (uint32_t iParticle = 0; iParticle < particleCount; ++iParticle)
                             {
-                                auto &particle = this->particles.PushNewParticle();
-                                {
-                                    this->DeserializeParticle(deserializer, particle);
-                                }
+                                Particle particle;
+                                this->DeserializeParticle(deserializer, particle);
+
+                                this->particles.SetParticle(this->particles.PushNewParticle(), particle);
                             }
                         }
                     }
@@ -95,9 +95,27 @@ namespace GT
     ///////////////////////////////////////
     // Size over Time
 
-    void ParticleFunction_SizeOverTime::Execute(Particle &particle, float lifetimeRatio)
+    void ParticleFunction_SizeOverTime::Execute(ParticleList &particles, size_t firstParticle, size_t endParticle, const float* lifetimeRatios)
     {
-        particle.scale = glm::vec4(this->Evaluate(lifetimeRatio));
+        float rangeMin;
+        float rangeMax;
+        this->GetRange(rangeMin, rangeMax);
+
+    #if defined(GT_BUILD_SSE2)
+        const __m128 rangeMin4   = _mm_set1_ps(rangeMin);
+        const __m128 rangeDelta4 = _mm_set1_ps(rangeMax - rangeMin);
+
+        for (size_t iParticle = firstParticle; iParticle < endParticle; ++iParticle)
+        {
+            __m128 ratio = _mm_set1_ps(lifetimeRatios[iParticle]);
+            _mm_store_ps(&particles.scales[iParticle].x, _mm_add_ps(rangeMin4, _mm_mul_ps(ratio, rangeDelta4)));
+        }
+    #else
+        for (size_t iParticle = firstParticle; iParticle < endParticle; ++iParticle)
+        {
+            particles.scales[iParticle] = glm::vec4(glm::mix(rangeMin, rangeMax, lifetimeRatios[iParticle]));
+        }
+    #endif
     }
 
 
@@ -105,10 +123,28 @@ namespace GT
     ///////////////////////////////////////
     // Linear Velocity over Time
 
-    void ParticleFunction_LinearVelocityOverTime::Execute(Particle &particle, float lifetimeRatio)
-    {
-        glm::vec3 temp = this->Evaluate(lifetimeRatio);
-        particle.functionLinearVelocity = glm::vec4(temp.x, temp.y, temp.z, 1.0f);
+    void ParticleFunction_LinearVelocityOverTime::Execute(ParticleList &particles, size_t firstParticle, size_t endParticle, const float* lifetimeRatios)
+    {
+        glm::vec3 rangeMin;
+        glm::vec3 rangeMax;
+        this->GetRange(rangeMin, rangeMax);
+
+    #if defined(GT_BUILD_SSE2)
+        // The w component is 1 at both ends of the range, so it stays at exactly 1.
+        const __m128 rangeMin4   = _mm_setr_ps(rangeMin.x, rangeMin.y, rangeMin.z, 1.0f);
+        const __m128 rangeDelta4 = _mm_setr_ps(rangeMax.x - rangeMin.x, rangeMax.y - rangeMin.y, rangeMax.z - rangeMin.z, 0.0f);
+
+        for (size_t iParticle = firstParticle; iParticle < endParticle; ++iParticle)
+        {
+            __m128 ratio = _mm_set1_ps(lifetimeRatios[iParticle]);
+            _mm_store_ps(&particles.functionLinearVelocities[iParticle].x, _mm_add_ps(rangeMin4, _mm_mul_ps(ratio, rangeDelta4)));
+        }
+    #else
+        for (size_t iParticle = firstParticle; iParticle < endParticle; ++iParticle)
+        {
+            particles.functionLinearVelocities[iParticle] = glm::vec4(glm::mix(rangeMin, rangeMax, lifetimeRatios[iParticle]), 1.0f);
+        }
+    #endif
     }
     
 
@@ -116,9 +152,43 @@ namespace GT
     ///////////////////////////////////////
     // Angular Velocity over Time
 
-    void ParticleFunction_AngularVelocityOverTime::Execute(Particle &particle, float lifetimeRatio)
-    {
-        particle.angularVelocity = glm::fastMix(this->rangeMinQuat, this->rangeMaxQuat, lifetimeRatio);
+    void ParticleFunction_AngularVelocityOverTime::Execute(ParticleList &particles, size_t firstParticle, size_t endParticle, const float* lifetimeRatios)
+    {
+    #if defined(GT_BUILD_SSE2)
+        // This is glm::fastMix(), which is a normalized lerp. The component order of the quaternion doesn't matter here because every
+        // operation is applied to each component equally.
+        const glm::quat identityQuat(1.0f, 0.0f, 0.0f, 0.0f);
+
+        const __m128 rangeMin4   = _mm_loadu_ps(&this->rangeMinQuat.x);
+        const __m128 rangeDelta4 = _mm_sub_ps(_mm_loadu_ps(&this->rangeMaxQuat.x), rangeMin4);
+        const __m128 identity    = _mm_loadu_ps(&identityQuat.x);
+
+        for (size_t iParticle = firstParticle; iParticle < endParticle; ++iParticle)
+        {
+            __m128 ratio = _mm_set1_ps(lifetimeRatios[iParticle]);
+            __m128 q     = _mm_add_ps(rangeMin4, _mm_mul_ps(ratio, rangeDelta4));
+
+            __m128 lengthSq = _mm_mul_ps(q, q);
+            lengthSq = _mm_add_ps(lengthSq, _mm_shuffle_ps(lengthSq, lengthSq, _MM_SHUFFLE(2,3,0,1)));
+            lengthSq = _mm_add_ps(lengthSq, _mm_shuffle_ps(lengthSq, lengthSq, _MM_SHUFFLE(1,0,3,2)));
+
+            if (_mm_cvtss_f32(lengthSq) > 0.0f)
+            {
+                q = _mm_div_ps(q, _mm_sqrt_ps(lengthSq));
+            }
+            else
+            {
+                q = identity;
+            }
+
+            _mm_store_ps(&particles.angularVelocities[iParticle].x, q);
+        }
+    #else
+        for (size_t iParticle = firstParticle; iParticle < endParticle; ++iParticle)
+        {
+            particles.angularVelocities[iParticle] = glm::fastMix(this->rangeMinQuat, this->rangeMaxQuat, lifetimeRatios[iParticle]);
+        }
+    #endif
     }
 
     void ParticleFunction_AngularVelocityOverTime::SetRange(const glm::vec3 &rangeMin, const glm::vec3 &rangeMax)
@@ -134,17 +204,49 @@ namespace GT
     ///////////////////////////////////////
     // ColorF over Time
 
-    void ParticleFunction_ColourOverTime::Execute(Particle &particle, float lifetimeRatio)
+    void ParticleFunction_ColourOverTime::Execute(ParticleList &particles, size_t firstParticle, size_t endParticle, const float* lifetimeRatios)
     {
-        glm::vec3 temp = this->Evaluate(lifetimeRatio);
-        particle.colour = glm::vec4(temp.x, temp.y, temp.z, particle.colour.w);
+        glm::vec3 rangeMin;
+        glm::vec3 rangeMax;
+        this->GetRange(rangeMin, rangeMax);
+
+    #if defined(GT_BUILD_SSE2)
+        const __m128 rangeMin4   = _mm_setr_ps(rangeMin.x, rangeMin.y, rangeMin.z, 0.0f);
+        const __m128 rangeDelta4 = _mm_setr_ps(rangeMax.x - rangeMin.x, rangeMax.y - rangeMin.y, rangeMax.z - rangeMin.z, 0.0f);
+
+        for (size_t iParticle = firstParticle; iParticle < endParticle; ++iParticle)
+        {
+            __m128 ratio     = _mm_set1_ps(lifetimeRatios[iParticle]);
+            __m128 rgb       = _mm_add_ps(rangeMin4, _mm_mul_ps(ratio, rangeDelta4));
+            __m128 oldColour = _mm_load_ps(&particles.colours[iParticle].x);
+
+            // The alpha channel is left alone - that's handled by the Alpha over Time function.
+            __m128 ba = _mm_shuffle_ps(rgb, oldColour, _MM_SHUFFLE(3,3,2,2));
+            _mm_store_ps(&particles.colours[iParticle].x, _mm_shuffle_ps(rgb, ba, _MM_SHUFFLE(2,0,1,0)));
+        }
+    #else
+        for (size_t iParticle = firstParticle; iParticle < endParticle; ++iParticle)
+        {
+            glm::vec3 temp = glm::mix(rangeMin, rangeMax, lifetimeRatios[iParticle]);
+            particles.colours[iParticle] = glm::vec4(temp.x, temp.y, temp.z, particles.colours[iParticle].w);
+        }
+    #endif
     }
 
     ///////////////////////////////////////
     // Alpha over Time
 
-    void ParticleFunction_AlphaOverTime::Execute(Particle &particle, float lifetimeRatio)
+    void ParticleFunction_AlphaOverTime::Execute(ParticleList &particles, size_t firstParticle, size_t endParticle, const float* lifetimeRatios)
     {
-        particle.colour.w = this->Evaluate(lifetimeRatio);
+        float rangeMin;
+        float rangeMax;
+        this->GetRange(rangeMin, rangeMax);
+
+        const float rangeDelta = rangeMax - rangeMin;
+
+        for (size_t iParticle = firstParticle; iParticle < endParticle; ++iParticle)
+        {
+            particles.colours[iParticle].w = rangeMin + (lifetimeRatios[iParticle] * rangeDelta);
+        }
     }
 }
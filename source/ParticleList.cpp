@@ -6,23 +6,48 @@
 
 namespace GT
 {
+    /// The number of 16 byte streams (vec4 and quat) in a particle list.
+    static const size_t ParticleList_Vec4StreamCount  = 11;
+
+    /// The number of float streams in a particle list.
+    static const size_t ParticleList_FloatStreamCount = 3;
+
+    /// Rounds a particle count up to a multiple of 4 so that each float stream is a multiple of 16 bytes. This keeps every stream aligned
+    /// and means the float streams can be safely processed 4 at a time.
+    static inline size_t ParticleList_PadCount(size_t particleCount)
+    {
+        return (particleCount + 3) & ~static_cast<size_t>(3);
+    }
+
+
     ParticleList::ParticleList(size_t initialBufferSize)
-        : buffer(nullptr), bufferSize(0), count(0), startIndex(0)
+        : positions(nullptr), orientations(nullptr), scales(nullptr),
+          linearVelocities(nullptr), angularVelocities(nullptr),
+          spawnLinearVelocities(nullptr), gravityLinearVelocities(nullptr), functionLinearVelocities(nullptr),
+          colours(nullptr), texCoordBounds0(nullptr), texCoordBounds1(nullptr),
+          lifetimes(nullptr), timesLeftToDeath(nullptr), uvTileInterpolationFactors(nullptr),
+          buffer(nullptr), bufferSize(0), count(0)
     {
         this->Resize(initialBufferSize);
     }
 
     ParticleList::ParticleList(const ParticleList &other)
-        : buffer(nullptr), bufferSize(0), count(0), startIndex(0)
+        : positions(nullptr), orientations(nullptr), scales(nullptr),
+          linearVelocities(nullptr), angularVelocities(nullptr),
+          spawnLinearVelocities(nullptr), gravityLinearVelocities(nullptr), functionLinearVelocities(nullptr),
+          colours(nullptr), texCoordBounds0(nullptr), texCoordBounds1(nullptr),
+          lifetimes(nullptr), timesLeftToDeath(nullptr), uvTileInterpolationFactors(nullptr),
+          buffer(nullptr), bufferSize(0), count(0)
     {
         if (other.buffer != nullptr && other.bufferSize > 0)
         {
-            this->startIndex = other.startIndex;
-            this->count      = other.count;
-            this->bufferSize = other.bufferSize;
-            this->buffer     = static_cast<Particle*>(malloc(other.bufferSize * sizeof(Particle)));
+            size_t bufferSizeInBytes = CalculateBufferSizeInBytes(other.bufferSize);
+
+            this->count  = other.count;
+            this->buffer = _mm_malloc(bufferSizeInBytes, 16);
+            memcpy(this->buffer, other.buffer, bufferSizeInBytes);
 
-            memcpy(this->buffer, other.buffer, other.bufferSize * sizeof(Particle));
+            this->SetStreamPointers(this->buffer, other.bufferSize);
         }
     }
 
@@ -32,7 +57,7 @@ namespace GT
     }
 
 
-    Particle & ParticleList::PushNewParticle()
+    size_t ParticleList::PushNewParticle()
     {
         // Make sure there is enough space.
         if (this->bufferSize == this->count)
@@ -40,10 +65,26 @@ namespace GT
             this->Resize((this->bufferSize == 0) ? 1 : this->bufferSize * 2);
         }
 
-        auto result = new (this->buffer + ((this->startIndex + this->count) % this->bufferSize)) Particle();      // TODO: See if we can avoid this constructor. Will need to document.
+        size_t index = this->count;
         this->count += 1;
 
-        return *result;
+        // Same defaults as the Particle constructor.
+        this->positions[index]                  = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        this->orientations[index]               = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        this->scales[index]                     = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+        this->linearVelocities[index]           = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        this->angularVelocities[index]          = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        this->spawnLinearVelocities[index]      = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        this->gravityLinearVelocities[index]    = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        this->functionLinearVelocities[index]   = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        this->colours[index]                    = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+        this->texCoordBounds0[index]            = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+        this->texCoordBounds1[index]            = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+        this->lifetimes[index]                  = 1.0f;
+        this->timesLeftToDeath[index]           = 1.0f;
+        this->uvTileInterpolationFactors[index] = 0.0f;
+
+        return index;
     }
 
     void ParticleList::Remove(size_t index)
@@ -51,44 +92,35 @@ namespace GT
         assert(this->count > 0);
         assert(this->count > index);
         {
-            if (index == 0)
+            size_t lastIndex = this->count - 1;
+            if (index != lastIndex)
             {
-                // Removing the front object.
-                this->startIndex = (this->startIndex + 1) % this->bufferSize;
+                this->MoveParticle(index, lastIndex);
             }
-            else if (index < this->count - 1)
-            {
-                if (index < this->count / 2)
-                {
-                    // Move the first half.
 
-                    for (size_t i = 0; i < index; ++i)
-                    {
-                        auto dst = this->buffer + (this->startIndex + i    ) % this->bufferSize;
-                        auto src = this->buffer + (this->startIndex + i + 1) % this->bufferSize;
-
-                        memcpy(dst, src, sizeof(Particle));
-                    }
-
-                    this->startIndex = (this->startIndex + 1) % this->bufferSize;
-                }
-                else
-                {
-                    // Moving the back half.
+            this->count -= 1;
+        }
+    }
 
-                    for (size_t i = index; i < this->count - 1; ++i)
-                    {
-                        auto dst = this->buffer + (this->startIndex + i + 1) % this->bufferSize;
-                        auto src = this->buffer + (this->startIndex + i    ) % this->bufferSize;
+    size_t ParticleList::RemoveDeadParticles()
+    {
+        size_t originalCount = this->count;
 
-                        memcpy(dst, src, sizeof(Particle));
-                    }
-                }
+        size_t iParticle = 0;
+        while (iParticle < this->count)
+        {
+            if (this->timesLeftToDeath[iParticle] <= 0.0f)
+            {
+                // The last particle is moved into this slot, which means we need to check the same index again.
+                this->Remove(iParticle);
+            }
+            else
+            {
+                ++iParticle;
             }
-
-
-            this->count -= 1;
         }
+
+        return originalCount - this->count;
     }
 
 
@@ -97,21 +129,56 @@ namespace GT
         return this->count;
     }
 
-    Particle & ParticleList::GetParticle(size_t index)
+    void ParticleList::GetParticle(size_t index, Particle &particleOut) const
     {
-        return this->buffer[(this->startIndex + index) % this->bufferSize];
+        assert(index < this->count);
+
+        particleOut.position                  = this->positions[index];
+        particleOut.orientation               = this->orientations[index];
+        particleOut.scale                     = this->scales[index];
+        particleOut.linearVelocity            = this->linearVelocities[index];
+        particleOut.angularVelocity           = this->angularVelocities[index];
+        particleOut.spawnLinearVelocity       = this->spawnLinearVelocities[index];
+        particleOut.gravityLinearVelocity     = this->gravityLinearVelocities[index];
+        particleOut.functionLinearVelocity    = this->functionLinearVelocities[index];
+        particleOut.colour                    = this->colours[index];
+        particleOut.lifetime                  = static_cast<double>(this->lifetimes[index]);
+        particleOut.timeLeftToDeath           = static_cast<double>(this->timesLeftToDeath[index]);
+        particleOut.uvTileInterpolationFactor = this->uvTileInterpolationFactors[index];
+        particleOut.uTexCoordMin0             = this->texCoordBounds0[index].x;
+        particleOut.vTexCoordMin0             = this->texCoordBounds0[index].y;
+        particleOut.uTexCoordMax0             = this->texCoordBounds0[index].z;
+        particleOut.vTexCoordMax0             = this->texCoordBounds0[index].w;
+        particleOut.uTexCoordMin1             = this->texCoordBounds1[index].x;
+        particleOut.vTexCoordMin1             = this->texCoordBounds1[index].y;
+        particleOut.uTexCoordMax1             = this->texCoordBounds1[index].z;
+        particleOut.vTexCoordMax1             = this->texCoordBounds1[index].w;
     }
 
-    const Particle & ParticleList::GetParticle(size_t index) const
+    void ParticleList::SetParticle(size_t index, const Particle &particle)
     {
-        return this->buffer[(this->startIndex + index) % this->bufferSize];
+        assert(index < this->count);
+
+        this->positions[index]                  = particle.position;
+        this->orientations[index]               = particle.orientation;
+        this->scales[index]                     = particle.scale;
+        this->linearVelocities[index]           = particle.linearVelocity;
+        this->angularVelocities[index]          = particle.angularVelocity;
+        this->spawnLinearVelocities[index]      = particle.spawnLinearVelocity;
+        this->gravityLinearVelocities[index]    = particle.gravityLinearVelocity;
+        this->functionLinearVelocities[index]   = particle.functionLinearVelocity;
+        this->colours[index]                    = particle.colour;
+        this->lifetimes[index]                  = static_cast<float>(particle.lifetime);
+        this->timesLeftToDeath[index]           = static_cast<float>(particle.timeLeftToDeath);
+        this->uvTileInterpolationFactors[index] = particle.uvTileInterpolationFactor;
+        this->texCoordBounds0[index]            = glm::vec4(particle.uTexCoordMin0, particle.vTexCoordMin0, particle.uTexCoordMax0, particle.vTexCoordMax0);
+        this->texCoordBounds1[index]            = glm::vec4(particle.uTexCoordMin1, particle.vTexCoordMin1, particle.uTexCoordMax1, particle.vTexCoordMax1);
     }
 
 
     void ParticleList::Clear()
     {
-        this->count      = 0;
-        this->startIndex = 0;
+        this->count = 0;
     }
 
 
@@ -124,34 +191,92 @@ namespace GT
     {
         if (newBufferSize > this->bufferSize)
         {
-            auto oldBufferSize = this->bufferSize;
-            auto oldBuffer     = this->buffer;
-            auto newBuffer     = static_cast<Particle*>(_mm_malloc(newBufferSize * sizeof(Particle), 16));
+            auto oldBuffer = this->buffer;
+            auto newBuffer = _mm_malloc(CalculateBufferSizeInBytes(newBufferSize), 16);
 
             if (oldBuffer != nullptr)
             {
-                // Copying over may need to be done in two parts due to the way the buffer if implemented.
-                if (this->startIndex + this->count > oldBufferSize)
-                {
-                    // Needs to be done in two parts.
-                    size_t part1Size = oldBufferSize - this->startIndex;
-                    size_t part2Size = this->count - (part1Size);
+                // Every stream is at a different offset in the new buffer, so they need to be copied over one at a time. The vec4 streams
+                // all come first, followed by the float streams.
+                size_t oldPaddedCount = ParticleList_PadCount(this->bufferSize);
+                size_t newPaddedCount = ParticleList_PadCount(newBufferSize);
 
-                    memcpy(newBuffer,             oldBuffer + this->startIndex, part1Size * sizeof(Particle));
-                    memcpy(newBuffer + part1Size, oldBuffer,                    part2Size * sizeof(Particle));
+                auto oldVec4Streams = static_cast<const glm::vec4*>(oldBuffer);
+                auto newVec4Streams = static_cast<glm::vec4*>(newBuffer);
+                for (size_t iStream = 0; iStream < ParticleList_Vec4StreamCount; ++iStream)
+                {
+                    memcpy(newVec4Streams + (iStream * newPaddedCount), oldVec4Streams + (iStream * oldPaddedCount), this->count * sizeof(glm::vec4));
                 }
-                else
+
+                auto oldFloatStreams = reinterpret_cast<const float*>(oldVec4Streams + (oldPaddedCount * ParticleList_Vec4StreamCount));
+                auto newFloatStreams = reinterpret_cast<float*>(newVec4Streams + (newPaddedCount * ParticleList_Vec4StreamCount));
+                for (size_t iStream = 0; iStream < ParticleList_FloatStreamCount; ++iStream)
                 {
-                    // Can be done in one part.
-                    memcpy(newBuffer, oldBuffer + this->startIndex, this->count * sizeof(Particle));
+                    memcpy(newFloatStreams + (iStream * newPaddedCount), oldFloatStreams + (iStream * oldPaddedCount), this->count * sizeof(float));
                 }
 
                 _mm_free(oldBuffer);
             }
 
-            this->bufferSize   = newBufferSize;
-            this->buffer       = newBuffer;
-            this->startIndex   = 0;
+            this->SetStreamPointers(newBuffer, newBufferSize);
+            this->buffer = newBuffer;
+        }
+    }
+
+
+
+    ////////////////////////////////////////
+    // Private
+
+    void ParticleList::SetStreamPointers(void* newBuffer, size_t newBufferSize)
+    {
+        if (newBuffer != nullptr)
+        {
+            size_t paddedCount = ParticleList_PadCount(newBufferSize);
+
+            auto vec4Streams = static_cast<glm::vec4*>(newBuffer);
+            this->positions                  = vec4Streams + (paddedCount * 0);
+            this->orientations               = reinterpret_cast<glm::quat*>(vec4Streams + (paddedCount * 1));
+            this->scales                     = vec4Streams + (paddedCount * 2);
+            this->linearVelocities           = vec4Streams + (paddedCount * 3);
+            this->angularVelocities          = reinterpret_cast<glm::quat*>(vec4Streams + (paddedCount * 4));
+            this->spawnLinearVelocities      = vec4Streams + (paddedCount * 5);
+            this->gravityLinearVelocities    = vec4Streams + (paddedCount * 6);
+            this->functionLinearVelocities   = vec4Streams + (paddedCount * 7);
+            this->colours                    = vec4Streams + (paddedCount * 8);
+            this->texCoordBounds0            = vec4Streams + (paddedCount * 9);
+            this->texCoordBounds1            = vec4Streams + (paddedCount * 10);
+
+            auto floatStreams = reinterpret_cast<float*>(vec4Streams + (paddedCount * ParticleList_Vec4StreamCount));
+            this->lifetimes                  = floatStreams + (paddedCount * 0);
+            this->timesLeftToDeath           = floatStreams + (paddedCount * 1);
+            this->uvTileInterpolationFactors = floatStreams + (paddedCount * 2);
         }
+
+        this->bufferSize = newBufferSize;
+    }
+
+    void ParticleList::MoveParticle(size_t dstIndex, size_t srcIndex)
+    {
+        this->positions[dstIndex]                  = this->positions[srcIndex];
+        this->orientations[dstIndex]               = this->orientations[srcIndex];
+        this->scales[dstIndex]                     = this->scales[srcIndex];
+        this->linearVelocities[dstIndex]           = this->linearVelocities[srcIndex];
+        this->angularVelocities[dstIndex]          = this->angularVelocities[srcIndex];
+        this->spawnLinearVelocities[dstIndex]      = this->spawnLinearVelocities[srcIndex];
+        this->gravityLinearVelocities[dstIndex]    = this->gravityLinearVelocities[srcIndex];
+        this->functionLinearVelocities[dstIndex]   = this->functionLinearVelocities[srcIndex];
+        this->colours[dstIndex]                    = this->colours[srcIndex];
+        this->texCoordBounds0[dstIndex]            = this->texCoordBounds0[srcIndex];
+        this->texCoordBounds1[dstIndex]            = this->texCoordBounds1[srcIndex];
+        this->lifetimes[dstIndex]                  = this->lifetimes[srcIndex];
+        this->timesLeftToDeath[dstIndex]           = this->timesLeftToDeath[srcIndex];
+        this->uvTileInterpolationFactors[dstIndex] = this->uvTileInterpolationFactors[srcIndex];
+    }
+
+    size_t ParticleList::CalculateBufferSizeInBytes(size_t particleCount)
+    {
+        size_t paddedCount = ParticleList_PadCount(particleCount);
+        return (paddedCount * ParticleList_Vec4StreamCount * sizeof(glm::vec4)) + (paddedCount * ParticleList_FloatStreamCount * sizeof(float));
     }
 }
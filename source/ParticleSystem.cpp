@@ -88,6 +88,17 @@ namespace GT
         return this->emitters[index];
     }
 
+    size_t ParticleSystem::GetParticleCount() const
+    {
+        size_t particleCount = 0;
+        for (size_t i = 0; i < this->emitters.count; ++i)
+        {
+            particleCount += this->emitters[i]->GetParticleCount();
+        }
+
+        return particleCount;
+    }
+
 
     void ParticleSystem::SetPosition(const glm::vec3 &newPosition)
     {
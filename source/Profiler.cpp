@@ -2,6 +2,14 @@
 
 #include <GTGE/Profiler.hpp>
 #include <GTGE/Core/Math.hpp>
+#include <GTGE/Core/Vector.hpp>
+#include <GTGE/Core/stdio.hpp>
+
+#if defined(_MSC_VER)
+#define GT_PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+#define GT_PROFILER_THREAD_LOCAL __thread
+#endif
 
 namespace GT
 {
@@ -117,4 +125,324 @@ namespace GT
         this->updateBenchmarker.Reset();
         this->renderingBenchmarker.Reset();
     }
+
+
+
+    ///////////////////////////////////////////
+    // ProfilerCapture
+
+    /// The ring buffer of zones for a single thread.
+    struct ProfilerThreadBuffer
+    {
+        /// The zones. This is a ring buffer of eventCapacity items.
+        ProfilerZoneEvent* pEvents;
+
+        /// The number of zones pEvents can hold.
+        size_t eventCapacity;
+
+        /// The number of zones written during the capture, including those that have been overwritten.
+        size_t eventsWritten;
+
+        /// The capture the buffer was last reset for. The buffer is reset by it's own thread the first time it enters a zone during a new capture.
+        uint32_t captureIndex;
+
+        /// The number of zones the thread is currently inside.
+        uint32_t depth;
+
+        /// The index of the thread, in the order threads entered their first zone. This is the thread ID in saved captures.
+        uint32_t threadIndex;
+
+        /// The name of the thread.
+        char name[64];
+    };
+
+
+    volatile bool ProfilerCapture::s_isCapturing = false;
+
+    /// The lock for the list of thread buffers.
+    static dr_mutex g_ProfilerBuffersLock = NULL;
+
+    /// The buffer of every thread that has entered a zone while capturing.
+    static Vector<ProfilerThreadBuffer*> g_ProfilerBuffers;
+
+    /// The index of the current or last capture.
+    static uint32_t g_ProfilerCaptureIndex = 0;
+
+    /// The number of zones each thread keeps during the current capture.
+    static size_t g_ProfilerEventsPerThread = ProfilerCapture::DefaultEventsPerThread;
+
+    /// The buffer of the calling thread, or null if it has not entered a zone while capturing.
+    static GT_PROFILER_THREAD_LOCAL ProfilerThreadBuffer* g_pProfilerThreadBuffer = nullptr;
+
+    /// The name given to the calling thread with SetThreadName(), kept until the thread is given a buffer.
+    static GT_PROFILER_THREAD_LOCAL char g_ProfilerThreadName[64];
+
+
+    /// Retrieves the calling thread's buffer, creating it or resetting it for the current capture if necessary.
+    static ProfilerThreadBuffer* ProfilerCapture_GetThreadBuffer()
+    {
+        auto pBuffer = g_pProfilerThreadBuffer;
+        if (pBuffer == nullptr)
+        {
+            pBuffer = new ProfilerThreadBuffer;
+            pBuffer->pEvents       = nullptr;
+            pBuffer->eventCapacity = 0;
+            pBuffer->eventsWritten = 0;
+            pBuffer->captureIndex  = 0;
+            pBuffer->depth         = 0;
+            strcpy_s(pBuffer->name, sizeof(pBuffer->name), g_ProfilerThreadName);
+
+            dr_lock_mutex(g_ProfilerBuffersLock);
+            {
+                pBuffer->threadIndex = static_cast<uint32_t>(g_ProfilerBuffers.count);
+                g_ProfilerBuffers.PushBack(pBuffer);
+            }
+            dr_unlock_mutex(g_ProfilerBuffersLock);
+
+            g_pProfilerThreadBuffer = pBuffer;
+        }
+
+        if (pBuffer->captureIndex != g_ProfilerCaptureIndex)
+        {
+            if (pBuffer->eventCapacity != g_ProfilerEventsPerThread)
+            {
+                free(pBuffer->pEvents);
+                pBuffer->pEvents       = reinterpret_cast<ProfilerZoneEvent*>(malloc(sizeof(ProfilerZoneEvent) * g_ProfilerEventsPerThread));
+                pBuffer->eventCapacity = (pBuffer->pEvents != nullptr) ? g_ProfilerEventsPerThread : 0;
+            }
+
+            pBuffer->eventsWritten = 0;
+            pBuffer->captureIndex  = g_ProfilerCaptureIndex;
+
+            // Zones that were entered before the capture began are not recorded, so they don't count towards the depth.
+            pBuffer->depth = 0;
+        }
+
+        return pBuffer;
+    }
+
+    /// Writes the given string to a JSON file as a quoted string.
+    static void ProfilerCapture_WriteJSONString(char* output, size_t outputSize, const char* str)
+    {
+        assert(outputSize > 2);
+
+        size_t length = 0;
+        output[length++] = '"';
+
+        for (; *str != '\0' && length + 3 < outputSize; ++str)
+        {
+            if (*str == '"' || *str == '\\')
+            {
+                output[length++] = '\\';
+                output[length++] = *str;
+            }
+            else if (static_cast<unsigned char>(*str) >= 32)
+            {
+                output[length++] = *str;
+            }
+        }
+
+        output[length++] = '"';
+        output[length]   = '\0';
+    }
+
+
+    void ProfilerCapture::Begin(size_t eventsPerThread)
+    {
+        if (g_ProfilerBuffersLock == NULL)
+        {
+            g_ProfilerBuffersLock = dr_create_mutex();
+        }
+
+        g_ProfilerCaptureIndex    += 1;
+        g_ProfilerEventsPerThread  = (eventsPerThread > 0) ? eventsPerThread : 1;
+        s_isCapturing              = true;
+    }
+
+    void ProfilerCapture::End()
+    {
+        s_isCapturing = false;
+    }
+
+
+    void ProfilerCapture::SetThreadName(const char* name)
+    {
+        if (name == nullptr)
+        {
+            name = "";
+        }
+
+        strcpy_s(g_ProfilerThreadName, sizeof(g_ProfilerThreadName), name);
+
+        if (g_pProfilerThreadBuffer != nullptr)
+        {
+            strcpy_s(g_pProfilerThreadBuffer->name, sizeof(g_pProfilerThreadBuffer->name), name);
+        }
+    }
+
+
+    bool ProfilerCapture::SaveAsChromeTrace(drfs_context* pVFS, const char* filePath)
+    {
+        drfs_file* pFile;
+        if (drfs_open(pVFS, filePath, DRFS_WRITE | DRFS_CREATE_DIRS, &pFile) != drfs_success)
+        {
+            return false;
+        }
+
+
+        // Events are formatted into a chunk which is written to the file whenever it gets close to full.
+        const size_t chunkSize = 65536;
+        char* chunk = reinterpret_cast<char*>(malloc(chunkSize));
+        if (chunk == nullptr)
+        {
+            drfs_close(pFile);
+            return false;
+        }
+
+        size_t chunkLength = 0;
+        bool   isFirstEvent = true;
+
+        auto writeEvent = [&](const char* eventJSON)
+        {
+            size_t eventLength = strlen(eventJSON);
+            if (chunkLength + eventLength + 2 > chunkSize)
+            {
+                drfs_write(pFile, chunk, static_cast<unsigned int>(chunkLength), nullptr);
+                chunkLength = 0;
+            }
+
+            if (!isFirstEvent)
+            {
+                chunk[chunkLength++] = ',';
+            }
+            chunk[chunkLength++] = '\n';
+
+            memcpy(chunk + chunkLength, eventJSON, eventLength);
+            chunkLength += eventLength;
+
+            isFirstEvent = false;
+        };
+
+
+        drfs_write_string(pFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+        if (g_ProfilerBuffersLock != NULL)
+        {
+            dr_lock_mutex(g_ProfilerBuffersLock);
+            {
+                // Timestamps are written relative to the earliest zone to keep them small.
+                double baseTime = 0;
+                bool   hasBaseTime = false;
+
+                for (size_t iBuffer = 0; iBuffer < g_ProfilerBuffers.count; ++iBuffer)
+                {
+                    auto pBuffer = g_ProfilerBuffers[iBuffer];
+                    if (pBuffer->captureIndex == g_ProfilerCaptureIndex && pBuffer->eventsWritten > 0)
+                    {
+                        size_t eventCount = Min(pBuffer->eventsWritten, pBuffer->eventCapacity);
+                        for (size_t iEvent = 0; iEvent < eventCount; ++iEvent)
+                        {
+                            if (!hasBaseTime || pBuffer->pEvents[iEvent].beginTime < baseTime)
+                            {
+                                baseTime    = pBuffer->pEvents[iEvent].beginTime;
+                                hasBaseTime = true;
+                            }
+                        }
+                    }
+                }
+
+
+                char eventJSON[512];
+                char nameJSON[256];
+
+                for (size_t iBuffer = 0; iBuffer < g_ProfilerBuffers.count; ++iBuffer)
+                {
+                    auto pBuffer = g_ProfilerBuffers[iBuffer];
+                    if (pBuffer->captureIndex != g_ProfilerCaptureIndex || pBuffer->eventsWritten == 0)
+                    {
+                        continue;
+                    }
+
+
+                    // The thread name is a metadata event.
+                    if (pBuffer->name[0] != '\0')
+                    {
+                        ProfilerCapture_WriteJSONString(nameJSON, sizeof(nameJSON), pBuffer->name);
+                    }
+                    else
+                    {
+                        char defaultName[64];
+                        IO::snprintf(defaultName, sizeof(defaultName), "Thread %u", pBuffer->threadIndex);
+                        ProfilerCapture_WriteJSONString(nameJSON, sizeof(nameJSON), defaultName);
+                    }
+
+                    IO::snprintf(eventJSON, sizeof(eventJSON), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":%s}}", pBuffer->threadIndex, nameJSON);
+                    writeEvent(eventJSON);
+
+
+                    // When the buffer has wrapped around, the oldest zone is the one that will be overwritten next.
+                    size_t eventCount = Min(pBuffer->eventsWritten, pBuffer->eventCapacity);
+                    size_t firstEvent = (pBuffer->eventsWritten > pBuffer->eventCapacity) ? (pBuffer->eventsWritten % pBuffer->eventCapacity) : 0;
+
+                    for (size_t iEvent = 0; iEvent < eventCount; ++iEvent)
+                    {
+                        auto &event = pBuffer->pEvents[(firstEvent + iEvent) % pBuffer->eventCapacity];
+
+                        ProfilerCapture_WriteJSONString(nameJSON, sizeof(nameJSON), event.name);
+                        IO::snprintf(eventJSON, sizeof(eventJSON), "{\"name\":%s,\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u,\"args\":{\"depth\":%u}}",
+                            nameJSON, (event.beginTime - baseTime) * 1000000.0, (event.endTime - event.beginTime) * 1000000.0, pBuffer->threadIndex, event.depth);
+                        writeEvent(eventJSON);
+                    }
+                }
+            }
+            dr_unlock_mutex(g_ProfilerBuffersLock);
+        }
+
+        drfs_write(pFile, chunk, static_cast<unsigned int>(chunkLength), nullptr);
+        drfs_write_string(pFile, "\n]}\n");
+
+        free(chunk);
+        drfs_close(pFile);
+
+        return true;
+    }
+
+
+    double ProfilerCapture::BeginZone()
+    {
+        auto pBuffer = ProfilerCapture_GetThreadBuffer();
+        pBuffer->depth += 1;
+
+        return Timing::GetTimeInSeconds();
+    }
+
+    void ProfilerCapture::EndZone(const char* name, double beginTime)
+    {
+        double endTime = Timing::GetTimeInSeconds();
+
+        auto pBuffer = g_pProfilerThreadBuffer;
+        assert(pBuffer != nullptr);
+
+        // A zone that was entered during an earlier capture is dropped.
+        if (pBuffer->captureIndex != g_ProfilerCaptureIndex)
+        {
+            return;
+        }
+
+        if (pBuffer->depth > 0)
+        {
+            pBuffer->depth -= 1;
+        }
+
+        if (s_isCapturing && pBuffer->eventCapacity > 0)
+        {
+            auto &event = pBuffer->pEvents[pBuffer->eventsWritten % pBuffer->eventCapacity];
+            event.name      = name;
+            event.beginTime = beginTime;
+            event.endTime   = endTime;
+            event.depth     = pBuffer->depth;
+
+            pBuffer->eventsWritten += 1;
+        }
+    }
 }
@@ -38,6 +38,9 @@ namespace GT
     /// The current state.
     static State_OpenGL21 State;
 
+    /// The number of draw calls that have been made.
+    static uint64_t DrawCallCount = 0;
+
 
     void SetOpenGL21VertexAttribState(const VertexFormat &format, const float* vertices)
     {
@@ -388,6 +391,7 @@ namespace GT
             glGetIntegerv(GL_MAX_DRAW_BUFFERS,        &RendererCaps.MaxDrawBuffers);
             glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &RendererCaps.MaxTextureUnits);
             RendererCaps.SupportsMixedSizedBufferAttachments = GTGL_ARB_framebuffer_object;
+            RendererCaps.SupportsS3TC                        = GTGL_EXT_texture_compression_s3tc;
 
 
             // Now we'll set some defaults.
@@ -971,6 +975,7 @@ namespace GT
 
         // Draw.
         glDrawElements(ToOpenGLDrawMode(mode), static_cast<GLsizei>(vertexArrayGL33.GetIndexCount()), GL_UNSIGNED_INT, 0);
+        DrawCallCount += 1;
 
 
         // Set state.
@@ -993,6 +998,7 @@ namespace GT
 
         // Draw.
         glDrawElements(ToOpenGLDrawMode(mode), static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, indices);
+        DrawCallCount += 1;
 
 
         // Set State.
@@ -1022,6 +1028,11 @@ namespace GT
         Renderer::Draw(vertices, vertexCount, indices, indexCount, format, mode);
     }
 
+    uint64_t Renderer::GetDrawCallCount()
+    {
+        return DrawCallCount;
+    }
+
 
 
     ///////////////////////////
@@ -1340,17 +1351,28 @@ namespace GT
 
             GLuint prevTexture = BindOpenGL21Texture(textureTarget, textureState->objectGL);
             {
-                glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+                if (IsImageFormatCompressed(format))
                 {
-                    // OpenGL requires us to flip the texture data upside down.
-                    GLvoid* upsideDownData = static_cast<GLvoid*>(malloc(ImageUtils::CalculateDataSize(width, height, format)));
-                    ImageUtils::CopyImageData(upsideDownData, data, width, height, format, flip);
+                    // Compressed data is uploaded as-is. Blocks can't be flipped by rows, so the data must already be upside down.
+                    assert(!flip);
+                    assert(data != nullptr);
+
+                    glCompressedTexImage2D(textureTarget, mipmapIndex, ToOpenGLInternalFormat(format), width, height, 0, static_cast<GLsizei>(ImageUtils::CalculateDataSize(width, height, format)), data);
+                }
+                else
+                {
+                    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
                     {
-                        glTexImage2D(textureTarget, mipmapIndex, ToOpenGLInternalFormat(format), width, height, 0, ToOpenGLFormat(format), ToOpenGLType(format), data);
+                        // OpenGL requires us to flip the texture data upside down.
+                        GLvoid* upsideDownData = static_cast<GLvoid*>(malloc(ImageUtils::CalculateDataSize(width, height, format)));
+                        ImageUtils::CopyImageData(upsideDownData, data, width, height, format, flip);
+                        {
+                            glTexImage2D(textureTarget, mipmapIndex, ToOpenGLInternalFormat(format), width, height, 0, ToOpenGLFormat(format), ToOpenGLType(format), data);
+                        }
+                        free(upsideDownData);
                     }
-                    free(upsideDownData);
+                    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
                 }
-                glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
             }
             BindOpenGL21Texture(textureTarget, prevTexture);
         }
@@ -1543,48 +1565,51 @@ namespace GT
 
                 GLint uniformLocation = glGetUniformLocation(programObject, uniformName);
 
+                // The name is interned once here so that setting the uniform from then on is a search over integer IDs.
+                StringID uniformNameID = InternString(uniformName);
+
                 switch (uniformType)
                 {
                 case GL_FLOAT:
                     {
-                        programState->floatUniformLocations.Add(uniformName, uniformLocation);
+                        programState->floatUniformLocations.Add(uniformNameID, uniformLocation);
                         break;
                     }
 
                 case GL_FLOAT_VEC2:
                     {
-                        programState->float2UniformLocations.Add(uniformName, uniformLocation);
+                        programState->float2UniformLocations.Add(uniformNameID, uniformLocation);
                         break;
                     }
 
                 case GL_FLOAT_VEC3:
                     {
-                        programState->float3UniformLocations.Add(uniformName, uniformLocation);
+                        programState->float3UniformLocations.Add(uniformNameID, uniformLocation);
                         break;
                     }
 
                 case GL_FLOAT_VEC4:
                     {
-                        programState->float4UniformLocations.Add(uniformName, uniformLocation);
+                        programState->float4UniformLocations.Add(uniformNameID, uniformLocation);
                         break;
                     }
 
 
                 case GL_FLOAT_MAT2:
                     {
-                        programState->float2x2UniformLocations.Add(uniformName, uniformLocation);
+                        programState->float2x2UniformLocations.Add(uniformNameID, uniformLocation);
                         break;
                     }
 
                 case GL_FLOAT_MAT3:
                     {
-                        programState->float3x3UniformLocations.Add(uniformName, uniformLocation);
+                        programState->float3x3UniformLocations.Add(uniformNameID, uniformLocation);
                         break;
                     }
 
                 case GL_FLOAT_MAT4:
                     {
-                        programState->float4x4UniformLocations.Add(uniformName, uniformLocation);
+                        programState->float4x4UniformLocations.Add(uniformNameID, uniformLocation);
                         break;
                     }
 
@@ -1613,7 +1638,7 @@ namespace GT
                 case GL_UNSIGNED_INT_SAMPLER_CUBE:
                 case GL_UNSIGNED_INT_SAMPLER_BUFFER:
                     {
-                        programState->textureUniformLocations.Add(uniformName, uniformLocation);
+                        programState->textureUniformLocations.Add(uniformNameID, uniformLocation);
                         break;
                     }
 
@@ -1684,7 +1709,7 @@ namespace GT
                     auto  parameterName  = programState->pendingFloatUniformsByName.buffer[i]->key;
                     auto &parameterValue = programState->pendingFloatUniformsByName.buffer[i]->value;
 
-                    glUniform1f(glGetUniformLocation(programState->programObject, parameterName), parameterValue.x);
+                    glUniform1f(glGetUniformLocation(programState->programObject, GetInternedString(parameterName)), parameterValue.x);
                 }
 
                 for (size_t i = 0; i < programState->pendingFloatUniformsByLocation.count; ++i)
@@ -1702,7 +1727,7 @@ namespace GT
                     auto  parameterName  = programState->pendingFloat2UniformsByName.buffer[i]->key;
                     auto &parameterValue = programState->pendingFloat2UniformsByName.buffer[i]->value;
 
-                    glUniform2f(glGetUniformLocation(programState->programObject, parameterName), parameterValue.x, parameterValue.y);
+                    glUniform2f(glGetUniformLocation(programState->programObject, GetInternedString(parameterName)), parameterValue.x, parameterValue.y);
                 }
 
                 for (size_t i = 0; i < programState->pendingFloat2UniformsByLocation.count; ++i)
@@ -1720,7 +1745,7 @@ namespace GT
                     auto  parameterName  = programState->pendingFloat3UniformsByName.buffer[i]->key;
                     auto &parameterValue = programState->pendingFloat3UniformsByName.buffer[i]->value;
 
-                    glUniform3f(glGetUniformLocation(programState->programObject, parameterName), parameterValue.x, parameterValue.y, parameterValue.z);
+                    glUniform3f(glGetUniformLocation(programState->programObject, GetInternedString(parameterName)), parameterValue.x, parameterValue.y, parameterValue.z);
                 }
 
                 for (size_t i = 0; i < programState->pendingFloat3UniformsByLocation.count; ++i)
@@ -1738,7 +1763,7 @@ namespace GT
                     auto  parameterName  = programState->pendingFloat4UniformsByName.buffer[i]->key;
                     auto &parameterValue = programState->pendingFloat4UniformsByName.buffer[i]->value;
 
-                    glUniform4f(glGetUniformLocation(programState->programObject, parameterName), parameterValue.x, parameterValue.y, parameterValue.z, parameterValue.w);
+                    glUniform4f(glGetUniformLocation(programState->programObject, GetInternedString(parameterName)), parameterValue.x, parameterValue.y, parameterValue.z, parameterValue.w);
                 }
 
                 for (size_t i = 0; i < programState->pendingFloat4UniformsByLocation.count; ++i)
@@ -1756,7 +1781,7 @@ namespace GT
                     auto  parameterName  = programState->pendingFloat2x2UniformsByName.buffer[i]->key;
                     auto &parameterValue = programState->pendingFloat2x2UniformsByName.buffer[i]->value;
 
-                    glUniformMatrix2fv(glGetUniformLocation(programState->programObject, parameterName), 1, false, parameterValue.value);
+                    glUniformMatrix2fv(glGetUniformLocation(programState->programObject, GetInternedString(parameterName)), 1, false, parameterValue.value);
                 }
 
                 for (size_t i = 0; i < programState->pendingFloat2x2UniformsByLocation.count; ++i)
@@ -1774,7 +1799,7 @@ namespace GT
                     auto  parameterName  = programState->pendingFloat3x3UniformsByName.buffer[i]->key;
                     auto &parameterValue = programState->pendingFloat3x3UniformsByName.buffer[i]->value;
 
-                    glUniformMatrix3fv(glGetUniformLocation(programState->programObject, parameterName), 1, false, parameterValue.value);
+                    glUniformMatrix3fv(glGetUniformLocation(programState->programObject, GetInternedString(parameterName)), 1, false, parameterValue.value);
                 }
 
                 for (size_t i = 0; i < programState->pendingFloat3x3UniformsByLocation.count; ++i)
@@ -1792,7 +1817,7 @@ namespace GT
                     auto  parameterName  = programState->pendingFloat4x4UniformsByName.buffer[i]->key;
                     auto &parameterValue = programState->pendingFloat4x4UniformsByName.buffer[i]->value;
 
-                    glUniformMatrix4fv(glGetUniformLocation(programState->programObject, parameterName), 1, false, parameterValue.value);
+                    glUniformMatrix4fv(glGetUniformLocation(programState->programObject, GetInternedString(parameterName)), 1, false, parameterValue.value);
                 }
 
                 for (size_t i = 0; i < programState->pendingFloat4x4UniformsByLocation.count; ++i)
@@ -1807,7 +1832,7 @@ namespace GT
                 // Texture
                 for (size_t i = 0; i < programState->pendingTextureUniformsByName.count; ++i)
                 {
-                    GLint uniformLocation = glGetUniformLocation(programState->programObject, programState->pendingTextureUniformsByName.buffer[i]->key);
+                    GLint uniformLocation = glGetUniformLocation(programState->programObject, GetInternedString(programState->pendingTextureUniformsByName.buffer[i]->key));
                     auto &uniformValue    = programState->pendingTextureUniformsByName.buffer[i]->value;
 
                     SetOpenGL21TextureUniform(programState, uniformLocation, uniformValue);
@@ -2107,4 +2132,9 @@ namespace GT
     {
         return RendererCaps.SupportsMixedSizedBufferAttachments != 0;
     }
+
+    bool Renderer::SupportsCompressedTextures()
+    {
+        return RendererCaps.SupportsS3TC != 0;
+    }
 }
@@ -9,6 +9,7 @@
 #include <GTGE/Core/Map.hpp>
 #include <GTGE/Core/Vector.hpp>
 #include <GTGE/Core/String.hpp>
+#include <GTGE/Core/StringID.hpp>
 #include <gtgl/gtgl.h>
 
 #include "TextureState_OpenGL21.hpp"
@@ -289,15 +290,16 @@ namespace GT
 
 
 
-        // The locations of every parameter used by the shader. These are intentionally separated into types for faster searching.
-        Dictionary<GLint> floatUniformLocations;
-        Dictionary<GLint> float2UniformLocations;
-        Dictionary<GLint> float3UniformLocations;
-        Dictionary<GLint> float4UniformLocations;
-        Dictionary<GLint> float2x2UniformLocations;
-        Dictionary<GLint> float3x3UniformLocations;
-        Dictionary<GLint> float4x4UniformLocations;
-        Dictionary<GLint> textureUniformLocations;
+        // The locations of every parameter used by the shader, keyed by the ID of the interned uniform name. These are intentionally separated
+        // into types for faster searching.
+        Map<StringID, GLint> floatUniformLocations;
+        Map<StringID, GLint> float2UniformLocations;
+        Map<StringID, GLint> float3UniformLocations;
+        Map<StringID, GLint> float4UniformLocations;
+        Map<StringID, GLint> float2x2UniformLocations;
+        Map<StringID, GLint> float3x3UniformLocations;
+        Map<StringID, GLint> float4x4UniformLocations;
+        Map<StringID, GLint> textureUniformLocations;
 
 
         // Parameters that have changed and need to be applied on the server side.
@@ -311,15 +313,16 @@ namespace GT
         Vector<TextureParameter>  pendingTextureUniformsByLocation;
 
 
-        // Parameters that were set before the shader has had a chance to allocate storage for the parameters.
-        Dictionary<FloatParameter>    pendingFloatUniformsByName;
-        Dictionary<Float2Parameter>   pendingFloat2UniformsByName;
-        Dictionary<Float3Parameter>   pendingFloat3UniformsByName;
-        Dictionary<Float4Parameter>   pendingFloat4UniformsByName;
-        Dictionary<Float2x2Parameter> pendingFloat2x2UniformsByName;
-        Dictionary<Float3x3Parameter> pendingFloat3x3UniformsByName;
-        Dictionary<Float4x4Parameter> pendingFloat4x4UniformsByName;
-        Dictionary<TextureParameter>  pendingTextureUniformsByName;
+        // Parameters that were set before the shader has had a chance to allocate storage for the parameters, keyed by the ID of the interned
+        // uniform name.
+        Map<StringID, FloatParameter>    pendingFloatUniformsByName;
+        Map<StringID, Float2Parameter>   pendingFloat2UniformsByName;
+        Map<StringID, Float3Parameter>   pendingFloat3UniformsByName;
+        Map<StringID, Float4Parameter>   pendingFloat4UniformsByName;
+        Map<StringID, Float2x2Parameter> pendingFloat2x2UniformsByName;
+        Map<StringID, Float3x3Parameter> pendingFloat3x3UniformsByName;
+        Map<StringID, Float4x4Parameter> pendingFloat4x4UniformsByName;
+        Map<StringID, TextureParameter>  pendingTextureUniformsByName;
 
 
         /// Constructor.
@@ -390,44 +393,44 @@ namespace GT
         ///
         /// @remarks
         ///     If the object has not yet been created or the uniform doesn't exist, -1 will be returned.
-        GLint GetFloatUniformLocation(const char* name)
+        GLint GetFloatUniformLocation(StringID name)
         {
             return this->GetUniformLocation(name, this->floatUniformLocations);
         }
 
-        GLint GetFloat2UniformLocation(const char* name)
+        GLint GetFloat2UniformLocation(StringID name)
         {
             return this->GetUniformLocation(name, this->float2UniformLocations);
         }
 
-        GLint GetFloat3UniformLocation(const char* name)
+        GLint GetFloat3UniformLocation(StringID name)
         {
             return this->GetUniformLocation(name, this->float3UniformLocations);
         }
 
-        GLint GetFloat4UniformLocation(const char* name)
+        GLint GetFloat4UniformLocation(StringID name)
         {
             return this->GetUniformLocation(name, this->float4UniformLocations);
         }
 
 
-        GLint GetFloat2x2UniformLocation(const char* name)
+        GLint GetFloat2x2UniformLocation(StringID name)
         {
             return this->GetUniformLocation(name, this->float2x2UniformLocations);
         }
 
-        GLint GetFloat3x3UniformLocation(const char* name)
+        GLint GetFloat3x3UniformLocation(StringID name)
         {
             return this->GetUniformLocation(name, this->float3x3UniformLocations);
         }
 
-        GLint GetFloat4x4UniformLocation(const char* name)
+        GLint GetFloat4x4UniformLocation(StringID name)
         {
             return this->GetUniformLocation(name, this->float4x4UniformLocations);
         }
 
 
-        GLint GetTextureUniformLocation(const char* name)
+        GLint GetTextureUniformLocation(StringID name)
         {
             return this->GetUniformLocation(name, this->textureUniformLocations);
         }
@@ -471,7 +474,7 @@ namespace GT
     private:
 
         /// Generic function for retrieving a uniform location from the given list.
-        GLint GetUniformLocation(const char* name, const Dictionary<GLint> &uniformLocations)
+        GLint GetUniformLocation(StringID name, const Map<StringID, GLint> &uniformLocations)
         {
             if (this->programObject != 0)
             {
@@ -31,7 +31,7 @@ namespace GT
     // the actual creation of the object will be delayed until the next call cache swap. Optimizations are done after the object is created to make
     // things a little more efficient.
 
-    void Shader_OpenGL21::SetUniform(const char* name, float x)
+    void Shader_OpenGL21::SetUniform(StringID name, float x)
     {
         if (this->stateGL->programObject == 0)
         {
@@ -47,7 +47,7 @@ namespace GT
         }
     }
 
-    void Shader_OpenGL21::SetUniform(const char* name, float x, float y)
+    void Shader_OpenGL21::SetUniform(StringID name, float x, float y)
     {
         if (this->stateGL->programObject == 0)
         {
@@ -63,7 +63,7 @@ namespace GT
         }
     }
 
-    void Shader_OpenGL21::SetUniform(const char* name, float x, float y, float z)
+    void Shader_OpenGL21::SetUniform(StringID name, float x, float y, float z)
     {
         if (this->stateGL->programObject == 0)
         {
@@ -79,7 +79,7 @@ namespace GT
         }
     }
 
-    void Shader_OpenGL21::SetUniform(const char* name, float x, float y, float z, float w)
+    void Shader_OpenGL21::SetUniform(StringID name, float x, float y, float z, float w)
     {
         if (this->stateGL->programObject == 0)
         {
@@ -95,7 +95,7 @@ namespace GT
         }
     }
 
-    void Shader_OpenGL21::SetUniform(const char* name, const glm::mat2 &value)
+    void Shader_OpenGL21::SetUniform(StringID name, const glm::mat2 &value)
     {
         if (this->stateGL->programObject == 0)
         {
@@ -111,7 +111,7 @@ namespace GT
         }
     }
 
-    void Shader_OpenGL21::SetUniform(const char* name, const glm::mat3 &value)
+    void Shader_OpenGL21::SetUniform(StringID name, const glm::mat3 &value)
     {
         if (this->stateGL->programObject == 0)
         {
@@ -127,7 +127,7 @@ namespace GT
         }
     }
 
-    void Shader_OpenGL21::SetUniform(const char* name, const glm::mat4 &value)
+    void Shader_OpenGL21::SetUniform(StringID name, const glm::mat4 &value)
     {
         if (this->stateGL->programObject == 0)
         {
@@ -143,7 +143,7 @@ namespace GT
         }
     }
 
-    void Shader_OpenGL21::SetUniform(const char* name, const Texture2D* value)
+    void Shader_OpenGL21::SetUniform(StringID name, const Texture2D* value)
     {
         assert(value != nullptr);
         {
@@ -167,7 +167,7 @@ namespace GT
         }
     }
 
-    void Shader_OpenGL21::SetUniform(const char* name, const TextureCube* value)
+    void Shader_OpenGL21::SetUniform(StringID name, const TextureCube* value)
     {
         assert(value != nullptr);
         {
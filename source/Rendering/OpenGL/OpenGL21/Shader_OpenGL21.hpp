@@ -29,15 +29,17 @@ namespace GT
         //////////////////////////////////////////////
         // Uniforms.
 
-        void SetUniform(const char* name, float x);
-        void SetUniform(const char* name, float x, float y);
-        void SetUniform(const char* name, float x, float y, float z);
-        void SetUniform(const char* name, float x, float y, float z, float w);
-        void SetUniform(const char* name, const glm::mat2 &value);
-        void SetUniform(const char* name, const glm::mat3 &value);
-        void SetUniform(const char* name, const glm::mat4 &value);
-        void SetUniform(const char* name, const Texture2D* value);
-        void SetUniform(const char* name, const TextureCube* value);
+        using Shader::SetUniform;
+
+        void SetUniform(StringID name, float x);
+        void SetUniform(StringID name, float x, float y);
+        void SetUniform(StringID name, float x, float y, float z);
+        void SetUniform(StringID name, float x, float y, float z, float w);
+        void SetUniform(StringID name, const glm::mat2 &value);
+        void SetUniform(StringID name, const glm::mat3 &value);
+        void SetUniform(StringID name, const glm::mat4 &value);
+        void SetUniform(StringID name, const Texture2D* value);
+        void SetUniform(StringID name, const TextureCube* value);
 
 
     private:
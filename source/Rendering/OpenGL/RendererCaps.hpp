@@ -19,6 +19,7 @@ namespace GT
         GLint MaxShaderUniforms;                            ///< The maximum number of uniforms per shader.
 
         GLboolean SupportsMixedSizedBufferAttachments;      ///< Whether or not buffers of different sizes can be attached to a framebuffer.
+        GLboolean SupportsS3TC;                             ///< Whether or not DXT1 and DXT5 compressed textures are supported.
     };
 }
 
@@ -114,6 +114,9 @@ namespace GT
 
         case ImageFormat_R10G10B10A2:      return GL_RGB10_A2;
 
+        case ImageFormat_DXT1:             return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case ImageFormat_DXT5:             return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+
         case ImageFormat_Auto:
         default: break;
         }
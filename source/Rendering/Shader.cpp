@@ -18,39 +18,39 @@ namespace GT
     //////////////////////////////////////////////
     // Uniforms.
 
-    void Shader::SetUniform(const char*, float)
+    void Shader::SetUniform(StringID, float)
     {
     }
 
-    void Shader::SetUniform(const char*, float, float)
+    void Shader::SetUniform(StringID, float, float)
     {
     }
 
-    void Shader::SetUniform(const char*, float, float, float)
+    void Shader::SetUniform(StringID, float, float, float)
     {
     }
 
-    void Shader::SetUniform(const char*, float, float, float, float)
+    void Shader::SetUniform(StringID, float, float, float, float)
     {
     }
 
-    void Shader::SetUniform(const char*, const glm::mat2 &)
+    void Shader::SetUniform(StringID, const glm::mat2 &)
     {
     }
 
-    void Shader::SetUniform(const char*, const glm::mat3 &)
+    void Shader::SetUniform(StringID, const glm::mat3 &)
     {
     }
 
-    void Shader::SetUniform(const char*, const glm::mat4 &)
+    void Shader::SetUniform(StringID, const glm::mat4 &)
     {
     }
 
-    void Shader::SetUniform(const char*, const Texture2D*)
+    void Shader::SetUniform(StringID, const Texture2D*)
     {
     }
 
-    void Shader::SetUniform(const char*, const TextureCube*)
+    void Shader::SetUniform(StringID, const TextureCube*)
     {
     }
 
@@ -4,6 +4,7 @@
 #include <GTGE/DefaultSceneUpdateManager.hpp>
 #include <GTGE/DefaultScenePhysicsManager.hpp>
 #include <GTGE/DefaultSceneCullingManager.hpp>
+#include <GTGE/Profiler.hpp>
 #include <GTGE/Scripting.hpp>
 #include <GTGE/Core/ToString.hpp>
 #include <GTGE/GTEngine.hpp>
@@ -232,6 +233,19 @@ namespace GT
     static const bool DoNotPostEvents = false;              // <-- For Scene::OnSceneNodeComponentAdded() and Scene::OnSceneNodeComponentRemoved().
 
 
+    /// Retrieves the number of ancestors of the given scene node. Used for sorting deferred transforms so parents are posted before children.
+    static size_t Scene_GetSceneNodeDepth(const SceneNode* node)
+    {
+        size_t depth = 0;
+        for (auto parent = node->GetParent(); parent != nullptr; parent = parent->GetParent())
+        {
+            depth += 1;
+        }
+
+        return depth;
+    }
+
+
     Scene::Scene(Context &context)
         : m_context(context),
           renderer(new DefaultSceneRenderer(context)),
@@ -244,6 +258,7 @@ namespace GT
           navigationMesh(),
           eventHandlers(),
           stateStack(*this), isStateStackEnabled(true),
+          isDeferredTransformPropagationEnabled(false), deferredTransformQueue(), deferredTransformFlushList(),
           registeredScript(nullptr), isScriptEventsBlocked(false),
           name(),
           isBackgroundClearEnabled(true), backgroundClearColour(0.5f),
@@ -264,6 +279,7 @@ namespace GT
           navigationMesh(),
           eventHandlers(),
           stateStack(*this), isStateStackEnabled(true),
+          isDeferredTransformPropagationEnabled(false), deferredTransformQueue(), deferredTransformFlushList(),
           registeredScript(nullptr), isScriptEventsBlocked(false),
           name(),
           isBackgroundClearEnabled(true), backgroundClearColour(0.5f),
@@ -317,6 +333,18 @@ namespace GT
 
     bool Scene::LoadFromFile(const char* relativeFilePath)
     {
+        // We prefer to map the file so it can be read without any file system calls, but that only works for files that aren't inside an archive.
+        char absolutePath[DRFS_MAX_PATH];
+        if (drfs_find_absolute_path(g_Context->GetVFS(), relativeFilePath, absolutePath, sizeof(absolutePath)))
+        {
+            MappedFileDeserializer deserializer(absolutePath);
+            if (deserializer.IsOpen())
+            {
+                return this->Deserialize(deserializer);
+            }
+        }
+
+
         drfs_file* pFile;
         if (drfs_open(g_Context->GetVFS(), relativeFilePath, DRFS_READ, &pFile) != drfs_success) {
             return false;
@@ -860,21 +888,36 @@ namespace GT
 
     void Scene::Update(double deltaTimeInSeconds)
     {
+        GT_PROFILE_ZONE("Scene::Update");
+
+        auto &stats = m_context.GetStats();
+        stats.Add(EngineStat_SceneNodes, static_cast<double>(this->GetSceneNodeCount()));
+
         this->OnUpdate(deltaTimeInSeconds);
 
 
         // Now we need to update via the update manager.
         if (!this->IsPaused())
         {
+            double updateStartTime = Timing::GetTimeInSeconds();
             this->updateManager.Step(deltaTimeInSeconds, this->GetCullingManager());
+            stats.Add(EngineStat_UpdateTime, (Timing::GetTimeInSeconds() - updateStartTime) * 1000.0);
         }
 
+        // Anything moved during the update needs to be pushed to the physics and culling managers before stepping the simulation.
+        this->FlushDeferredTransforms();
+
         // Physics. We do this after updating because the update might set velocity or whatnot.
         if (!this->IsPaused())
         {
+            double physicsStartTime = Timing::GetTimeInSeconds();
             this->physicsManager.Step(deltaTimeInSeconds);
+            stats.Add(EngineStat_PhysicsTime, (Timing::GetTimeInSeconds() - physicsStartTime) * 1000.0);
         }
 
+        // The physics step will have moved dynamic objects, and these need to be posted before proximity checks and rendering.
+        this->FlushDeferredTransforms();
+
 
         // We now want to check proximity components.
         for (size_t i = 0; i < this->sceneNodesWithProximityComponents.count; ++i)
@@ -1210,6 +1253,67 @@ namespace GT
     }
 
 
+    void Scene::EnableDeferredTransformPropagation()
+    {
+        this->isDeferredTransformPropagationEnabled = true;
+    }
+
+    void Scene::DisableDeferredTransformPropagation()
+    {
+        if (this->isDeferredTransformPropagationEnabled)
+        {
+            this->FlushDeferredTransforms();
+            this->isDeferredTransformPropagationEnabled = false;
+        }
+    }
+
+    bool Scene::IsDeferredTransformPropagationEnabled() const
+    {
+        return this->isDeferredTransformPropagationEnabled;
+    }
+
+    void Scene::FlushDeferredTransforms()
+    {
+        // Event handlers may modify transformations while we're flushing, which will queue up more nodes. We just keep going until
+        // the queue is empty. The flush list is reused between flushes to avoid allocations.
+        while (this->deferredTransformQueue.count > 0)
+        {
+            this->deferredTransformFlushList.Clear();
+            this->deferredTransformFlushList.Reserve(this->deferredTransformQueue.count);
+            for (size_t i = 0; i < this->deferredTransformQueue.count; ++i)
+            {
+                if (this->deferredTransformQueue[i] != nullptr)
+                {
+                    this->deferredTransformFlushList.PushBack(this->deferredTransformQueue[i]);
+                }
+            }
+            this->deferredTransformQueue.Clear();
+
+
+            // Parents need to be posted before their children. When a parent is posted, the event is propagated down to the children which will
+            // clear their pending transformation so they're not posted a second time.
+            std::stable_sort(this->deferredTransformFlushList.buffer, this->deferredTransformFlushList.buffer + this->deferredTransformFlushList.count,
+                [](const SceneNode* a, const SceneNode* b) -> bool
+                {
+                    return Scene_GetSceneNodeDepth(a) < Scene_GetSceneNodeDepth(b);
+                });
+
+
+            // An event handler may remove a node from the scene during the flush, in which case it will have been set to null.
+            for (size_t i = 0; i < this->deferredTransformFlushList.count; ++i)
+            {
+                auto node = this->deferredTransformFlushList[i];
+                if (node != nullptr)
+                {
+                    node->_PostDeferredTransformEvents();
+                }
+            }
+        }
+
+        this->deferredTransformFlushList.Clear();
+    }
+
+
 
     void Scene::CommitStateStackFrame()
     {
@@ -1967,10 +2071,13 @@ namespace GT
                         deserializer.Read(sceneNodeCount);
 
                         // The scene node IDs
-                        Vector<uint64_t> sceneNodeIDs;
-                        sceneNodeIDs.Reserve(sceneNodeCount);
-                        sceneNodeIDs.count = sceneNodeCount;
-                        deserializer.Read(sceneNodeIDs.buffer, sizeof(uint64_t) * sceneNodeCount);
+                        void* sceneNodeIDsBuffer;
+                        auto sceneNodeIDs = static_cast<const uint64_t*>(deserializer.ReadBlock(sizeof(uint64_t) * sceneNodeCount, sceneNodeIDsBuffer, alignof(uint64_t)));
+                        if (sceneNodeIDs == nullptr)
+                        {
+                            g_Context->Logf("Error deserializing scene. The scene node chunk is truncated.");
+                            return false;
+                        }
 
 
                         // The scene nodes need to be instantiated here.
@@ -1983,6 +2090,8 @@ namespace GT
                             deserializedNodes.PushBack(sceneNode);
                         }
 
+                        free(sceneNodeIDsBuffer);
+
                         // The new scene nodes now need to be linked to their parents.
                         for (size_t i = 0; i < childParentPairs.count; ++i)
                         {
@@ -2519,6 +2628,29 @@ namespace GT
         // The node must be removed from the update manager.
         this->updateManager.RemoveSceneNode(node);
 
+        // Any deferred transformations are discarded. The node may be in the queue even if it has already been posted by a parent, so this
+        // is based on the queued flag rather than whether or not there's anything pending.
+        if (node._IsInDeferredTransformQueue())
+        {
+            for (size_t i = 0; i < this->deferredTransformQueue.count; ++i)
+            {
+                if (this->deferredTransformQueue[i] == &node)
+                {
+                    this->deferredTransformQueue[i] = nullptr;
+                }
+            }
+
+            for (size_t i = 0; i < this->deferredTransformFlushList.count; ++i)
+            {
+                if (this->deferredTransformFlushList[i] == &node)
+                {
+                    this->deferredTransformFlushList[i] = nullptr;
+                }
+            }
+
+            node._CancelDeferredTransformEvents();
+        }
+
         // Event handlers need to know.
         this->PostEvent_OnSceneNodeRemoved(node);
     }
@@ -2669,6 +2801,11 @@ namespace GT
         this->PostEvent_OnSceneNodeScale(node);
     }
 
+    void Scene::QueueDeferredSceneNodeTransform(SceneNode &node)
+    {
+        this->deferredTransformQueue.PushBack(&node);
+    }
+
     void Scene::OnSceneNodeStaticChanged(SceneNode &node)
     {
         if (this->IsStateStackEnabled() && node.IsStateStackStagingEnabled())
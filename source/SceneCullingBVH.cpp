@@ -0,0 +1,758 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#include <GTGE/SceneCullingBVH.hpp>
+#include <GTGE/Math.hpp>
+#include <algorithm>
+
+#undef min
+#undef max
+
+namespace GT
+{
+    /// The bounds given to unused children. They are inverted so that they fail every test and drop out of every union.
+    static const float SceneCullingBVH_EmptyMin =  1e30f;
+    static const float SceneCullingBVH_EmptyMax = -1e30f;
+
+    /// The maximum number of nodes waiting on the stack during a query. Each level of the tree adds at most three, and the tree is at
+    /// most 15 levels deep from splitting the Morton codes plus however many it takes to split objects that share a cell.
+    static const size_t SceneCullingBVH_MaxStackSize = 128;
+
+    /// The number of refits before the tree is rebuilt.
+    static const uint32_t SceneCullingBVH_MaxRefitCount = 120;
+
+
+    /// The frustum planes, split into components. A point is inside a plane when a*x + b*y + c*z + d >= 0.
+    struct SceneCullingBVH_Frustum
+    {
+        float a[6];
+        float b[6];
+        float c[6];
+        float d[6];
+    };
+
+    /// The bounds of four boxes as a structure of arrays.
+    struct SceneCullingBVH_Boxes4
+    {
+        const float* minX;
+        const float* minY;
+        const float* minZ;
+        const float* maxX;
+        const float* maxY;
+        const float* maxZ;
+    };
+
+
+#if defined(GT_BUILD_SSE2)
+    /// Tests four boxes against the frustum.
+    ///
+    /// @return A mask of the boxes that are at least partially inside the frustum. insideMaskOut is set to the boxes that are entirely inside.
+    static inline unsigned int SceneCullingBVH_TestBoxes4(const SceneCullingBVH_Frustum &frustum, const SceneCullingBVH_Boxes4 &boxes, unsigned int &insideMaskOut)
+    {
+        __m128 minX = _mm_loadu_ps(boxes.minX);
+        __m128 minY = _mm_loadu_ps(boxes.minY);
+        __m128 minZ = _mm_loadu_ps(boxes.minZ);
+        __m128 maxX = _mm_loadu_ps(boxes.maxX);
+        __m128 maxY = _mm_loadu_ps(boxes.maxY);
+        __m128 maxZ = _mm_loadu_ps(boxes.maxZ);
+
+        __m128 zero    = _mm_setzero_ps();
+        __m128 outside = _mm_setzero_ps();
+        __m128 partial = _mm_setzero_ps();
+
+        for (int iPlane = 0; iPlane < 6; ++iPlane)
+        {
+            // The corner furthest along the plane's normal decides whether or not the box is entirely outside, and the nearest corner
+            // decides whether or not it's entirely inside. The sign of the normal is the same for all four boxes so the corners are
+            // picked without any blending.
+            __m128 farX  = (frustum.a[iPlane] >= 0) ? maxX : minX;
+            __m128 farY  = (frustum.b[iPlane] >= 0) ? maxY : minY;
+            __m128 farZ  = (frustum.c[iPlane] >= 0) ? maxZ : minZ;
+            __m128 nearX = (frustum.a[iPlane] >= 0) ? minX : maxX;
+            __m128 nearY = (frustum.b[iPlane] >= 0) ? minY : maxY;
+            __m128 nearZ = (frustum.c[iPlane] >= 0) ? minZ : maxZ;
+
+            __m128 a = _mm_set1_ps(frustum.a[iPlane]);
+            __m128 b = _mm_set1_ps(frustum.b[iPlane]);
+            __m128 c = _mm_set1_ps(frustum.c[iPlane]);
+            __m128 d = _mm_set1_ps(frustum.d[iPlane]);
+
+            __m128 farDistance  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, farX),  _mm_mul_ps(b, farY)),  _mm_add_ps(_mm_mul_ps(c, farZ),  d));
+            __m128 nearDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, nearX), _mm_mul_ps(b, nearY)), _mm_add_ps(_mm_mul_ps(c, nearZ), d));
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(farDistance,  zero));
+            partial = _mm_or_ps(partial, _mm_cmplt_ps(nearDistance, zero));
+        }
+
+        unsigned int visibleMask = ~static_cast<unsigned int>(_mm_movemask_ps(outside)) & 0xF;
+        insideMaskOut = visibleMask & ~static_cast<unsigned int>(_mm_movemask_ps(partial));
+
+        return visibleMask;
+    }
+
+    /// Tests four boxes against a single box.
+    ///
+    /// @return A mask of the boxes that overlap the box.
+    static inline unsigned int SceneCullingBVH_OverlapBoxes4(const glm::vec3 &aabbMin, const glm::vec3 &aabbMax, const SceneCullingBVH_Boxes4 &boxes)
+    {
+        __m128 overlapX = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(boxes.minX), _mm_set1_ps(aabbMax.x)), _mm_cmpge_ps(_mm_loadu_ps(boxes.maxX), _mm_set1_ps(aabbMin.x)));
+        __m128 overlapY = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(boxes.minY), _mm_set1_ps(aabbMax.y)), _mm_cmpge_ps(_mm_loadu_ps(boxes.maxY), _mm_set1_ps(aabbMin.y)));
+        __m128 overlapZ = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(boxes.minZ), _mm_set1_ps(aabbMax.z)), _mm_cmpge_ps(_mm_loadu_ps(boxes.maxZ), _mm_set1_ps(aabbMin.z)));
+
+        return static_cast<unsigned int>(_mm_movemask_ps(_mm_and_ps(overlapX, _mm_and_ps(overlapY, overlapZ))));
+    }
+#else
+    static inline unsigned int SceneCullingBVH_TestBoxes4(const SceneCullingBVH_Frustum &frustum, const SceneCullingBVH_Boxes4 &boxes, unsigned int &insideMaskOut)
+    {
+        unsigned int visibleMask = 0;
+        unsigned int insideMask  = 0;
+
+        for (unsigned int iBox = 0; iBox < 4; ++iBox)
+        {
+            bool isOutside = false;
+            bool isPartial = false;
+
+            for (int iPlane = 0; iPlane < 6; ++iPlane)
+            {
+                float a = frustum.a[iPlane];
+                float b = frustum.b[iPlane];
+                float c = frustum.c[iPlane];
+                float d = frustum.d[iPlane];
+
+                float farDistance  = a*((a >= 0) ? boxes.maxX[iBox] : boxes.minX[iBox]) + b*((b >= 0) ? boxes.maxY[iBox] : boxes.minY[iBox]) + c*((c >= 0) ? boxes.maxZ[iBox] : boxes.minZ[iBox]) + d;
+                float nearDistance = a*((a >= 0) ? boxes.minX[iBox] : boxes.maxX[iBox]) + b*((b >= 0) ? boxes.minY[iBox] : boxes.maxY[iBox]) + c*((c >= 0) ? boxes.minZ[iBox] : boxes.maxZ[iBox]) + d;
+
+                isOutside = isOutside || farDistance  < 0;
+                isPartial = isPartial || nearDistance < 0;
+            }
+
+            if (!isOutside)
+            {
+                visibleMask |= (1U << iBox);
+
+                if (!isPartial)
+                {
+                    insideMask |= (1U << iBox);
+                }
+            }
+        }
+
+        insideMaskOut = insideMask;
+        return visibleMask;
+    }
+
+    static inline unsigned int SceneCullingBVH_OverlapBoxes4(const glm::vec3 &aabbMin, const glm::vec3 &aabbMax, const SceneCullingBVH_Boxes4 &boxes)
+    {
+        unsigned int overlapMask = 0;
+
+        for (unsigned int iBox = 0; iBox < 4; ++iBox)
+        {
+            if (boxes.minX[iBox] <= aabbMax.x && boxes.maxX[iBox] >= aabbMin.x &&
+                boxes.minY[iBox] <= aabbMax.y && boxes.maxY[iBox] >= aabbMin.y &&
+                boxes.minZ[iBox] <= aabbMax.z && boxes.maxZ[iBox] >= aabbMin.z)
+            {
+                overlapMask |= (1U << iBox);
+            }
+        }
+
+        return overlapMask;
+    }
+#endif
+
+
+    /// Helper for running a four-wide test over a packed list of object slots, where the last group may have fewer than four.
+    struct SceneCullingBVH_SlotGroup
+    {
+        /// The padded copy of the last group.
+        float tail[6][4];
+
+        /// Retrieves the boxes of the group starting at the given slot.
+        SceneCullingBVH_Boxes4 Get(const float* minX, const float* minY, const float* minZ, const float* maxX, const float* maxY, const float* maxZ, size_t firstSlot, size_t slotCount)
+        {
+            SceneCullingBVH_Boxes4 boxes;
+
+            if (firstSlot + 4 <= slotCount)
+            {
+                boxes.minX = minX + firstSlot;
+                boxes.minY = minY + firstSlot;
+                boxes.minZ = minZ + firstSlot;
+                boxes.maxX = maxX + firstSlot;
+                boxes.maxY = maxY + firstSlot;
+                boxes.maxZ = maxZ + firstSlot;
+            }
+            else
+            {
+                for (size_t iBox = 0; iBox < 4; ++iBox)
+                {
+                    size_t iSlot = firstSlot + iBox;
+                    bool   used  = iSlot < slotCount;
+
+                    this->tail[0][iBox] = used ? minX[iSlot] : SceneCullingBVH_EmptyMin;
+                    this->tail[1][iBox] = used ? minY[iSlot] : SceneCullingBVH_EmptyMin;
+                    this->tail[2][iBox] = used ? minZ[iSlot] : SceneCullingBVH_EmptyMin;
+                    this->tail[3][iBox] = used ? maxX[iSlot] : SceneCullingBVH_EmptyMax;
+                    this->tail[4][iBox] = used ? maxY[iSlot] : SceneCullingBVH_EmptyMax;
+                    this->tail[5][iBox] = used ? maxZ[iSlot] : SceneCullingBVH_EmptyMax;
+                }
+
+                boxes.minX = this->tail[0];
+                boxes.minY = this->tail[1];
+                boxes.minZ = this->tail[2];
+                boxes.maxX = this->tail[3];
+                boxes.maxY = this->tail[4];
+                boxes.maxZ = this->tail[5];
+            }
+
+            return boxes;
+        }
+    };
+
+    /// Spreads the low 10 bits of a value out so there are two zero bits between each one, for building a Morton code.
+    static inline uint32_t SceneCullingBVH_SpreadBits(uint32_t value)
+    {
+        value = (value | (value << 16)) & 0x030000FF;
+        value = (value | (value <<  8)) & 0x0300F00F;
+        value = (value | (value <<  4)) & 0x030C30C3;
+        value = (value | (value <<  2)) & 0x09249249;
+
+        return value;
+    }
+
+    static inline SceneCullingBVH_Boxes4 SceneCullingBVH_GetNodeBoxes(const SceneCullingBVHNode &node)
+    {
+        SceneCullingBVH_Boxes4 boxes;
+        boxes.minX = node.minX;
+        boxes.minY = node.minY;
+        boxes.minZ = node.minZ;
+        boxes.maxX = node.maxX;
+        boxes.maxY = node.maxY;
+        boxes.maxZ = node.maxZ;
+
+        return boxes;
+    }
+
+
+
+    SceneCullingBVH::SceneCullingBVH()
+        : m_minX(), m_minY(), m_minZ(), m_maxX(), m_maxY(), m_maxZ(),
+          m_slotIDs(), m_idSlots(), m_freeIDs(),
+          m_nodes(), m_buildItems(),
+          m_needsRebuild(false), m_needsRefit(false), m_refitCount(0)
+    {
+    }
+
+    SceneCullingBVH::~SceneCullingBVH()
+    {
+    }
+
+
+    uint32_t SceneCullingBVH::Add(const glm::vec3 &aabbMin, const glm::vec3 &aabbMax)
+    {
+        uint32_t objectID;
+        if (m_freeIDs.count > 0)
+        {
+            objectID = m_freeIDs.GetBack();
+            m_freeIDs.PopBack();
+        }
+        else
+        {
+            objectID = static_cast<uint32_t>(m_idSlots.count);
+            m_idSlots.PushBack(-1);
+        }
+
+        m_idSlots[objectID] = static_cast<int32_t>(m_slotIDs.count);
+        m_slotIDs.PushBack(objectID);
+
+        m_minX.PushBack(aabbMin.x);
+        m_minY.PushBack(aabbMin.y);
+        m_minZ.PushBack(aabbMin.z);
+        m_maxX.PushBack(aabbMax.x);
+        m_maxY.PushBack(aabbMax.y);
+        m_maxZ.PushBack(aabbMax.z);
+
+        m_needsRebuild = true;
+
+        return objectID;
+    }
+
+    void SceneCullingBVH::Remove(uint32_t objectID)
+    {
+        assert(objectID < m_idSlots.count);
+        assert(m_idSlots[objectID] != -1);
+        {
+            // The last object is moved into the removed object's slot to keep the arrays packed.
+            size_t iSlot     = static_cast<size_t>(m_idSlots[objectID]);
+            size_t iLastSlot = m_slotIDs.count - 1;
+            if (iSlot != iLastSlot)
+            {
+                m_minX[iSlot] = m_minX[iLastSlot];
+                m_minY[iSlot] = m_minY[iLastSlot];
+                m_minZ[iSlot] = m_minZ[iLastSlot];
+                m_maxX[iSlot] = m_maxX[iLastSlot];
+                m_maxY[iSlot] = m_maxY[iLastSlot];
+                m_maxZ[iSlot] = m_maxZ[iLastSlot];
+
+                m_slotIDs[iSlot] = m_slotIDs[iLastSlot];
+                m_idSlots[m_slotIDs[iSlot]] = static_cast<int32_t>(iSlot);
+            }
+
+            m_minX.PopBack();
+            m_minY.PopBack();
+            m_minZ.PopBack();
+            m_maxX.PopBack();
+            m_maxY.PopBack();
+            m_maxZ.PopBack();
+            m_slotIDs.PopBack();
+
+            m_idSlots[objectID] = -1;
+            m_freeIDs.PushBack(objectID);
+
+            m_needsRebuild = true;
+        }
+    }
+
+    void SceneCullingBVH::Update(uint32_t objectID, const glm::vec3 &aabbMin, const glm::vec3 &aabbMax)
+    {
+        assert(objectID < m_idSlots.count);
+        assert(m_idSlots[objectID] != -1);
+        {
+            size_t iSlot = static_cast<size_t>(m_idSlots[objectID]);
+
+            m_minX[iSlot] = aabbMin.x;
+            m_minY[iSlot] = aabbMin.y;
+            m_minZ[iSlot] = aabbMin.z;
+            m_maxX[iSlot] = aabbMax.x;
+            m_maxY[iSlot] = aabbMax.y;
+            m_maxZ[iSlot] = aabbMax.z;
+
+            m_needsRefit = true;
+        }
+    }
+
+    void SceneCullingBVH::Clear()
+    {
+        m_minX.Clear();
+        m_minY.Clear();
+        m_minZ.Clear();
+        m_maxX.Clear();
+        m_maxY.Clear();
+        m_maxZ.Clear();
+        m_slotIDs.Clear();
+        m_idSlots.Clear();
+        m_freeIDs.Clear();
+        m_nodes.Clear();
+
+        m_needsRebuild = false;
+        m_needsRefit   = false;
+        m_refitCount   = 0;
+    }
+
+
+    void SceneCullingBVH::Commit()
+    {
+        if (m_needsRebuild || (m_needsRefit && m_refitCount >= SceneCullingBVH_MaxRefitCount))
+        {
+            this->Rebuild();
+        }
+        else if (m_needsRefit)
+        {
+            this->Refit();
+        }
+    }
+
+
+    void SceneCullingBVH::GetAABB(uint32_t objectID, glm::vec3 &aabbMinOut, glm::vec3 &aabbMaxOut) const
+    {
+        assert(objectID < m_idSlots.count);
+        assert(m_idSlots[objectID] != -1);
+        {
+            size_t iSlot = static_cast<size_t>(m_idSlots[objectID]);
+
+            aabbMinOut = glm::vec3(m_minX[iSlot], m_minY[iSlot], m_minZ[iSlot]);
+            aabbMaxOut = glm::vec3(m_maxX[iSlot], m_maxY[iSlot], m_maxZ[iSlot]);
+        }
+    }
+
+    void SceneCullingBVH::GetGlobalAABB(glm::vec3 &aabbMinOut, glm::vec3 &aabbMaxOut) const
+    {
+        if (m_slotIDs.count == 0)
+        {
+            aabbMinOut = glm::vec3(0.0f);
+            aabbMaxOut = glm::vec3(0.0f);
+            return;
+        }
+
+        if (!this->IsOutOfDate() && m_nodes.count > 0)
+        {
+            this->GetChildAABB(0, aabbMinOut, aabbMaxOut);
+        }
+        else
+        {
+            aabbMinOut = glm::vec3(SceneCullingBVH_EmptyMin);
+            aabbMaxOut = glm::vec3(SceneCullingBVH_EmptyMax);
+
+            for (size_t iSlot = 0; iSlot < m_slotIDs.count; ++iSlot)
+            {
+                aabbMinOut = glm::min(aabbMinOut, glm::vec3(m_minX.buffer[iSlot], m_minY.buffer[iSlot], m_minZ.buffer[iSlot]));
+                aabbMaxOut = glm::max(aabbMaxOut, glm::vec3(m_maxX.buffer[iSlot], m_maxY.buffer[iSlot], m_maxZ.buffer[iSlot]));
+            }
+        }
+    }
+
+
+    void SceneCullingBVH::QueryFrustum(const glm::mat4 &mvp, Vector<uint32_t> &visibleObjectsOut) const
+    {
+        size_t slotCount = m_slotIDs.count;
+        if (slotCount == 0)
+        {
+            return;
+        }
+
+
+        Math::Plane planes[6];
+        Math::CalculateFrustumPlanes(mvp, planes, false);       // <-- The planes don't need to be normalized for a sign test.
+
+        SceneCullingBVH_Frustum frustum;
+        for (int iPlane = 0; iPlane < 6; ++iPlane)
+        {
+            frustum.a[iPlane] = planes[iPlane].a;
+            frustum.b[iPlane] = planes[iPlane].b;
+            frustum.c[iPlane] = planes[iPlane].c;
+            frustum.d[iPlane] = planes[iPlane].d;
+        }
+
+
+        if (this->IsOutOfDate() || m_nodes.count == 0)
+        {
+            // The tree can't be trusted, but the objects themselves are up to date so they're just tested in order.
+            SceneCullingBVH_SlotGroup group;
+            for (size_t iSlot = 0; iSlot < slotCount; iSlot += 4)
+            {
+                unsigned int insideMask;
+                unsigned int visibleMask = SceneCullingBVH_TestBoxes4(frustum, group.Get(m_minX.buffer, m_minY.buffer, m_minZ.buffer, m_maxX.buffer, m_maxY.buffer, m_maxZ.buffer, iSlot, slotCount), insideMask);
+
+                for (unsigned int iBox = 0; iBox < 4; ++iBox)
+                {
+                    if ((visibleMask & (1U << iBox)) != 0 && iSlot + iBox < slotCount)
+                    {
+                        visibleObjectsOut.PushBack(m_slotIDs.buffer[iSlot + iBox]);
+                    }
+                }
+            }
+
+            return;
+        }
+
+
+        // Each stack entry is a node index shifted up by one, with the low bit set if the node is known to be entirely inside the
+        // frustum, in which case none of it's children need to be tested.
+        uint32_t stack[SceneCullingBVH_MaxStackSize];
+        size_t   stackSize = 0;
+
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            uint32_t entry = stack[--stackSize];
+            const SceneCullingBVHNode &node = m_nodes.buffer[entry >> 1];
+
+            unsigned int visibleMask = 0xF;
+            unsigned int insideMask  = 0xF;
+            if ((entry & 1) == 0)
+            {
+                visibleMask = SceneCullingBVH_TestBoxes4(frustum, SceneCullingBVH_GetNodeBoxes(node), insideMask);
+            }
+
+            for (unsigned int iChild = 0; iChild < 4; ++iChild)
+            {
+                if ((visibleMask & (1U << iChild)) != 0)
+                {
+                    int32_t child = node.children[iChild];
+                    if (child >= 0)
+                    {
+                        assert(stackSize < SceneCullingBVH_MaxStackSize);
+                        stack[stackSize++] = (static_cast<uint32_t>(child) << 1) | ((insideMask >> iChild) & 1);
+                    }
+                    else if (child != EmptyChild)
+                    {
+                        visibleObjectsOut.PushBack(m_slotIDs.buffer[~child]);
+                    }
+                }
+            }
+        }
+    }
+
+    void SceneCullingBVH::QueryAABB(const glm::vec3 &aabbMin, const glm::vec3 &aabbMax, Vector<uint32_t> &objectsOut) const
+    {
+        size_t slotCount = m_slotIDs.count;
+        if (slotCount == 0)
+        {
+            return;
+        }
+
+
+        if (this->IsOutOfDate() || m_nodes.count == 0)
+        {
+            SceneCullingBVH_SlotGroup group;
+            for (size_t iSlot = 0; iSlot < slotCount; iSlot += 4)
+            {
+                unsigned int overlapMask = SceneCullingBVH_OverlapBoxes4(aabbMin, aabbMax, group.Get(m_minX.buffer, m_minY.buffer, m_minZ.buffer, m_maxX.buffer, m_maxY.buffer, m_maxZ.buffer, iSlot, slotCount));
+
+                for (unsigned int iBox = 0; iBox < 4; ++iBox)
+                {
+                    if ((overlapMask & (1U << iBox)) != 0 && iSlot + iBox < slotCount)
+                    {
+                        objectsOut.PushBack(m_slotIDs.buffer[iSlot + iBox]);
+                    }
+                }
+            }
+
+            return;
+        }
+
+
+        int32_t stack[SceneCullingBVH_MaxStackSize];
+        size_t  stackSize = 0;
+
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const SceneCullingBVHNode &node = m_nodes.buffer[stack[--stackSize]];
+
+            unsigned int overlapMask = SceneCullingBVH_OverlapBoxes4(aabbMin, aabbMax, SceneCullingBVH_GetNodeBoxes(node));
+            for (unsigned int iChild = 0; iChild < 4; ++iChild)
+            {
+                if ((overlapMask & (1U << iChild)) != 0)
+                {
+                    int32_t child = node.children[iChild];
+                    if (child >= 0)
+                    {
+                        assert(stackSize < SceneCullingBVH_MaxStackSize);
+                        stack[stackSize++] = child;
+                    }
+                    else if (child != EmptyChild)
+                    {
+                        objectsOut.PushBack(m_slotIDs.buffer[~child]);
+                    }
+                }
+            }
+        }
+    }
+
+    void SceneCullingBVH::QueryAll(Vector<uint32_t> &objectsOut) const
+    {
+        for (size_t iSlot = 0; iSlot < m_slotIDs.count; ++iSlot)
+        {
+            objectsOut.PushBack(m_slotIDs.buffer[iSlot]);
+        }
+    }
+
+
+
+    ////////////////////////////////////////////////
+    // Private
+
+    void SceneCullingBVH::Rebuild()
+    {
+        m_nodes.Clear();
+
+        m_needsRebuild = false;
+        m_needsRefit   = false;
+        m_refitCount   = 0;
+
+
+        size_t slotCount = m_slotIDs.count;
+        if (slotCount == 0)
+        {
+            return;
+        }
+
+        // The objects are sorted along a Morton curve through their centres, which puts objects that are close to each other next to
+        // each other in the list. Each node's range of the list can then be split in half spatially with a binary search.
+        glm::vec3 centreMin;
+        glm::vec3 centreMax;
+        this->GetGlobalAABB(centreMin, centreMax);
+
+        glm::vec3 extents = centreMax - centreMin;
+        glm::vec3 scale(
+            (extents.x > 0) ? 1023.0f / extents.x : 0.0f,
+            (extents.y > 0) ? 1023.0f / extents.y : 0.0f,
+            (extents.z > 0) ? 1023.0f / extents.z : 0.0f);
+
+        m_buildItems.Clear();
+        m_buildItems.Reserve(slotCount);
+        for (size_t iSlot = 0; iSlot < slotCount; ++iSlot)
+        {
+            glm::vec3 centre((m_minX.buffer[iSlot] + m_maxX.buffer[iSlot]) * 0.5f, (m_minY.buffer[iSlot] + m_maxY.buffer[iSlot]) * 0.5f, (m_minZ.buffer[iSlot] + m_maxZ.buffer[iSlot]) * 0.5f);
+            glm::vec3 cell = glm::clamp((centre - centreMin) * scale, glm::vec3(0.0f), glm::vec3(1023.0f));
+
+            BuildItem item;
+            item.mortonCode = (SceneCullingBVH_SpreadBits(static_cast<uint32_t>(cell.x)) << 2) | (SceneCullingBVH_SpreadBits(static_cast<uint32_t>(cell.y)) << 1) | SceneCullingBVH_SpreadBits(static_cast<uint32_t>(cell.z));
+            item.slot       = static_cast<uint32_t>(iSlot);
+
+            m_buildItems.PushBack(item);
+        }
+
+        std::sort(m_buildItems.buffer, m_buildItems.buffer + m_buildItems.count, [](const BuildItem &a, const BuildItem &b) -> bool
+        {
+            return a.mortonCode < b.mortonCode;
+        });
+
+        // A four-wide tree with mostly full leaves has roughly a third as many nodes as objects.
+        m_nodes.Reserve(slotCount / 3 + 1);
+
+        this->BuildNode(0, slotCount);
+    }
+
+    void SceneCullingBVH::Refit()
+    {
+        // Every node comes before it's children, so going backwards means the children are always refitted first.
+        for (size_t iNode = m_nodes.count; iNode > 0; --iNode)
+        {
+            int32_t nodeIndex = static_cast<int32_t>(iNode - 1);
+            for (unsigned int iChild = 0; iChild < 4; ++iChild)
+            {
+                this->SetNodeChild(nodeIndex, iChild, m_nodes.buffer[nodeIndex].children[iChild]);
+            }
+        }
+
+        m_needsRefit  = false;
+        m_refitCount += 1;
+    }
+
+    int32_t SceneCullingBVH::BuildNode(size_t first, size_t count)
+    {
+        assert(count > 0);
+
+        int32_t nodeIndex = static_cast<int32_t>(m_nodes.count);
+        m_nodes.PushBack(SceneCullingBVHNode());
+
+
+        // The range is split in two, and then each half is split in two again.
+        size_t groupFirst[4];
+        size_t groupCount[4];
+
+        if (count <= 4)
+        {
+            for (size_t iGroup = 0; iGroup < 4; ++iGroup)
+            {
+                groupFirst[iGroup] = first + iGroup;
+                groupCount[iGroup] = (iGroup < count) ? 1 : 0;
+            }
+        }
+        else
+        {
+            size_t countA = this->FindBuildSplit(first, count);
+            size_t countB = count - countA;
+
+            groupFirst[0] = first;
+            groupCount[0] = this->FindBuildSplit(first, countA);
+            groupFirst[1] = first + groupCount[0];
+            groupCount[1] = countA - groupCount[0];
+            groupFirst[2] = first + countA;
+            groupCount[2] = this->FindBuildSplit(first + countA, countB);
+            groupFirst[3] = groupFirst[2] + groupCount[2];
+            groupCount[3] = countB - groupCount[2];
+        }
+
+
+        for (unsigned int iGroup = 0; iGroup < 4; ++iGroup)
+        {
+            int32_t child = EmptyChild;
+            if (groupCount[iGroup] == 1)
+            {
+                child = ~static_cast<int32_t>(m_buildItems[groupFirst[iGroup]].slot);
+            }
+            else if (groupCount[iGroup] > 1)
+            {
+                child = this->BuildNode(groupFirst[iGroup], groupCount[iGroup]);
+            }
+
+            this->SetNodeChild(nodeIndex, iGroup, child);
+        }
+
+        return nodeIndex;
+    }
+
+    size_t SceneCullingBVH::FindBuildSplit(size_t first, size_t count) const
+    {
+        if (count < 2)
+        {
+            return count;
+        }
+
+        uint32_t firstCode = m_buildItems.buffer[first].mortonCode;
+        uint32_t lastCode  = m_buildItems.buffer[first + count - 1].mortonCode;
+        if (firstCode == lastCode)
+        {
+            // The objects are all in the same cell, so they're just split evenly.
+            return count / 2;
+        }
+
+
+        // Every item in the range has the same bits above the highest bit that differs between the first and last items. The split
+        // is at the first item with that bit set, which is the same as splitting the range's cell in half.
+        uint32_t splitBit = firstCode ^ lastCode;
+        splitBit |= splitBit >> 1;
+        splitBit |= splitBit >> 2;
+        splitBit |= splitBit >> 4;
+        splitBit |= splitBit >> 8;
+        splitBit |= splitBit >> 16;
+        splitBit ^= splitBit >> 1;
+
+        BuildItem splitItem;
+        splitItem.mortonCode = lastCode & ~(splitBit - 1);
+        splitItem.slot       = 0;
+
+        const BuildItem* begin = m_buildItems.buffer + first;
+        const BuildItem* split = std::lower_bound(begin, begin + count, splitItem, [](const BuildItem &a, const BuildItem &b) -> bool
+        {
+            return a.mortonCode < b.mortonCode;
+        });
+
+        return static_cast<size_t>(split - begin);
+    }
+
+    void SceneCullingBVH::SetNodeChild(int32_t nodeIndex, unsigned int childIndex, int32_t child)
+    {
+        glm::vec3 aabbMin;
+        glm::vec3 aabbMax;
+        this->GetChildAABB(child, aabbMin, aabbMax);
+
+        SceneCullingBVHNode &node = m_nodes.buffer[nodeIndex];
+        node.minX[childIndex] = aabbMin.x;
+        node.minY[childIndex] = aabbMin.y;
+        node.minZ[childIndex] = aabbMin.z;
+        node.maxX[childIndex] = aabbMax.x;
+        node.maxY[childIndex] = aabbMax.y;
+        node.maxZ[childIndex] = aabbMax.z;
+        node.children[childIndex] = child;
+    }
+
+    void SceneCullingBVH::GetChildAABB(int32_t child, glm::vec3 &aabbMinOut, glm::vec3 &aabbMaxOut) const
+    {
+        if (child == EmptyChild)
+        {
+            aabbMinOut = glm::vec3(SceneCullingBVH_EmptyMin);
+            aabbMaxOut = glm::vec3(SceneCullingBVH_EmptyMax);
+        }
+        else if (child < 0)
+        {
+            size_t iSlot = static_cast<size_t>(~child);
+
+            aabbMinOut = glm::vec3(m_minX.buffer[iSlot], m_minY.buffer[iSlot], m_minZ.buffer[iSlot]);
+            aabbMaxOut = glm::vec3(m_maxX.buffer[iSlot], m_maxY.buffer[iSlot], m_maxZ.buffer[iSlot]);
+        }
+        else
+        {
+            const SceneCullingBVHNode &node = m_nodes.buffer[child];
+
+            aabbMinOut = glm::vec3(glm::min(glm::min(node.minX[0], node.minX[1]), glm::min(node.minX[2], node.minX[3])),
+                                   glm::min(glm::min(node.minY[0], node.minY[1]), glm::min(node.minY[2], node.minY[3])),
+                                   glm::min(glm::min(node.minZ[0], node.minZ[1]), glm::min(node.minZ[2], node.minZ[3])));
+            aabbMaxOut = glm::vec3(glm::max(glm::max(node.maxX[0], node.maxX[1]), glm::max(node.maxX[2], node.maxX[3])),
+                                   glm::max(glm::max(node.maxY[0], node.maxY[1]), glm::max(node.maxY[2], node.maxY[3])),
+                                   glm::max(glm::max(node.maxZ[0], node.maxZ[1]), glm::max(node.maxZ[2], node.maxZ[3])));
+        }
+    }
+}
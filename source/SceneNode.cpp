@@ -16,10 +16,11 @@ namespace GT
           m_parent(nullptr),
           firstChild(nullptr), lastChild(nullptr), prevSibling(nullptr), nextSibling(nullptr),
           m_position(), m_orientation(), m_scale(1.0f, 1.0f, 1.0f),
+          m_worldPosition(), m_worldOrientation(), m_worldScale(1.0f, 1.0f, 1.0f), m_worldTransform(), m_isWorldTransformDirty(true),
           eventHandlers(), components(), dataPointers(),
           scene(nullptr),
           m_flags(0),
-          eventLockCounter(0),
+          eventLockCounter(0), m_deferredTransformFlags(0),
           modelComponent(nullptr), pointLightComponent(nullptr), spotLightComponent(nullptr), editorMetadataComponent(nullptr)
     {
     }
@@ -429,6 +430,7 @@ namespace GT
     void SceneNode::_SetParent(SceneNode *parent)
     {
         m_parent = parent;
+        this->InvalidateWorldTransform();
     }
 
     void SceneNode::_SetPrevSibling(SceneNode* newPrevSibling)
@@ -451,34 +453,19 @@ namespace GT
         if (m_position.x != position.x || m_position.y != position.y || m_position.z != position.z)
         {
             m_position = position;
+            this->InvalidateWorldTransform();
 
             if (!this->EventsLocked())
             {
-                this->OnTransform(updateDynamicsObject);
+                this->PostTransformEvent(updateDynamicsObject);
             }
         }
     }
 
     glm::vec3 SceneNode::GetWorldPosition() const
     {
-        if (m_parent != nullptr && this->IsPositionInheritanceEnabled())
-        {
-            glm::quat orientation;
-            if (this->IsOrientationInheritanceEnabled())
-            {
-                orientation = m_parent->GetWorldOrientation();
-            }
-
-            glm::vec3 scale(1.0f, 1.0f, 1.0f);
-            if (this->IsScaleInheritanceEnabled())
-            {
-                scale = m_parent->GetWorldScale();
-            }
-
-            return m_parent->GetWorldPosition() + (orientation * (scale * m_position));
-        }
-
-        return m_position;
+        this->UpdateWorldTransform();
+        return m_worldPosition;
     }
 
     void SceneNode::SetWorldPosition(const glm::vec3 &worldPosition, bool updateDynamicsObject)
@@ -506,22 +493,19 @@ namespace GT
             m_orientation[3] != orientation[3])
         {
             m_orientation = orientation;
+            this->InvalidateWorldTransform();
 
             if (!this->EventsLocked())
             {
-                this->OnTransform(updateDynamicsObject);
+                this->PostTransformEvent(updateDynamicsObject);
             }
         }
     }
 
     glm::quat SceneNode::GetWorldOrientation() const
     {
-        if (m_parent != nullptr && this->IsOrientationInheritanceEnabled())
-        {
-            return m_parent->GetWorldOrientation() * m_orientation;
-        }
-
-        return m_orientation;
+        this->UpdateWorldTransform();
+        return m_worldOrientation;
     }
 
     void SceneNode::SetWorldOrientation(const glm::quat &worldOrientation, bool updateDynamicsObject)
@@ -542,22 +526,19 @@ namespace GT
         if (m_scale.x != scale.x || m_scale.y != scale.y || m_scale.z != scale.z)
         {
             m_scale = scale;
+            this->InvalidateWorldTransform();
 
             if (!this->EventsLocked())
             {
-                this->OnScale();
+                this->PostScaleEvent();
             }
         }
     }
 
     glm::vec3 SceneNode::GetWorldScale() const
     {
-        if (m_parent != nullptr && this->IsScaleInheritanceEnabled())
-        {
-            return m_parent->GetWorldScale() * m_scale;
-        }
-
-        return m_scale;
+        this->UpdateWorldTransform();
+        return m_worldScale;
     }
 
     void SceneNode::SetWorldScale(const glm::vec3 &worldScale)
@@ -608,66 +589,11 @@ namespace GT
 
     void SceneNode::GetWorldTransformComponents(glm::vec3 &positionOut, glm::quat &orientationOut, glm::vec3 &scaleOut) const
     {
-        if (m_parent != nullptr)
-        {
-            m_parent->GetWorldTransformComponents(positionOut, orientationOut, scaleOut);
-
-            glm::vec3 temp;
-            if (!this->IsPositionInheritanceEnabled())
-            {
-                positionOut = m_position;
+        this->UpdateWorldTransform();
 
-                if (!this->IsScaleInheritanceEnabled())
-                {
-                    scaleOut = m_scale;
-                }
-                else
-                {
-                    scaleOut = scaleOut * m_scale;
-                }
-
-                if (!this->IsOrientationInheritanceEnabled())
-                {
-                    orientationOut = m_orientation;
-                }
-                else
-                {
-                    orientationOut = orientationOut * m_orientation;
-                }
-            }
-            else
-            {
-                glm::vec3 offset = m_position;
-
-                if (!this->IsScaleInheritanceEnabled())
-                {
-                    scaleOut = m_scale;
-                }
-                else
-                {
-                    offset   = scaleOut * offset;
-                    scaleOut = scaleOut * m_scale;
-                }
-
-                if (!this->IsOrientationInheritanceEnabled())
-                {
-                    orientationOut = m_orientation;
-                }
-                else
-                {
-                    offset         = orientationOut * offset;
-                    orientationOut = orientationOut * m_orientation;
-                }
-
-                positionOut += offset;
-            }
-        }
-        else
-        {
-            positionOut    = m_position;
-            orientationOut = m_orientation;
-            scaleOut       = m_scale;
-        }
+        positionOut    = m_worldPosition;
+        orientationOut = m_worldOrientation;
+        scaleOut       = m_worldScale;
     }
 
     void SceneNode::SetWorldTransformComponents(const glm::vec3 &position, const glm::quat &orientation, const glm::vec3 &scale, bool updateDynamicsObject)
@@ -694,42 +620,26 @@ namespace GT
 
     glm::mat4 SceneNode::GetWorldTransform() const
     {
-        glm::vec3 position;
-        glm::quat orientation;
-        glm::vec3 scale;
-        this->GetWorldTransformComponents(position, orientation, scale);
-
-        glm::mat4 result;
-        Math::CalculateTransformMatrix(position, orientation, scale, result);
-
-        return result;
+        this->UpdateWorldTransform();
+        return m_worldTransform;
     }
 
     glm::mat4 SceneNode::GetWorldTransformWithoutScale() const
     {
-        glm::vec3 position;
-        glm::quat orientation;
-        glm::vec3 devnull;
-        this->GetWorldTransformComponents(position, orientation, devnull);
+        this->UpdateWorldTransform();
 
         glm::mat4 result;
-        Math::CalculateTransformMatrix(position, orientation, result);
+        Math::CalculateTransformMatrix(m_worldPosition, m_worldOrientation, result);
 
         return result;
     }
 
     void SceneNode::GetWorldTransform(btTransform &worldTransform) const
     {
-        glm::vec3 position;
-        glm::quat orientation;
-        glm::vec3 devnull;
-        this->GetWorldTransformComponents(position, orientation, devnull);
+        this->UpdateWorldTransform();
 
-        worldTransform.setRotation(btQuaternion(orientation.x, orientation.y, orientation.z, orientation.w));
-        worldTransform.setOrigin(btVector3(position.x, position.y, position.z));
-
-
-        (void)devnull;  // <-- warning silencer.
+        worldTransform.setRotation(btQuaternion(m_worldOrientation.x, m_worldOrientation.y, m_worldOrientation.z, m_worldOrientation.w));
+        worldTransform.setOrigin(btVector3(m_worldPosition.x, m_worldPosition.y, m_worldPosition.z));
     }
 
     void SceneNode::SetWorldTransform(const btTransform &worldTransform, bool updateDynamicsObject)
@@ -743,7 +653,7 @@ namespace GT
         this->UnlockEvents();
 
         // Now is where we post the transformation event.
-        this->OnTransform(updateDynamicsObject);
+        this->PostTransformEvent(updateDynamicsObject);
     }
 
 
@@ -883,6 +793,38 @@ namespace GT
         return nullptr;
     }
 
+    Component* SceneNode::GetComponentByID(StringID nameID)
+    {
+        if (nameID == ModelComponent::GetNameID())
+        {
+            return this->modelComponent;
+        }
+
+        if (nameID == PointLightComponent::GetNameID())
+        {
+            return this->pointLightComponent;
+        }
+
+        if (nameID == SpotLightComponent::GetNameID())
+        {
+            return this->spotLightComponent;
+        }
+
+        if (nameID == EditorMetadataComponent::GetNameID())
+        {
+            return this->editorMetadataComponent;
+        }
+
+
+        auto item = this->components.Find(GetInternedString(nameID), -1, GetInternedStringHash(nameID));
+        if (item != nullptr)
+        {
+            return item->value;
+        }
+
+        return nullptr;
+    }
+
     Component* SceneNode::AddComponentByName(const char* componentName)
     {
         // A component of the same name can't already exist. If it doesn, we just return the existing one.
@@ -1032,6 +974,28 @@ namespace GT
         this->scene = newScene;
     }
 
+    void SceneNode::_PostDeferredTransformEvents()
+    {
+        // The queued flag is cleared first so that if an event handler modifies the transformation again, the node is re-queued.
+        unsigned int flags = m_deferredTransformFlags;
+        m_deferredTransformFlags = 0;
+
+        if ((flags & DeferredTransform_Transform) != 0)
+        {
+            this->OnTransform((flags & DeferredTransform_UpdateDynamicsObject) != 0);
+        }
+
+        if ((flags & DeferredTransform_Scale) != 0)
+        {
+            this->OnScale();
+        }
+    }
+
+    void SceneNode::_CancelDeferredTransformEvents()
+    {
+        m_deferredTransformFlags = 0;
+    }
+
     void SceneNode::RemoveFromScene()
     {
         if (this->scene != nullptr)
@@ -1126,6 +1090,7 @@ namespace GT
         auto worldPosition = this->GetWorldPosition();
 
         m_flags = m_flags | NoPositionInheritance;
+        this->InvalidateWorldTransform();
         this->SetWorldPosition(worldPosition);     // This will ensure the position is correct.
     }
 
@@ -1134,6 +1099,7 @@ namespace GT
         auto worldPosition = this->GetWorldPosition();
 
         m_flags = m_flags & ~NoPositionInheritance;
+        this->InvalidateWorldTransform();
         this->SetWorldPosition(worldPosition);     // This will ensure the position is correct.
     }
 
@@ -1149,6 +1115,7 @@ namespace GT
         auto worldOrientation = this->GetWorldOrientation();
 
         m_flags = m_flags | NoOrientationInheritance;
+        this->InvalidateWorldTransform();
         this->SetWorldOrientation(worldOrientation);
     }
 
@@ -1157,6 +1124,7 @@ namespace GT
         auto worldOrientation = this->GetWorldOrientation();
 
         m_flags = m_flags & ~NoOrientationInheritance;
+        this->InvalidateWorldTransform();
         this->SetWorldOrientation(worldOrientation);
     }
 
@@ -1172,6 +1140,7 @@ namespace GT
         auto worldScale = this->GetWorldScale();
 
         m_flags = m_flags | NoScaleInheritance;
+        this->InvalidateWorldTransform();
         this->SetWorldScale(worldScale);
     }
 
@@ -1180,6 +1149,7 @@ namespace GT
         auto worldScale = this->GetWorldScale();
 
         m_flags = m_flags & ~NoOrientationInheritance;
+        this->InvalidateWorldTransform();
         this->SetWorldScale(worldScale);
     }
 
@@ -1319,6 +1289,7 @@ namespace GT
                         deserializer.Read(newOrientation);
                         deserializer.Read(newScale);
                         deserializer.Read(reinterpret_cast<uint32_t &>(m_flags));
+                        this->InvalidateWorldTransform();
 
                         break;
                     }
@@ -1528,6 +1499,12 @@ namespace GT
 
     void SceneNode::OnTransform(bool updateDynamicsObject)
     {
+        // If a deferred transformation is pending it is satisfied by this event, which will be the case when an ancestor is flushed
+        // before this node. The scale and queued flags are left alone.
+        bool updateOwnDynamicsObject = updateDynamicsObject || (m_deferredTransformFlags & DeferredTransform_UpdateDynamicsObject) != 0;
+        m_deferredTransformFlags &= ~(DeferredTransform_Transform | DeferredTransform_UpdateDynamicsObject);
+
+
         for (auto i = this->eventHandlers.root; i != nullptr; i = i->next)
         {
             i->value->OnTransform(*this);
@@ -1535,7 +1512,7 @@ namespace GT
 
         if (this->scene != nullptr)
         {
-            this->scene->OnSceneNodeTransform(*this, updateDynamicsObject);
+            this->scene->OnSceneNodeTransform(*this, updateOwnDynamicsObject);
         }
 
 
@@ -1551,6 +1528,9 @@ namespace GT
 
     void SceneNode::OnScale()
     {
+        m_deferredTransformFlags &= ~DeferredTransform_Scale;
+
+
         for (auto i = this->eventHandlers.root; i != nullptr; i = i->next)
         {
             i->value->OnScale(*this);
@@ -1647,4 +1627,114 @@ namespace GT
     {
         return this->eventLockCounter > 0;
     }
+
+
+    void SceneNode::InvalidateWorldTransform()
+    {
+        if (!m_isWorldTransformDirty)
+        {
+            m_isWorldTransformDirty = true;
+
+            // Every descendant is invalidated regardless of it's inheritance flags. A child that inherits position but not scale still
+            // has it's world position affected by the parent's scale, so it's simpler and safer to not try and be clever here.
+            for (auto i = this->firstChild; i != nullptr; i = i->nextSibling)
+            {
+                i->InvalidateWorldTransform();
+            }
+        }
+    }
+
+    void SceneNode::UpdateWorldTransform() const
+    {
+        if (m_isWorldTransformDirty)
+        {
+            if (m_parent != nullptr)
+            {
+                m_parent->UpdateWorldTransform();
+
+                glm::vec3 offset = m_position;
+
+                if (this->IsScaleInheritanceEnabled())
+                {
+                    offset       = m_parent->m_worldScale * offset;
+                    m_worldScale = m_parent->m_worldScale * m_scale;
+                }
+                else
+                {
+                    m_worldScale = m_scale;
+                }
+
+                if (this->IsOrientationInheritanceEnabled())
+                {
+                    offset             = m_parent->m_worldOrientation * offset;
+                    m_worldOrientation = m_parent->m_worldOrientation * m_orientation;
+                }
+                else
+                {
+                    m_worldOrientation = m_orientation;
+                }
+
+                if (this->IsPositionInheritanceEnabled())
+                {
+                    m_worldPosition = m_parent->m_worldPosition + offset;
+                }
+                else
+                {
+                    m_worldPosition = m_position;
+                }
+            }
+            else
+            {
+                m_worldPosition    = m_position;
+                m_worldOrientation = m_orientation;
+                m_worldScale       = m_scale;
+            }
+
+            Math::CalculateTransformMatrix(m_worldPosition, m_worldOrientation, m_worldScale, m_worldTransform);
+
+            m_isWorldTransformDirty = false;
+        }
+    }
+
+
+    void SceneNode::PostTransformEvent(bool updateDynamicsObject)
+    {
+        if (this->scene != nullptr && this->scene->IsDeferredTransformPropagationEnabled())
+        {
+            m_deferredTransformFlags |= DeferredTransform_Transform;
+
+            if (updateDynamicsObject)
+            {
+                m_deferredTransformFlags |= DeferredTransform_UpdateDynamicsObject;
+            }
+
+            if ((m_deferredTransformFlags & DeferredTransform_Queued) == 0)
+            {
+                m_deferredTransformFlags |= DeferredTransform_Queued;
+                this->scene->QueueDeferredSceneNodeTransform(*this);
+            }
+        }
+        else
+        {
+            this->OnTransform(updateDynamicsObject);
+        }
+    }
+
+    void SceneNode::PostScaleEvent()
+    {
+        if (this->scene != nullptr && this->scene->IsDeferredTransformPropagationEnabled())
+        {
+            m_deferredTransformFlags |= DeferredTransform_Scale;
+
+            if ((m_deferredTransformFlags & DeferredTransform_Queued) == 0)
+            {
+                m_deferredTransformFlags |= DeferredTransform_Queued;
+                this->scene->QueueDeferredSceneNodeTransform(*this);
+            }
+        }
+        else
+        {
+            this->OnScale();
+        }
+    }
 }
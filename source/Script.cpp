@@ -228,7 +228,7 @@ namespace GT
     }
 
     Script::Script()
-        : state(luaL_newstate()), errorHandlers()
+        : state(luaL_newstate()), errorHandlers(), callCount(0)
     {
         luaL_openlibs(LUA_STATE);
 
@@ -359,6 +359,8 @@ namespace GT
 
     bool Script::Call(int numArgs, int numResults)
     {
+        this->callCount += 1;
+
         // We need to insert the error handler function just above the calling function.
         int errfunc = -2 - numArgs;
         lua_getglobal(LUA_STATE, "GT_PCallError");
@@ -415,6 +417,30 @@ namespace GT
     }
 
 
+    int Script::CreateReference(int index)
+    {
+        lua_pushvalue(LUA_STATE, index);
+
+        int reference = luaL_ref(LUA_STATE, LUA_REGISTRYINDEX);
+        if (reference == LUA_REFNIL)
+        {
+            reference = NoReference;
+        }
+
+        return reference;
+    }
+
+    void Script::PushReference(int reference)
+    {
+        lua_rawgeti(LUA_STATE, LUA_REGISTRYINDEX, reference);
+    }
+
+    void Script::ReleaseReference(int reference)
+    {
+        luaL_unref(LUA_STATE, LUA_REGISTRYINDEX, reference);
+    }
+
+
     bool Script::Get(const char* statement)
     {
         Strings::List<char> command;
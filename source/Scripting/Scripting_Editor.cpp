@@ -343,7 +343,7 @@ namespace GT
                         }
 
 
-                        script.Push(name);
+                        script.Push(GetInternedString(name));
                         script.PushNewTable();
                         {
                             script.Push("type");
@@ -371,7 +371,7 @@ namespace GT
                         }
 
 
-                        script.Push(name);
+                        script.Push(GetInternedString(name));
                         script.PushNewTable();
                         {
                             script.Push("type");
@@ -399,7 +399,7 @@ namespace GT
                         }
 
 
-                        script.Push(name);
+                        script.Push(GetInternedString(name));
                         script.PushNewTable();
                         {
                             script.Push("type");
@@ -427,7 +427,7 @@ namespace GT
                         }
 
 
-                        script.Push(name);
+                        script.Push(GetInternedString(name));
                         script.PushNewTable();
                         {
                             script.Push("type");
@@ -455,7 +455,7 @@ namespace GT
                         }
 
 
-                        script.Push(name);
+                        script.Push(GetInternedString(name));
                         script.PushNewTable();
                         {
                             script.Push("type");
@@ -160,6 +160,10 @@ namespace GT
             script.SetTableFunction(-1, "LoadGameState",                      GameFFI::LoadGameState);
             script.SetTableFunction(-1, "LoadScene",                          GameFFI::LoadScene);
             script.SetTableFunction(-1, "PackageForDistribution",             GameFFI::PackageForDistribution);
+            script.SetTableFunction(-1, "GetStatNames",                       GameFFI::GetStatNames);
+            script.SetTableFunction(-1, "GetStatSummary",                     GameFFI::GetStatSummary);
+            script.SetTableFunction(-1, "GetStatPercentile",                  GameFFI::GetStatPercentile);
+            script.SetTableFunction(-1, "GetStatHitches",                     GameFFI::GetStatHitches);
 
 
             script.Push("CollisionGroups");
@@ -365,7 +369,113 @@ namespace GT
 
         int PackageForDistribution(GT::Script &script)
         {
-            script.Push(GetContext(script).PackageForDistribution(script.ToString(1), script.ToString(2)));
+            script.Push(GetContext(script).PackageForDistribution(script.ToString(1), script.ToString(2), script.ToBoolean(3), script.ToBoolean(4)));
+            return 1;
+        }
+
+
+        int GetStatNames(GT::Script &script)
+        {
+            auto &stats = GetContext(script).GetStats();
+
+            script.PushNewTable();
+            for (size_t iStat = 0; iStat < stats.GetCount(); ++iStat)
+            {
+                script.SetTableValue(-1, iStat + 1, stats.GetName(static_cast<uint32_t>(iStat)));
+            }
+
+            return 1;
+        }
+
+        int GetStatSummary(GT::Script &script)
+        {
+            auto &stats = GetContext(script).GetStats();
+
+            uint32_t statID = stats.Find(script.ToString(1));
+            if (statID != StatsRegistry::InvalidStat)
+            {
+                StatSummary summary;
+                stats.GetSummary(statID, summary);
+
+                script.PushNewTable();
+                script.SetTableValue(-1, "last",       summary.last);
+                script.SetTableValue(-1, "min",        summary.min);
+                script.SetTableValue(-1, "max",        summary.max);
+                script.SetTableValue(-1, "mean",       summary.mean);
+                script.SetTableValue(-1, "p50",        summary.p50);
+                script.SetTableValue(-1, "p90",        summary.p90);
+                script.SetTableValue(-1, "p99",        summary.p99);
+                script.SetTableValue(-1, "total",      summary.total);
+                script.SetTableValue(-1, "frameCount", static_cast<int>(summary.frameCount));
+            }
+            else
+            {
+                script.PushNil();
+            }
+
+            return 1;
+        }
+
+        int GetStatPercentile(GT::Script &script)
+        {
+            auto &stats = GetContext(script).GetStats();
+
+            uint32_t statID = stats.Find(script.ToString(1));
+            if (statID != StatsRegistry::InvalidStat)
+            {
+                script.Push(stats.GetPercentile(statID, script.ToDouble(2)));
+            }
+            else
+            {
+                script.PushNil();
+            }
+
+            return 1;
+        }
+
+        int GetStatHitches(GT::Script &script)
+        {
+            auto &stats = GetContext(script).GetStats();
+
+            script.PushNewTable();
+            for (size_t iHitch = 0; iHitch < stats.GetHitchCount(); ++iHitch)
+            {
+                auto &hitch = stats.GetHitch(iHitch);
+
+                script.Push(static_cast<int>(iHitch + 1));
+                script.PushNewTable();
+                {
+                    script.SetTableValue(-1, "frameIndex", static_cast<double>(hitch.frameIndex));
+
+                    if (hitch.spikeStat != StatsRegistry::InvalidStat)
+                    {
+                        script.SetTableValue(-1, "spike", stats.GetName(hitch.spikeStat));
+                    }
+
+                    // Stats registered after the hitch will not have values.
+                    script.Push("values");
+                    script.PushNewTable();
+                    {
+                        for (size_t iStat = 0; iStat < hitch.values.count; ++iStat)
+                        {
+                            script.SetTableValue(-1, stats.GetName(static_cast<uint32_t>(iStat)), hitch.values[iStat]);
+                        }
+                    }
+                    script.SetTableValue(-3);
+
+                    script.Push("medians");
+                    script.PushNewTable();
+                    {
+                        for (size_t iStat = 0; iStat < hitch.medians.count; ++iStat)
+                        {
+                            script.SetTableValue(-1, stats.GetName(static_cast<uint32_t>(iStat)), hitch.medians[iStat]);
+                        }
+                    }
+                    script.SetTableValue(-3);
+                }
+                script.SetTableValue(-3);
+            }
+
             return 1;
         }
     }
@@ -592,6 +592,20 @@ namespace GT
     {
         // For now we'll just set the value in GTEngine.RegisteredScenes to nil, but this might need improving later on.
 
+        // The scene nodes' tables are going away with the scene, so any references held by their script components need releasing.
+        for (size_t iSceneNode = 0; iSceneNode < scene.GetSceneNodeCount(); ++iSceneNode)
+        {
+            auto sceneNode = scene.GetSceneNodeByIndex(iSceneNode);
+            if (sceneNode != nullptr)
+            {
+                auto scriptComponent = sceneNode->GetComponent<ScriptComponent>();
+                if (scriptComponent != nullptr)
+                {
+                    scriptComponent->ReleaseScriptReferences();
+                }
+            }
+        }
+
         script.GetGlobal("GTEngine");
         assert(script.IsTable(-1));
         {
@@ -4,6 +4,7 @@
 #include <GTGE/Scripting/Scripting_Math.hpp>
 #include <GTGE/Scripting.hpp>
 #include <GTGE/SceneNode.hpp>
+#include <GTGE/Components/ScriptComponent.hpp>
 
 #undef GetNextSibling
 #undef GetPrevSibling
@@ -685,6 +686,13 @@ namespace GT
 
     void UninstantiateSceneNode(GT::Script &script, SceneNode &sceneNode)
     {
+        // The Lua table is about to go away, so any references to it or it's event handlers need to be released.
+        auto scriptComponent = sceneNode.GetComponent<ScriptComponent>();
+        if (scriptComponent != nullptr)
+        {
+            scriptComponent->ReleaseScriptReferences();
+        }
+
         // We need to find the scene in GTEngine.RegisteredScenes which will be keyed by the scene. We then want to call InstantiateSceneNode() on it.
         script.GetGlobal("GTEngine");
         assert(script.IsTable(-1));
@@ -744,6 +752,13 @@ namespace GT
             }
         }
         script.Pop(1);
+
+        // The event handlers will have been rebound, so any cached references to them are now stale.
+        auto scriptComponent = sceneNode.GetComponent<ScriptComponent>();
+        if (scriptComponent != nullptr)
+        {
+            scriptComponent->ReleaseScriptEventHandlerReferences();
+        }
     }
 
     void UnregisterComponent(GT::Script &script, SceneNode &sceneNode, const char* componentID)
@@ -761,6 +776,13 @@ namespace GT
             }
         }
         script.Pop(1);
+
+        // The event handlers will have been rebound, so any cached references to them are now stale.
+        auto scriptComponent = sceneNode.GetComponent<ScriptComponent>();
+        if (scriptComponent != nullptr)
+        {
+            scriptComponent->ReleaseScriptEventHandlerReferences();
+        }
     }
 
     void PushSceneNode(GT::Script &script, SceneNode &sceneNode)
@@ -990,22 +1012,60 @@ namespace GT
 
     void PostSceneNodeEvent_OnUpdate(GT::Script &script, SceneNode &sceneNode, double deltaTimeInSeconds)
     {
-        // First we push the scene node.
-        PushSceneNode(script, sceneNode);
+        // This is called for every scripted scene node every frame, so we don't want to be walking GTEngine.RegisteredScenes each
+        // time. Instead, the scene node's table and it's OnUpdate function are kept in the registry and referenced from the script
+        // component. They are looked up the slow way the first time and whenever the event handlers are rebound.
+        auto scriptComponent = sceneNode.GetComponent<ScriptComponent>();
+        if (scriptComponent == nullptr)
+        {
+            return;
+        }
 
-        // Now we just call OnUpdate on it.
-        assert(script.IsTable(-1));
+        if (scriptComponent->GetReferencedScript() != &script)
         {
-            script.Push("OnUpdate");
-            script.GetTableValue(-2);
-            assert(script.IsFunction(-1));
+            scriptComponent->ReleaseScriptReferences();
+        }
+
+        if (scriptComponent->GetOnUpdateReference() == Script::NoReference)
+        {
+            int sceneNodeTableReference = scriptComponent->GetSceneNodeTableReference();
+            if (sceneNodeTableReference == Script::NoReference)
             {
-                script.PushValue(-2);                   // <-- 'self'
-                script.Push(deltaTimeInSeconds);        // <-- 'deltaTimeInSeconds'
-                script.Call(2, 0);
+                PushSceneNode(script, sceneNode);
+                sceneNodeTableReference = script.CreateReference(-1);
+            }
+            else
+            {
+                script.PushReference(sceneNodeTableReference);
+            }
+
+            int onUpdateReference = Script::NoReference;
+
+            assert(script.IsTable(-1));
+            {
+                script.Push("OnUpdate");
+                script.GetTableValue(-2);
+                if (script.IsFunction(-1))
+                {
+                    onUpdateReference = script.CreateReference(-1);
+                }
+                script.Pop(1);
+            }
+            script.Pop(1);
+
+            scriptComponent->SetScriptReferences(script, sceneNodeTableReference, onUpdateReference);
+
+            if (onUpdateReference == Script::NoReference)
+            {
+                return;
             }
         }
-        script.Pop(1);
+
+
+        script.PushReference(scriptComponent->GetOnUpdateReference());
+        script.PushReference(scriptComponent->GetSceneNodeTableReference());    // <-- 'self'
+        script.Push(deltaTimeInSeconds);                                        // <-- 'deltaTimeInSeconds'
+        script.Call(2, 0);
     }
 
     void PostSceneNodeEvent_OnStartup(GT::Script &script, SceneNode &sceneNode)
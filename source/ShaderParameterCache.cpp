@@ -42,40 +42,82 @@ namespace GT
 
     void ShaderParameterCache::Set(const char* name, float value)
     {
-        this->floatParameters.Add(name, value);
+        this->Set(InternString(name), value);
     }
     void ShaderParameterCache::Set(const char* name, const glm::vec2 &value)
     {
-        this->float2Parameters.Add(name, value);
+        this->Set(InternString(name), value);
     }
     void ShaderParameterCache::Set(const char* name, const glm::vec3 &value)
     {
-        this->float3Parameters.Add(name, value);
+        this->Set(InternString(name), value);
     }
     void ShaderParameterCache::Set(const char* name, const glm::vec4 &value)
     {
-        this->float4Parameters.Add(name, value);
+        this->Set(InternString(name), value);
     }
 
 
     void ShaderParameterCache::Set(const char* name, const glm::mat2 &value)
     {
-        this->float2x2Parameters.Add(name, value);
+        this->Set(InternString(name), value);
     }
     void ShaderParameterCache::Set(const char* name, const glm::mat3 &value)
     {
-        this->float3x3Parameters.Add(name, value);
+        this->Set(InternString(name), value);
     }
     void ShaderParameterCache::Set(const char* name, const glm::mat4 &value)
     {
-        this->float4x4Parameters.Add(name, value);
+        this->Set(InternString(name), value);
     }
 
     void ShaderParameterCache::Set(const char* name, Texture2D* value)
     {
-        this->texture2DParameters.Add(name, ShaderParameter_Texture2D(m_pContext->GetTextureLibrary(), value));
+        this->Set(InternString(name), value);
     }
     void ShaderParameterCache::Set(const char* name, TextureCube* value)
+    {
+        this->Set(InternString(name), value);
+    }
+
+
+
+    void ShaderParameterCache::Set(StringID name, float value)
+    {
+        this->floatParameters.Add(name, value);
+    }
+    void ShaderParameterCache::Set(StringID name, const glm::vec2 &value)
+    {
+        this->float2Parameters.Add(name, value);
+    }
+    void ShaderParameterCache::Set(StringID name, const glm::vec3 &value)
+    {
+        this->float3Parameters.Add(name, value);
+    }
+    void ShaderParameterCache::Set(StringID name, const glm::vec4 &value)
+    {
+        this->float4Parameters.Add(name, value);
+    }
+
+
+    void ShaderParameterCache::Set(StringID name, const glm::mat2 &value)
+    {
+        this->float2x2Parameters.Add(name, value);
+    }
+    void ShaderParameterCache::Set(StringID name, const glm::mat3 &value)
+    {
+        this->float3x3Parameters.Add(name, value);
+    }
+    void ShaderParameterCache::Set(StringID name, const glm::mat4 &value)
+    {
+        this->float4x4Parameters.Add(name, value);
+    }
+
+    void ShaderParameterCache::Set(StringID name, Texture2D* value)
+    {
+        this->texture2DParameters.Add(name, ShaderParameter_Texture2D(m_pContext->GetTextureLibrary(), value));
+    }
+    void ShaderParameterCache::Set(StringID name, TextureCube* value)
     {
         this->textureCubeParameters.Add(name, value);
     }
@@ -84,45 +126,126 @@ namespace GT
 
     void ShaderParameterCache::UnsetFloat(const char* name)
     {
-        this->floatParameters.RemoveByKey(name);
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            this->UnsetFloat(nameID);
+        }
     }
 
     void ShaderParameterCache::UnsetFloat2(const char* name)
     {
-        this->float2Parameters.RemoveByKey(name);
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            this->UnsetFloat2(nameID);
+        }
     }
 
     void ShaderParameterCache::UnsetFloat3(const char* name)
     {
-        this->float3Parameters.RemoveByKey(name);
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            this->UnsetFloat3(nameID);
+        }
     }
 
     void ShaderParameterCache::UnsetFloat4(const char* name)
     {
-        this->float4Parameters.RemoveByKey(name);
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            this->UnsetFloat4(nameID);
+        }
     }
 
     void ShaderParameterCache::UnsetFloat2x2(const char* name)
     {
-        this->float2x2Parameters.RemoveByKey(name);
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            this->UnsetFloat2x2(nameID);
+        }
     }
 
     void ShaderParameterCache::UnsetFloat3x3(const char* name)
     {
-        this->float3x3Parameters.RemoveByKey(name);
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            this->UnsetFloat3x3(nameID);
+        }
     }
 
     void ShaderParameterCache::UnsetFloat4x4(const char* name)
     {
-        this->float4x4Parameters.RemoveByKey(name);
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            this->UnsetFloat4x4(nameID);
+        }
     }
 
     void ShaderParameterCache::UnsetTexture2D(const char* name)
     {
-        this->texture2DParameters.RemoveByKey(name);
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            this->UnsetTexture2D(nameID);
+        }
     }
 
     void ShaderParameterCache::UnsetTextureCube(const char* name)
+    {
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            this->UnsetTextureCube(nameID);
+        }
+    }
+
+    void ShaderParameterCache::UnsetFloat(StringID name)
+    {
+        this->floatParameters.RemoveByKey(name);
+    }
+
+    void ShaderParameterCache::UnsetFloat2(StringID name)
+    {
+        this->float2Parameters.RemoveByKey(name);
+    }
+
+    void ShaderParameterCache::UnsetFloat3(StringID name)
+    {
+        this->float3Parameters.RemoveByKey(name);
+    }
+
+    void ShaderParameterCache::UnsetFloat4(StringID name)
+    {
+        this->float4Parameters.RemoveByKey(name);
+    }
+
+    void ShaderParameterCache::UnsetFloat2x2(StringID name)
+    {
+        this->float2x2Parameters.RemoveByKey(name);
+    }
+
+    void ShaderParameterCache::UnsetFloat3x3(StringID name)
+    {
+        this->float3x3Parameters.RemoveByKey(name);
+    }
+
+    void ShaderParameterCache::UnsetFloat4x4(StringID name)
+    {
+        this->float4x4Parameters.RemoveByKey(name);
+    }
+
+    void ShaderParameterCache::UnsetTexture2D(StringID name)
+    {
+        this->texture2DParameters.RemoveByKey(name);
+    }
+
+    void ShaderParameterCache::UnsetTextureCube(StringID name)
     {
         this->textureCubeParameters.RemoveByKey(name);
     }
@@ -130,6 +253,105 @@ namespace GT
 
 
     const ShaderParameter_Float* ShaderParameterCache::GetFloatParameter(const char* name) const
+    {
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            return this->GetFloatParameter(nameID);
+        }
+
+        return nullptr;
+    }
+
+    const ShaderParameter_Float2* ShaderParameterCache::GetFloat2Parameter(const char* name) const
+    {
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            return this->GetFloat2Parameter(nameID);
+        }
+
+        return nullptr;
+    }
+
+    const ShaderParameter_Float3* ShaderParameterCache::GetFloat3Parameter(const char* name) const
+    {
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            return this->GetFloat3Parameter(nameID);
+        }
+
+        return nullptr;
+    }
+
+    const ShaderParameter_Float4* ShaderParameterCache::GetFloat4Parameter(const char* name) const
+    {
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            return this->GetFloat4Parameter(nameID);
+        }
+
+        return nullptr;
+    }
+
+    const ShaderParameter_Float2x2* ShaderParameterCache::GetFloat2x2Parameter(const char* name) const
+    {
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            return this->GetFloat2x2Parameter(nameID);
+        }
+
+        return nullptr;
+    }
+
+    const ShaderParameter_Float3x3* ShaderParameterCache::GetFloat3x3Parameter(const char* name) const
+    {
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            return this->GetFloat3x3Parameter(nameID);
+        }
+
+        return nullptr;
+    }
+
+    const ShaderParameter_Float4x4* ShaderParameterCache::GetFloat4x4Parameter(const char* name) const
+    {
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            return this->GetFloat4x4Parameter(nameID);
+        }
+
+        return nullptr;
+    }
+
+    const ShaderParameter_Texture2D* ShaderParameterCache::GetTexture2DParameter(const char* name) const
+    {
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            return this->GetTexture2DParameter(nameID);
+        }
+
+        return nullptr;
+    }
+
+    const ShaderParameter_TextureCube* ShaderParameterCache::GetTextureCubeParameter(const char* name) const
+    {
+        StringID nameID = FindStringID(name);
+        if (nameID != InvalidStringID)
+        {
+            return this->GetTextureCubeParameter(nameID);
+        }
+
+        return nullptr;
+    }
+
+    const ShaderParameter_Float* ShaderParameterCache::GetFloatParameter(StringID name) const
     {
         auto iParameter = this->floatParameters.Find(name);
         if (iParameter != nullptr)
@@ -140,7 +362,7 @@ namespace GT
         return nullptr;
     }
 
-    const ShaderParameter_Float2* ShaderParameterCache::GetFloat2Parameter(const char* name) const
+    const ShaderParameter_Float2* ShaderParameterCache::GetFloat2Parameter(StringID name) const
     {
         auto iParameter = this->float2Parameters.Find(name);
         if (iParameter != nullptr)
@@ -151,7 +373,7 @@ namespace GT
         return nullptr;
     }
 
-    const ShaderParameter_Float3* ShaderParameterCache::GetFloat3Parameter(const char* name) const
+    const ShaderParameter_Float3* ShaderParameterCache::GetFloat3Parameter(StringID name) const
     {
         auto iParameter = this->float3Parameters.Find(name);
         if (iParameter != nullptr)
@@ -162,7 +384,7 @@ namespace GT
         return nullptr;
     }
 
-    const ShaderParameter_Float4* ShaderParameterCache::GetFloat4Parameter(const char* name) const
+    const ShaderParameter_Float4* ShaderParameterCache::GetFloat4Parameter(StringID name) const
     {
         auto iParameter = this->float4Parameters.Find(name);
         if (iParameter != nullptr)
@@ -173,7 +395,7 @@ namespace GT
         return nullptr;
     }
 
-    const ShaderParameter_Float2x2* ShaderParameterCache::GetFloat2x2Parameter(const char* name) const
+    const ShaderParameter_Float2x2* ShaderParameterCache::GetFloat2x2Parameter(StringID name) const
     {
         auto iParameter = this->float2x2Parameters.Find(name);
         if (iParameter != nullptr)
@@ -184,7 +406,7 @@ namespace GT
         return nullptr;
     }
 
-    const ShaderParameter_Float3x3* ShaderParameterCache::GetFloat3x3Parameter(const char* name) const
+    const ShaderParameter_Float3x3* ShaderParameterCache::GetFloat3x3Parameter(StringID name) const
     {
         auto iParameter = this->float3x3Parameters.Find(name);
         if (iParameter != nullptr)
@@ -195,7 +417,7 @@ namespace GT
         return nullptr;
     }
 
-    const ShaderParameter_Float4x4* ShaderParameterCache::GetFloat4x4Parameter(const char* name) const
+    const ShaderParameter_Float4x4* ShaderParameterCache::GetFloat4x4Parameter(StringID name) const
     {
         auto iParameter = this->float4x4Parameters.Find(name);
         if (iParameter != nullptr)
@@ -206,7 +428,7 @@ namespace GT
         return nullptr;
     }
 
-    const ShaderParameter_Texture2D* ShaderParameterCache::GetTexture2DParameter(const char* name) const
+    const ShaderParameter_Texture2D* ShaderParameterCache::GetTexture2DParameter(StringID name) const
     {
         auto iParameter = this->texture2DParameters.Find(name);
         if (iParameter != nullptr)
@@ -217,7 +439,7 @@ namespace GT
         return nullptr;
     }
 
-    const ShaderParameter_TextureCube* ShaderParameterCache::GetTextureCubeParameter(const char* name) const
+    const ShaderParameter_TextureCube* ShaderParameterCache::GetTextureCubeParameter(StringID name) const
     {
         auto iParameter = this->textureCubeParameters.Find(name);
         if (iParameter != nullptr)
@@ -398,7 +620,7 @@ namespace GT
             auto name  = this->floatParameters.buffer[i]->key;
             auto value = this->floatParameters.buffer[i]->value.value;
 
-            intermediarySerializer.WriteString(name);
+            intermediarySerializer.WriteString(GetInternedString(name));
             intermediarySerializer.Write(value);
         }
 
@@ -410,7 +632,7 @@ namespace GT
             auto name  = this->float2Parameters.buffer[i]->key;
             auto value = this->float2Parameters.buffer[i]->value.value;
 
-            intermediarySerializer.WriteString(name);
+            intermediarySerializer.WriteString(GetInternedString(name));
             intermediarySerializer.Write(value);
         }
 
@@ -422,7 +644,7 @@ namespace GT
             auto name  = this->float3Parameters.buffer[i]->key;
             auto value = this->float3Parameters.buffer[i]->value.value;
 
-            intermediarySerializer.WriteString(name);
+            intermediarySerializer.WriteString(GetInternedString(name));
             intermediarySerializer.Write(value);
         }
 
@@ -434,7 +656,7 @@ namespace GT
             auto name  = this->float4Parameters.buffer[i]->key;
             auto value = this->float4Parameters.buffer[i]->value.value;
 
-            intermediarySerializer.WriteString(name);
+            intermediarySerializer.WriteString(GetInternedString(name));
             intermediarySerializer.Write(value);
         }
 
@@ -447,7 +669,7 @@ namespace GT
             auto name  = this->float2x2Parameters.buffer[i]->key;
             auto value = this->float2x2Parameters.buffer[i]->value.value;
 
-            intermediarySerializer.WriteString(name);
+            intermediarySerializer.WriteString(GetInternedString(name));
             intermediarySerializer.Write(value);
         }
 
@@ -459,7 +681,7 @@ namespace GT
             auto name  = this->float3x3Parameters.buffer[i]->key;
             auto value = this->float3x3Parameters.buffer[i]->value.value;
 
-            intermediarySerializer.WriteString(name);
+            intermediarySerializer.WriteString(GetInternedString(name));
             intermediarySerializer.Write(value);
         }
 
@@ -471,7 +693,7 @@ namespace GT
             auto name  = this->float4x4Parameters.buffer[i]->key;
             auto value = this->float4x4Parameters.buffer[i]->value.value;
 
-            intermediarySerializer.WriteString(name);
+            intermediarySerializer.WriteString(GetInternedString(name));
             intermediarySerializer.Write(value);
         }
 
@@ -484,7 +706,7 @@ namespace GT
             auto name  = this->texture2DParameters.buffer[i]->key;
             auto value = this->texture2DParameters.buffer[i]->value.value;
 
-            intermediarySerializer.WriteString(name);
+            intermediarySerializer.WriteString(GetInternedString(name));
 
             if (value != nullptr)
             {
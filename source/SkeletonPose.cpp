@@ -0,0 +1,220 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#include <GTGE/SkeletonPose.hpp>
+#include <GTGE/Core/HashMap.hpp>
+#include <GTGE/Math.hpp>
+#include <cfloat>
+
+#undef min
+#undef max
+
+namespace GT
+{
+#if defined(GT_BUILD_SSE2)
+    /// Multiplies two column-major matrices. The output must not be either of the inputs.
+    static inline void SkeletonPose_MulMat4(const glm::mat4 &a, const glm::mat4 &b, glm::mat4 &result)
+    {
+        const float* pA = &a[0][0];
+        const float* pB = &b[0][0];
+              float* pR = &result[0][0];
+
+        __m128 a0 = _mm_loadu_ps(pA +  0);
+        __m128 a1 = _mm_loadu_ps(pA +  4);
+        __m128 a2 = _mm_loadu_ps(pA +  8);
+        __m128 a3 = _mm_loadu_ps(pA + 12);
+
+        for (int iColumn = 0; iColumn < 4; ++iColumn)
+        {
+            __m128 b0 = _mm_set1_ps(pB[iColumn*4 + 0]);
+            __m128 b1 = _mm_set1_ps(pB[iColumn*4 + 1]);
+            __m128 b2 = _mm_set1_ps(pB[iColumn*4 + 2]);
+            __m128 b3 = _mm_set1_ps(pB[iColumn*4 + 3]);
+
+            __m128 column = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, b0), _mm_mul_ps(a1, b1)), _mm_add_ps(_mm_mul_ps(a2, b2), _mm_mul_ps(a3, b3)));
+            _mm_storeu_ps(pR + iColumn*4, column);
+        }
+    }
+#else
+    static inline void SkeletonPose_MulMat4(const glm::mat4 &a, const glm::mat4 &b, glm::mat4 &result)
+    {
+        result = a * b;
+    }
+#endif
+
+
+    SkeletonPose::SkeletonPose()
+        : parentIndices(), boneIndices(), sortedIndices(),
+          localPositions(), localRotations(), localScales(),
+          offsetMatrices(), modelTransforms(), palette()
+    {
+    }
+
+    SkeletonPose::~SkeletonPose()
+    {
+    }
+
+
+    void SkeletonPose::Build(const Vector<Bone*> &bones)
+    {
+        this->Clear();
+
+        size_t boneCount = bones.count;
+        if (boneCount == 0)
+        {
+            return;
+        }
+
+
+        // We need to be able to find the index of a bone's parent.
+        HashMap<const Bone*, uint32_t> boneIndexMap;
+        boneIndexMap.Reserve(boneCount);
+        for (size_t iBone = 0; iBone < boneCount; ++iBone)
+        {
+            boneIndexMap.Add(bones[iBone], static_cast<uint32_t>(iBone));
+        }
+
+
+        // Sorting the bones by their depth in the hierarchy guarantees that every bone comes after it's parent. This is a counting
+        // sort so it's stable, which keeps siblings in their original order.
+        Vector<uint32_t> depths(boneCount);
+        uint32_t maxDepth = 0;
+        for (size_t iBone = 0; iBone < boneCount; ++iBone)
+        {
+            uint32_t depth = 0;
+            for (auto parent = bones[iBone]->GetParent(); parent != nullptr; parent = parent->GetParent())
+            {
+                depth += 1;
+            }
+
+            depths.PushBack(depth);
+
+            if (depth > maxDepth)
+            {
+                maxDepth = depth;
+            }
+        }
+
+        Vector<uint32_t> depthOffsets;
+        depthOffsets.Resize(maxDepth + 2);
+        for (size_t iDepth = 0; iDepth < depthOffsets.count; ++iDepth)
+        {
+            depthOffsets[iDepth] = 0;
+        }
+
+        for (size_t iBone = 0; iBone < boneCount; ++iBone)
+        {
+            depthOffsets[depths[iBone] + 1] += 1;
+        }
+
+        for (size_t iDepth = 1; iDepth < depthOffsets.count; ++iDepth)
+        {
+            depthOffsets[iDepth] += depthOffsets[iDepth - 1];
+        }
+
+
+        this->boneIndices.Resize(boneCount);
+        this->sortedIndices.Resize(boneCount);
+        for (size_t iBone = 0; iBone < boneCount; ++iBone)
+        {
+            uint32_t iSorted = depthOffsets[depths[iBone]]++;
+
+            this->boneIndices[iSorted] = static_cast<uint32_t>(iBone);
+            this->sortedIndices[iBone] = iSorted;
+        }
+
+
+        this->parentIndices.Resize(boneCount);
+        this->localPositions.Resize(boneCount);
+        this->localRotations.Resize(boneCount);
+        this->localScales.Resize(boneCount);
+        this->offsetMatrices.Resize(boneCount);
+        this->modelTransforms.Resize(boneCount);
+        this->palette.Resize(boneCount);
+
+        for (size_t iSorted = 0; iSorted < boneCount; ++iSorted)
+        {
+            auto bone = bones[this->boneIndices[iSorted]];
+
+            int32_t parentIndex = -1;
+            if (bone->GetParent() != nullptr)
+            {
+                auto iParent = boneIndexMap.Find(bone->GetParent());
+                assert(iParent != nullptr);
+
+                parentIndex = static_cast<int32_t>(this->sortedIndices[iParent->value]);
+                assert(parentIndex < static_cast<int32_t>(iSorted));
+            }
+
+            this->parentIndices[iSorted]  = parentIndex;
+            this->localPositions[iSorted] = bone->GetPosition();
+            this->localRotations[iSorted] = bone->GetRotation();
+            this->localScales[iSorted]    = bone->GetScale();
+            this->offsetMatrices[iSorted] = bone->GetOffsetMatrix();
+        }
+
+
+        this->Evaluate();
+    }
+
+    void SkeletonPose::Clear()
+    {
+        this->parentIndices.Clear();
+        this->boneIndices.Clear();
+        this->sortedIndices.Clear();
+        this->localPositions.Clear();
+        this->localRotations.Clear();
+        this->localScales.Clear();
+        this->offsetMatrices.Clear();
+        this->modelTransforms.Clear();
+        this->palette.Clear();
+    }
+
+
+    void SkeletonPose::Evaluate()
+    {
+        size_t boneCount = this->sortedIndices.count;
+
+        const int32_t*   parentIndicesBuffer   = this->parentIndices.buffer;
+        const uint32_t*  boneIndicesBuffer     = this->boneIndices.buffer;
+        const glm::vec3* localPositionsBuffer  = this->localPositions.buffer;
+        const glm::quat* localRotationsBuffer  = this->localRotations.buffer;
+        const glm::vec3* localScalesBuffer     = this->localScales.buffer;
+        const glm::mat4* offsetMatricesBuffer  = this->offsetMatrices.buffer;
+              glm::mat4* modelTransformsBuffer = this->modelTransforms.buffer;
+              glm::mat4* paletteBuffer         = this->palette.buffer;
+
+        for (size_t iSorted = 0; iSorted < boneCount; ++iSorted)
+        {
+            glm::mat4 localTransform;
+            Math::CalculateTransformMatrix(localPositionsBuffer[iSorted], localRotationsBuffer[iSorted], localScalesBuffer[iSorted], localTransform);
+
+            // The parent always comes before the child, so it's transform has already been calculated.
+            int32_t iParent = parentIndicesBuffer[iSorted];
+            if (iParent != -1)
+            {
+                SkeletonPose_MulMat4(modelTransformsBuffer[iParent], localTransform, modelTransformsBuffer[iSorted]);
+            }
+            else
+            {
+                modelTransformsBuffer[iSorted] = localTransform;
+            }
+
+            SkeletonPose_MulMat4(modelTransformsBuffer[iSorted], offsetMatricesBuffer[iSorted], paletteBuffer[boneIndicesBuffer[iSorted]]);
+        }
+    }
+
+
+    void SkeletonPose::GetBoneAABB(glm::vec3 &aabbMinOut, glm::vec3 &aabbMaxOut) const
+    {
+        aabbMinOut = glm::vec3( FLT_MAX);
+        aabbMaxOut = glm::vec3(-FLT_MAX);
+
+        for (size_t iSorted = 0; iSorted < this->modelTransforms.count; ++iSorted)
+        {
+            glm::vec3 position(this->modelTransforms.buffer[iSorted][3]);
+
+            aabbMinOut = glm::min(aabbMinOut, position);
+            aabbMaxOut = glm::max(aabbMaxOut, position);
+        }
+    }
+}
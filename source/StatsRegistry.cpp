@@ -0,0 +1,311 @@
+// Copyright (C) 2011 - 2016 David Reid. See included LICENCE file.
+
+#include <GTGE/StatsRegistry.hpp>
+#include <GTGE/Core/Strings/Equal.hpp>
+
+namespace GT
+{
+    StatsRegistry::StatsRegistry(size_t historySize)
+        : m_lock(dr_create_mutex()),
+          m_stats(),
+          m_historySize((historySize > 0) ? historySize : 1),
+          m_frameCount(0),
+          m_hitchThreshold(1.0 / 30.0),
+          m_hitches(),
+          m_sortBuffer()
+    {
+        // These need to be registered in the same order as the EngineStat enum.
+        this->Register("frame.time",              StatType_Time);
+        this->Register("render.draw_calls",       StatType_Counter);
+        this->Register("render.visible_meshes",   StatType_Counter);
+        this->Register("render.skinned_vertices", StatType_Counter);
+        this->Register("scene.live_particles",    StatType_Counter);
+        this->Register("scene.nodes",             StatType_Counter);
+        this->Register("script.callbacks",        StatType_Counter);
+        this->Register("assets.bytes_loaded",     StatType_Counter);
+        this->Register("time.update",             StatType_Time);
+        this->Register("time.physics",            StatType_Time);
+        this->Register("time.culling",            StatType_Time);
+        this->Register("time.render",             StatType_Time);
+        this->Register("time.gui",                StatType_Time);
+        assert(m_stats.count == EngineStat_Count);
+    }
+
+    StatsRegistry::~StatsRegistry()
+    {
+        for (size_t iStat = 0; iStat < m_stats.count; ++iStat)
+        {
+            delete m_stats[iStat];
+        }
+
+        for (size_t iHitch = 0; iHitch < m_hitches.count; ++iHitch)
+        {
+            delete m_hitches[iHitch];
+        }
+
+        dr_delete_mutex(m_lock);
+    }
+
+
+    uint32_t StatsRegistry::Register(const char* name, StatType type)
+    {
+        uint32_t statID = this->Find(name);
+        if (statID != InvalidStat)
+        {
+            return statID;
+        }
+
+        auto pStat = new Stat;
+        pStat->name           = name;
+        pStat->type           = type;
+        pStat->value          = 0;
+        pStat->total          = 0;
+        pStat->historyWritten = 0;
+        pStat->history.Resize(m_historySize);
+
+        dr_lock_mutex(m_lock);
+        {
+            statID = static_cast<uint32_t>(m_stats.count);
+            m_stats.PushBack(pStat);
+        }
+        dr_unlock_mutex(m_lock);
+
+        return statID;
+    }
+
+    uint32_t StatsRegistry::Find(const char* name) const
+    {
+        for (size_t iStat = 0; iStat < m_stats.count; ++iStat)
+        {
+            if (Strings::Equal(m_stats[iStat]->name.c_str(), name))
+            {
+                return static_cast<uint32_t>(iStat);
+            }
+        }
+
+        return InvalidStat;
+    }
+
+    const char* StatsRegistry::GetName(uint32_t statID) const
+    {
+        assert(statID < m_stats.count);
+        return m_stats[statID]->name.c_str();
+    }
+
+    StatType StatsRegistry::GetType(uint32_t statID) const
+    {
+        assert(statID < m_stats.count);
+        return m_stats[statID]->type;
+    }
+
+
+    void StatsRegistry::Add(uint32_t statID, double amount)
+    {
+        assert(statID < m_stats.count);
+
+        dr_lock_mutex(m_lock);
+        {
+            m_stats[statID]->value += amount;
+        }
+        dr_unlock_mutex(m_lock);
+    }
+
+    void StatsRegistry::Set(uint32_t statID, double value)
+    {
+        assert(statID < m_stats.count);
+
+        dr_lock_mutex(m_lock);
+        {
+            m_stats[statID]->value = value;
+        }
+        dr_unlock_mutex(m_lock);
+    }
+
+    double StatsRegistry::GetValue(uint32_t statID) const
+    {
+        assert(statID < m_stats.count);
+
+        double value;
+        dr_lock_mutex(m_lock);
+        {
+            value = m_stats[statID]->value;
+        }
+        dr_unlock_mutex(m_lock);
+
+        return value;
+    }
+
+
+    void StatsRegistry::GetSummary(uint32_t statID, StatSummary &summaryOut) const
+    {
+        assert(statID < m_stats.count);
+
+        summaryOut.last       = 0;
+        summaryOut.min        = 0;
+        summaryOut.max        = 0;
+        summaryOut.mean       = 0;
+        summaryOut.p50        = 0;
+        summaryOut.p90        = 0;
+        summaryOut.p99        = 0;
+        summaryOut.total      = 0;
+        summaryOut.frameCount = 0;
+
+        dr_lock_mutex(m_lock);
+        {
+            auto &stat = *m_stats[statID];
+            summaryOut.total = stat.total;
+
+            this->CopyHistory(stat);
+            if (m_sortBuffer.count > 0)
+            {
+                summaryOut.last       = m_sortBuffer.GetBack();
+                summaryOut.min        = m_sortBuffer[0];
+                summaryOut.max        = m_sortBuffer[0];
+                summaryOut.frameCount = m_sortBuffer.count;
+
+                double sum = 0;
+                for (size_t i = 0; i < m_sortBuffer.count; ++i)
+                {
+                    summaryOut.min = Min(summaryOut.min, m_sortBuffer[i]);
+                    summaryOut.max = Max(summaryOut.max, m_sortBuffer[i]);
+                    sum += m_sortBuffer[i];
+                }
+
+                summaryOut.mean = sum / m_sortBuffer.count;
+
+                // Each percentile reorders the buffer, but the set of values stays the same.
+                summaryOut.p50 = this->GetSortBufferPercentile(50);
+                summaryOut.p90 = this->GetSortBufferPercentile(90);
+                summaryOut.p99 = this->GetSortBufferPercentile(99);
+            }
+        }
+        dr_unlock_mutex(m_lock);
+    }
+
+    double StatsRegistry::GetPercentile(uint32_t statID, double percentile) const
+    {
+        assert(statID < m_stats.count);
+
+        double result = 0;
+        dr_lock_mutex(m_lock);
+        {
+            this->CopyHistory(*m_stats[statID]);
+            if (m_sortBuffer.count > 0)
+            {
+                result = this->GetSortBufferPercentile(percentile);
+            }
+        }
+        dr_unlock_mutex(m_lock);
+
+        return result;
+    }
+
+
+    void StatsRegistry::SetHitchThreshold(double thresholdInSeconds)
+    {
+        m_hitchThreshold = thresholdInSeconds;
+    }
+
+
+    void StatsRegistry::EndFrame(double frameTimeInSeconds)
+    {
+        dr_lock_mutex(m_lock);
+        {
+            m_stats[EngineStat_FrameTime]->value = frameTimeInSeconds * 1000.0;
+
+            // The hitch is recorded before the frame is pushed onto the history so that the medians are of the frames leading up to it.
+            if (frameTimeInSeconds > m_hitchThreshold)
+            {
+                StatsHitch* pHitch;
+                if (m_hitches.count == MaxHitches)
+                {
+                    pHitch = m_hitches[0];
+                    m_hitches.Remove(0);
+                }
+                else
+                {
+                    pHitch = new StatsHitch;
+                }
+
+                pHitch->frameIndex = m_frameCount;
+                pHitch->spikeStat  = InvalidStat;
+                pHitch->values.Clear();
+                pHitch->medians.Clear();
+
+                double largestSpike = 0;
+                for (size_t iStat = 0; iStat < m_stats.count; ++iStat)
+                {
+                    auto &stat = *m_stats[iStat];
+
+                    double median = 0;
+                    this->CopyHistory(stat);
+                    if (m_sortBuffer.count > 0)
+                    {
+                        median = this->GetSortBufferPercentile(50);
+                    }
+
+                    pHitch->values.PushBack(stat.value);
+                    pHitch->medians.PushBack(median);
+
+                    if (stat.type == StatType_Time && iStat != EngineStat_FrameTime && stat.value - median > largestSpike)
+                    {
+                        largestSpike      = stat.value - median;
+                        pHitch->spikeStat = static_cast<uint32_t>(iStat);
+                    }
+                }
+
+                m_hitches.PushBack(pHitch);
+            }
+
+
+            for (size_t iStat = 0; iStat < m_stats.count; ++iStat)
+            {
+                auto &stat = *m_stats[iStat];
+                stat.history[stat.historyWritten % m_historySize] = stat.value;
+                stat.historyWritten += 1;
+                stat.total          += stat.value;
+
+                if (stat.type != StatType_Gauge)
+                {
+                    stat.value = 0;
+                }
+            }
+
+            m_frameCount += 1;
+        }
+        dr_unlock_mutex(m_lock);
+    }
+
+
+
+    ///////////////////////////////////////////
+    // Private
+
+    void StatsRegistry::CopyHistory(const Stat &stat) const
+    {
+        size_t count = Min(stat.historyWritten, m_historySize);
+        size_t first = (stat.historyWritten > m_historySize) ? (stat.historyWritten % m_historySize) : 0;
+
+        m_sortBuffer.Clear();
+        m_sortBuffer.Reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            m_sortBuffer.PushBack(stat.history[(first + i) % m_historySize]);
+        }
+    }
+
+    double StatsRegistry::GetSortBufferPercentile(double percentile) const
+    {
+        assert(m_sortBuffer.count > 0);
+
+        // Nearest rank.
+        double rank  = Clamp(percentile, 0.0, 100.0) / 100.0 * m_sortBuffer.count;
+        size_t index = static_cast<size_t>(ceil(rank));
+        index = (index > 0) ? index - 1 : 0;
+        index = Min(index, m_sortBuffer.count - 1);
+
+        std::nth_element(m_sortBuffer.buffer, m_sortBuffer.buffer + index, m_sortBuffer.buffer + m_sortBuffer.count);
+        return m_sortBuffer[index];
+    }
+}
@@ -1,8 +1,11 @@
 // Copyright (C) 2011 - 2014 David Reid. See included LICENCE.
 
 #include <GTGE/Texture2DLibrary.hpp>
+#include <GTGE/BakedTexture.hpp>
+#include <GTGE/Assets/ImageAsset.hpp>
 #include <GTGE/Rendering/Renderer.hpp>
 #include <GTGE/Context.hpp>
+#include <GTGE/Profiler.hpp>
 
 namespace GT
 {
@@ -43,6 +46,8 @@ namespace GT
 
     Texture2D* Texture2DLibrary::Acquire(const char* fileName, const char* makeRelativeTo)
     {
+        GT_PROFILE_ZONE("Texture2DLibrary::Acquire");
+
         char relativePath[DRFS_MAX_PATH];
         strcpy_s(relativePath, sizeof(relativePath), fileName);
 
@@ -61,37 +66,26 @@ namespace GT
 
 
         char absFileName[DRFS_MAX_PATH];
-        if (drfs_find_absolute_path(m_context.GetVFS(), fileName, absFileName, sizeof(absFileName)))
+        if (m_context.GetAssetLibrary().FindAbsolutePath(fileName, absFileName, sizeof(absFileName)))
         {
             auto iTexture = m_loadedTextures.Find(absFileName);
             if (iTexture == nullptr)
             {
-                Image image(absFileName);
-                if (image.IsLinkedToFile())
-                {
-                    image.PullAllMipmaps();     // <-- This loads the image data.
-
+                auto newTexture = Renderer::CreateTexture2D();
+                newTexture->SetRelativePath(relativePath);
 
-                    auto newTexture = Renderer::CreateTexture2D();
-                    newTexture->SetRelativePath(relativePath);
-                    newTexture->SetData(image.GetWidth(), image.GetHeight(), image.GetFormat(), image.GetBaseMipmapData());
-
-                    Renderer::PushTexture2DData(*newTexture);
-                    Renderer::GenerateTexture2DMipmaps(*newTexture);
+                if (this->LoadTextureData(*newTexture, absFileName))
+                {
                     Renderer::SetTexture2DFilter(*newTexture, m_defaultMinFilter, m_defaultMagFilter);
                     Renderer::SetTexture2DAnisotropy(*newTexture, m_defaultAnisotropy);
-                    
-
-
-                    // Local data should be cleared since it won't be needed now. The renderer will have made a copy of the data, so it's safe to delete now.
-                    newTexture->DeleteLocalData();
-
 
                     m_loadedTextures.Add(absFileName, newTexture);
                     return newTexture;
                 }
                 else
                 {
+                    Renderer::DeleteTexture2D(newTexture);
+
                     m_context.LogErrorf("Can not find file: %s", fileName);
                     return nullptr;
                 }
@@ -145,7 +139,7 @@ namespace GT
     bool Texture2DLibrary::Reload(const char* fileName)
     {
         char absFileName[DRFS_MAX_PATH];
-        if (drfs_find_absolute_path(m_context.GetVFS(), fileName, absFileName, sizeof(absFileName)))
+        if (m_context.GetAssetLibrary().FindAbsolutePath(fileName, absFileName, sizeof(absFileName)))
         {
             auto iTexture = m_loadedTextures.Find(absFileName);
             if (iTexture != nullptr)
@@ -153,18 +147,7 @@ namespace GT
                 auto texture = iTexture->value;
                 assert(texture != nullptr);
                 {
-                    Image image(absFileName);
-                    if (image.IsLinkedToFile())
-                    {
-                        texture->SetData(image.GetWidth(), image.GetHeight(), image.GetFormat(), image.GetBaseMipmapData());
-                        Renderer::PushTexture2DData(*texture);
-                        Renderer::GenerateTexture2DMipmaps(*texture);
-
-                        // The local data should be deleted to save on some memory.
-                        texture->DeleteLocalData();
-
-                        return true;
-                    }
+                    return this->LoadTextureData(*texture, absFileName);
                 }
             }
         }
@@ -216,5 +199,172 @@ namespace GT
     {
         return ImageLoader::IsExtensionSupported(extension);
     }
+
+
+
+    /////////////////////////////////////////////////////
+    // Private
+
+    bool Texture2DLibrary::LoadTextureData(Texture2D &texture, const char* absFileName)
+    {
+        if (m_context.GetAssetLibrary().IsPackagePath(absFileName))
+        {
+            return this->LoadPackagedTextureData(texture, absFileName);
+        }
+
+        // The image is only looked up once. It's modified time is what decides whether or not the baked texture is up-to-date.
+        drfs_file_info sourceInfo;
+        if (drfs_get_file_info(m_context.GetVFS(), absFileName, &sourceInfo) != drfs_success)
+        {
+            return false;
+        }
+
+        if (this->LoadBakedTextureData(texture, sourceInfo))
+        {
+            return true;
+        }
+
+
+        Image image(sourceInfo.absolutePath);
+        if (image.IsLinkedToFile())
+        {
+            image.PullAllMipmaps();     // <-- This loads the image data.
+
+            texture.SetData(image.GetWidth(), image.GetHeight(), image.GetFormat(), image.GetBaseMipmapData());
+            Renderer::PushTexture2DData(texture);
+            Renderer::GenerateTexture2DMipmaps(texture);
+
+            // Local data should be cleared since it won't be needed now. The renderer will have made a copy of the data, so it's safe to delete now.
+            texture.DeleteLocalData();
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool Texture2DLibrary::LoadBakedTextureData(Texture2D &texture, const drfs_file_info &sourceInfo)
+    {
+        // The baked texture sits next to the image, in the same way as .gtmodel files. It is only used if the image hasn't been modified since
+        // it was baked. Ties go to the baked texture since the packager copies the image just before baking it.
+        char bakedAbsolutePath[DRFS_MAX_PATH];
+        drpath_copy_and_append_extension(bakedAbsolutePath, sizeof(bakedAbsolutePath), sourceInfo.absolutePath, "gttexture");
+
+        drfs_file_info bakedInfo;
+        if (drfs_get_file_info(m_context.GetVFS(), bakedAbsolutePath, &bakedInfo) != drfs_success || sourceInfo.lastModifiedTime > bakedInfo.lastModifiedTime)
+        {
+            return false;
+        }
+
+
+        // The file is mapped if possible so the mipmaps can go straight from the file to the renderer. Files inside archives are read instead.
+        MappedFile mappedFile;
+        void* pFileData = nullptr;
+
+        const void* pData;
+        size_t dataSize;
+        if (mappedFile.Open(bakedInfo.absolutePath))
+        {
+            pData    = mappedFile.GetData();
+            dataSize = mappedFile.GetSize();
+        }
+        else
+        {
+            pFileData = drfs_open_and_read_binary_file(m_context.GetVFS(), bakedInfo.absolutePath, &dataSize);
+            if (pFileData == nullptr)
+            {
+                return false;
+            }
+
+            pData = pFileData;
+        }
+
+        bool result = this->SetBakedTextureData(texture, pData, dataSize, bakedAbsolutePath);
+
+        drfs_free(pFileData);
+        return result;
+    }
+
+    bool Texture2DLibrary::SetBakedTextureData(Texture2D &texture, const void* pData, size_t dataSize, const char* bakedAbsolutePath)
+    {
+        bool result = false;
+
+        BakedTexture bakedTexture;
+        if (bakedTexture.Parse(pData, dataSize))
+        {
+            // Textures baked for a renderer with the other orientation, or compressed textures on hardware without support for them, fall
+            // back to the image.
+            if (bakedTexture.IsFlipped() == Renderer::HasFlippedTextures() && (!IsImageFormatCompressed(bakedTexture.GetFormat()) || Renderer::SupportsCompressedTextures()))
+            {
+                // Only the properties of the texture are set on the client side. There is no local data to delete afterwards.
+                texture.SetData(bakedTexture.GetWidth(), bakedTexture.GetHeight(), bakedTexture.GetFormat(), nullptr);
+
+                for (uint32_t iMipmap = 0; iMipmap < bakedTexture.GetMipmapCount(); ++iMipmap)
+                {
+                    Renderer::SetTexture2DData(texture, static_cast<int>(iMipmap), bakedTexture.GetMipmapWidth(iMipmap), bakedTexture.GetMipmapHeight(iMipmap), bakedTexture.GetFormat(), bakedTexture.GetMipmapData(iMipmap));
+                }
+
+                Renderer::SetTexture2DMipmapLevels(texture, 0, bakedTexture.GetMipmapCount() - 1);
+
+                result = true;
+            }
+        }
+        else
+        {
+            m_context.LogErrorf("Invalid baked texture: %s", bakedAbsolutePath);
+        }
+
+        return result;
+    }
+
+    bool Texture2DLibrary::LoadPackagedTextureData(Texture2D &texture, const char* absFileName)
+    {
+        auto &assetLibrary = m_context.GetAssetLibrary();
+
+        // Packed textures are baked when the package is built, so there are no timestamps to compare.
+        char bakedAbsolutePath[DRFS_MAX_PATH];
+        drpath_copy_and_append_extension(bakedAbsolutePath, sizeof(bakedAbsolutePath), absFileName, "gttexture");
+
+        size_t bakedDataSize;
+        void* pBakedBuffer;
+        const void* pBakedData = assetLibrary.GetPackageFileData(bakedAbsolutePath, bakedDataSize, pBakedBuffer);
+
+        bool isBakedTextureSet = pBakedData != nullptr && this->SetBakedTextureData(texture, pBakedData, bakedDataSize, bakedAbsolutePath);
+
+        free(pBakedBuffer);
+
+        if (isBakedTextureSet)
+        {
+            return true;
+        }
+
+
+        auto pAsset = assetLibrary.Load(absFileName);
+        if (pAsset == nullptr)
+        {
+            return false;
+        }
+
+        bool result = false;
+
+        if (pAsset->GetClass() == AssetClass_Image)
+        {
+            auto pImageAsset = reinterpret_cast<ImageAsset*>(pAsset);
+            if (pImageAsset->GetImageFormat() == TextureFormat_RGBA8)
+            {
+                texture.SetData(pImageAsset->GetImageWidth(), pImageAsset->GetImageHeight(), ImageFormat_RGBA8, pImageAsset->GetImageData());
+                Renderer::PushTexture2DData(texture);
+                Renderer::GenerateTexture2DMipmaps(texture);
+
+                // As with images loaded from files, the renderer will have made a copy of the data.
+                texture.DeleteLocalData();
+
+                result = true;
+            }
+        }
+
+        assetLibrary.Unload(pAsset);
+        return result;
+    }
 }
 